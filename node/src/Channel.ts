@@ -3,6 +3,7 @@ import { Duplex } from 'stream';
 import { Logger } from './Logger';
 import { EnhancedEventEmitter } from './EnhancedEventEmitter';
 import { InvalidStateError } from './errors';
+import * as binaryMessage from './binaryMessage';
 
 const littleEndian = os.endianness() == 'LE';
 const logger = new Logger('Channel');
@@ -115,9 +116,15 @@ export class Channel extends EnhancedEventEmitter
 
 				try
 				{
-					// We can receive JSON messages (Channel messages) or log strings.
+					// We can receive JSON or binary messages (Channel messages) or log
+					// strings.
 					switch (payload[0])
 					{
+						// 0 (a Channel binary message).
+						case 0:
+							this.processMessage(binaryMessage.toJsonMessage(payload));
+							break;
+
 						// 123 = '{' (a Channel JSON message).
 						case 123:
 							this.processMessage(JSON.parse(payload.toString('utf8')));
@@ -238,7 +245,15 @@ export class Channel extends EnhancedEventEmitter
 			throw new InvalidStateError('Channel closed');
 		}
 
-		const request = `${id}:${method}:${handlerId}:${JSON.stringify(data)}`;
+		const methodId = binaryMessage.getChannelMethodId(method);
+
+		// Methods known by id are sent as binary requests (with JSON data), so the
+		// worker replies in binary too, with schema encoded stats and dumps.
+		// Others fall back to the text protocol.
+		const request = methodId
+			? binaryMessage.encode(
+				binaryMessage.MessageType.REQUEST, methodId, id, handlerId, JSON.stringify(data))
+			: `${id}:${method}:${handlerId}:${JSON.stringify(data)}`;
 
 		if (Buffer.byteLength(request) > MESSAGE_MAX_LEN)
 		{
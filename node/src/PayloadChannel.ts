@@ -3,6 +3,7 @@ import { Duplex } from 'stream';
 import { Logger } from './Logger';
 import { EnhancedEventEmitter } from './EnhancedEventEmitter';
 import { InvalidStateError } from './errors';
+import * as binaryMessage from './binaryMessage';
 
 const littleEndian = os.endianness() == 'LE';
 const logger = new Logger('PayloadChannel');
@@ -191,7 +192,11 @@ export class PayloadChannel extends EnhancedEventEmitter
 			throw new InvalidStateError('PayloadChannel closed');
 		}
 
-		const notification = `n:${event}:${handlerId}:${data}`;
+		const eventId = binaryMessage.getPayloadChannelEventId(event);
+		const notification = eventId
+			? binaryMessage.encode(
+				binaryMessage.MessageType.NOTIFICATION, eventId, 0, handlerId, data)
+			: `n:${event}:${handlerId}:${data}`;
 
 		if (Buffer.byteLength(notification) > MESSAGE_MAX_LEN)
 		{
@@ -251,7 +256,11 @@ export class PayloadChannel extends EnhancedEventEmitter
 			throw new InvalidStateError('PayloadChannel closed');
 		}
 
-		const request = `r:${id}:${method}:${handlerId}:${data}`;
+		const methodId = binaryMessage.getPayloadChannelMethodId(method);
+		const request = methodId
+			? binaryMessage.encode(
+				binaryMessage.MessageType.REQUEST, methodId, id, handlerId, data)
+			: `r:${id}:${method}:${handlerId}:${data}`;
 
 		if (Buffer.byteLength(request) > MESSAGE_MAX_LEN)
 		{
@@ -313,7 +322,10 @@ export class PayloadChannel extends EnhancedEventEmitter
 
 			try
 			{
-				msg = JSON.parse(data.toString('utf8'));
+				// Binary messages are sent once we sent a binary one.
+				msg = binaryMessage.isBinary(data)
+					? binaryMessage.toJsonMessage(data)
+					: JSON.parse(data.toString('utf8'));
 			}
 			catch (error)
 			{
@@ -34,6 +34,13 @@ export type ProducerOptions<ProducerAppData extends AppData = AppData> =
 	 */
 	keyFrameRequestDelay?: number;
 
+	/**
+	 * Just for video. Whether the packets since the most recent key frame must
+	 * be kept so new Consumers can start with them instead of asking the sender
+	 * for a new key frame. Default false.
+	 */
+	keyFrameCache?: boolean;
+
 	/**
 	 * Custom application data.
 	 */
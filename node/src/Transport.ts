@@ -549,6 +549,7 @@ export class Transport
 			rtpParameters,
 			paused = false,
 			keyFrameRequestDelay,
+			keyFrameCache = false,
 			appData
 		}: ProducerOptions<ProducerAppData>
 	): Promise<Producer<ProducerAppData>>
@@ -620,6 +621,7 @@ export class Transport
 			rtpParameters,
 			rtpMapping,
 			keyFrameRequestDelay,
+			keyFrameCache,
 			paused
 		};
 
@@ -12,6 +12,18 @@ export type WebRtcServerOptions<WebRtcServerAppData extends AppData = AppData> =
 	 */
 	listenInfos: WebRtcServerListenInfo[];
 
+	/**
+	 * Share the UDP ports of listenInfos (which must be given) with the
+	 * WebRtcServers of other workers by binding them with SO_REUSEPORT (Linux).
+	 * Each WebRtcServer in the group must have a different index (from 0 to 61)
+	 * and they must be created in index order, before any of them handles
+	 * traffic. None of them should be closed while the others are in use. The
+	 * kernel delivers ICE traffic of each WebRtcTransport to the worker that
+	 * owns it. TCP listenInfos are not shared so they need a different port in
+	 * each worker.
+	 */
+	reusePortIndex?: number;
+
 	/**
 	 * Custom application data.
 	 */
@@ -141,6 +141,25 @@ export type DtlsRole = 'auto' | 'client' | 'server';
 
 export type DtlsState = 'new' | 'connecting' | 'connected' | 'failed' | 'closed';
 
+/**
+ * Tuple in WebRtcTransport stats. TCP ones also have the write queue stats of
+ * their connection.
+ */
+export type WebRtcTransportTupleStat = TransportTuple &
+{
+	/**
+	 * Bytes given to the connection but not written into the socket yet.
+	 */
+	writeQueueSize?: number;
+	maxWriteQueueSize?: number;
+	/**
+	 * Number of writes that could not be entirely done immediately.
+	 */
+	queuedWrites?: number;
+	writeBatchFlushes?: number;
+	writeBatchItems?: number;
+};
+
 export type WebRtcTransportStat =
 {
 	// Common to all Transports.
@@ -168,7 +187,7 @@ export type WebRtcTransportStat =
 	// WebRtcTransport specific.
 	iceRole: string;
 	iceState: IceState;
-	iceSelectedTuple?: TransportTuple;
+	iceSelectedTuple?: WebRtcTransportTupleStat;
 	dtlsState: DtlsState;
 };
 
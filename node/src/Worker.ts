@@ -75,6 +75,58 @@ export type WorkerSettings<WorkerAppData extends AppData = AppData> =
 	 */
 	libwebrtcFieldTrials?: string;
 
+	/**
+	 * Whether UDP datagrams sent during a loop iteration are batched and sent at
+	 * the end of it with a single sendmmsg() syscall per socket (and UDP GSO when
+	 * supported). Just supported in Linux. Default false.
+	 */
+	udpSendBatching?: boolean;
+
+	/**
+	 * Max number of UDP datagrams read with a single recvmmsg() syscall per socket
+	 * readiness event. Valid values are 1 to 20. Just effective in Linux.
+	 * Default 1.
+	 */
+	udpRecvBatchSize?: number;
+
+	/**
+	 * Pace the RTP sent by transports with bandwidth estimation according to the
+	 * estimated available bitrate so bursts (e.g. key frames) do not overflow the
+	 * network queues. Audio is sent first, then retransmissions and video.
+	 * Default false.
+	 */
+	egressPacing?: boolean;
+
+	/**
+	 * Run the CPU intensive part of DTLS handshakes (processing of received
+	 * handshake messages, including the key exchange and signatures) in the libuv
+	 * thread pool instead of the worker thread, so a burst of new connections
+	 * does not delay the media of the existing ones. Default false.
+	 */
+	dtlsHandshakeOffload?: boolean;
+
+	/**
+	 * Whether data sent over each ICE-TCP connection during a loop iteration is
+	 * coalesced and written at the end of it with a single syscall. Default false.
+	 */
+	tcpSendBatching?: boolean;
+
+	/**
+	 * Number of records of the binary RTP trace ring of the worker, one per
+	 * sent or dropped RTP packet. Retrieve it with worker.dumpRtpTrace(). Max
+	 * 32768. Default 0 (disabled).
+	 */
+	rtpTraceSize?: number;
+
+	/**
+	 * Whether log messages are batched and written to the Node process once per
+	 * event loop iteration instead of one by one, and logging call sites are
+	 * rate limited (excess messages are counted and reported). Messages are
+	 * still formatted and written by the worker thread. Error messages are
+	 * written right away. Default false.
+	 */
+	logBatching?: boolean;
+
 	/**
 	 * Custom application data.
 	 */
@@ -177,9 +229,102 @@ export type WorkerResourceUsage =
 	/* eslint-enable camelcase */
 };
 
+/**
+ * Binary RTP trace of the worker. Each record (recordSize bytes, in byteOrder)
+ * has these fields: timestamp (uint64, ms), recvTransportHandle,
+ * sendTransportHandle, routerHandle, producerHandle, consumerHandle,
+ * recvSsrc, recvRtpTimestamp, sendRtpTimestamp (uint32), recvSeqNumber,
+ * sendSeqNumber (uint16), dropped, dropReason (uint8) and 2 reserved bytes.
+ */
+export type WorkerRtpTraceDump =
+{
+	/**
+	 * Version of the record layout.
+	 */
+	version: number;
+
+	/**
+	 * Size of each record in bytes.
+	 */
+	recordSize: number;
+
+	/**
+	 * Byte order of record fields.
+	 */
+	byteOrder: 'little' | 'big';
+
+	/**
+	 * Max number of records in the ring.
+	 */
+	capacity: number;
+
+	/**
+	 * Number of records written since the worker started (older ones were
+	 * overwritten).
+	 */
+	numWritten: number;
+
+	/**
+	 * Base64 encoded chunks of records, oldest first.
+	 */
+	records: string[];
+
+	/**
+	 * Ids of alive objects (Routers, Transports, Producers and Consumers)
+	 * indexed by the handle used in records. Handle 0 means none.
+	 */
+	objects: Record<string, string>;
+
+	/**
+	 * Drop reason names indexed by the value used in records.
+	 */
+	dropReasons: Record<string, string>;
+};
+
+/**
+ * Stats of a Transport, or of an RTP stream of a Producer or Consumer, pushed
+ * by the worker once worker.subscribeStats() is called.
+ */
+export type WorkerStatsEntry =
+{
+	/**
+	 * Id of the Transport, Producer or Consumer.
+	 */
+	id: string;
+
+	type: 'transport' | 'inbound-rtp' | 'outbound-rtp';
+
+	/**
+	 * SSRC of the RTP stream (not present in transport entries).
+	 */
+	ssrc?: number;
+
+	/**
+	 * Current values, named as in getStats().
+	 */
+	stats: Record<string, number>;
+};
+
+export type WorkerStatsUpdate =
+{
+	timestamp: number;
+
+	/**
+	 * New entries and those whose stats changed since the previous update.
+	 */
+	changed: WorkerStatsEntry[];
+
+	/**
+	 * Entries that are gone (their Transport, Producer, Consumer or RTP stream
+	 * was closed).
+	 */
+	removed: WorkerStatsEntry[];
+};
+
 export type WorkerEvents =
 {
 	died: [Error];
+	stats: [WorkerStatsUpdate];
 	// Private events.
 	'@success': [];
 	'@failure': [Error];
@@ -204,6 +349,62 @@ const workerBin = process.env.MEDIASOUP_WORKER_BIN
 const logger = new Logger('Worker');
 const workerLogger = new Logger('Worker');
 
+// Version of the stats stream payload.
+const STATS_VERSION = 1;
+
+// Names of the values of each type of stats stream entry, in payload order.
+const STATS_NAMES: Record<WorkerStatsEntry['type'], string[]> =
+{
+	'transport' :
+	[
+		'bytesReceived',
+		'recvBitrate',
+		'bytesSent',
+		'sendBitrate',
+		'rtpBytesReceived',
+		'rtpRecvBitrate',
+		'rtpBytesSent',
+		'rtpSendBitrate',
+		'rtxBytesReceived',
+		'rtxRecvBitrate',
+		'rtxBytesSent',
+		'rtxSendBitrate',
+		'probationBytesSent',
+		'probationSendBitrate',
+		'availableOutgoingBitrate',
+		'availableIncomingBitrate'
+	],
+	'inbound-rtp'  : [],
+	'outbound-rtp' : []
+};
+
+STATS_NAMES['inbound-rtp'] = STATS_NAMES['outbound-rtp'] =
+[
+	'packetCount',
+	'byteCount',
+	'bitrate',
+	'packetsLost',
+	'fractionLost',
+	'packetsDiscarded',
+	'packetsRetransmitted',
+	'packetsRepaired',
+	'nackCount',
+	'nackPacketCount',
+	'pliCount',
+	'firCount',
+	'score',
+	'roundTripTime',
+	'jitter'
+];
+
+type StatsStreamEntry =
+{
+	id: string;
+	type: WorkerStatsEntry['type'];
+	ssrc?: number;
+	values: number[];
+};
+
 export class Worker<WorkerAppData extends AppData = AppData>
 	extends EnhancedEventEmitter<WorkerEvents>
 {
@@ -237,6 +438,9 @@ export class Worker<WorkerAppData extends AppData = AppData>
 	// Observer instance.
 	readonly #observer = new EnhancedEventEmitter<WorkerObserverEvents>();
 
+	// Stats stream entries indexed by entryId.
+	readonly #statsEntries: Map<number, StatsStreamEntry> = new Map();
+
 	/**
 	 * @private
 	 */
@@ -249,6 +453,13 @@ export class Worker<WorkerAppData extends AppData = AppData>
 			dtlsCertificateFile,
 			dtlsPrivateKeyFile,
 			libwebrtcFieldTrials,
+			udpSendBatching,
+			udpRecvBatchSize,
+			egressPacing,
+			dtlsHandshakeOffload,
+			tcpSendBatching,
+			rtpTraceSize,
+			logBatching,
 			appData
 		}: WorkerSettings<WorkerAppData>)
 	{
@@ -309,6 +520,41 @@ export class Worker<WorkerAppData extends AppData = AppData>
 			spawnArgs.push(`--libwebrtcFieldTrials=${libwebrtcFieldTrials}`);
 		}
 
+		if (typeof udpSendBatching === 'boolean')
+		{
+			spawnArgs.push(`--udpSendBatching=${udpSendBatching}`);
+		}
+
+		if (typeof udpRecvBatchSize === 'number' && !Number.isNaN(udpRecvBatchSize))
+		{
+			spawnArgs.push(`--udpRecvBatchSize=${udpRecvBatchSize}`);
+		}
+
+		if (typeof egressPacing === 'boolean')
+		{
+			spawnArgs.push(`--egressPacing=${egressPacing}`);
+		}
+
+		if (typeof dtlsHandshakeOffload === 'boolean')
+		{
+			spawnArgs.push(`--dtlsHandshakeOffload=${dtlsHandshakeOffload}`);
+		}
+
+		if (typeof tcpSendBatching === 'boolean')
+		{
+			spawnArgs.push(`--tcpSendBatching=${tcpSendBatching}`);
+		}
+
+		if (typeof rtpTraceSize === 'number' && !Number.isNaN(rtpTraceSize))
+		{
+			spawnArgs.push(`--rtpTraceSize=${rtpTraceSize}`);
+		}
+
+		if (typeof logBatching === 'boolean')
+		{
+			spawnArgs.push(`--logBatching=${logBatching}`);
+		}
+
 		logger.debug(
 			'spawning worker process: %s %s', spawnBin, spawnArgs.join(' '));
 
@@ -376,6 +622,26 @@ export class Worker<WorkerAppData extends AppData = AppData>
 			}
 		});
 
+		this.#payloadChannel.on(
+			String(this.#pid),
+			(event: string, data: any | undefined, payload: Buffer) =>
+			{
+				switch (event)
+				{
+					case 'stats':
+					{
+						this.handleStats(data, payload);
+
+						break;
+					}
+
+					default:
+					{
+						logger.error('ignoring unknown event "%s"', event);
+					}
+				}
+			});
+
 		this.#child.on('exit', (code, signal) =>
 		{
 			this.#child = undefined;
@@ -599,6 +865,57 @@ export class Worker<WorkerAppData extends AppData = AppData>
 		return this.#channel.request('worker.getResourceUsage');
 	}
 
+	/**
+	 * Dump the binary RTP trace ring of the worker (see rtpTraceSize setting).
+	 */
+	async dumpRtpTrace(): Promise<WorkerRtpTraceDump>
+	{
+		logger.debug('dumpRtpTrace()');
+
+		return this.#channel.request('worker.dumpRtpTrace');
+	}
+
+	/**
+	 * Get the worker metrics (packets routed and dropped, SRTP failures, send
+	 * EAGAINs, event loop lag, etc.) in OpenMetrics text format, ready to be
+	 * served to a Prometheus scraper.
+	 */
+	async getMetrics(): Promise<string>
+	{
+		logger.debug('getMetrics()');
+
+		const { text } = await this.#channel.request('worker.getMetrics');
+
+		return text;
+	}
+
+	/**
+	 * Make the worker push the stats of all its Transports, Producers and
+	 * Consumers every interval ms through the 'stats' event. Only the stats that
+	 * changed are sent. Calling it again changes the interval and sends all the
+	 * stats again.
+	 */
+	async subscribeStats({ interval }: { interval: number }): Promise<void>
+	{
+		logger.debug('subscribeStats()');
+
+		await this.#channel.request('worker.subscribeStats', undefined, { interval });
+
+		this.#statsEntries.clear();
+	}
+
+	/**
+	 * Stop the 'stats' event.
+	 */
+	async unsubscribeStats(): Promise<void>
+	{
+		logger.debug('unsubscribeStats()');
+
+		await this.#channel.request('worker.unsubscribeStats');
+
+		this.#statsEntries.clear();
+	}
+
 	/**
 	 * Update settings.
 	 */
@@ -622,6 +939,7 @@ export class Worker<WorkerAppData extends AppData = AppData>
 	async createWebRtcServer<WebRtcServerAppData extends AppData = AppData>(
 		{
 			listenInfos,
+			reusePortIndex,
 			appData
 		}: WebRtcServerOptions<WebRtcServerAppData>
 	): Promise<WebRtcServer<WebRtcServerAppData>>
@@ -636,7 +954,8 @@ export class Worker<WorkerAppData extends AppData = AppData>
 		const reqData =
 		{
 			webRtcServerId : uuidv4(),
-			listenInfos
+			listenInfos,
+			reusePortIndex
 		};
 
 		await this.#channel.request('worker.createWebRtcServer', undefined, reqData);
@@ -702,6 +1021,116 @@ export class Worker<WorkerAppData extends AppData = AppData>
 		return router;
 	}
 
+	private handleStats(data: any, payload: Buffer): void
+	{
+		if (payload.length === 0 || payload[0] !== STATS_VERSION)
+		{
+			logger.error('handleStats() | unsupported stats payload version');
+
+			return;
+		}
+
+		const changed: Map<number, StatsStreamEntry> = new Map();
+		const removed: WorkerStatsEntry[] = [];
+
+		for (const { entryId, id, type, ssrc } of data.added)
+		{
+			const entry = { id, type, ssrc, values: new Array(16).fill(0) };
+
+			this.#statsEntries.set(entryId, entry);
+			changed.set(entryId, entry);
+		}
+
+		let pos = 1;
+
+		// Values may not fit into 32 bits so avoid bitwise operators.
+		const readVarint = (): number =>
+		{
+			let value = 0;
+			let multiplier = 1;
+			let byte: number;
+
+			do
+			{
+				byte = payload[pos++];
+				value += (byte & 0x7F) * multiplier;
+				multiplier *= 128;
+			}
+			while (byte & 0x80);
+
+			return value;
+		};
+
+		while (pos < payload.length)
+		{
+			const entryId = readVarint();
+			const mask = readVarint();
+			const entry = this.#statsEntries.get(entryId);
+
+			for (let idx = 0; idx < 16; ++idx)
+			{
+				if (!(mask & (1 << idx)))
+				{
+					continue;
+				}
+
+				const zigZag = readVarint();
+				const delta = zigZag % 2 === 0 ? zigZag / 2 : -(zigZag + 1) / 2;
+
+				if (entry)
+				{
+					entry.values[idx] += delta;
+				}
+			}
+
+			if (entry)
+			{
+				changed.set(entryId, entry);
+			}
+		}
+
+		for (const entryId of data.removed)
+		{
+			const entry = this.#statsEntries.get(entryId);
+
+			if (!entry)
+			{
+				continue;
+			}
+
+			this.#statsEntries.delete(entryId);
+			changed.delete(entryId);
+			removed.push(this.statsEntryToJson(entry));
+		}
+
+		this.safeEmit(
+			'stats',
+			{
+				timestamp : data.timestamp,
+				changed   : Array.from(changed.values())
+					.map((entry) => this.statsEntryToJson(entry)),
+				removed
+			});
+	}
+
+	private statsEntryToJson(entry: StatsStreamEntry): WorkerStatsEntry
+	{
+		const stats: Record<string, number> = {};
+
+		STATS_NAMES[entry.type].forEach((name, idx) =>
+		{
+			stats[name] = entry.values[idx];
+		});
+
+		// It comes in microseconds.
+		if (stats.roundTripTime !== undefined)
+		{
+			stats.roundTripTime /= 1000;
+		}
+
+		return { id: entry.id, type: entry.type, ssrc: entry.ssrc, stats };
+	}
+
 	private workerDied(error: Error): void
 	{
 		if (this.#closed)
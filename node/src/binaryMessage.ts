@@ -0,0 +1,626 @@
+import * as os from 'os';
+
+// Binary encoding of Channel and PayloadChannel messages. It mirrors
+// worker/include/Channel/BinaryMessage.hpp and BinaryBody.hpp, see them for
+// the layout of the header and the schema of the bodies.
+
+const littleEndian = os.endianness() == 'LE';
+
+export const HEADER_SIZE = 13;
+
+export enum MessageType
+{
+	REQUEST = 1,
+	NOTIFICATION,
+	RESPONSE_ACCEPTED,
+	RESPONSE_ERROR,
+	RESPONSE_TYPE_ERROR
+}
+
+export enum BodyType
+{
+	JSON = 0,
+	RECORD,
+	RECORDS
+}
+
+export type BinaryMessage =
+{
+	type: MessageType;
+	code: number;
+	id: number;
+	field1: string;
+	field2: string;
+	bodyType: BodyType;
+	data: Buffer;
+};
+
+enum ValueType
+{
+	UINT = 1,
+	INT,
+	DOUBLE,
+	BOOL,
+	STRING,
+	STRINGS,
+	RECORD,
+	STRING_MAP,
+	STRINGS_MAP,
+	UINT_MAP
+}
+
+// Channel request methods indexed by their id - 1 (ChannelRequest::MethodId).
+const channelMethods: string[] =
+[
+	'worker.close',
+	'worker.dump',
+	'worker.getResourceUsage',
+	'worker.updateSettings',
+	'worker.createWebRtcServer',
+	'worker.createRouter',
+	'worker.closeWebRtcServer',
+	'webRtcServer.dump',
+	'worker.closeRouter',
+	'router.dump',
+	'router.createWebRtcTransport',
+	'router.createWebRtcTransportWithServer',
+	'router.createPlainTransport',
+	'router.createPipeTransport',
+	'router.createDirectTransport',
+	'router.closeTransport',
+	'router.createActiveSpeakerObserver',
+	'router.createAudioLevelObserver',
+	'router.closeRtpObserver',
+	'transport.dump',
+	'transport.getStats',
+	'transport.connect',
+	'transport.setMaxIncomingBitrate',
+	'transport.setMaxOutgoingBitrate',
+	'transport.setMinOutgoingBitrate',
+	'transport.restartIce',
+	'transport.produce',
+	'transport.consume',
+	'transport.produceData',
+	'transport.consumeData',
+	'transport.enableTraceEvent',
+	'transport.closeProducer',
+	'producer.dump',
+	'producer.getStats',
+	'producer.pause',
+	'producer.resume',
+	'producer.enableTraceEvent',
+	'transport.closeConsumer',
+	'consumer.dump',
+	'consumer.getStats',
+	'consumer.pause',
+	'consumer.resume',
+	'consumer.setPreferredLayers',
+	'consumer.setPriority',
+	'consumer.requestKeyFrame',
+	'consumer.enableTraceEvent',
+	'transport.closeDataProducer',
+	'dataProducer.dump',
+	'dataProducer.getStats',
+	'transport.closeDataConsumer',
+	'dataConsumer.dump',
+	'dataConsumer.getStats',
+	'dataConsumer.getBufferedAmount',
+	'dataConsumer.setBufferedAmountLowThreshold',
+	'rtpObserver.pause',
+	'rtpObserver.resume',
+	'rtpObserver.addProducer',
+	'rtpObserver.removeProducer',
+	'worker.dumpRtpTrace',
+	'worker.subscribeStats',
+	'worker.unsubscribeStats',
+	'worker.getMetrics'
+];
+
+// PayloadChannel request methods indexed by their id - 1
+// (PayloadChannelRequest::MethodId).
+const payloadChannelMethods: string[] =
+[
+	'dataConsumer.send'
+];
+
+// PayloadChannel notification events indexed by their id - 1
+// (PayloadChannelNotification::EventId).
+const payloadChannelEvents: string[] =
+[
+	'transport.sendRtcp',
+	'producer.send',
+	'dataProducer.send'
+];
+
+const channelMethodIds = toIds(channelMethods);
+const payloadChannelMethodIds = toIds(payloadChannelMethods);
+const payloadChannelEventIds = toIds(payloadChannelEvents);
+
+// Names and value types indexed by key (BinaryBody::Key).
+const keys: [ string, ValueType ][] =
+[
+	[ '',                                    ValueType.UINT ],
+	[ 'type',                                ValueType.STRING ],
+	[ 'id',                                  ValueType.STRING ],
+	[ 'timestamp',                           ValueType.UINT ],
+	[ 'transportId',                         ValueType.STRING ],
+	[ 'sctpState',                           ValueType.STRING ],
+	[ 'bytesReceived',                       ValueType.UINT ],
+	[ 'recvBitrate',                         ValueType.UINT ],
+	[ 'bytesSent',                           ValueType.UINT ],
+	[ 'sendBitrate',                         ValueType.UINT ],
+	[ 'rtpBytesReceived',                    ValueType.UINT ],
+	[ 'rtpRecvBitrate',                      ValueType.UINT ],
+	[ 'rtpBytesSent',                        ValueType.UINT ],
+	[ 'rtpSendBitrate',                      ValueType.UINT ],
+	[ 'rtxBytesReceived',                    ValueType.UINT ],
+	[ 'rtxRecvBitrate',                      ValueType.UINT ],
+	[ 'rtxBytesSent',                        ValueType.UINT ],
+	[ 'rtxSendBitrate',                      ValueType.UINT ],
+	[ 'probationBytesSent',                  ValueType.UINT ],
+	[ 'probationSendBitrate',                ValueType.UINT ],
+	[ 'availableOutgoingBitrate',            ValueType.UINT ],
+	[ 'availableIncomingBitrate',            ValueType.UINT ],
+	[ 'maxIncomingBitrate',                  ValueType.UINT ],
+	[ 'rtpPacketLossReceived',               ValueType.DOUBLE ],
+	[ 'rtpPacketLossSent',                   ValueType.DOUBLE ],
+	[ 'iceRole',                             ValueType.STRING ],
+	[ 'iceState',                            ValueType.STRING ],
+	[ 'iceSelectedTuple',                    ValueType.RECORD ],
+	[ 'dtlsState',                           ValueType.STRING ],
+	[ 'rtcpMux',                             ValueType.BOOL ],
+	[ 'comedia',                             ValueType.BOOL ],
+	[ 'tuple',                               ValueType.RECORD ],
+	[ 'rtcpTuple',                           ValueType.RECORD ],
+	[ 'localIp',                             ValueType.STRING ],
+	[ 'localPort',                           ValueType.UINT ],
+	[ 'remoteIp',                            ValueType.STRING ],
+	[ 'remotePort',                          ValueType.UINT ],
+	[ 'protocol',                            ValueType.STRING ],
+	[ 'ssrc',                                ValueType.UINT ],
+	[ 'kind',                                ValueType.STRING ],
+	[ 'mimeType',                            ValueType.STRING ],
+	[ 'packetsLost',                         ValueType.INT ],
+	[ 'fractionLost',                        ValueType.UINT ],
+	[ 'packetsDiscarded',                    ValueType.UINT ],
+	[ 'packetsRetransmitted',                ValueType.UINT ],
+	[ 'packetsRepaired',                     ValueType.UINT ],
+	[ 'nackCount',                           ValueType.UINT ],
+	[ 'nackPacketCount',                     ValueType.UINT ],
+	[ 'pliCount',                            ValueType.UINT ],
+	[ 'firCount',                            ValueType.UINT ],
+	[ 'score',                               ValueType.UINT ],
+	[ 'rid',                                 ValueType.STRING ],
+	[ 'rtxSsrc',                             ValueType.UINT ],
+	[ 'rtxPacketsDiscarded',                 ValueType.UINT ],
+	[ 'roundTripTime',                       ValueType.DOUBLE ],
+	[ 'jitter',                              ValueType.UINT ],
+	[ 'packetCount',                         ValueType.UINT ],
+	[ 'byteCount',                           ValueType.UINT ],
+	[ 'bitrate',                             ValueType.UINT ],
+	[ 'bitrateByLayer',                      ValueType.UINT_MAP ],
+	[ 'label',                               ValueType.STRING ],
+	[ 'messagesReceived',                    ValueType.UINT ],
+	[ 'messagesSent',                        ValueType.UINT ],
+	[ 'bufferedAmount',                      ValueType.UINT ],
+	[ 'pid',                                 ValueType.UINT ],
+	[ 'webRtcServerIds',                     ValueType.STRINGS ],
+	[ 'routerIds',                           ValueType.STRINGS ],
+	[ 'channelMessageHandlers',              ValueType.RECORD ],
+	[ 'channelRequestHandlers',              ValueType.STRINGS ],
+	[ 'payloadChannelRequestHandlers',       ValueType.STRINGS ],
+	[ 'payloadChannelNotificationHandlers',  ValueType.STRINGS ],
+	[ 'rtpPacketPool',                       ValueType.RECORD ],
+	[ 'packets',                             ValueType.RECORD ],
+	[ 'buffers',                             ValueType.RECORD ],
+	[ 'blockSize',                           ValueType.UINT ],
+	[ 'capacity',                            ValueType.UINT ],
+	[ 'inUse',                               ValueType.UINT ],
+	[ 'highWater',                           ValueType.UINT ],
+	[ 'transportIds',                        ValueType.STRINGS ],
+	[ 'rtpObserverIds',                      ValueType.STRINGS ],
+	[ 'mapProducerIdConsumerIds',            ValueType.STRINGS_MAP ],
+	[ 'mapConsumerIdProducerId',             ValueType.STRING_MAP ],
+	[ 'mapProducerIdObserverIds',            ValueType.STRINGS_MAP ],
+	[ 'mapDataProducerIdDataConsumerIds',    ValueType.STRINGS_MAP ],
+	[ 'mapDataConsumerIdDataProducerId',     ValueType.STRING_MAP ],
+	[ 'ppid',                                ValueType.UINT ],
+	[ 'writeQueueSize',                      ValueType.UINT ],
+	[ 'maxWriteQueueSize',                   ValueType.UINT ],
+	[ 'queuedWrites',                        ValueType.UINT ],
+	[ 'writeBatchFlushes',                   ValueType.UINT ],
+	[ 'writeBatchItems',                     ValueType.UINT ]
+];
+
+// Maximum nesting of records accepted by the decoder.
+const MAX_DEPTH = 8;
+
+/**
+ * Whether the given message received from the worker is a binary one.
+ */
+export function isBinary(msg: Buffer): boolean
+{
+	return msg.length >= HEADER_SIZE && msg[0] === 0;
+}
+
+/**
+ * Id of the given Channel request method, undefined if the worker does not
+ * know it by id (so the request must be sent as text).
+ */
+export function getChannelMethodId(method: string): number | undefined
+{
+	return channelMethodIds.get(method);
+}
+
+/**
+ * Id of the given PayloadChannel request method.
+ */
+export function getPayloadChannelMethodId(method: string): number | undefined
+{
+	return payloadChannelMethodIds.get(method);
+}
+
+/**
+ * Id of the given PayloadChannel notification event.
+ */
+export function getPayloadChannelEventId(event: string): number | undefined
+{
+	return payloadChannelEventIds.get(event);
+}
+
+/**
+ * Encodes a binary message whose data is given as is (a JSON text for
+ * requests and notifications sent to the worker).
+ */
+export function encode(
+	type: MessageType,
+	code: number,
+	id: number,
+	field1: string | undefined,
+	data: string | undefined
+): Buffer
+{
+	const field1Len = field1 ? Buffer.byteLength(field1) : 0;
+	const dataLen = data ? Buffer.byteLength(data) : 0;
+	const buffer = Buffer.allocUnsafe(HEADER_SIZE + field1Len + dataLen);
+
+	buffer[0] = 0;
+	buffer[1] = type;
+
+	if (littleEndian)
+	{
+		buffer.writeUInt16LE(code, 2);
+		buffer.writeUInt32LE(id, 4);
+		buffer.writeUInt16LE(field1Len, 8);
+		buffer.writeUInt16LE(0, 10);
+	}
+	else
+	{
+		buffer.writeUInt16BE(code, 2);
+		buffer.writeUInt32BE(id, 4);
+		buffer.writeUInt16BE(field1Len, 8);
+		buffer.writeUInt16BE(0, 10);
+	}
+
+	buffer[12] = BodyType.JSON;
+
+	if (field1)
+	{
+		buffer.write(field1, HEADER_SIZE, 'utf8');
+	}
+
+	if (data)
+	{
+		buffer.write(data, HEADER_SIZE + field1Len, 'utf8');
+	}
+
+	return buffer;
+}
+
+/**
+ * Decodes a binary message. Throws if it is not valid. Fields and data are
+ * not copied.
+ */
+export function decode(msg: Buffer): BinaryMessage
+{
+	if (!isBinary(msg))
+	{
+		throw new TypeError('not a binary message');
+	}
+
+	const type = msg[1] as MessageType;
+	const bodyType = msg[12] as BodyType;
+	const code = littleEndian ? msg.readUInt16LE(2) : msg.readUInt16BE(2);
+	const id = littleEndian ? msg.readUInt32LE(4) : msg.readUInt32BE(4);
+	const field1Len = littleEndian ? msg.readUInt16LE(8) : msg.readUInt16BE(8);
+	const field2Len = littleEndian ? msg.readUInt16LE(10) : msg.readUInt16BE(10);
+
+	if (type < MessageType.REQUEST || type > MessageType.RESPONSE_TYPE_ERROR)
+	{
+		throw new TypeError(`unknown binary message type ${type}`);
+	}
+	else if (bodyType > BodyType.RECORDS)
+	{
+		throw new TypeError(`unknown binary message body type ${bodyType}`);
+	}
+	else if (HEADER_SIZE + field1Len + field2Len > msg.length)
+	{
+		throw new TypeError('binary message fields exceed its length');
+	}
+
+	const field2Start = HEADER_SIZE + field1Len;
+	const dataStart = field2Start + field2Len;
+
+	return {
+		type,
+		code,
+		id,
+		field1 : msg.toString('utf8', HEADER_SIZE, field2Start),
+		field2 : msg.toString('utf8', field2Start, dataStart),
+		bodyType,
+		data   : msg.subarray(dataStart)
+	};
+}
+
+/**
+ * Decodes the data of a binary message into the object it would have had in
+ * a JSON message (undefined if empty). Throws if it is not valid.
+ */
+export function decodeBody(bodyType: BodyType, data: Buffer): any
+{
+	switch (bodyType)
+	{
+		case BodyType.JSON:
+		{
+			return data.length > 0 ? JSON.parse(data.toString('utf8')) : undefined;
+		}
+
+		case BodyType.RECORD:
+		{
+			const reader = new Reader(data);
+			const record = reader.readRecord(0);
+
+			if (!reader.atEnd())
+			{
+				throw new TypeError('trailing data after binary record');
+			}
+
+			return record;
+		}
+
+		case BodyType.RECORDS:
+		{
+			const reader = new Reader(data);
+			const records = [];
+
+			while (!reader.atEnd())
+			{
+				records.push(reader.readRecord(0));
+			}
+
+			return records;
+		}
+
+		default:
+		{
+			throw new TypeError(`unknown binary message body type ${bodyType}`);
+		}
+	}
+}
+
+/**
+ * Decodes a binary message received from the worker into the equivalent JSON
+ * message. Throws if it is not valid.
+ */
+export function toJsonMessage(msg: Buffer): any
+{
+	const { type, id, field1, field2, bodyType, data } = decode(msg);
+
+	switch (type)
+	{
+		case MessageType.RESPONSE_ACCEPTED:
+		{
+			return { id, accepted: true, data: decodeBody(bodyType, data) };
+		}
+
+		case MessageType.RESPONSE_ERROR:
+		{
+			return { id, error: 'Error', reason: data.toString('utf8') };
+		}
+
+		case MessageType.RESPONSE_TYPE_ERROR:
+		{
+			return { id, error: 'TypeError', reason: data.toString('utf8') };
+		}
+
+		case MessageType.NOTIFICATION:
+		{
+			return { targetId: field1, event: field2, data: decodeBody(bodyType, data) };
+		}
+
+		default:
+		{
+			throw new TypeError(`unexpected binary message type ${type}`);
+		}
+	}
+}
+
+function toIds(names: string[]): Map<string, number>
+{
+	return new Map(names.map((name, idx) => [ name, idx + 1 ]));
+}
+
+class Reader
+{
+	readonly #data: Buffer;
+	#pos = 0;
+
+	constructor(data: Buffer)
+	{
+		this.#data = data;
+	}
+
+	atEnd(): boolean
+	{
+		return this.#pos === this.#data.length;
+	}
+
+	readRecord(depth: number): any
+	{
+		if (depth > MAX_DEPTH)
+		{
+			throw new TypeError('binary records nested too deep');
+		}
+
+		const record: any = {};
+
+		while (this.#pos < this.#data.length)
+		{
+			const key = this.#data[this.#pos++];
+
+			if (key === 0)
+			{
+				return record;
+			}
+			else if (key >= keys.length)
+			{
+				throw new TypeError(`unknown binary record key ${key}`);
+			}
+
+			const [ name, type ] = keys[key];
+
+			record[name] = this.readValue(type, depth);
+		}
+
+		throw new TypeError('missing end of binary record');
+	}
+
+	private readValue(type: ValueType, depth: number): any
+	{
+		switch (type)
+		{
+			case ValueType.UINT:
+			{
+				return this.readVarint();
+			}
+
+			case ValueType.INT:
+			{
+				const value = this.readVarint();
+
+				// Zigzag decoding.
+				return value % 2 === 0 ? value / 2 : -(value + 1) / 2;
+			}
+
+			case ValueType.DOUBLE:
+			{
+				if (this.#data.length - this.#pos < 8)
+				{
+					throw new TypeError('truncated binary double');
+				}
+
+				const value = littleEndian
+					? this.#data.readDoubleLE(this.#pos)
+					: this.#data.readDoubleBE(this.#pos);
+
+				this.#pos += 8;
+
+				return value;
+			}
+
+			case ValueType.BOOL:
+			{
+				return this.readVarint() !== 0;
+			}
+
+			case ValueType.STRING:
+			{
+				return this.readString();
+			}
+
+			case ValueType.STRINGS:
+			{
+				const count = this.readVarint();
+				const values = [];
+
+				for (let idx = 0; idx < count; ++idx)
+				{
+					values.push(this.readString());
+				}
+
+				return values;
+			}
+
+			case ValueType.RECORD:
+			{
+				return this.readRecord(depth + 1);
+			}
+
+			case ValueType.STRING_MAP:
+			case ValueType.STRINGS_MAP:
+			case ValueType.UINT_MAP:
+			{
+				const itemType = type === ValueType.STRING_MAP
+					? ValueType.STRING
+					: type === ValueType.STRINGS_MAP ? ValueType.STRINGS : ValueType.UINT;
+				const count = this.readVarint();
+				const map: any = {};
+
+				for (let idx = 0; idx < count; ++idx)
+				{
+					const mapKey = this.readString();
+
+					map[mapKey] = this.readValue(itemType, depth);
+				}
+
+				return map;
+			}
+
+			default:
+			{
+				throw new TypeError(`unknown binary value type ${type}`);
+			}
+		}
+	}
+
+	private readVarint(): number
+	{
+		let value = 0;
+
+		// Bitwise operators are 32 bits, so multiply instead of shifting.
+		for (let factor = 1; factor < 2 ** 64; factor *= 128)
+		{
+			if (this.#pos === this.#data.length)
+			{
+				throw new TypeError('truncated binary varint');
+			}
+
+			const byte = this.#data[this.#pos++];
+
+			value += (byte & 0x7F) * factor;
+
+			if ((byte & 0x80) === 0)
+			{
+				return value;
+			}
+		}
+
+		throw new TypeError('invalid binary varint');
+	}
+
+	private readString(): string
+	{
+		const len = this.readVarint();
+
+		if (len > this.#data.length - this.#pos)
+		{
+			throw new TypeError('truncated binary string');
+		}
+
+		const value = this.#data.toString('utf8', this.#pos, this.#pos + len);
+
+		this.#pos += len;
+
+		return value;
+	}
+}
@@ -48,6 +48,13 @@ export async function createWorker<WorkerAppData extends AppData = AppData>(
 		dtlsCertificateFile,
 		dtlsPrivateKeyFile,
 		libwebrtcFieldTrials,
+		udpSendBatching,
+		udpRecvBatchSize,
+		egressPacing,
+		dtlsHandshakeOffload,
+		tcpSendBatching,
+		rtpTraceSize,
+		logBatching,
 		appData
 	}: WorkerSettings<WorkerAppData> = {}
 ): Promise<Worker<WorkerAppData>>
@@ -68,6 +75,13 @@ export async function createWorker<WorkerAppData extends AppData = AppData>(
 			dtlsCertificateFile,
 			dtlsPrivateKeyFile,
 			libwebrtcFieldTrials,
+			udpSendBatching,
+			udpRecvBatchSize,
+			egressPacing,
+			dtlsHandshakeOffload,
+			tcpSendBatching,
+			rtpTraceSize,
+			logBatching,
 			appData
 		});
 
@@ -0,0 +1,191 @@
+import * as os from 'os';
+import * as binaryMessage from '../binaryMessage';
+
+const littleEndian = os.endianness() == 'LE';
+
+// Keys of the records below (BinaryBody::Key in the worker).
+const TYPE = 1;
+const TIMESTAMP = 3;
+const LOCAL_IP = 33;
+const LOCAL_PORT = 34;
+const TUPLE = 31;
+const PACKETS_LOST = 41;
+const ROUND_TRIP_TIME = 54;
+const RTCP_MUX = 29;
+const SSRC = 38;
+const BITRATE_BY_LAYER = 59;
+const ROUTER_IDS = 66;
+const MAP_PRODUCER_ID_CONSUMER_IDS = 80;
+const PPID = 85;
+
+function varint(value: number): number[]
+{
+	const bytes = [];
+
+	while (value >= 0x80)
+	{
+		bytes.push((value % 0x80) | 0x80);
+		value = Math.floor(value / 0x80);
+	}
+
+	bytes.push(value);
+
+	return bytes;
+}
+
+function string(value: string): number[]
+{
+	const buffer = Buffer.from(value);
+
+	return [ ...varint(buffer.length), ...buffer ];
+}
+
+function double(value: number): number[]
+{
+	const buffer = Buffer.alloc(8);
+
+	if (littleEndian)
+	{
+		buffer.writeDoubleLE(value);
+	}
+	else
+	{
+		buffer.writeDoubleBE(value);
+	}
+
+	return [ ...buffer ];
+}
+
+function header(type: number, id: number, bodyType: number): Buffer
+{
+	const buffer = Buffer.alloc(binaryMessage.HEADER_SIZE);
+
+	buffer[1] = type;
+	buffer[12] = bodyType;
+
+	if (littleEndian)
+	{
+		buffer.writeUInt32LE(id, 4);
+	}
+	else
+	{
+		buffer.writeUInt32BE(id, 4);
+	}
+
+	return buffer;
+}
+
+const record = Buffer.from(
+	[
+		TYPE, ...string('webrtc-transport'),
+		TIMESTAMP, ...varint(1234567890123),
+		PACKETS_LOST, ...varint(5),
+		ROUND_TRIP_TIME, ...double(12.5),
+		RTCP_MUX, 1,
+		TUPLE, LOCAL_IP, ...string('1.2.3.4'), LOCAL_PORT, ...varint(40000), 0,
+		ROUTER_IDS, 2, ...string('r1'), ...string('r2'),
+		MAP_PRODUCER_ID_CONSUMER_IDS, 1, ...string('p1'), 2, ...string('c1'), ...string('c2'),
+		BITRATE_BY_LAYER, 1, ...string('0.1'), ...varint(300000),
+		0
+	]);
+
+test('decodeBody() decodes a record into the equivalent JSON object', () =>
+{
+	expect(binaryMessage.decodeBody(binaryMessage.BodyType.RECORD, record))
+		.toEqual(
+			{
+				type                     : 'webrtc-transport',
+				timestamp                : 1234567890123,
+				packetsLost              : -3,
+				roundTripTime            : 12.5,
+				rtcpMux                  : true,
+				tuple                    : { localIp: '1.2.3.4', localPort: 40000 },
+				routerIds                : [ 'r1', 'r2' ],
+				mapProducerIdConsumerIds : { p1: [ 'c1', 'c2' ] },
+				bitrateByLayer           : { '0.1': 300000 }
+			});
+}, 500);
+
+test('decodeBody() decodes records into an array', () =>
+{
+	const records = Buffer.from([ SSRC, ...varint(1111), 0, SSRC, ...varint(2222), 0 ]);
+
+	expect(binaryMessage.decodeBody(binaryMessage.BodyType.RECORDS, records))
+		.toEqual([ { ssrc: 1111 }, { ssrc: 2222 } ]);
+}, 500);
+
+test('decodeBody() rejects invalid data', () =>
+{
+	// Missing END key.
+	expect(() => binaryMessage.decodeBody(
+		binaryMessage.BodyType.RECORD, record.subarray(0, record.length - 1)))
+		.toThrow(TypeError);
+
+	// Trailing data after the record.
+	expect(() => binaryMessage.decodeBody(
+		binaryMessage.BodyType.RECORD, Buffer.concat([ record, Buffer.from([ 0 ]) ])))
+		.toThrow(TypeError);
+
+	// Unknown key.
+	expect(() => binaryMessage.decodeBody(
+		binaryMessage.BodyType.RECORD, Buffer.from([ 0xFE, 0 ])))
+		.toThrow(TypeError);
+}, 500);
+
+test('encode() and decode() succeed', () =>
+{
+	const methodId = binaryMessage.getChannelMethodId('transport.getStats');
+
+	expect(methodId).toBe(21);
+	expect(binaryMessage.getChannelMethodId('foo.bar')).toBeUndefined();
+
+	const msg = binaryMessage.decode(
+		binaryMessage.encode(
+			binaryMessage.MessageType.REQUEST, methodId!, 9, 'handler', '{"foo":1}'));
+
+	expect(msg.type).toBe(binaryMessage.MessageType.REQUEST);
+	expect(msg.code).toBe(21);
+	expect(msg.id).toBe(9);
+	expect(msg.field1).toBe('handler');
+	expect(msg.field2).toBe('');
+	expect(msg.bodyType).toBe(binaryMessage.BodyType.JSON);
+	expect(msg.data.toString()).toBe('{"foo":1}');
+}, 500);
+
+test('toJsonMessage() translates responses and notifications', () =>
+{
+	expect(binaryMessage.toJsonMessage(
+		Buffer.concat(
+			[
+				header(binaryMessage.MessageType.RESPONSE_ACCEPTED, 7, binaryMessage.BodyType.RECORDS),
+				Buffer.from([ SSRC, ...varint(1111), 0 ])
+			])))
+		.toEqual({ id: 7, accepted: true, data: [ { ssrc: 1111 } ] });
+
+	expect(binaryMessage.toJsonMessage(
+		Buffer.concat(
+			[
+				header(binaryMessage.MessageType.RESPONSE_TYPE_ERROR, 8, binaryMessage.BodyType.JSON),
+				Buffer.from('wrong foo')
+			])))
+		.toEqual({ id: 8, error: 'TypeError', reason: 'wrong foo' });
+
+	// Target id 'c1' and event 'message'.
+	const notification = header(
+		binaryMessage.MessageType.NOTIFICATION, 0, binaryMessage.BodyType.RECORD);
+
+	if (littleEndian)
+	{
+		notification.writeUInt16LE(2, 8);
+		notification.writeUInt16LE(7, 10);
+	}
+	else
+	{
+		notification.writeUInt16BE(2, 8);
+		notification.writeUInt16BE(7, 10);
+	}
+
+	expect(binaryMessage.toJsonMessage(
+		Buffer.concat([ notification, Buffer.from('c1message'), Buffer.from([ PPID, 51, 0 ]) ])))
+		.toEqual({ targetId: 'c1', event: 'message', data: { ppid: 51 } });
+}, 500);
@@ -25,7 +25,7 @@ use crate::srtp_parameters::{SrtpCryptoSuite, SrtpParameters};
 use crate::transport::{TransportId, TransportTraceEventType};
 use crate::webrtc_server::{WebRtcServerDump, WebRtcServerId, WebRtcServerListenInfos};
 use crate::webrtc_transport::{TransportListenIps, WebRtcTransportListen, WebRtcTransportOptions};
-use crate::worker::{WorkerDump, WorkerUpdateSettings};
+use crate::worker::{WorkerDump, WorkerMetrics, WorkerRtpTraceDump, WorkerUpdateSettings};
 use parking_lot::Mutex;
 use serde::de::DeserializeOwned;
 use serde::{Deserialize, Serialize};
@@ -158,6 +158,28 @@ request_response!(
     WorkerDump
 );
 
+request_response!(
+    &'static str,
+    "worker.dumpRtpTrace",
+    WorkerDumpRtpTraceRequest {},
+    WorkerRtpTraceDump
+);
+
+request_response!(
+    &'static str,
+    "worker.getMetrics",
+    WorkerGetMetricsRequest {},
+    WorkerMetrics
+);
+
+request_response!(
+    &'static str,
+    "worker.subscribeStats",
+    WorkerSubscribeStatsRequest { interval: u32 },
+);
+
+request_response!(&'static str, "worker.unsubscribeStats", WorkerUnsubscribeStatsRequest {});
+
 request_response!(
     &'static str,
     "worker.updateSettings",
@@ -174,6 +196,8 @@ request_response!(
         #[serde(rename = "webRtcServerId")]
         webrtc_server_id: WebRtcServerId,
         listen_infos: WebRtcServerListenInfos,
+        #[serde(skip_serializing_if = "Option::is_none")]
+        reuse_port_index: Option<u8>,
     },
 );
 
@@ -415,6 +439,7 @@ pub(crate) struct RouterCreatePipeTransportData {
     sctp_send_buffer_size: u32,
     enable_rtx: bool,
     enable_srtp: bool,
+    enable_in_process: bool,
     is_data_channel: bool,
 }
 
@@ -433,6 +458,7 @@ impl RouterCreatePipeTransportData {
             sctp_send_buffer_size: pipe_transport_options.sctp_send_buffer_size,
             enable_rtx: pipe_transport_options.enable_rtx,
             enable_srtp: pipe_transport_options.enable_srtp,
+            enable_in_process: pipe_transport_options.enable_in_process,
             is_data_channel: false,
         }
     }
@@ -619,6 +645,7 @@ request_response!(
         rtp_parameters: RtpParameters,
         rtp_mapping: RtpMapping,
         key_frame_request_delay: u32,
+        key_frame_cache: bool,
         paused: bool,
     },
     TransportProduceResponse {
@@ -15,8 +15,9 @@ pub use crate::worker_manager::WorkerManager;
 pub use crate::worker::{Worker, WorkerSettings};
 
 pub use crate::router::{
-    PipeDataProducerToRouterError, PipeDataProducerToRouterPair, PipeProducerToRouterError,
-    PipeProducerToRouterPair, PipeToRouterOptions, Router, RouterOptions,
+    CreateEgressTransportError, PipeDataProducerToRouterError, PipeDataProducerToRouterPair,
+    PipeProducerToRouterError, PipeProducerToRouterPair, PipeToRouterOptions, Router,
+    RouterOptions,
 };
 
 pub use crate::webrtc_server::{
@@ -51,7 +51,7 @@ use crate::transport::{
     TransportId,
 };
 use crate::webrtc_transport::{WebRtcTransport, WebRtcTransportListen, WebRtcTransportOptions};
-use crate::worker::{Channel, PayloadChannel, RequestError, Worker};
+use crate::worker::{Channel, CreateRouterError, PayloadChannel, RequestError, Worker};
 use crate::{ortc, uuid_based_wrapper_type};
 use async_executor::Executor;
 use async_lock::Mutex as AsyncMutex;
@@ -64,7 +64,7 @@ use serde::{Deserialize, Serialize};
 use std::fmt;
 use std::net::{IpAddr, Ipv4Addr};
 use std::ops::Deref;
-use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::atomic::{AtomicBool, AtomicUsize, Ordering};
 use std::sync::{Arc, Weak};
 use thiserror::Error;
 
@@ -85,6 +85,12 @@ uuid_based_wrapper_type!(
 pub struct RouterOptions {
     /// Router media codecs.
     pub media_codecs: Vec<RtpCodecCapability>,
+    /// Workers over which the Consumers of this Router are spread, see
+    /// [`Router::create_egress_webrtc_transport()`]. They should live in this process, so that
+    /// Producers are piped into them without using the network.
+    ///
+    /// Default empty.
+    pub egress_workers: Vec<Worker>,
     /// Custom application data.
     pub app_data: AppData,
 }
@@ -95,6 +101,7 @@ impl RouterOptions {
     pub fn new(media_codecs: Vec<RtpCodecCapability>) -> Self {
         Self {
             media_codecs,
+            egress_workers: Vec::new(),
             app_data: AppData::default(),
         }
     }
@@ -132,6 +139,10 @@ pub struct PipeToRouterOptions {
     ///
     /// Default `false`.
     pub enable_srtp: bool,
+    /// Exchange packets through shared memory if both Routers live in this process.
+    ///
+    /// Default `false`.
+    pub enable_in_process: bool,
 }
 
 impl PipeToRouterOptions {
@@ -148,6 +159,7 @@ impl PipeToRouterOptions {
             num_sctp_streams: NumSctpStreams::default(),
             enable_rtx: false,
             enable_srtp: false,
+            enable_in_process: false,
         }
     }
 }
@@ -169,7 +181,8 @@ pub struct PipeProducerToRouterPair {
     pub pipe_producer: PipedProducer,
 }
 
-/// Error that caused [`Router::pipe_producer_to_router()`] to fail.
+/// Error that caused [`Router::pipe_producer_to_router()`] or [`Router::consume_egress()`] to
+/// fail.
 #[derive(Debug, Error, Eq, PartialEq)]
 pub enum PipeProducerToRouterError {
     /// Destination router must be different
@@ -207,6 +220,17 @@ impl From<ProduceError> for PipeProducerToRouterError {
     }
 }
 
+/// Error that caused [`Router::create_egress_webrtc_transport()`] to fail.
+#[derive(Debug, Error, Eq, PartialEq)]
+pub enum CreateEgressTransportError {
+    /// Failed to create Router in egress Worker
+    #[error("Failed to create Router in egress Worker: \"{0}\"")]
+    RouterFailed(CreateRouterError),
+    /// Failed to create transport
+    #[error("Failed to create transport: \"{0}\"")]
+    TransportFailed(RequestError),
+}
+
 /// Container for pipe data consumer and pipe data producer pair.
 ///
 /// # Notes on usage
@@ -353,6 +377,31 @@ impl WeakPipeTransportPair {
     }
 }
 
+/// Routers in other Workers over which the Consumers of a Router are spread.
+pub(crate) struct Egress {
+    workers: Vec<Worker>,
+    media_codecs: Vec<RtpCodecCapability>,
+    shards: AsyncMutex<Vec<EgressShard>>,
+    // Serializes piping Producers so that they are not piped twice into the same Router.
+    pipe_mutex: AsyncMutex<()>,
+}
+
+impl Egress {
+    pub(crate) fn new(workers: Vec<Worker>, media_codecs: Vec<RtpCodecCapability>) -> Self {
+        Self {
+            workers,
+            media_codecs,
+            shards: AsyncMutex::new(Vec::new()),
+            pipe_mutex: AsyncMutex::new(()),
+        }
+    }
+}
+
+struct EgressShard {
+    router: Router,
+    num_transports: Arc<AtomicUsize>,
+}
+
 #[derive(Default)]
 #[allow(clippy::type_complexity)]
 struct Handlers {
@@ -377,6 +426,7 @@ struct Inner {
         Arc<Mutex<HashedMap<RouterId, Arc<AsyncMutex<Option<WeakPipeTransportPair>>>>>>,
     // Make sure worker is not dropped until this router is not dropped
     worker: Worker,
+    egress: Option<Egress>,
     closed: AtomicBool,
     _on_worker_close_handler: Mutex<HandlerId>,
 }
@@ -437,6 +487,7 @@ impl fmt::Debug for Router {
 }
 
 impl Router {
+    #[allow(clippy::too_many_arguments)]
     pub(super) fn new(
         id: RouterId,
         executor: Arc<Executor<'static>>,
@@ -445,6 +496,7 @@ impl Router {
         rtp_capabilities: RtpCapabilitiesFinalized,
         app_data: AppData,
         worker: Worker,
+        egress: Option<Egress>,
     ) -> Self {
         debug!("new()");
 
@@ -480,6 +532,7 @@ impl Router {
             mapped_pipe_transports,
             app_data,
             worker,
+            egress,
             closed: AtomicBool::new(false),
             _on_worker_close_handler: Mutex::new(on_worker_close_handler),
         });
@@ -656,6 +709,164 @@ impl Router {
         Ok(transport)
     }
 
+    /// Create a [`WebRtcTransport`] for consuming in a Router of one of the
+    /// [`RouterOptions::egress_workers`], the one with the fewest such transports, or in this
+    /// Router if there are none. Consume on it with [`Router::consume_egress()`].
+    ///
+    /// This spreads the Consumers of a large broadcast over several Workers (and thus CPU cores),
+    /// while media is only received by this Router. Routers in egress Workers are created on first
+    /// use and live as long as this Router.
+    ///
+    /// # Example
+    /// ```rust
+    /// use mediasoup::prelude::*;
+    /// use std::net::{IpAddr, Ipv4Addr};
+    ///
+    /// # async fn f(
+    /// #     worker: Worker,
+    /// #     egress_worker1: Worker,
+    /// #     egress_worker2: Worker,
+    /// #     producer_id: ProducerId,
+    /// #     rtp_capabilities: RtpCapabilities,
+    /// # ) -> Result<(), Box<dyn std::error::Error>> {
+    /// let router = worker
+    ///     .create_router({
+    ///         let mut options = RouterOptions::default();
+    ///         options.egress_workers = vec![egress_worker1, egress_worker2];
+    ///         options
+    ///     })
+    ///     .await?;
+    ///
+    /// let transport = router
+    ///     .create_egress_webrtc_transport(WebRtcTransportOptions::new(TransportListenIps::new(
+    ///         ListenIp {
+    ///             ip: IpAddr::V4(Ipv4Addr::LOCALHOST),
+    ///             announced_ip: Some("9.9.9.1".parse().unwrap()),
+    ///         },
+    ///     )))
+    ///     .await?;
+    /// let consumer = router
+    ///     .consume_egress(&transport, ConsumerOptions::new(producer_id, rtp_capabilities))
+    ///     .await?;
+    /// # Ok(())
+    /// # }
+    /// ```
+    pub async fn create_egress_webrtc_transport(
+        &self,
+        webrtc_transport_options: WebRtcTransportOptions,
+    ) -> Result<WebRtcTransport, CreateEgressTransportError> {
+        debug!("create_egress_webrtc_transport()");
+
+        let egress = match &self.inner.egress {
+            Some(egress) => egress,
+            None => {
+                return self
+                    .create_webrtc_transport(webrtc_transport_options)
+                    .await
+                    .map_err(CreateEgressTransportError::TransportFailed);
+            }
+        };
+
+        let (router, num_transports) = {
+            let mut shards = egress.shards.lock().await;
+
+            if shards.is_empty() {
+                let mut new_shards = Vec::with_capacity(egress.workers.len());
+
+                for worker in &egress.workers {
+                    let router = worker
+                        .create_router(RouterOptions::new(egress.media_codecs.clone()))
+                        .await
+                        .map_err(CreateEgressTransportError::RouterFailed)?;
+
+                    new_shards.push(EgressShard {
+                        router,
+                        num_transports: Arc::default(),
+                    });
+                }
+
+                *shards = new_shards;
+            }
+
+            let shard = match shards
+                .iter()
+                .filter(|shard| !shard.router.closed())
+                .min_by_key(|shard| shard.num_transports.load(Ordering::Relaxed))
+            {
+                Some(shard) => shard,
+                None => {
+                    // Egress Workers are closed.
+                    return self
+                        .create_webrtc_transport(webrtc_transport_options)
+                        .await
+                        .map_err(CreateEgressTransportError::TransportFailed);
+                }
+            };
+
+            // Counted right away so that concurrent calls pick other Routers.
+            shard.num_transports.fetch_add(1, Ordering::Relaxed);
+
+            (shard.router.clone(), Arc::clone(&shard.num_transports))
+        };
+
+        let transport = match router
+            .create_webrtc_transport(webrtc_transport_options)
+            .await
+        {
+            Ok(transport) => transport,
+            Err(error) => {
+                num_transports.fetch_sub(1, Ordering::Relaxed);
+
+                return Err(CreateEgressTransportError::TransportFailed(error));
+            }
+        };
+
+        transport
+            .on_close(Box::new(move || {
+                num_transports.fetch_sub(1, Ordering::Relaxed);
+            }))
+            .detach();
+
+        Ok(transport)
+    }
+
+    /// Consume a [`Producer`] of this Router on a transport created with
+    /// [`Router::create_egress_webrtc_transport()`]. The Producer is piped into the Router of the
+    /// transport (in-process if possible) the first time, for as long as the Producer lives.
+    pub async fn consume_egress(
+        &self,
+        transport: &WebRtcTransport,
+        consumer_options: ConsumerOptions,
+    ) -> Result<Consumer, PipeProducerToRouterError> {
+        debug!("consume_egress()");
+
+        let router = transport.router();
+
+        if let Some(egress) = &self.inner.egress {
+            if router.id() != self.id() {
+                let _pipe_guard = egress.pipe_mutex.lock().await;
+
+                if !router.has_producer(&consumer_options.producer_id) {
+                    let mut pipe_to_router_options = PipeToRouterOptions::new(router.clone());
+                    pipe_to_router_options.enable_sctp = false;
+                    pipe_to_router_options.enable_in_process = true;
+
+                    // Dropping the pair ties the piped Producer to the lifetime of the Producer.
+                    self.pipe_producer_to_router(
+                        consumer_options.producer_id,
+                        pipe_to_router_options,
+                    )
+                    .await?;
+                }
+            }
+        }
+
+        transport
+            .consume(consumer_options)
+            .await
+            .map_err(PipeProducerToRouterError::ConsumeFailed)
+    }
+
     /// Create a [`PipeTransport`].
     ///
     /// Router will be kept alive as long as at least one transport instance is alive.
@@ -1405,6 +1616,7 @@ impl Router {
             num_sctp_streams,
             enable_rtx,
             enable_srtp,
+            enable_in_process,
         } = pipe_to_router_options;
 
         let remote_router_id = router.id();
@@ -1414,6 +1626,7 @@ impl Router {
             num_sctp_streams,
             enable_rtx,
             enable_srtp,
+            enable_in_process,
             app_data: AppData::default(),
             ..PipeTransportOptions::new(listen_ip)
         };
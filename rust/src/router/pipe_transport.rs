@@ -57,6 +57,11 @@ pub struct PipeTransportOptions {
     /// different hosts. For this to work, connect() must be called with remote SRTP parameters.
     /// Default false.
     pub enable_srtp: bool,
+    /// Exchange packets with the remote PipeTransport through shared memory instead of UDP if
+    /// both live in Workers of this process. SRTP is not applied to such packets. UDP is used
+    /// otherwise. For this to work, both PipeTransports must enable this setting.
+    /// Default false.
+    pub enable_in_process: bool,
     /// Custom application data.
     pub app_data: AppData,
 }
@@ -74,6 +79,7 @@ impl PipeTransportOptions {
             sctp_send_buffer_size: 268_435_456,
             enable_rtx: false,
             enable_srtp: false,
+            enable_in_process: false,
             app_data: AppData::default(),
         }
     }
@@ -52,6 +52,10 @@ pub struct ProducerOptions {
     /// Just for video. Time (in ms) before asking the sender for a new key frame after having asked
     /// a previous one. If 0 there is no delay.
     pub key_frame_request_delay: u32,
+    /// Just for video. Whether the packets since the most recent key frame must be kept so new
+    /// consumers can start with them instead of asking the sender for a new key frame. Default
+    /// false.
+    pub key_frame_cache: bool,
     /// Custom application data.
     pub app_data: AppData,
 }
@@ -70,6 +74,7 @@ impl ProducerOptions {
             rtp_parameters,
             paused: false,
             key_frame_request_delay: 0,
+            key_frame_cache: false,
             app_data: AppData::default(),
         }
     }
@@ -83,6 +88,7 @@ impl ProducerOptions {
             rtp_parameters,
             paused: false,
             key_frame_request_delay: 0,
+            key_frame_cache: false,
             app_data: AppData::default(),
         }
     }
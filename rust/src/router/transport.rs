@@ -419,6 +419,7 @@ pub(super) trait TransportImpl: TransportGeneric {
             mut rtp_parameters,
             paused,
             key_frame_request_delay,
+            key_frame_cache,
             app_data,
         } = producer_options;
 
@@ -478,6 +479,7 @@ pub(super) trait TransportImpl: TransportGeneric {
                     rtp_parameters: rtp_parameters.clone(),
                     rtp_mapping,
                     key_frame_request_delay,
+                    key_frame_cache,
                     paused,
                 },
             )
@@ -214,6 +214,32 @@ pub struct WebRtcTransportDump {
     pub ice_selected_tuple: Option<TransportTuple>,
 }
 
+/// Tuple in [`WebRtcTransportStat`], with the write queue stats of its connection when it is a
+/// TCP one.
+#[derive(Debug, Copy, Clone, PartialOrd, PartialEq, Deserialize, Serialize)]
+#[serde(rename_all = "camelCase")]
+#[non_exhaustive]
+pub struct WebRtcTransportTupleStat {
+    /// Transport tuple.
+    #[serde(flatten)]
+    pub tuple: TransportTuple,
+    /// Bytes given to the TCP connection but not written into its socket yet.
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub write_queue_size: Option<usize>,
+    /// Max value of `write_queue_size` seen.
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub max_write_queue_size: Option<usize>,
+    /// Number of writes that could not be entirely done immediately.
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub queued_writes: Option<usize>,
+    /// Number of batches of writes flushed at the end of a loop iteration.
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub write_batch_flushes: Option<usize>,
+    /// Number of writes flushed in those batches.
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub write_batch_items: Option<usize>,
+}
+
 /// RTC statistics of the [`WebRtcTransport`].
 #[derive(Debug, Clone, PartialOrd, PartialEq, Deserialize, Serialize)]
 #[serde(rename_all = "camelCase")]
@@ -253,7 +279,7 @@ pub struct WebRtcTransportStat {
     pub ice_role: IceRole,
     pub ice_state: IceState,
     #[serde(skip_serializing_if = "Option::is_none")]
-    pub ice_selected_tuple: Option<TransportTuple>,
+    pub ice_selected_tuple: Option<WebRtcTransportTupleStat>,
     pub dtls_state: DtlsState,
 }
 
@@ -137,6 +137,15 @@ impl TryFrom<Vec<WebRtcServerListenInfo>> for WebRtcServerListenInfos {
 pub struct WebRtcServerOptions {
     /// Listening infos in order of preference (first one is the preferred one).
     pub listen_infos: WebRtcServerListenInfos,
+    /// Share the UDP ports of listen infos (which must be given) with the WebRTC servers of other
+    /// workers by binding them with `SO_REUSEPORT` (Linux).
+    ///
+    /// Each WebRTC server in the group must have a different index (from 0 to 61) and they must
+    /// be created in index order, before any of them handles traffic. None of them should be
+    /// closed while the others are in use. The kernel delivers ICE traffic of each WebRTC
+    /// transport to the worker that owns it. TCP listen infos are not shared so they need a
+    /// different port in each worker.
+    pub reuse_port_index: Option<u8>,
     /// Custom application data.
     pub app_data: AppData,
 }
@@ -146,6 +155,7 @@ impl WebRtcServerOptions {
     pub fn new(listen_infos: WebRtcServerListenInfos) -> Self {
         Self {
             listen_infos,
+            reuse_port_index: None,
             app_data: AppData::default(),
         }
     }
@@ -1,6 +1,7 @@
 //! A worker represents a mediasoup C++ thread that runs on a single CPU core and handles
 //! [`Router`] instances.
 
+mod binary_message;
 mod channel;
 mod common;
 mod payload_channel;
@@ -9,10 +10,11 @@ mod utils;
 use crate::data_structures::AppData;
 use crate::messages::{
     WorkerCloseRequest, WorkerCreateRouterRequest, WorkerCreateWebRtcServerRequest,
-    WorkerDumpRequest, WorkerUpdateSettingsRequest,
+    WorkerDumpRequest, WorkerDumpRtpTraceRequest, WorkerGetMetricsRequest,
+    WorkerSubscribeStatsRequest, WorkerUnsubscribeStatsRequest, WorkerUpdateSettingsRequest,
 };
 pub use crate::ortc::RtpCapabilitiesError;
-use crate::router::{Router, RouterId, RouterOptions};
+use crate::router::{Egress, Router, RouterId, RouterOptions};
 use crate::webrtc_server::{WebRtcServer, WebRtcServerId, WebRtcServerOptions};
 use crate::worker::channel::BufferMessagesGuard;
 pub use crate::worker::utils::ExitError;
@@ -27,6 +29,7 @@ use log::{debug, error, warn};
 use parking_lot::Mutex;
 pub(crate) use payload_channel::{NotificationError, PayloadChannel};
 use serde::{Deserialize, Serialize};
+use std::collections::HashMap;
 use std::ops::RangeInclusive;
 use std::path::PathBuf;
 use std::sync::atomic::{AtomicBool, Ordering};
@@ -189,6 +192,37 @@ pub struct WorkerSettings {
     /// "WebRTC-Bwe-AlrLimitedBackoff/Enabled/".
     #[doc(hidden)]
     pub libwebrtc_field_trials: Option<String>,
+    /// Whether UDP datagrams sent during a loop iteration are batched and sent at the
+    /// end of it with a single sendmmsg() syscall per socket (and UDP GSO when
+    /// supported). Just supported in Linux. Default false.
+    pub udp_send_batching: bool,
+    /// Max number of UDP datagrams read with a single recvmmsg() syscall per socket
+    /// readiness event. Valid values are 1 to 20. Just effective in Linux.
+    ///
+    /// If `None`, default value (1) is used.
+    pub udp_recv_batch_size: Option<u32>,
+    /// Pace the RTP sent by transports with bandwidth estimation according to the
+    /// estimated available bitrate so bursts (e.g. key frames) do not overflow the
+    /// network queues. Audio is sent first, then retransmissions and video.
+    /// Default false.
+    pub egress_pacing: bool,
+    /// Run the CPU intensive part of DTLS handshakes (processing of received
+    /// handshake messages, including the key exchange and signatures) in the libuv
+    /// thread pool instead of the worker thread, so a burst of new connections
+    /// does not delay the media of the existing ones. Default false.
+    pub dtls_handshake_offload: bool,
+    /// Whether data sent over each ICE-TCP connection during a loop iteration is coalesced and
+    /// written at the end of it with a single syscall. Default false.
+    pub tcp_send_batching: bool,
+    /// Number of records of the binary RTP trace ring of the worker, one per sent
+    /// or dropped RTP packet. Retrieve it with [`Worker::dump_rtp_trace()`]. Max 32768.
+    /// Default `None` (disabled).
+    pub rtp_trace_size: Option<u32>,
+    /// Whether log messages are batched and written once per event loop iteration instead of one
+    /// by one, and logging call sites are rate limited (excess messages are counted and
+    /// reported). Messages are still formatted and written by the worker thread. Error messages
+    /// are written right away. Default false.
+    pub log_batching: bool,
     /// Function that will be called under worker thread before worker starts, can be used for
     /// pinning worker threads to CPU cores.
     pub thread_initializer: Option<Arc<dyn Fn() + Send + Sync>>,
@@ -218,6 +252,13 @@ impl Default for WorkerSettings {
             rtc_ports_range: 10000..=59999,
             dtls_files: None,
             libwebrtc_field_trials: None,
+            udp_send_batching: false,
+            udp_recv_batch_size: None,
+            egress_pacing: false,
+            dtls_handshake_offload: false,
+            tcp_send_batching: false,
+            rtp_trace_size: None,
+            log_batching: false,
             thread_initializer: None,
             app_data: AppData::default(),
         }
@@ -232,6 +273,13 @@ impl fmt::Debug for WorkerSettings {
             rtc_ports_range,
             dtls_files,
             libwebrtc_field_trials,
+            udp_send_batching,
+            udp_recv_batch_size,
+            egress_pacing,
+            dtls_handshake_offload,
+            tcp_send_batching,
+            rtp_trace_size,
+            log_batching,
             thread_initializer,
             app_data,
         } = self;
@@ -242,6 +290,13 @@ impl fmt::Debug for WorkerSettings {
             .field("rtc_ports_range", &rtc_ports_range)
             .field("dtls_files", &dtls_files)
             .field("libwebrtc_field_trials", &libwebrtc_field_trials)
+            .field("udp_send_batching", &udp_send_batching)
+            .field("udp_recv_batch_size", &udp_recv_batch_size)
+            .field("egress_pacing", &egress_pacing)
+            .field("dtls_handshake_offload", &dtls_handshake_offload)
+            .field("tcp_send_batching", &tcp_send_batching)
+            .field("rtp_trace_size", &rtp_trace_size)
+            .field("log_batching", &log_batching)
             .field(
                 "thread_initializer",
                 &thread_initializer.as_ref().map(|_| "ThreadInitializer"),
@@ -288,6 +343,86 @@ pub struct WorkerDump {
     pub channel_message_handlers: ChannelMessageHandlers,
 }
 
+/// Binary RTP trace of the worker, see [`WorkerSettings::rtp_trace_size`].
+#[derive(Debug, Clone, Deserialize, Serialize)]
+#[serde(rename_all = "camelCase")]
+#[non_exhaustive]
+pub struct WorkerRtpTraceDump {
+    /// Version of the record layout.
+    pub version: u8,
+    /// Size of each record in bytes.
+    pub record_size: usize,
+    /// Byte order of record fields ("little" or "big").
+    pub byte_order: String,
+    /// Max number of records in the ring.
+    pub capacity: usize,
+    /// Number of records written since the worker started (older ones were overwritten).
+    pub num_written: u64,
+    /// Base64 encoded chunks of records, oldest first.
+    pub records: Vec<String>,
+    /// Ids of alive objects (routers, transports, producers and consumers) indexed by the
+    /// handle used in records.
+    pub objects: HashMap<String, String>,
+    /// Drop reason names indexed by the value used in records.
+    pub drop_reasons: HashMap<String, String>,
+}
+
+/// Worker metrics, see [`Worker::get_metrics`].
+#[derive(Debug, Clone, Deserialize, Serialize)]
+#[non_exhaustive]
+pub struct WorkerMetrics {
+    /// Metrics in OpenMetrics text format.
+    pub text: String,
+}
+
+/// Entry of the worker stats stream, see [`Worker::subscribe_stats`].
+#[derive(Debug, Clone, Deserialize, Serialize)]
+#[serde(rename_all = "camelCase")]
+#[non_exhaustive]
+pub struct WorkerStatsEntry {
+    /// Id of the entry used in the payload.
+    pub entry_id: u32,
+    /// Id of the transport, producer or consumer.
+    pub id: String,
+    /// Type of the entry ("transport", "inbound-rtp" or "outbound-rtp").
+    pub r#type: String,
+    /// SSRC of the RTP stream (not present in transport entries).
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub ssrc: Option<u32>,
+}
+
+/// Stats pushed by the worker once per interval, see [`Worker::subscribe_stats`].
+///
+/// `payload` starts with the version of its format (1) followed by one record per entry whose
+/// stats changed: entry id (varint), mask of changed values (varint, bit N being value N) and
+/// the delta of each changed value (zigzag varint). Values are indexed as the fields of the
+/// equivalent `get_stats()` output (round trip time in microseconds).
+#[derive(Debug, Clone)]
+#[non_exhaustive]
+pub struct WorkerStats {
+    /// Time of the stats in ms.
+    pub timestamp: u64,
+    /// Entries announced before their first values.
+    pub added: Vec<WorkerStatsEntry>,
+    /// Ids of entries that are gone.
+    pub removed: Vec<u32>,
+    /// Delta encoded values.
+    pub payload: Vec<u8>,
+}
+
+#[derive(Debug, Deserialize)]
+struct WorkerStatsData {
+    timestamp: u64,
+    added: Vec<WorkerStatsEntry>,
+    removed: Vec<u32>,
+}
+
+#[derive(Debug, Deserialize)]
+#[serde(tag = "event", rename_all = "lowercase", content = "data")]
+enum PayloadNotification {
+    Stats(WorkerStatsData),
+}
+
 /// Error that caused [`Worker::create_webrtc_server`] to fail.
 #[derive(Debug, Error, Eq, PartialEq)]
 pub enum CreateWebRtcServerError {
@@ -315,6 +450,7 @@ struct Handlers {
     #[allow(clippy::type_complexity)]
     dead: BagOnce<Box<dyn FnOnce(Result<(), ExitError>) + Send>>,
     close: BagOnce<Box<dyn FnOnce() + Send>>,
+    stats: Bag<Arc<dyn Fn(&WorkerStats) + Send + Sync>>,
 }
 
 struct Inner {
@@ -325,6 +461,7 @@ struct Inner {
     handlers: Handlers,
     app_data: AppData,
     closed: Arc<AtomicBool>,
+    stats_subscription_handler: Mutex<Option<SubscriptionHandler>>,
     // Make sure worker is not dropped until this worker manager is not dropped
     _worker_manager: WorkerManager,
 }
@@ -346,6 +483,13 @@ impl Inner {
             rtc_ports_range,
             dtls_files,
             libwebrtc_field_trials,
+            udp_send_batching,
+            udp_recv_batch_size,
+            egress_pacing,
+            dtls_handshake_offload,
+            tcp_send_batching,
+            rtp_trace_size,
+            log_batching,
             thread_initializer,
             app_data,
         }: WorkerSettings,
@@ -394,6 +538,24 @@ impl Inner {
             ));
         }
 
+        spawn_args.push(format!("--udpSendBatching={}", udp_send_batching));
+
+        if let Some(udp_recv_batch_size) = udp_recv_batch_size {
+            spawn_args.push(format!("--udpRecvBatchSize={}", udp_recv_batch_size));
+        }
+
+        spawn_args.push(format!("--egressPacing={}", egress_pacing));
+
+        spawn_args.push(format!("--dtlsHandshakeOffload={}", dtls_handshake_offload));
+
+        spawn_args.push(format!("--tcpSendBatching={}", tcp_send_batching));
+
+        if let Some(rtp_trace_size) = rtp_trace_size {
+            spawn_args.push(format!("--rtpTraceSize={}", rtp_trace_size));
+        }
+
+        spawn_args.push(format!("--logBatching={}", log_batching));
+
         let id = WorkerId::new();
         debug!(
             "spawning worker with arguments [id:{}]: {}",
@@ -429,6 +591,7 @@ impl Inner {
             handlers,
             app_data,
             closed,
+            stats_subscription_handler: Mutex::new(None),
             _worker_manager: worker_manager,
         };
 
@@ -437,6 +600,35 @@ impl Inner {
         let (mut early_status_sender, early_status_receiver) = async_oneshot::oneshot();
 
         let inner = Arc::new(inner);
+        {
+            let inner_weak = Arc::downgrade(&inner);
+            let stats_subscription_handler = inner.payload_channel.subscribe_to_notifications(
+                std::process::id().into(),
+                move |message, payload| {
+                    match serde_json::from_slice::<PayloadNotification>(message) {
+                        Ok(PayloadNotification::Stats(data)) => {
+                            if let Some(inner) = inner_weak.upgrade() {
+                                let stats = WorkerStats {
+                                    timestamp: data.timestamp,
+                                    added: data.added,
+                                    removed: data.removed,
+                                    payload: payload.to_vec(),
+                                };
+
+                                inner.handlers.stats.call(|callback| {
+                                    callback(&stats);
+                                });
+                            }
+                        }
+                        Err(error) => {
+                            error!("Failed to parse payload notification: {}", error);
+                        }
+                    }
+                },
+            );
+
+            *inner.stats_subscription_handler.lock() = stats_subscription_handler;
+        }
         {
             let inner_weak = Arc::downgrade(&inner);
             inner
@@ -644,6 +836,57 @@ impl Worker {
         self.inner.channel.request("", WorkerDumpRequest {}).await
     }
 
+    /// Dump the binary RTP trace ring of the worker.
+    pub async fn dump_rtp_trace(&self) -> Result<WorkerRtpTraceDump, RequestError> {
+        debug!("dump_rtp_trace()");
+
+        self.inner
+            .channel
+            .request("", WorkerDumpRtpTraceRequest {})
+            .await
+    }
+
+    /// Get the worker metrics (packets routed and dropped, SRTP failures, send EAGAINs, event
+    /// loop lag, etc.) in OpenMetrics text format, ready to be served to a Prometheus scraper.
+    pub async fn get_metrics(&self) -> Result<String, RequestError> {
+        debug!("get_metrics()");
+
+        let metrics: WorkerMetrics = self
+            .inner
+            .channel
+            .request("", WorkerGetMetricsRequest {})
+            .await?;
+
+        Ok(metrics.text)
+    }
+
+    /// Make the worker push the stats of all its transports, producers and consumers every
+    /// `interval_ms` (at least 100), see [`Worker::on_stats`]. Only the stats that changed are
+    /// sent. Calling it again changes the interval and announces every entry again.
+    pub async fn subscribe_stats(&self, interval_ms: u32) -> Result<(), RequestError> {
+        debug!("subscribe_stats()");
+
+        self.inner
+            .channel
+            .request(
+                "",
+                WorkerSubscribeStatsRequest {
+                    interval: interval_ms,
+                },
+            )
+            .await
+    }
+
+    /// Stop pushing stats.
+    pub async fn unsubscribe_stats(&self) -> Result<(), RequestError> {
+        debug!("unsubscribe_stats()");
+
+        self.inner
+            .channel
+            .request("", WorkerUnsubscribeStatsRequest {})
+            .await
+    }
+
     /// Updates the worker settings in runtime. Just a subset of the worker settings can be updated.
     pub async fn update_settings(&self, data: WorkerUpdateSettings) -> Result<(), RequestError> {
         debug!("update_settings()");
@@ -665,6 +908,7 @@ impl Worker {
 
         let WebRtcServerOptions {
             listen_infos,
+            reuse_port_index,
             app_data,
         } = webrtc_server_options;
 
@@ -682,6 +926,7 @@ impl Worker {
                 WorkerCreateWebRtcServerRequest {
                     webrtc_server_id,
                     listen_infos,
+                    reuse_port_index,
                 },
             )
             .await
@@ -715,8 +960,15 @@ impl Worker {
         let RouterOptions {
             app_data,
             media_codecs,
+            mut egress_workers,
         } = router_options;
 
+        // Producer ids are unique per Worker, so they can't be piped into this one.
+        egress_workers.retain(|worker| worker.id() != self.id());
+
+        let egress =
+            (!egress_workers.is_empty()).then(|| Egress::new(egress_workers, media_codecs.clone()));
+
         let rtp_capabilities = ortc::generate_router_rtp_capabilities(media_codecs)
             .map_err(CreateRouterError::FailedRtpCapabilitiesGeneration)?;
 
@@ -738,6 +990,7 @@ impl Worker {
             rtp_capabilities,
             app_data,
             self.clone(),
+            egress,
         );
 
         self.inner.handlers.new_router.call_simple(&router);
@@ -769,6 +1022,11 @@ impl Worker {
         self.inner.handlers.dead.add(Box::new(callback))
     }
 
+    /// Callback is called with the stats pushed by the worker, see [`Worker::subscribe_stats`].
+    pub fn on_stats<F: Fn(&WorkerStats) + Send + Sync + 'static>(&self, callback: F) -> HandlerId {
+        self.inner.handlers.stats.add(Arc::new(callback))
+    }
+
     /// Callback is called when the worker is closed for whatever reason.
     ///
     /// NOTE: Callback will be called in place if worker is already closed.
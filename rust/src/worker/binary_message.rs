@@ -0,0 +1,474 @@
+//! Binary encoding of Channel and PayloadChannel messages.
+//!
+//! Mirrors `worker/include/Channel/BinaryMessage.hpp` and `BinaryBody.hpp`, see them for the
+//! layout of the header and the schema of the bodies. Messages received in binary are translated
+//! into the equivalent JSON messages, so the rest of the crate keeps parsing JSON.
+
+#[cfg(test)]
+mod tests;
+
+use serde_json::{Map, Value};
+use thiserror::Error;
+
+pub(super) const HEADER_SIZE: usize = 13;
+
+#[derive(Debug, Copy, Clone, Eq, PartialEq)]
+#[repr(u8)]
+pub(super) enum MessageType {
+    Request = 1,
+    Notification = 2,
+    ResponseAccepted = 3,
+    ResponseError = 4,
+    ResponseTypeError = 5,
+}
+
+const BODY_TYPE_JSON: u8 = 0;
+const BODY_TYPE_RECORD: u8 = 1;
+const BODY_TYPE_RECORDS: u8 = 2;
+
+#[derive(Debug, Copy, Clone, Eq, PartialEq)]
+enum ValueType {
+    Uint,
+    Int,
+    Double,
+    Bool,
+    String,
+    Strings,
+    Record,
+    StringMap,
+    StringsMap,
+    UintMap,
+}
+
+/// Channel request methods indexed by their id - 1 (`ChannelRequest::MethodId`).
+const CHANNEL_METHODS: &[&str] = &[
+    "worker.close",
+    "worker.dump",
+    "worker.getResourceUsage",
+    "worker.updateSettings",
+    "worker.createWebRtcServer",
+    "worker.createRouter",
+    "worker.closeWebRtcServer",
+    "webRtcServer.dump",
+    "worker.closeRouter",
+    "router.dump",
+    "router.createWebRtcTransport",
+    "router.createWebRtcTransportWithServer",
+    "router.createPlainTransport",
+    "router.createPipeTransport",
+    "router.createDirectTransport",
+    "router.closeTransport",
+    "router.createActiveSpeakerObserver",
+    "router.createAudioLevelObserver",
+    "router.closeRtpObserver",
+    "transport.dump",
+    "transport.getStats",
+    "transport.connect",
+    "transport.setMaxIncomingBitrate",
+    "transport.setMaxOutgoingBitrate",
+    "transport.setMinOutgoingBitrate",
+    "transport.restartIce",
+    "transport.produce",
+    "transport.consume",
+    "transport.produceData",
+    "transport.consumeData",
+    "transport.enableTraceEvent",
+    "transport.closeProducer",
+    "producer.dump",
+    "producer.getStats",
+    "producer.pause",
+    "producer.resume",
+    "producer.enableTraceEvent",
+    "transport.closeConsumer",
+    "consumer.dump",
+    "consumer.getStats",
+    "consumer.pause",
+    "consumer.resume",
+    "consumer.setPreferredLayers",
+    "consumer.setPriority",
+    "consumer.requestKeyFrame",
+    "consumer.enableTraceEvent",
+    "transport.closeDataProducer",
+    "dataProducer.dump",
+    "dataProducer.getStats",
+    "transport.closeDataConsumer",
+    "dataConsumer.dump",
+    "dataConsumer.getStats",
+    "dataConsumer.getBufferedAmount",
+    "dataConsumer.setBufferedAmountLowThreshold",
+    "rtpObserver.pause",
+    "rtpObserver.resume",
+    "rtpObserver.addProducer",
+    "rtpObserver.removeProducer",
+    "worker.dumpRtpTrace",
+    "worker.subscribeStats",
+    "worker.unsubscribeStats",
+    "worker.getMetrics",
+];
+
+/// PayloadChannel request methods indexed by their id - 1 (`PayloadChannelRequest::MethodId`).
+const PAYLOAD_CHANNEL_METHODS: &[&str] = &["dataConsumer.send"];
+
+/// PayloadChannel notification events indexed by their id - 1
+/// (`PayloadChannelNotification::EventId`).
+const PAYLOAD_CHANNEL_EVENTS: &[&str] =
+    &["transport.sendRtcp", "producer.send", "dataProducer.send"];
+
+/// Names and value types indexed by key (`BinaryBody::Key`).
+const KEYS: &[(&str, ValueType)] = &[
+    ("", ValueType::Uint),
+    ("type", ValueType::String),
+    ("id", ValueType::String),
+    ("timestamp", ValueType::Uint),
+    ("transportId", ValueType::String),
+    ("sctpState", ValueType::String),
+    ("bytesReceived", ValueType::Uint),
+    ("recvBitrate", ValueType::Uint),
+    ("bytesSent", ValueType::Uint),
+    ("sendBitrate", ValueType::Uint),
+    ("rtpBytesReceived", ValueType::Uint),
+    ("rtpRecvBitrate", ValueType::Uint),
+    ("rtpBytesSent", ValueType::Uint),
+    ("rtpSendBitrate", ValueType::Uint),
+    ("rtxBytesReceived", ValueType::Uint),
+    ("rtxRecvBitrate", ValueType::Uint),
+    ("rtxBytesSent", ValueType::Uint),
+    ("rtxSendBitrate", ValueType::Uint),
+    ("probationBytesSent", ValueType::Uint),
+    ("probationSendBitrate", ValueType::Uint),
+    ("availableOutgoingBitrate", ValueType::Uint),
+    ("availableIncomingBitrate", ValueType::Uint),
+    ("maxIncomingBitrate", ValueType::Uint),
+    ("rtpPacketLossReceived", ValueType::Double),
+    ("rtpPacketLossSent", ValueType::Double),
+    ("iceRole", ValueType::String),
+    ("iceState", ValueType::String),
+    ("iceSelectedTuple", ValueType::Record),
+    ("dtlsState", ValueType::String),
+    ("rtcpMux", ValueType::Bool),
+    ("comedia", ValueType::Bool),
+    ("tuple", ValueType::Record),
+    ("rtcpTuple", ValueType::Record),
+    ("localIp", ValueType::String),
+    ("localPort", ValueType::Uint),
+    ("remoteIp", ValueType::String),
+    ("remotePort", ValueType::Uint),
+    ("protocol", ValueType::String),
+    ("ssrc", ValueType::Uint),
+    ("kind", ValueType::String),
+    ("mimeType", ValueType::String),
+    ("packetsLost", ValueType::Int),
+    ("fractionLost", ValueType::Uint),
+    ("packetsDiscarded", ValueType::Uint),
+    ("packetsRetransmitted", ValueType::Uint),
+    ("packetsRepaired", ValueType::Uint),
+    ("nackCount", ValueType::Uint),
+    ("nackPacketCount", ValueType::Uint),
+    ("pliCount", ValueType::Uint),
+    ("firCount", ValueType::Uint),
+    ("score", ValueType::Uint),
+    ("rid", ValueType::String),
+    ("rtxSsrc", ValueType::Uint),
+    ("rtxPacketsDiscarded", ValueType::Uint),
+    ("roundTripTime", ValueType::Double),
+    ("jitter", ValueType::Uint),
+    ("packetCount", ValueType::Uint),
+    ("byteCount", ValueType::Uint),
+    ("bitrate", ValueType::Uint),
+    ("bitrateByLayer", ValueType::UintMap),
+    ("label", ValueType::String),
+    ("messagesReceived", ValueType::Uint),
+    ("messagesSent", ValueType::Uint),
+    ("bufferedAmount", ValueType::Uint),
+    ("pid", ValueType::Uint),
+    ("webRtcServerIds", ValueType::Strings),
+    ("routerIds", ValueType::Strings),
+    ("channelMessageHandlers", ValueType::Record),
+    ("channelRequestHandlers", ValueType::Strings),
+    ("payloadChannelRequestHandlers", ValueType::Strings),
+    ("payloadChannelNotificationHandlers", ValueType::Strings),
+    ("rtpPacketPool", ValueType::Record),
+    ("packets", ValueType::Record),
+    ("buffers", ValueType::Record),
+    ("blockSize", ValueType::Uint),
+    ("capacity", ValueType::Uint),
+    ("inUse", ValueType::Uint),
+    ("highWater", ValueType::Uint),
+    ("transportIds", ValueType::Strings),
+    ("rtpObserverIds", ValueType::Strings),
+    ("mapProducerIdConsumerIds", ValueType::StringsMap),
+    ("mapConsumerIdProducerId", ValueType::StringMap),
+    ("mapProducerIdObserverIds", ValueType::StringsMap),
+    ("mapDataProducerIdDataConsumerIds", ValueType::StringsMap),
+    ("mapDataConsumerIdDataProducerId", ValueType::StringMap),
+    ("ppid", ValueType::Uint),
+    ("writeQueueSize", ValueType::Uint),
+    ("maxWriteQueueSize", ValueType::Uint),
+    ("queuedWrites", ValueType::Uint),
+    ("writeBatchFlushes", ValueType::Uint),
+    ("writeBatchItems", ValueType::Uint),
+];
+
+/// Maximum nesting of records accepted by the decoder.
+const MAX_DEPTH: usize = 8;
+
+/// Error decoding a binary message.
+#[derive(Debug, Error, Eq, PartialEq)]
+#[error("invalid binary message: {0}")]
+pub(super) struct DecodeError(&'static str);
+
+fn find_id(names: &[&str], name: &str) -> Option<u16> {
+    names
+        .iter()
+        .position(|&known| known == name)
+        .map(|idx| idx as u16 + 1)
+}
+
+/// Id of the given Channel request method, `None` if the worker doesn't know it by id (so the
+/// request must be sent as text).
+pub(super) fn channel_method_id(method: &str) -> Option<u16> {
+    find_id(CHANNEL_METHODS, method)
+}
+
+/// Id of the given PayloadChannel request method.
+pub(super) fn payload_channel_method_id(method: &str) -> Option<u16> {
+    find_id(PAYLOAD_CHANNEL_METHODS, method)
+}
+
+/// Id of the given PayloadChannel notification event.
+pub(super) fn payload_channel_event_id(event: &str) -> Option<u16> {
+    find_id(PAYLOAD_CHANNEL_EVENTS, event)
+}
+
+/// Whether the given message received from the worker is a binary one.
+pub(super) fn is_binary(bytes: &[u8]) -> bool {
+    bytes.len() >= HEADER_SIZE && bytes[0] == 0
+}
+
+/// Encodes a binary message whose data (a JSON text) is given as is.
+pub(super) fn encode(
+    message_type: MessageType,
+    code: u16,
+    id: u32,
+    field1: &str,
+    data: &[u8],
+) -> Vec<u8> {
+    let mut bytes = Vec::with_capacity(HEADER_SIZE + field1.len() + data.len());
+
+    bytes.push(0);
+    bytes.push(message_type as u8);
+    bytes.extend_from_slice(&code.to_ne_bytes());
+    bytes.extend_from_slice(&id.to_ne_bytes());
+    bytes.extend_from_slice(&(field1.len() as u16).to_ne_bytes());
+    bytes.extend_from_slice(&0_u16.to_ne_bytes());
+    bytes.push(BODY_TYPE_JSON);
+    bytes.extend_from_slice(field1.as_bytes());
+    bytes.extend_from_slice(data);
+
+    bytes
+}
+
+/// Decodes a binary message received from the worker into the equivalent JSON message.
+pub(super) fn to_json_message(bytes: &[u8]) -> Result<Vec<u8>, DecodeError> {
+    if !is_binary(bytes) {
+        return Err(DecodeError("not a binary message"));
+    }
+
+    let read_u16 = |pos: usize| u16::from_ne_bytes([bytes[pos], bytes[pos + 1]]);
+    let message_type = bytes[1];
+    let id = u32::from_ne_bytes([bytes[4], bytes[5], bytes[6], bytes[7]]);
+    let field1_len = usize::from(read_u16(8));
+    let field2_len = usize::from(read_u16(10));
+    let body_type = bytes[12];
+
+    if HEADER_SIZE + field1_len + field2_len > bytes.len() {
+        return Err(DecodeError("fields exceed message length"));
+    }
+
+    let field2_start = HEADER_SIZE + field1_len;
+    let data_start = field2_start + field2_len;
+    let field1 = String::from_utf8_lossy(&bytes[HEADER_SIZE..field2_start]);
+    let field2 = String::from_utf8_lossy(&bytes[field2_start..data_start]);
+    let data = &bytes[data_start..];
+
+    let message = match message_type {
+        t if t == MessageType::ResponseAccepted as u8 => serde_json::json!({
+            "id": id,
+            "accepted": true,
+            "data": decode_body(body_type, data)?,
+        }),
+        t if t == MessageType::ResponseError as u8 => serde_json::json!({
+            "id": id,
+            "error": "Error",
+            "reason": String::from_utf8_lossy(data),
+        }),
+        t if t == MessageType::ResponseTypeError as u8 => serde_json::json!({
+            "id": id,
+            "error": "TypeError",
+            "reason": String::from_utf8_lossy(data),
+        }),
+        t if t == MessageType::Notification as u8 => serde_json::json!({
+            "targetId": field1,
+            "event": field2,
+            "data": decode_body(body_type, data)?,
+        }),
+        _ => return Err(DecodeError("unexpected message type")),
+    };
+
+    Ok(serde_json::to_vec(&message).expect("Value is always serializable; qed"))
+}
+
+/// Decodes the data of a binary message into the value it would have had in a JSON message
+/// (`Null` if empty).
+fn decode_body(body_type: u8, data: &[u8]) -> Result<Value, DecodeError> {
+    match body_type {
+        BODY_TYPE_JSON => {
+            if data.is_empty() {
+                Ok(Value::Null)
+            } else {
+                serde_json::from_slice(data).map_err(|_| DecodeError("invalid JSON body"))
+            }
+        }
+        BODY_TYPE_RECORD => {
+            let mut reader = Reader { data, pos: 0 };
+            let record = reader.read_record(0)?;
+
+            if !reader.at_end() {
+                return Err(DecodeError("trailing data after record"));
+            }
+
+            Ok(record)
+        }
+        BODY_TYPE_RECORDS => {
+            let mut reader = Reader { data, pos: 0 };
+            let mut records = Vec::new();
+
+            while !reader.at_end() {
+                records.push(reader.read_record(0)?);
+            }
+
+            Ok(Value::Array(records))
+        }
+        _ => Err(DecodeError("unknown body type")),
+    }
+}
+
+struct Reader<'a> {
+    data: &'a [u8],
+    pos: usize,
+}
+
+impl<'a> Reader<'a> {
+    fn at_end(&self) -> bool {
+        self.pos == self.data.len()
+    }
+
+    fn read_record(&mut self, depth: usize) -> Result<Value, DecodeError> {
+        if depth > MAX_DEPTH {
+            return Err(DecodeError("records nested too deep"));
+        }
+
+        let mut record = Map::new();
+
+        while let Some(&key) = self.data.get(self.pos) {
+            self.pos += 1;
+
+            if key == 0 {
+                return Ok(Value::Object(record));
+            }
+
+            let (name, value_type) = KEYS
+                .get(usize::from(key))
+                .ok_or(DecodeError("unknown record key"))?;
+
+            record.insert((*name).to_string(), self.read_value(*value_type, depth)?);
+        }
+
+        Err(DecodeError("missing end of record"))
+    }
+
+    fn read_value(&mut self, value_type: ValueType, depth: usize) -> Result<Value, DecodeError> {
+        Ok(match value_type {
+            ValueType::Uint => Value::from(self.read_varint()?),
+            ValueType::Int => {
+                let value = self.read_varint()?;
+
+                // Zigzag decoding.
+                Value::from((value >> 1) as i64 ^ -((value & 1) as i64))
+            }
+            ValueType::Double => {
+                let bytes = self
+                    .data
+                    .get(self.pos..self.pos + 8)
+                    .ok_or(DecodeError("truncated double"))?;
+
+                self.pos += 8;
+
+                Value::from(f64::from_ne_bytes(bytes.try_into().expect("8 bytes; qed")))
+            }
+            ValueType::Bool => Value::from(self.read_varint()? != 0),
+            ValueType::String => Value::from(self.read_string()?),
+            ValueType::Strings => {
+                let count = self.read_varint()?;
+                let mut values = Vec::new();
+
+                for _ in 0..count {
+                    values.push(Value::from(self.read_string()?));
+                }
+
+                Value::Array(values)
+            }
+            ValueType::Record => self.read_record(depth + 1)?,
+            ValueType::StringMap | ValueType::StringsMap | ValueType::UintMap => {
+                let item_type = match value_type {
+                    ValueType::StringMap => ValueType::String,
+                    ValueType::StringsMap => ValueType::Strings,
+                    _ => ValueType::Uint,
+                };
+                let count = self.read_varint()?;
+                let mut map = Map::new();
+
+                for _ in 0..count {
+                    let map_key = self.read_string()?;
+                    let value = self.read_value(item_type, depth)?;
+
+                    map.insert(map_key, value);
+                }
+
+                Value::Object(map)
+            }
+        })
+    }
+
+    fn read_varint(&mut self) -> Result<u64, DecodeError> {
+        let mut value = 0_u64;
+
+        for shift in (0..64).step_by(7) {
+            let byte = *self
+                .data
+                .get(self.pos)
+                .ok_or(DecodeError("truncated varint"))?;
+
+            self.pos += 1;
+            value |= u64::from(byte & 0x7F) << shift;
+
+            if byte & 0x80 == 0 {
+                return Ok(value);
+            }
+        }
+
+        Err(DecodeError("invalid varint"))
+    }
+
+    fn read_string(&mut self) -> Result<String, DecodeError> {
+        let len = self.read_varint()?;
+        let bytes = usize::try_from(len)
+            .ok()
+            .and_then(|len| self.data.get(self.pos..self.pos.checked_add(len)?))
+            .ok_or(DecodeError("truncated string"))?;
+
+        self.pos += bytes.len();
+
+        Ok(String::from_utf8_lossy(bytes).into_owned())
+    }
+}
@@ -0,0 +1,206 @@
+use super::*;
+use serde_json::json;
+
+fn key(name: &str) -> u8 {
+    KEYS.iter().position(|(known, _)| *known == name).unwrap() as u8
+}
+
+fn varint(mut value: u64, bytes: &mut Vec<u8>) {
+    while value >= 0x80 {
+        bytes.push((value as u8) | 0x80);
+        value >>= 7;
+    }
+
+    bytes.push(value as u8);
+}
+
+fn string(value: &str, bytes: &mut Vec<u8>) {
+    varint(value.len() as u64, bytes);
+    bytes.extend_from_slice(value.as_bytes());
+}
+
+fn message(
+    message_type: MessageType,
+    id: u32,
+    field1: &str,
+    field2: &str,
+    body_type: u8,
+) -> Vec<u8> {
+    let mut bytes = encode(message_type, 0, id, field1, &[]);
+
+    bytes[10..12].copy_from_slice(&(field2.len() as u16).to_ne_bytes());
+    bytes[12] = body_type;
+    bytes.extend_from_slice(field2.as_bytes());
+
+    bytes
+}
+
+fn record() -> Vec<u8> {
+    let mut bytes = Vec::new();
+
+    bytes.push(key("type"));
+    string("webrtc-transport", &mut bytes);
+    bytes.push(key("timestamp"));
+    varint(1_234_567_890_123, &mut bytes);
+    bytes.push(key("packetsLost"));
+    varint(5, &mut bytes);
+    bytes.push(key("roundTripTime"));
+    bytes.extend_from_slice(&12.5_f64.to_ne_bytes());
+    bytes.push(key("rtcpMux"));
+    varint(1, &mut bytes);
+    bytes.push(key("tuple"));
+    bytes.push(key("localIp"));
+    string("1.2.3.4", &mut bytes);
+    bytes.push(key("localPort"));
+    varint(40000, &mut bytes);
+    bytes.push(0);
+    bytes.push(key("routerIds"));
+    varint(2, &mut bytes);
+    string("r1", &mut bytes);
+    string("r2", &mut bytes);
+    bytes.push(key("mapProducerIdConsumerIds"));
+    varint(1, &mut bytes);
+    string("p1", &mut bytes);
+    varint(2, &mut bytes);
+    string("c1", &mut bytes);
+    string("c2", &mut bytes);
+    bytes.push(key("bitrateByLayer"));
+    varint(1, &mut bytes);
+    string("0.1", &mut bytes);
+    varint(300_000, &mut bytes);
+    bytes.push(0);
+
+    bytes
+}
+
+#[test]
+fn decode_record() {
+    assert_eq!(
+        decode_body(BODY_TYPE_RECORD, &record()),
+        Ok(json!({
+            "type": "webrtc-transport",
+            "timestamp": 1_234_567_890_123_u64,
+            "packetsLost": -3,
+            "roundTripTime": 12.5,
+            "rtcpMux": true,
+            "tuple": { "localIp": "1.2.3.4", "localPort": 40000 },
+            "routerIds": ["r1", "r2"],
+            "mapProducerIdConsumerIds": { "p1": ["c1", "c2"] },
+            "bitrateByLayer": { "0.1": 300_000 },
+        })),
+    );
+}
+
+#[test]
+fn decode_records() {
+    let mut bytes = Vec::new();
+
+    bytes.push(key("ssrc"));
+    varint(1111, &mut bytes);
+    bytes.push(0);
+    bytes.push(key("ssrc"));
+    varint(2222, &mut bytes);
+    bytes.push(0);
+
+    assert_eq!(
+        decode_body(BODY_TYPE_RECORDS, &bytes),
+        Ok(json!([{ "ssrc": 1111 }, { "ssrc": 2222 }])),
+    );
+}
+
+#[test]
+fn reject_invalid_data() {
+    let record = record();
+
+    assert_eq!(
+        decode_body(BODY_TYPE_RECORD, &record[..record.len() - 1]),
+        Err(DecodeError("missing end of record")),
+    );
+
+    let mut trailing = record.clone();
+
+    trailing.push(0);
+
+    assert_eq!(
+        decode_body(BODY_TYPE_RECORD, &trailing),
+        Err(DecodeError("trailing data after record")),
+    );
+    assert_eq!(
+        decode_body(BODY_TYPE_RECORD, &[0xFE, 0]),
+        Err(DecodeError("unknown record key")),
+    );
+    assert_eq!(
+        decode_body(BODY_TYPE_RECORD, &[key("label"), 10, b'a']),
+        Err(DecodeError("truncated string")),
+    );
+    assert!(to_json_message(b"{}").is_err());
+}
+
+#[test]
+fn method_ids() {
+    assert_eq!(channel_method_id("worker.close"), Some(1));
+    assert_eq!(channel_method_id("transport.getStats"), Some(21));
+    assert_eq!(channel_method_id("worker.getMetrics"), Some(62));
+    assert_eq!(channel_method_id("foo.bar"), None);
+    assert_eq!(payload_channel_method_id("dataConsumer.send"), Some(1));
+    assert_eq!(payload_channel_event_id("dataProducer.send"), Some(3));
+}
+
+#[test]
+fn encode_request() {
+    let bytes = encode(MessageType::Request, 21, 9, "handler", br#"{"foo":1}"#);
+
+    assert_eq!(bytes[0], 0);
+    assert_eq!(bytes[1], MessageType::Request as u8);
+    assert_eq!(u16::from_ne_bytes([bytes[2], bytes[3]]), 21);
+    assert_eq!(
+        u32::from_ne_bytes([bytes[4], bytes[5], bytes[6], bytes[7]]),
+        9
+    );
+    assert_eq!(u16::from_ne_bytes([bytes[8], bytes[9]]), 7);
+    assert_eq!(u16::from_ne_bytes([bytes[10], bytes[11]]), 0);
+    assert_eq!(bytes[12], BODY_TYPE_JSON);
+    assert_eq!(&bytes[HEADER_SIZE..], br#"handler{"foo":1}"#);
+}
+
+#[test]
+fn translate_messages() {
+    let to_value = |bytes: &[u8]| -> Value {
+        serde_json::from_slice(&to_json_message(bytes).unwrap()).unwrap()
+    };
+
+    let mut accepted = message(MessageType::ResponseAccepted, 7, "", "", BODY_TYPE_RECORDS);
+
+    accepted.push(key("ssrc"));
+    varint(1111, &mut accepted);
+    accepted.push(0);
+
+    assert_eq!(
+        to_value(&accepted),
+        json!({ "id": 7, "accepted": true, "data": [{ "ssrc": 1111 }] }),
+    );
+
+    let mut type_error = message(MessageType::ResponseTypeError, 8, "", "", BODY_TYPE_JSON);
+
+    type_error.extend_from_slice(b"wrong foo");
+
+    assert_eq!(
+        to_value(&type_error),
+        json!({ "id": 8, "error": "TypeError", "reason": "wrong foo" }),
+    );
+
+    let mut notification = message(
+        MessageType::Notification,
+        0,
+        "c1",
+        "message",
+        BODY_TYPE_RECORD,
+    );
+
+    notification.extend_from_slice(&[key("ppid"), 51, 0]);
+
+    assert_eq!(
+        to_value(&notification),
+        json!({ "targetId": "c1", "event": "message", "data": { "ppid": 51 } }),
+    );
+}
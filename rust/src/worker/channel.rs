@@ -1,4 +1,5 @@
 use crate::messages::{Request, WorkerCloseRequest};
+use crate::worker::binary_message;
 use crate::worker::common::{EventHandlers, SubscriptionTarget, WeakEventHandlers};
 use crate::worker::utils;
 use crate::worker::utils::{PreparedChannelRead, PreparedChannelWrite};
@@ -222,6 +223,23 @@ impl Channel {
             move |message| {
                 trace!("received raw message: {}", String::from_utf8_lossy(message));
 
+                // Binary messages are translated into the equivalent JSON ones
+                let json_message;
+                let message = if binary_message::is_binary(message) {
+                    match binary_message::to_json_message(message) {
+                        Ok(translated) => {
+                            json_message = translated;
+                            json_message.as_slice()
+                        }
+                        Err(error) => {
+                            warn!("{}", error);
+                            return;
+                        }
+                    }
+                } else {
+                    message
+                };
+
                 match deserialize_message(message) {
                     ChannelReceiveMessage::Notification { target_id } => {
                         if !non_buffered_notifications.contains(&target_id) {
@@ -342,11 +360,22 @@ impl Channel {
         // TODO: Todo pre-allocate fixed size string sufficient for most cases by default
         // TODO: Refactor to avoid extra allocation during JSON serialization if possible
         let message = Arc::new(AtomicTake::new(
-            format!(
-                "{id}:{method}:{handler_id}:{}",
-                serde_json::to_string(&request).unwrap()
-            )
-            .into_bytes(),
+            match binary_message::channel_method_id(method) {
+                // Methods known by id are sent as binary requests (with JSON data), so the worker
+                // replies in binary too, with schema encoded stats and dumps
+                Some(method_id) => binary_message::encode(
+                    binary_message::MessageType::Request,
+                    method_id,
+                    id,
+                    &handler_id.to_string(),
+                    &serde_json::to_vec(&request).unwrap(),
+                ),
+                None => format!(
+                    "{id}:{method}:{handler_id}:{}",
+                    serde_json::to_string(&request).unwrap()
+                )
+                .into_bytes(),
+            },
         ));
 
         {
@@ -1,4 +1,5 @@
 use crate::messages::{Notification, Request};
+use crate::worker::binary_message;
 use crate::worker::common::{EventHandlers, SubscriptionTarget, WeakEventHandlers};
 use crate::worker::utils::{PreparedPayloadChannelRead, PreparedPayloadChannelWrite};
 use crate::worker::{utils, RequestError, SubscriptionHandler};
@@ -191,6 +192,23 @@ impl PayloadChannel {
             utils::prepare_payload_channel_write_fn(move |message, payload| {
                 trace!("received raw message: {}", String::from_utf8_lossy(message));
 
+                // Binary messages are translated into the equivalent JSON ones
+                let json_message;
+                let message = if binary_message::is_binary(message) {
+                    match binary_message::to_json_message(message) {
+                        Ok(translated) => {
+                            json_message = translated;
+                            json_message.as_slice()
+                        }
+                        Err(error) => {
+                            warn!("{}", error);
+                            return;
+                        }
+                    }
+                } else {
+                    message
+                };
+
                 match deserialize_message(message) {
                     PayloadChannelReceiveMessage::Notification { target_id } => {
                         trace!("received notification payload of {} bytes", payload.len());
@@ -277,12 +295,21 @@ impl PayloadChannel {
 
         // TODO: Todo pre-allocate fixed size string sufficient for most cases by default
         // TODO: Refactor to avoid extra allocation during JSON serialization if possible
-        let message = format!(
-            "r:{id}:{}:{handler_id}:{}",
-            request.as_method(),
-            serde_json::to_string(&request).unwrap()
-        )
-        .into_bytes();
+        let message = match binary_message::payload_channel_method_id(method) {
+            Some(method_id) => binary_message::encode(
+                binary_message::MessageType::Request,
+                method_id,
+                id,
+                &handler_id.to_string(),
+                &serde_json::to_vec(&request).unwrap(),
+            ),
+            None => format!(
+                "r:{id}:{}:{handler_id}:{}",
+                request.as_method(),
+                serde_json::to_string(&request).unwrap()
+            )
+            .into_bytes(),
+        };
 
         let message_with_payload =
             Arc::new(AtomicTake::new(OutgoingMessageRequest { message, payload }));
@@ -352,12 +379,21 @@ impl PayloadChannel {
 
         // TODO: Todo pre-allocate fixed size string sufficient for most cases by default
         // TODO: Refactor to avoid extra allocation during JSON serialization if possible
-        let message = format!(
-            "n:{}:{handler_id}:{}",
-            notification.as_event(),
-            serde_json::to_string(&notification).unwrap()
-        )
-        .into_bytes();
+        let message = match binary_message::payload_channel_event_id(notification.as_event()) {
+            Some(event_id) => binary_message::encode(
+                binary_message::MessageType::Notification,
+                event_id,
+                0,
+                &handler_id.to_string(),
+                &serde_json::to_vec(&notification).unwrap(),
+            ),
+            None => format!(
+                "n:{}:{handler_id}:{}",
+                notification.as_event(),
+                serde_json::to_string(&notification).unwrap()
+            )
+            .into_bytes(),
+        };
 
         {
             let mut outgoing_message_buffer = self.inner.outgoing_message_buffer.lock();
@@ -919,6 +919,86 @@ fn consume_for_pipe_producer_succeeds() {
     });
 }
 
+#[test]
+fn consume_egress_succeeds() {
+    future::block_on(async move {
+        let (worker1, worker2, _router1, _router2, _transport1, _transport2) = init().await;
+
+        let router = worker1
+            .create_router({
+                let mut options = RouterOptions::new(media_codecs());
+                // The Worker of the Router itself is ignored.
+                options.egress_workers = vec![worker1.clone(), worker2.clone()];
+                options
+            })
+            .await
+            .expect("Failed to create router");
+
+        let transport_options = WebRtcTransportOptions::new(TransportListenIps::new(ListenIp {
+            ip: IpAddr::V4(Ipv4Addr::LOCALHOST),
+            announced_ip: None,
+        }));
+
+        let transport = router
+            .create_webrtc_transport(transport_options.clone())
+            .await
+            .expect("Failed to create transport");
+
+        let audio_producer = transport
+            .produce(audio_producer_options())
+            .await
+            .expect("Failed to produce audio");
+
+        let mut audio_consumers = vec![];
+
+        for _ in 0..2 {
+            let egress_transport = router
+                .create_egress_webrtc_transport(transport_options.clone())
+                .await
+                .expect("Failed to create egress transport");
+
+            assert_eq!(egress_transport.router().worker().id(), worker2.id());
+
+            let audio_consumer = router
+                .consume_egress(
+                    &egress_transport,
+                    ConsumerOptions::new(audio_producer.id(), consumer_device_capabilities()),
+                )
+                .await
+                .expect("Failed to consume audio");
+
+            assert_eq!(audio_consumer.producer_id(), audio_producer.id());
+
+            audio_consumers.push((egress_transport, audio_consumer));
+        }
+
+        {
+            let dump = router.dump().await.expect("Failed to dump router");
+
+            // There should be two Transports in router:
+            // - WebRtcTransport for audio_producer.
+            // - PipeTransport to the egress Router, used once for both Consumers.
+            assert_eq!(dump.transport_ids.len(), 2);
+        }
+
+        {
+            let egress_router = audio_consumers[0].0.router();
+            let dump = egress_router.dump().await.expect("Failed to dump router");
+
+            // There should be three Transports in the egress Router:
+            // - Two WebRtcTransports for audio_consumers.
+            // - PipeTransport from router.
+            assert_eq!(dump.transport_ids.len(), 3);
+            assert_eq!(
+                dump.map_producer_id_consumer_ids
+                    .get(&audio_producer.id())
+                    .map(|consumer_ids| consumer_ids.len()),
+                Some(2),
+            );
+        }
+    });
+}
+
 #[test]
 fn producer_pause_resume_are_transmitted_to_pipe_consumer() {
     future::block_on(async move {
@@ -0,0 +1,213 @@
+#ifndef MS_CHANNEL_BINARY_BODY_HPP
+#define MS_CHANNEL_BINARY_BODY_HPP
+
+#include "common.hpp"
+#include "Channel/BinaryMessage.hpp"
+#include <absl/container/inlined_vector.h>
+#include <nlohmann/json.hpp>
+#include <string>
+
+using json = nlohmann::json;
+
+namespace Channel
+{
+	// Schema encoded data of binary messages (see BinaryMessage.hpp), used for
+	// the bodies with a fixed shape (stats, Worker and Router dumps, DataConsumer
+	// messages) instead of JSON.
+	//
+	// A record is a sequence of fields terminated by the END key (0). A field is
+	// a key (uint8) followed by its value, whose encoding is given by the value
+	// type of the key in the schema below, so neither names nor types are sent.
+	// Optional values are just omitted. Integers are LEB128 varints (zigzag
+	// encoded if signed) and doubles 8 bytes in host byte order:
+	//
+	// - UINT, INT, BOOL: a varint.
+	// - DOUBLE: 8 bytes.
+	// - STRING: the length (varint) and the UTF-8 bytes.
+	// - STRINGS: the count (varint) and as many STRINGs.
+	// - RECORD: a nested record.
+	// - STRING_MAP, STRINGS_MAP, UINT_MAP: the count (varint) and as many key
+	//   STRINGs, each one followed by a STRING, STRINGS or UINT value.
+	//
+	// Names of the keys are the ones of the JSON bodies, so decoded records are
+	// the objects clients got so far.
+	//
+	// NOTE: The schema is mirrored by the Node (binaryMessage.ts) and Rust
+	// (binary_message.rs) decoders.
+	class BinaryBody
+	{
+	public:
+		enum class ValueType : uint8_t
+		{
+			UINT = 1,
+			INT,
+			DOUBLE,
+			BOOL,
+			STRING,
+			STRINGS,
+			RECORD,
+			STRING_MAP,
+			STRINGS_MAP,
+			UINT_MAP
+		};
+
+		// NOTE: Values are sent as keys, so new keys must be appended.
+		enum class Key : uint8_t
+		{
+			END = 0,
+			TYPE,
+			ID,
+			TIMESTAMP,
+			TRANSPORT_ID,
+			SCTP_STATE,
+			BYTES_RECEIVED,
+			RECV_BITRATE,
+			BYTES_SENT,
+			SEND_BITRATE,
+			RTP_BYTES_RECEIVED,
+			RTP_RECV_BITRATE,
+			RTP_BYTES_SENT,
+			RTP_SEND_BITRATE,
+			RTX_BYTES_RECEIVED,
+			RTX_RECV_BITRATE,
+			RTX_BYTES_SENT,
+			RTX_SEND_BITRATE,
+			PROBATION_BYTES_SENT,
+			PROBATION_SEND_BITRATE,
+			AVAILABLE_OUTGOING_BITRATE,
+			AVAILABLE_INCOMING_BITRATE,
+			MAX_INCOMING_BITRATE,
+			RTP_PACKET_LOSS_RECEIVED,
+			RTP_PACKET_LOSS_SENT,
+			ICE_ROLE,
+			ICE_STATE,
+			ICE_SELECTED_TUPLE,
+			DTLS_STATE,
+			RTCP_MUX,
+			COMEDIA,
+			TUPLE,
+			RTCP_TUPLE,
+			LOCAL_IP,
+			LOCAL_PORT,
+			REMOTE_IP,
+			REMOTE_PORT,
+			PROTOCOL,
+			SSRC,
+			KIND,
+			MIME_TYPE,
+			PACKETS_LOST,
+			FRACTION_LOST,
+			PACKETS_DISCARDED,
+			PACKETS_RETRANSMITTED,
+			PACKETS_REPAIRED,
+			NACK_COUNT,
+			NACK_PACKET_COUNT,
+			PLI_COUNT,
+			FIR_COUNT,
+			SCORE,
+			RID,
+			RTX_SSRC,
+			RTX_PACKETS_DISCARDED,
+			ROUND_TRIP_TIME,
+			JITTER,
+			PACKET_COUNT,
+			BYTE_COUNT,
+			BITRATE,
+			BITRATE_BY_LAYER,
+			LABEL,
+			MESSAGES_RECEIVED,
+			MESSAGES_SENT,
+			BUFFERED_AMOUNT,
+			PID,
+			WEBRTC_SERVER_IDS,
+			ROUTER_IDS,
+			CHANNEL_MESSAGE_HANDLERS,
+			CHANNEL_REQUEST_HANDLERS,
+			PAYLOAD_CHANNEL_REQUEST_HANDLERS,
+			PAYLOAD_CHANNEL_NOTIFICATION_HANDLERS,
+			RTP_PACKET_POOL,
+			PACKETS,
+			BUFFERS,
+			BLOCK_SIZE,
+			CAPACITY,
+			IN_USE,
+			HIGH_WATER,
+			TRANSPORT_IDS,
+			RTP_OBSERVER_IDS,
+			MAP_PRODUCER_ID_CONSUMER_IDS,
+			MAP_CONSUMER_ID_PRODUCER_ID,
+			MAP_PRODUCER_ID_OBSERVER_IDS,
+			MAP_DATA_PRODUCER_ID_DATA_CONSUMER_IDS,
+			MAP_DATA_CONSUMER_ID_DATA_PRODUCER_ID,
+			PPID,
+			WRITE_QUEUE_SIZE,
+			MAX_WRITE_QUEUE_SIZE,
+			QUEUED_WRITES,
+			WRITE_BATCH_FLUSHES,
+			WRITE_BATCH_ITEMS
+		};
+
+	public:
+		struct KeyInfo
+		{
+			const char* name;
+			ValueType type;
+		};
+
+	public:
+		class Writer
+		{
+		public:
+			explicit Writer(BinaryMessage::BodyType bodyType);
+
+		public:
+			BinaryMessage::BodyType GetBodyType() const
+			{
+				return this->bodyType;
+			}
+			const char* GetData() const
+			{
+				return reinterpret_cast<const char*>(this->buffer.data());
+			}
+			size_t GetSize() const
+			{
+				return this->buffer.size();
+			}
+			void WriteUint(Key key, uint64_t value);
+			void WriteInt(Key key, int64_t value);
+			void WriteDouble(Key key, double value);
+			void WriteBool(Key key, bool value);
+			void WriteString(Key key, const std::string& value);
+			// Starts a nested record, to be ended with EndRecord().
+			void StartRecord(Key key);
+			void EndRecord();
+			// Starts a STRINGS or map value with the given number of items, to be
+			// followed by as many AppendString(), AppendUint() or AppendCount() calls
+			// as its type requires.
+			void StartItems(Key key, size_t count);
+			void AppendString(const std::string& value);
+			void AppendUint(uint64_t value);
+			void AppendCount(size_t count);
+
+		private:
+			void WriteKey(Key key, ValueType type);
+			void WriteVarint(uint64_t value);
+
+		private:
+			// Passed by argument.
+			BinaryMessage::BodyType bodyType;
+			// Others.
+			// Small bodies (DataConsumer messages) don't allocate.
+			absl::InlinedVector<uint8_t, 32> buffer;
+		};
+
+	public:
+		static const KeyInfo& GetKeyInfo(Key key);
+		// Decodes schema encoded data into the equivalent JSON. Returns false if
+		// the data is not valid.
+		static bool ToJson(
+		  BinaryMessage::BodyType bodyType, const char* data, size_t dataLen, json& jsonValue);
+	};
+} // namespace Channel
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef MS_CHANNEL_BINARY_MESSAGE_HPP
+#define MS_CHANNEL_BINARY_MESSAGE_HPP
+
+#include "common.hpp"
+#include <string>
+#include <vector>
+
+namespace Channel
+{
+	// Binary encoding of Channel and PayloadChannel messages. Text messages
+	// start with a digit (Channel requests), "r:"/"n:" (PayloadChannel) or "{"
+	// (JSON), so the leading zero byte tells binary messages apart and the JSON
+	// protocol keeps working unchanged.
+	//
+	// Layout (integers in host byte order, as the length prefix of the framing):
+	//
+	//  0       1       2               4                               8
+	//  +-------+-------+---------------+-------------------------------+
+	//  |   0   | type  |     code      |              id               |
+	//  +-------+-------+---------------+-------+-----------------------+
+	//  |  field1Len    |  field2Len    | body  | field1, field2, data...
+	//  +---------------+---------------+-------+-----------------------
+	//
+	// - REQUEST: code is the method id, id is the request id, field1 is the
+	//   handler id and data is the request data.
+	// - NOTIFICATION: code is the event id (received notifications), field1 is
+	//   the target/handler id, field2 is the event name (sent notifications) and
+	//   data is the notification data, if any.
+	// - RESPONSE_*: id is the request id and data is either the response data,
+	//   if any, or the error reason.
+	//
+	// body tells how data is encoded: JSON, or records of the schema defined in
+	// BinaryBody.hpp. Error reasons are plain text.
+	//
+	// Fields of a parsed message point into the given buffer, nothing is copied.
+	class BinaryMessage
+	{
+	public:
+		enum class Type : uint8_t
+		{
+			REQUEST = 1,
+			NOTIFICATION,
+			RESPONSE_ACCEPTED,
+			RESPONSE_ERROR,
+			RESPONSE_TYPE_ERROR
+		};
+
+		enum class BodyType : uint8_t
+		{
+			JSON = 0,
+			// A single record.
+			RECORD,
+			// Records until the end of the data.
+			RECORDS
+		};
+
+	public:
+		struct Fields
+		{
+			Type type;
+			uint16_t code;
+			uint32_t id;
+			const char* field1;
+			size_t field1Len;
+			const char* field2;
+			size_t field2Len;
+			BodyType bodyType;
+			const char* data;
+			size_t dataLen;
+		};
+
+	public:
+		static constexpr size_t HeaderSize{ 13u };
+
+	public:
+		static bool IsBinary(const char* msg, size_t msgLen)
+		{
+			return msgLen >= HeaderSize && msg[0] == '\0';
+		}
+		static bool IsBinary(const char* msg, size_t msgLen, Type type)
+		{
+			return IsBinary(msg, msgLen) && static_cast<Type>(msg[1]) == type;
+		}
+		// Returns false if the message is not a valid binary message.
+		static bool Parse(const char* msg, size_t msgLen, Fields& fields);
+		// Replaces the content of the given buffer with the encoded message.
+		static void Write(
+		  std::vector<uint8_t>& buffer,
+		  Type type,
+		  uint16_t code,
+		  uint32_t id,
+		  const std::string& field1,
+		  const char* field2,
+		  BodyType bodyType,
+		  const char* data,
+		  size_t dataLen);
+	};
+} // namespace Channel
+
+#endif
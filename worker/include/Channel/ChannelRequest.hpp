@@ -2,6 +2,7 @@
 #define MS_CHANNEL_REQUEST_HPP
 
 #include "common.hpp"
+#include "Channel/BinaryBody.hpp"
 #include <absl/container/flat_hash_map.h>
 #include <nlohmann/json.hpp>
 #include <string>
@@ -17,6 +18,8 @@ namespace Channel
 	class ChannelRequest
 	{
 	public:
+		// NOTE: Values are sent as method id by binary requests, so new methods
+		// must be appended.
 		enum class MethodId
 		{
 			WORKER_CLOSE = 1,
@@ -76,11 +79,16 @@ namespace Channel
 			RTP_OBSERVER_PAUSE,
 			RTP_OBSERVER_RESUME,
 			RTP_OBSERVER_ADD_PRODUCER,
-			RTP_OBSERVER_REMOVE_PRODUCER
+			RTP_OBSERVER_REMOVE_PRODUCER,
+			WORKER_DUMP_RTP_TRACE,
+			WORKER_SUBSCRIBE_STATS,
+			WORKER_UNSUBSCRIBE_STATS,
+			WORKER_GET_METRICS
 		};
 
 	private:
 		static absl::flat_hash_map<std::string, MethodId> string2MethodId;
+		static absl::flat_hash_map<MethodId, std::string> methodId2String;
 
 	public:
 		ChannelRequest(Channel::ChannelSocket* channel, const char* msg, size_t msgLen);
@@ -88,9 +96,15 @@ namespace Channel
 
 		void Accept();
 		void Accept(json& data);
+		// Only for binary requests.
+		void Accept(const Channel::BinaryBody::Writer& body);
 		void Error(const char* reason = nullptr);
 		void TypeError(const char* reason = nullptr);
 
+	private:
+		void ParseBinary(const char* msg, size_t msgLen);
+		void ParseText(const char* msg, size_t msgLen);
+
 	public:
 		// Passed by argument.
 		Channel::ChannelSocket* channel{ nullptr };
@@ -100,6 +114,7 @@ namespace Channel
 		std::string handlerId;
 		json data;
 		// Others.
+		bool binary{ false };
 		bool replied{ false };
 	};
 } // namespace Channel
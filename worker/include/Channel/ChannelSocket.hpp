@@ -2,10 +2,12 @@
 #define MS_CHANNEL_SOCKET_HPP
 
 #include "common.hpp"
+#include "Channel/BinaryMessage.hpp"
 #include "Channel/ChannelRequest.hpp"
 #include "handles/UnixStreamSocket.hpp"
 #include <nlohmann/json.hpp>
 #include <string>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -88,11 +90,28 @@ namespace Channel
 		void SetListener(Listener* listener);
 		void Send(json& jsonMessage);
 		void Send(const std::string& message);
+		void SendBinary(
+		  Channel::BinaryMessage::Type type,
+		  uint32_t id,
+		  const std::string& field1,
+		  const char* field2,
+		  Channel::BinaryMessage::BodyType bodyType,
+		  const char* data,
+		  size_t dataLen);
 		void SendLog(const char* message, uint32_t messageLen);
+		// Sends many log messages at once. Each one must be preceded by its
+		// length (uint32_t in host byte order), as written to the pipe.
+		void SendLogs(const uint8_t* data, size_t len);
 		bool CallbackRead();
+		// Whether the remote side talks the binary protocol.
+		bool IsBinary() const
+		{
+			return this->binary;
+		}
 
 	private:
 		void SendImpl(const uint8_t* payload, uint32_t payloadLen);
+		void OnMessage(const char* msg, size_t msgLen);
 
 		/* Pure virtual methods inherited from ConsumerSocket::Listener. */
 	public:
@@ -112,6 +131,8 @@ namespace Channel
 		ChannelWriteCtx channelWriteCtx{ nullptr };
 		uv_async_t* uvReadHandle{ nullptr };
 		uint8_t* writeBuffer{ nullptr };
+		std::vector<uint8_t> binaryBuffer;
+		bool binary{ false };
 	};
 } // namespace Channel
 
@@ -2,6 +2,7 @@
 #define MS_CHANNEL_MESSAGE_REGISTRATOR_HPP
 
 #include "common.hpp"
+#include "Channel/BinaryBody.hpp"
 #include "Channel/ChannelSocket.hpp"
 #include "PayloadChannel/PayloadChannelSocket.hpp"
 #include <absl/container/flat_hash_map.h>
@@ -16,6 +17,7 @@ public:
 
 public:
 	void FillJson(json& jsonObject);
+	void FillBinary(Channel::BinaryBody::Writer& writer);
 	void RegisterHandler(
 	  const std::string& id,
 	  Channel::ChannelSocket::RequestHandler* channelRequestHandler,
@@ -4,7 +4,8 @@
 #include "common.hpp"
 #include "RTC/SctpAssociation.hpp"
 #include "handles/Timer.hpp"
-#include <absl/container/flat_hash_map.h>
+#include <atomic>
+#include <vector>
 
 class DepUsrSCTP
 {
@@ -28,21 +29,49 @@ private:
 		uint64_t lastCalledAtMs{ 0u };
 	};
 
+public:
+	// SctpAssociations are stored in slots of chunks which are allocated on
+	// demand (and not freed until ClassDestroy()), so usrsctp callbacks can
+	// retrieve them by id without taking the global lock. The lowest SlotBits
+	// bits of an id are its slot and the rest a generation number of the slot,
+	// so stale ids of closed SctpAssociations never match a new one.
+	static constexpr size_t SlotBits{ 20u };
+	static constexpr size_t ChunkBits{ 10u };
+	static constexpr size_t MaxSlots{ size_t{ 1u } << SlotBits };
+	static constexpr size_t SlotsPerChunk{ size_t{ 1u } << ChunkBits };
+	static constexpr size_t MaxChunks{ MaxSlots / SlotsPerChunk };
+	static constexpr uintptr_t SlotMask{ MaxSlots - 1u };
+	static constexpr uintptr_t MaxGeneration{ ~uintptr_t{ 0u } >> SlotBits };
+
 public:
 	static void ClassInit();
 	static void ClassDestroy();
 	static void CreateChecker();
 	static void CloseChecker();
 	static uintptr_t GetNextSctpAssociationId();
+	// Gives back the slot of an id got from GetNextSctpAssociationId() whose
+	// SctpAssociation failed to be created (so it was not registered).
+	static void ReleaseSctpAssociationId(uintptr_t id);
+	static uintptr_t GetNextSlotGeneration(uintptr_t generation)
+	{
+		// NOTE: usrsctp_connect() fails with a value of 0, so generation 0 is
+		// never used.
+		return generation >= MaxGeneration ? 1u : generation + 1u;
+	}
 	static void RegisterSctpAssociation(RTC::SctpAssociation* sctpAssociation);
 	static void DeregisterSctpAssociation(RTC::SctpAssociation* sctpAssociation);
 	static RTC::SctpAssociation* RetrieveSctpAssociation(uintptr_t id);
 
+private:
+	static std::atomic<RTC::SctpAssociation*>& GetSlot(uintptr_t id);
+
 private:
 	thread_local static Checker* checker;
 	static uint64_t numSctpAssociations;
-	static uintptr_t nextSctpAssociationId;
-	static absl::flat_hash_map<uintptr_t, RTC::SctpAssociation*> mapIdSctpAssociation;
+	static std::atomic<std::atomic<RTC::SctpAssociation*>*> chunks[MaxChunks];
+	// Guarded by the global lock.
+	static std::vector<uintptr_t> slotGenerations;
+	static std::vector<uintptr_t> freeSlots;
 };
 
 #endif
@@ -29,6 +29,13 @@
  *
  *   Logs if the current log level is satisfied and the given tag is enabled.
  *
+ *   In batching mode (logBatching setting) these and the other DEBUG and WARN
+ *   macros are rate limited per call site, and the number of suppressed
+ *   messages is appended to the next one logged by that call site. Messages
+ *   of all macros but MS_ERROR are buffered and written to the Channel once
+ *   per event loop iteration. MS_ERROR flushes the buffer and is written
+ *   right away.
+ *
  *   Example:
  *     MS_WARN_TAG(ice, "ICE failed");
  *
@@ -128,14 +135,47 @@
 
 class Logger
 {
+public:
+	// State of a logging macro call site for rate limiting in batching mode. It
+	// must be zero initialized.
+	struct CallSite
+	{
+		uint64_t windowStartMs;
+		uint32_t numLogged;
+		uint32_t numSuppressed;
+	};
+
 public:
 	static void ClassInit(Channel::ChannelSocket* channel);
+	static void SetBatching(bool enabled);
+	static bool IsBatching()
+	{
+		return Logger::batching;
+	}
+	static bool IsAllowed(CallSite& callSite);
+	static void SendLog(const char* message, int messageLen);
+	static void SendLog(CallSite& callSite, char* message, int messageLen);
+	static void SendErrorLog(const char* message, int messageLen);
+	static void Flush();
+	static uint64_t GetNumSuppressed()
+	{
+		return Logger::numSuppressed;
+	}
 
 public:
 	static const uint64_t pid;
 	thread_local static Channel::ChannelSocket* channel;
 	static const size_t bufferSize {50000};
 	thread_local static char buffer[];
+	// Max messages logged by a call site per window in batching mode.
+	static constexpr uint32_t MaxMessagesPerWindow{ 20u };
+	static constexpr uint64_t RateLimitWindowMs{ 1000u };
+	// Buffered messages are written before exceeding this size.
+	static constexpr size_t MaxBatchBufferSize{ 65536u };
+
+private:
+	thread_local static bool batching;
+	thread_local static uint64_t numSuppressed;
 };
 
 /* Logging macros. */
@@ -160,7 +200,7 @@ public:
 			if (Settings::configuration.logLevel == LogLevel::LOG_DEBUG) \
 			{ \
 				const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "D(trace) " _MS_LOG_STR, _MS_LOG_ARG); \
-				Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+				Logger::SendLog(Logger::buffer, loggerWritten); \
 			} \
 		} \
 		while (false)
@@ -191,8 +231,12 @@ public:
 	{ \
 		if (Settings::configuration.logLevel == LogLevel::LOG_DEBUG && _MS_TAG_ENABLED(tag)) \
 		{ \
-			const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+			thread_local static Logger::CallSite loggerCallSite; \
+			if (Logger::IsAllowed(loggerCallSite)) \
+			{ \
+				const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
+				Logger::SendLog(loggerCallSite, Logger::buffer, loggerWritten); \
+			} \
 		} \
 	} \
 	while (false)
@@ -213,8 +257,12 @@ public:
 	{ \
 		if (Settings::configuration.logLevel >= LogLevel::LOG_WARN && _MS_TAG_ENABLED(tag)) \
 		{ \
-			const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+			thread_local static Logger::CallSite loggerCallSite; \
+			if (Logger::IsAllowed(loggerCallSite)) \
+			{ \
+				const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
+				Logger::SendLog(loggerCallSite, Logger::buffer, loggerWritten); \
+			} \
 		} \
 	} \
 	while (false)
@@ -235,8 +283,12 @@ public:
 	{ \
 		if (Settings::configuration.logLevel == LogLevel::LOG_DEBUG && _MS_TAG_ENABLED_2(tag1, tag2)) \
 		{ \
-			const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+			thread_local static Logger::CallSite loggerCallSite; \
+			if (Logger::IsAllowed(loggerCallSite)) \
+			{ \
+				const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
+				Logger::SendLog(loggerCallSite, Logger::buffer, loggerWritten); \
+			} \
 		} \
 	} \
 	while (false)
@@ -257,8 +309,12 @@ public:
 	{ \
 		if (Settings::configuration.logLevel >= LogLevel::LOG_WARN && _MS_TAG_ENABLED_2(tag1, tag2)) \
 		{ \
-			const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+			thread_local static Logger::CallSite loggerCallSite; \
+			if (Logger::IsAllowed(loggerCallSite)) \
+			{ \
+				const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
+				Logger::SendLog(loggerCallSite, Logger::buffer, loggerWritten); \
+			} \
 		} \
 	} \
 	while (false)
@@ -278,8 +334,12 @@ public:
 	#define MS_DEBUG_DEV(desc, ...) \
 		do \
 		{ \
-			const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+			thread_local static Logger::CallSite loggerCallSite; \
+			if (Logger::IsAllowed(loggerCallSite)) \
+			{ \
+				const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
+				Logger::SendLog(loggerCallSite, Logger::buffer, loggerWritten); \
+			} \
 		} \
 		while (false)
 
@@ -300,8 +360,12 @@ public:
 	#define MS_WARN_DEV(desc, ...) \
 		do \
 		{ \
-			const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+			thread_local static Logger::CallSite loggerCallSite; \
+			if (Logger::IsAllowed(loggerCallSite)) \
+			{ \
+				const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
+				Logger::SendLog(loggerCallSite, Logger::buffer, loggerWritten); \
+			} \
 		} \
 		while (false)
 
@@ -321,7 +385,7 @@ public:
 	do \
 	{ \
 		const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "X" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-		Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+		Logger::SendLog(Logger::buffer, loggerWritten); \
 	} \
 	while (false)
 
@@ -337,7 +401,7 @@ public:
 	do \
 	{ \
 		const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "X(data) " _MS_LOG_STR, _MS_LOG_ARG); \
-		Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+		Logger::SendLog(Logger::buffer, loggerWritten); \
 		size_t bufferDataLen{ 0 }; \
 		for (size_t i{0}; i < len; ++i) \
 		{ \
@@ -345,7 +409,7 @@ public:
 		  { \
 		  	if (bufferDataLen != 0) \
 		  	{ \
-		  		Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(bufferDataLen)); \
+		  		Logger::SendLog(Logger::buffer, static_cast<int>(bufferDataLen)); \
 		  		bufferDataLen = 0; \
 		  	} \
 		    const int loggerWritten = std::snprintf(Logger::buffer + bufferDataLen, Logger::bufferSize, "X%06X ", static_cast<unsigned int>(i)); \
@@ -355,7 +419,7 @@ public:
 		  bufferDataLen += loggerWritten; \
 		} \
 		if (bufferDataLen != 0) \
-			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(bufferDataLen)); \
+			Logger::SendLog(Logger::buffer, static_cast<int>(bufferDataLen)); \
 	} \
 	while (false)
 
@@ -395,7 +459,7 @@ public:
 		if (Settings::configuration.logLevel >= LogLevel::LOG_ERROR || MS_LOG_DEV_LEVEL >= 1) \
 		{ \
 			const int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "E" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, static_cast<uint32_t>(loggerWritten)); \
+			Logger::SendErrorLog(Logger::buffer, loggerWritten); \
 		} \
 	} \
 	while (false)
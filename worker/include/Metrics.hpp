@@ -0,0 +1,68 @@
+#ifndef MS_METRICS_HPP
+#define MS_METRICS_HPP
+
+#include "common.hpp"
+#include "RTC/RtcLogger.hpp"
+#include <string>
+
+// Aggregate counters and histograms of the worker updated in hot paths (RTP
+// routing, packet drops, SRTP, socket sends and the event loop). They are
+// per thread so updating them is a plain increment, and they are rendered on
+// demand as OpenMetrics text without walking Routers, Transports, etc.
+class Metrics
+{
+public:
+	enum class Counter : uint8_t
+	{
+		RTP_PACKETS_ROUTED = 0,
+		RTP_PACKETS_SENT,
+		SRTP_PROTECT_RTP_FAILURES,
+		SRTP_UNPROTECT_RTP_FAILURES,
+		SRTP_PROTECT_RTCP_FAILURES,
+		SRTP_UNPROTECT_RTCP_FAILURES,
+		UDP_SEND_EAGAIN,
+		TCP_SEND_EAGAIN
+	};
+
+public:
+	static constexpr size_t NumCounters{ 8u };
+	static constexpr size_t NumDropReasons{ RTC::RtcLogger::RtpPacket::NumDropReasons };
+	// Upper bounds (in microseconds) of the event loop lag histogram buckets.
+	static constexpr size_t NumLoopLagBuckets{ 10u };
+	static constexpr uint64_t LoopLagBucketsUs[NumLoopLagBuckets]{
+		1000u, 2500u, 5000u, 10000u, 25000u, 50000u, 100000u, 250000u, 500000u, 1000000u
+	};
+
+private:
+	// Aligned so no other thread data shares its cache lines.
+	struct alignas(64) Data
+	{
+		uint64_t counters[NumCounters];
+		uint64_t rtpPacketsDropped[NumDropReasons];
+		// Non cumulative, the last one being +Inf.
+		uint64_t loopLagBuckets[NumLoopLagBuckets + 1];
+		uint64_t loopLagSumUs;
+		uint64_t loopLagCount;
+	};
+
+public:
+	static void Increment(Counter counter)
+	{
+		++Metrics::data.counters[static_cast<size_t>(counter)];
+	}
+	static void IncrementRtpPacketsDropped(RTC::RtcLogger::RtpPacket::DropReason dropReason)
+	{
+		++Metrics::data.rtpPacketsDropped[static_cast<size_t>(dropReason)];
+	}
+	static uint64_t GetCounter(Counter counter)
+	{
+		return Metrics::data.counters[static_cast<size_t>(counter)];
+	}
+	static void ObserveLoopLag(uint64_t lagUs);
+	static std::string Render();
+
+private:
+	thread_local static Data data;
+};
+
+#endif
@@ -10,6 +10,8 @@ namespace PayloadChannel
 	class PayloadChannelNotification
 	{
 	public:
+		// NOTE: Values are sent as event id by binary notifications, so new events
+		// must be appended.
 		enum class EventId
 		{
 			TRANSPORT_SEND_RTCP = 1,
@@ -22,6 +24,7 @@ namespace PayloadChannel
 
 	private:
 		static absl::flat_hash_map<std::string, EventId> string2EventId;
+		static absl::flat_hash_map<EventId, std::string> eventId2String;
 
 	public:
 		PayloadChannelNotification(const char* msg, size_t msgLen);
@@ -30,6 +33,10 @@ namespace PayloadChannel
 	public:
 		void SetPayload(const uint8_t* payload, size_t payloadLen);
 
+	private:
+		void ParseBinary(const char* msg, size_t msgLen);
+		void ParseText(const char* msg, size_t msgLen);
+
 	public:
 		// Passed by argument.
 		std::string event;
@@ -2,6 +2,7 @@
 #define MS_PAYLOAD_CHANNEL_NOTIFIER_HPP
 
 #include "common.hpp"
+#include "Channel/BinaryBody.hpp"
 #include "PayloadChannel/PayloadChannelSocket.hpp"
 #include <nlohmann/json.hpp>
 #include <string>
@@ -16,6 +17,13 @@ namespace PayloadChannel
 		explicit PayloadChannelNotifier(PayloadChannel::PayloadChannelSocket* payloadChannel);
 
 	public:
+		// Whether the remote side talks the binary protocol.
+		bool IsBinary() const
+		{
+			return this->payloadChannel->IsBinary();
+		}
+		void Emit(
+		  uint64_t targetId, const char* event, json& data, const uint8_t* payload, size_t payloadLen);
 		void Emit(const std::string& targetId, const char* event, const uint8_t* payload, size_t payloadLen);
 		void Emit(
 		  const std::string& targetId,
@@ -29,6 +37,13 @@ namespace PayloadChannel
 		  const std::string& data,
 		  const uint8_t* payload,
 		  size_t payloadLen);
+		// Only if IsBinary().
+		void Emit(
+		  const std::string& targetId,
+		  const char* event,
+		  const Channel::BinaryBody::Writer& body,
+		  const uint8_t* payload,
+		  size_t payloadLen);
 
 	private:
 		// Passed by argument.
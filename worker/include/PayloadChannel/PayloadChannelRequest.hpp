@@ -17,9 +17,11 @@ namespace PayloadChannel
 	class PayloadChannelRequest
 	{
 	public:
+		// NOTE: Values are sent as method id by binary requests, so new methods
+		// must be appended.
 		enum class MethodId
 		{
-			DATA_CONSUMER_SEND
+			DATA_CONSUMER_SEND = 1
 		};
 
 	public:
@@ -27,6 +29,7 @@ namespace PayloadChannel
 
 	private:
 		static absl::flat_hash_map<std::string, MethodId> string2MethodId;
+		static absl::flat_hash_map<MethodId, std::string> methodId2String;
 
 	public:
 		PayloadChannelRequest(PayloadChannel::PayloadChannelSocket* channel, char* msg, size_t msgLen);
@@ -39,6 +42,10 @@ namespace PayloadChannel
 		void TypeError(const char* reason = nullptr);
 		void SetPayload(const uint8_t* payload, size_t payloadLen);
 
+	private:
+		void ParseBinary(const char* msg, size_t msgLen);
+		void ParseText(const char* msg, size_t msgLen);
+
 	public:
 		// Passed by argument.
 		PayloadChannel::PayloadChannelSocket* channel{ nullptr };
@@ -50,6 +57,7 @@ namespace PayloadChannel
 		const uint8_t* payload{ nullptr };
 		size_t payloadLen{ 0u };
 		// Others.
+		bool binary{ false };
 		bool replied{ false };
 	};
 } // namespace PayloadChannel
@@ -2,11 +2,13 @@
 #define MS_PAYLOAD_CHANNEL_SOCKET_HPP
 
 #include "common.hpp"
+#include "Channel/BinaryMessage.hpp"
 #include "PayloadChannel/PayloadChannelNotification.hpp"
 #include "PayloadChannel/PayloadChannelRequest.hpp"
 #include "handles/UnixStreamSocket.hpp"
 #include <nlohmann/json.hpp>
 #include <string>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -100,7 +102,22 @@ namespace PayloadChannel
 		void Send(const std::string& message, const uint8_t* payload, size_t payloadLen);
 		void Send(json& jsonMessage);
 		void Send(const std::string& message);
+		void SendBinary(
+		  Channel::BinaryMessage::Type type,
+		  uint32_t id,
+		  const std::string& field1,
+		  const char* field2,
+		  Channel::BinaryMessage::BodyType bodyType,
+		  const char* data,
+		  size_t dataLen,
+		  const uint8_t* payload = nullptr,
+		  size_t payloadLen      = 0u);
 		bool CallbackRead();
+		// Whether the remote side talks the binary protocol.
+		bool IsBinary() const
+		{
+			return this->binary;
+		}
 
 	private:
 		void SendImpl(const uint8_t* message, uint32_t messageLen);
@@ -127,6 +144,8 @@ namespace PayloadChannel
 		PayloadChannel::PayloadChannelRequest* ongoingRequest{ nullptr };
 		uv_async_t* uvReadHandle{ nullptr };
 		uint8_t* writeBuffer{ nullptr };
+		std::vector<uint8_t> binaryBuffer;
+		bool binary{ false };
 	};
 } // namespace PayloadChannel
 
@@ -6,7 +6,6 @@
 #include "handles/Timer.hpp"
 #include <absl/container/flat_hash_map.h>
 #include <nlohmann/json.hpp>
-#include <utility>
 #include <vector>
 
 // Implementation of Dominant Speaker Identification for Multipoint
@@ -23,25 +22,28 @@ namespace RTC
 		{
 		public:
 			Speaker();
-			void EvalActivityScores();
-			double GetActivityScore(uint8_t interval);
 			void LevelChanged(uint32_t level, uint64_t now);
 			void LevelTimedOut(uint64_t now);
-
-		private:
 			bool ComputeImmediates();
 			bool ComputeLongs();
 			bool ComputeMediums();
-			void EvalImmediateActivityScore();
-			void EvalMediumActivityScore();
-			void EvalLongActivityScore();
+			uint8_t GetImmediate() const
+			{
+				return this->immediates[0];
+			}
+			uint8_t GetMedium() const
+			{
+				return this->mediums[0];
+			}
+			uint8_t GetLong() const
+			{
+				return this->longs[0];
+			}
+
+		private:
 			void UpdateMinLevel(int8_t level);
 
 		public:
-			bool paused{ false };
-			double immediateActivityScore{ 0 };
-			double mediumActivityScore{ 0 };
-			double longActivityScore{ 0 };
 			uint64_t lastLevelChangeTime{ 0 };
 
 		private:
@@ -55,19 +57,13 @@ namespace RTC
 			size_t nextLevelIndex{ 0u };
 		};
 
-		class ProducerSpeaker
-		{
-		public:
-			explicit ProducerSpeaker(RTC::Producer* producer);
-			~ProducerSpeaker();
-
-		public:
-			RTC::Producer* producer;
-			Speaker* speaker;
-		};
-
 	private:
-		static const size_t RelativeSpeachActivitiesLen{ 3u };
+		static constexpr size_t NoSpeaker{ SIZE_MAX };
+
+	public:
+		// Logarithm of the activity score of the given number of active subunits
+		// in the immediate (0), medium (1) or long (2) interval (used by tests).
+		static double GetLogActivityScore(uint8_t interval, uint8_t vL);
 
 	public:
 		ActiveSpeakerObserver(
@@ -86,6 +82,7 @@ namespace RTC
 		void Resumed() override;
 		void Update();
 		bool CalculateActiveSpeaker();
+		void EvalActivityScores(size_t idx);
 		void TimeoutIdleLevels(uint64_t now);
 
 		/* Pure virtual methods inherited from Timer. */
@@ -93,12 +90,20 @@ namespace RTC
 		void OnTimer(Timer* timer) override;
 
 	private:
-		double relativeSpeachActivities[RelativeSpeachActivitiesLen];
-		std::string dominantId;
 		Timer* periodicTimer{ nullptr };
 		uint16_t interval{ 300u };
-		// Map of ProducerSpeakers indexed by Producer id.
-		absl::flat_hash_map<std::string, ProducerSpeaker*> mapProducerSpeakers;
+		// Index of each Producer in the arrays below.
+		absl::flat_hash_map<RTC::Producer*, size_t> mapProducerSpeakerIdx;
+		// Speakers are laid out as a structure of arrays so computing the
+		// dominant one just walks contiguous memory. Activity scores are kept as
+		// logarithms so relative activities are just subtractions.
+		std::vector<RTC::Producer*> producers;
+		std::vector<Speaker> speakers;
+		std::vector<uint8_t> paused;
+		std::vector<double> immediateScores;
+		std::vector<double> mediumScores;
+		std::vector<double> longScores;
+		size_t dominantIdx{ NoSpeaker };
 		uint64_t lastLevelIdleTime{ 0u };
 	};
 } // namespace RTC
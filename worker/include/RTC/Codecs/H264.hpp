@@ -41,6 +41,12 @@ namespace RTC
 			  size_t len,
 			  RTC::RtpPacket::FrameMarking* frameMarking = nullptr,
 			  uint8_t frameMarkingLen                    = 0);
+			static bool Parse(
+			  const uint8_t* data,
+			  size_t len,
+			  H264::PayloadDescriptor& payloadDescriptor,
+			  RTC::RtpPacket::FrameMarking* frameMarking = nullptr,
+			  uint8_t frameMarkingLen                    = 0);
 			static void ProcessRtpPacket(RTC::RtpPacket* packet);
 
 		public:
@@ -64,13 +70,13 @@ namespace RTC
 			class PayloadDescriptorHandler : public RTC::Codecs::PayloadDescriptorHandler
 			{
 			public:
-				explicit PayloadDescriptorHandler(PayloadDescriptor* payloadDescriptor);
+				explicit PayloadDescriptorHandler(const PayloadDescriptor& payloadDescriptor);
 				~PayloadDescriptorHandler() = default;
 
 			public:
 				void Dump() const override
 				{
-					this->payloadDescriptor->Dump();
+					this->payloadDescriptor.Dump();
 				}
 				bool Process(RTC::Codecs::EncodingContext* encodingContext, uint8_t* data, bool& marker) override;
 				void Restore(uint8_t* data) override;
@@ -80,15 +86,19 @@ namespace RTC
 				}
 				uint8_t GetTemporalLayer() const override
 				{
-					return this->payloadDescriptor->tid;
+					return this->payloadDescriptor.tid;
 				}
 				bool IsKeyFrame() const override
 				{
-					return this->payloadDescriptor->isKeyFrame;
+					return this->payloadDescriptor.isKeyFrame;
+				}
+				PayloadDescriptorHandler* CloneInto(uint8_t* storage) const override
+				{
+					return new (storage) PayloadDescriptorHandler(*this);
 				}
 
 			private:
-				std::unique_ptr<PayloadDescriptor> payloadDescriptor;
+				PayloadDescriptor payloadDescriptor;
 			};
 		};
 	} // namespace Codecs
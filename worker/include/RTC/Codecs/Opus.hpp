@@ -26,6 +26,7 @@ namespace RTC
 
 		public:
 			static Opus::PayloadDescriptor* Parse(const uint8_t* data, size_t len);
+			static bool Parse(const uint8_t* data, size_t len, Opus::PayloadDescriptor& payloadDescriptor);
 			static void ProcessRtpPacket(RTC::RtpPacket* packet);
 
 		public:
@@ -53,13 +54,13 @@ namespace RTC
 			class PayloadDescriptorHandler : public RTC::Codecs::PayloadDescriptorHandler
 			{
 			public:
-				explicit PayloadDescriptorHandler(PayloadDescriptor* payloadDescriptor);
+				explicit PayloadDescriptorHandler(const PayloadDescriptor& payloadDescriptor);
 				~PayloadDescriptorHandler() = default;
 
 			public:
 				void Dump() const override
 				{
-					this->payloadDescriptor->Dump();
+					this->payloadDescriptor.Dump();
 				}
 				bool Process(RTC::Codecs::EncodingContext* encodingContext, uint8_t* data, bool& marker) override;
 				void Restore(uint8_t* data) override
@@ -78,9 +79,13 @@ namespace RTC
 				{
 					return false;
 				}
+				PayloadDescriptorHandler* CloneInto(uint8_t* storage) const override
+				{
+					return new (storage) PayloadDescriptorHandler(*this);
+				}
 
 			private:
-				std::unique_ptr<PayloadDescriptor> payloadDescriptor;
+				PayloadDescriptor payloadDescriptor;
 			};
 		};
 	} // namespace Codecs
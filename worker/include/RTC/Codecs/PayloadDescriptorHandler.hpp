@@ -108,6 +108,9 @@ namespace RTC
 			virtual uint8_t GetSpatialLayer() const                                                  = 0;
 			virtual uint8_t GetTemporalLayer() const                                                 = 0;
 			virtual bool IsKeyFrame() const                                                          = 0;
+
+			// Copy this handler into the given storage (placement new) and return it.
+			virtual PayloadDescriptorHandler* CloneInto(uint8_t* storage) const = 0;
 		};
 	} // namespace Codecs
 } // namespace RTC
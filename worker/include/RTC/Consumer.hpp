@@ -16,6 +16,7 @@
 #include "RTC/RtpStream.hpp"
 #include "RTC/RtpStreamSend.hpp"
 #include "RTC/Shared.hpp"
+#include "RTC/StatsStreamer.hpp"
 #include <absl/container/flat_hash_set.h>
 #include <nlohmann/json.hpp>
 #include <string>
@@ -25,7 +26,7 @@ using json = nlohmann::json;
 
 namespace RTC
 {
-	class Consumer : public Channel::ChannelSocket::RequestHandler
+	class Consumer : public Channel::ChannelSocket::RequestHandler, public RTC::StatsStreamer::Source
 	{
 	public:
 		class Listener
@@ -71,8 +72,9 @@ namespace RTC
 
 	public:
 		virtual void FillJson(json& jsonObject) const;
-		virtual void FillJsonStats(json& jsonArray) const  = 0;
-		virtual void FillJsonScore(json& jsonObject) const = 0;
+		virtual void FillJsonStats(json& jsonArray) const                         = 0;
+		virtual void FillBinaryStats(Channel::BinaryBody::Writer& writer) const = 0;
+		virtual void FillJsonScore(json& jsonObject) const                        = 0;
 		RTC::Media::Kind GetKind() const
 		{
 			return this->kind;
@@ -144,7 +146,13 @@ namespace RTC
 		virtual uint32_t IncreaseLayer(uint32_t bitrate, bool considerLoss) = 0;
 		virtual void ApplyLayers()                                          = 0;
 		virtual uint32_t GetDesiredBitrate() const                          = 0;
-		virtual void SendRtpPacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket) = 0;
+		virtual void SendRtpPacket(RTC::RtpPacket* packet, RTC::RtpPacket::SharedPtr& sharedPacket) = 0;
+		// Whether nothing has been sent yet and a key frame is awaited for the given
+		// stream, so the Consumer can be started with the packets of a cached one.
+		virtual bool NeedsKeyFrameToStart(uint32_t /*mappedSsrc*/) const
+		{
+			return false;
+		}
 		virtual bool GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t nowMs) = 0;
 		virtual const std::vector<RTC::RtpStreamSend*>& GetRtpStreams() const   = 0;
 		virtual void NeedWorstRemoteFractionLost(uint32_t mappedSsrc, uint8_t& worstRemoteFractionLost) = 0;
@@ -160,6 +168,10 @@ namespace RTC
 	public:
 		void HandleRequest(Channel::ChannelRequest* request) override;
 
+		/* Pure virtual methods inherited from RTC::StatsStreamer::Source. */
+	public:
+		void FillStatsStream(uint64_t nowMs, RTC::StatsStreamer* statsStreamer) override;
+
 	protected:
 		void EmitTraceEventRtpAndKeyFrameTypes(RTC::RtpPacket* packet, bool isRtx = false) const;
 		void EmitTraceEventKeyFrameType(RTC::RtpPacket* packet, bool isRtx = false) const;
@@ -197,6 +209,11 @@ namespace RTC
 		bool externallyManagedBitrate{ false };
 		uint8_t priority{ 1u };
 		struct TraceEventTypes traceEventTypes;
+		// Handle in RTP traces.
+		RtcLogger::ObjectHandle traceHandle{ this->id };
+		// Header rewrite attached to packets being sent. Its MID is compiled from
+		// rtpParameters once, the rest is set for every packet.
+		RTC::RtpPacket::RewritePlan rewritePlan;
 
 	private:
 		// Others.
@@ -60,6 +60,7 @@ namespace RTC
 	public:
 		void FillJson(json& jsonObject) const;
 		void FillJsonStats(json& jsonArray) const;
+		void FillBinaryStats(Channel::BinaryBody::Writer& writer) const;
 		Type GetType() const
 		{
 			return this->type;
@@ -16,6 +16,7 @@ namespace RTC
 	public:
 		void FillJson(json& jsonObject) const override;
 		void FillJsonStats(json& jsonArray) override;
+		void FillBinaryStats(Channel::BinaryBody::Writer& writer) override;
 
 	private:
 		bool IsConnected() const override;
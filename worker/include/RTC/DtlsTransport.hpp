@@ -7,7 +7,9 @@
 #include <openssl/bio.h>
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
+#include <uv.h>
 #include <absl/container/flat_hash_map.h>
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -59,6 +61,28 @@ namespace RTC
 			const char* name;
 		};
 
+	public:
+		// Processing of a received DTLS datagram during the handshake in the
+		// libuv thread pool. While it runs the SSL instance belongs to it and
+		// nothing else touches it.
+		struct HandshakeJob
+		{
+			uv_work_t uvWork;
+			// Set to nullptr if the DtlsTransport is closed or reset meanwhile, in
+			// which case the job owns the SSL instance.
+			DtlsTransport* dtlsTransport{ nullptr };
+			SSL* ssl{ nullptr };
+			// Received datagram.
+			std::vector<uint8_t> data;
+			// Results.
+			int read{ 0 };
+			int err{ SSL_ERROR_NONE };
+			bool handshakeDone{ false };
+			std::vector<uint8_t> readData;
+			std::vector<uint8_t> outgoingData;
+			std::vector<std::string> errors;
+		};
+
 	public:
 		class Listener
 		{
@@ -174,6 +198,7 @@ namespace RTC
 		void SendApplicationData(const uint8_t* data, size_t len);
 
 	private:
+		void CreateSsl();
 		bool IsRunning() const
 		{
 			switch (this->state)
@@ -193,6 +218,10 @@ namespace RTC
 		}
 		void Reset();
 		bool CheckStatus(int returnCode);
+		bool CheckSslError(int err);
+		void ProcessSslRead(int read, int err, const uint8_t* readData);
+		bool StartHandshakeJob(const uint8_t* data, size_t len);
+		void DetachHandshakeJob();
 		void SendPendingOutgoingDtlsData();
 		bool SetTimeout();
 		bool ProcessHandshake();
@@ -204,6 +233,10 @@ namespace RTC
 	public:
 		void OnSslInfo(int where, int ret);
 
+		/* Callbacks fired by UV events. */
+	public:
+		void OnHandshakeJobDone(HandshakeJob* job);
+
 		/* Pure virtual methods inherited from Timer::Listener. */
 	public:
 		void OnTimer(Timer* timer) override;
@@ -223,6 +256,9 @@ namespace RTC
 		bool handshakeDone{ false };
 		bool handshakeDoneNow{ false };
 		std::string remoteCert;
+		HandshakeJob* handshakeJob{ nullptr };
+		// DTLS datagrams received while a HandshakeJob is running.
+		std::deque<std::vector<uint8_t>> pendingDtlsData;
 	};
 } // namespace RTC
 
@@ -0,0 +1,132 @@
+#ifndef MS_RTC_EGRESS_PACER_HPP
+#define MS_RTC_EGRESS_PACER_HPP
+
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "handles/Timer.hpp"
+#include <deque>
+#include <vector>
+
+namespace RTC
+{
+	// Avoid cyclic #include problem by declaring classes instead of including
+	// the corresponding header files.
+	class Consumer;
+
+	// Paces the RTP packets sent by a Transport according to its estimated
+	// available bitrate (token bucket). Packets that cannot be sent yet are
+	// copied and sent later in priority order. All pacers in the thread share a
+	// single timer which is just running while some pacer has queued packets.
+	class EgressPacer
+	{
+	public:
+		// Ordered by priority, higher first.
+		enum class Priority : uint8_t
+		{
+			AUDIO = 0,
+			RETRANSMISSION,
+			VIDEO,
+			PROBATION
+		};
+
+	public:
+		class Listener
+		{
+		public:
+			virtual ~Listener() = default;
+
+		public:
+			virtual void OnEgressPacerSendRtpPacket(
+			  RTC::EgressPacer* egressPacer,
+			  RTC::Consumer* consumer,
+			  RTC::RtpPacket* packet,
+			  Priority priority) = 0;
+		};
+
+	private:
+		class Scheduler : public Timer::Listener
+		{
+		public:
+			Scheduler();
+			~Scheduler() override;
+
+		public:
+			void Add(EgressPacer* egressPacer);
+			void Remove(EgressPacer* egressPacer);
+
+			/* Pure virtual methods inherited from Timer::Listener. */
+		public:
+			void OnTimer(Timer* timer) override;
+
+		public:
+			size_t numPacers{ 0u };
+
+		private:
+			// Allocated by this.
+			Timer* timer{ nullptr };
+			// Others.
+			std::vector<EgressPacer*> activePacers;
+		};
+
+	private:
+		struct Item
+		{
+			RTC::Consumer* consumer{ nullptr };
+			RTC::RtpPacket* packet{ nullptr };
+			bool hasRewritePlan{ false };
+			RTC::RtpPacket::RewritePlan rewritePlan;
+			uint64_t enqueuedAtMs{ 0u };
+		};
+
+	public:
+		static constexpr uint64_t ProcessIntervalMs{ 5u };
+		// Max budget accumulated while idle, so bursts are limited to this
+		// interval worth of data.
+		static constexpr uint64_t MaxBurstMs{ 10u };
+		// Queued packets older than this are sent regardless of the budget.
+		static constexpr uint64_t MaxQueueDelayMs{ 500u };
+		// Pacing bitrate is the available bitrate times this factor so the queue
+		// is drained faster than it gets filled.
+		static constexpr float PacingFactor{ 1.5f };
+
+	private:
+		thread_local static Scheduler* scheduler;
+
+	public:
+		explicit EgressPacer(Listener* listener);
+		~EgressPacer();
+
+	public:
+		void SetBitrate(uint32_t availableBitrate);
+		// Returns true if the packet has been queued (so it must not be sent
+		// now). In that case the listener will be given a copy of the packet
+		// once it can be sent.
+		bool Enqueue(RTC::Consumer* consumer, RTC::RtpPacket* packet, Priority priority);
+		// Returns true if a probation packet can be sent now. Probation packets
+		// are never queued but just sent while no other packet is waiting.
+		bool MaySendProbation(RTC::RtpPacket* packet);
+		// Drop queued packets of the given Consumer.
+		void RemoveConsumer(RTC::Consumer* consumer);
+		size_t GetQueueSize() const
+		{
+			return this->queueSize;
+		}
+
+	private:
+		void Refill(uint64_t nowMs);
+		void Process(uint64_t nowMs);
+		void Clear();
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		// Others.
+		std::deque<Item> queues[3];
+		size_t queueSize{ 0u };
+		uint32_t bitrate{ 0u };
+		int64_t budget{ 0 };
+		uint64_t lastRefillMs{ 0u };
+	};
+} // namespace RTC
+
+#endif
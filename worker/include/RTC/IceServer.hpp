@@ -59,7 +59,7 @@ namespace RTC
 		}
 		const std::string& GetPassword() const
 		{
-			return this->password;
+			return this->password.GetKey();
 		}
 		IceState GetState() const
 		{
@@ -79,8 +79,8 @@ namespace RTC
 			this->oldUsernameFragment = this->usernameFragment;
 			this->usernameFragment    = usernameFragment;
 
-			this->oldPassword = this->password;
-			this->password    = password;
+			this->oldPassword.SetKey(this->password.GetKey());
+			this->password.SetKey(password);
 
 			this->remoteNomination = 0u;
 
@@ -119,9 +119,12 @@ namespace RTC
 		Listener* listener{ nullptr };
 		// Others.
 		std::string usernameFragment;
-		std::string password;
+		// Passwords are kept along with their HMAC-SHA1 key schedule so checking
+		// and authenticating STUN messages (ICE consent checks) do not compute
+		// it every time.
+		Utils::Crypto::HmacSha1Key password;
 		std::string oldUsernameFragment;
-		std::string oldPassword;
+		Utils::Crypto::HmacSha1Key oldPassword;
 		uint32_t remoteNomination{ 0u };
 		IceState state{ IceState::NEW };
 		std::list<RTC::TransportTuple> tuples;
@@ -0,0 +1,92 @@
+#ifndef MS_RTC_IN_PROCESS_PIPE_HPP
+#define MS_RTC_IN_PROCESS_PIPE_HPP
+
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <uv.h>
+#include <memory>
+#include <string>
+
+namespace RTC
+{
+	// Exchanges datagrams between two PipeTransports living in different Worker
+	// threads of the same process without sockets, syscalls or SRTP.
+	//
+	// Each side registers an inbox under the address it announces to the remote
+	// PipeTransport and, once connected, writes into the inbox registered under
+	// the remote address. Inboxes are lock-free SPSC rings of slots that are
+	// handed back to the sender once the receiver is done with them. RTP packets
+	// are cloned into the slot, so the receiver gets them already parsed.
+	class InProcessPipe
+	{
+	public:
+		class Listener
+		{
+		public:
+			virtual ~Listener() = default;
+
+		public:
+			virtual void OnInProcessPipeDataReceived(
+			  RTC::InProcessPipe* inProcessPipe, const uint8_t* data, size_t len) = 0;
+			// The packet is destroyed once this returns, so it must not be deleted.
+			virtual void OnInProcessPipeRtpPacketReceived(
+			  RTC::InProcessPipe* inProcessPipe, RTC::RtpPacket* packet) = 0;
+		};
+
+	public:
+		// Defined in the translation unit.
+		class Inbox;
+		struct Slot;
+
+	public:
+		// Max size of a datagram sent through the pipe. Buffers have extra room
+		// since received RTP packets may grow in place.
+		static constexpr size_t MaxDataSize{ RTC::MtuSize };
+		static constexpr size_t BufferSize{ RTC::MtuSize + 100u };
+		static constexpr size_t InboxCapacity{ 1024u };
+
+	public:
+		InProcessPipe(Listener* listener, const std::string& localIp, uint16_t localPort);
+		~InProcessPipe();
+
+	public:
+		// Attach to the inbox of the remote PipeTransport. Returns false if there
+		// is no such inbox in this process so the caller must use UDP.
+		bool Connect(const std::string& remoteIp, uint16_t remotePort);
+		bool IsConnected() const
+		{
+			return this->remoteInbox != nullptr;
+		}
+		// Return false if data could not be handed to the remote inbox. If the
+		// remote inbox has been closed the pipe attaches to the one registered
+		// again under the remote address, if any, or gets disconnected.
+		bool Send(const uint8_t* data, size_t len);
+		bool Send(const RTC::RtpPacket* packet);
+
+	private:
+		bool Attach();
+		bool CheckRemoteInbox();
+		Slot* GetSlot();
+		bool Push(Slot* slot, size_t len, RTC::RtpPacket* packet);
+
+		/* Callbacks fired by UV events. */
+	public:
+		void OnUvAsync();
+		void OnUvCheck();
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		// Allocated by this.
+		uv_async_t* uvAsyncHandle{ nullptr };
+		uv_check_t* uvCheckHandle{ nullptr };
+		// Others.
+		std::string localKey;
+		std::string remoteKey;
+		std::shared_ptr<Inbox> localInbox;
+		std::shared_ptr<Inbox> remoteInbox;
+		bool wakePending{ false };
+	};
+} // namespace RTC
+
+#endif
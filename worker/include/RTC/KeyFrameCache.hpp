@@ -0,0 +1,50 @@
+#ifndef MS_RTC_KEY_FRAME_CACHE_HPP
+#define MS_RTC_KEY_FRAME_CACHE_HPP
+
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <absl/container/flat_hash_map.h>
+#include <vector>
+
+namespace RTC
+{
+	// Keeps, for each (mapped) SSRC of a Producer, the packets since its most
+	// recent key frame so a new Consumer can be started with them instead of
+	// asking the sender for a new key frame. Packets are shared with the
+	// retransmission buffers of the Consumers, so caching them does not copy
+	// anything but the first clone.
+	//
+	// A stream is not provided once its cached packets have a gap (a lost
+	// packet not recovered yet), when there are too many of them (the sender
+	// uses long GOPs) or when the stream is not flowing anymore.
+	class KeyFrameCache
+	{
+	public:
+		static constexpr size_t MaxPackets{ 1000u };
+		static constexpr uint64_t MaxIdleMs{ 1000u };
+
+	private:
+		struct Stream
+		{
+			// Indexed by seq number from the first packet of the key frame.
+			std::vector<RTC::RtpPacket::SharedPtr> packets;
+			size_t numPackets{ 0u };
+			uint16_t firstSeq{ 0u };
+			uint32_t timestamp{ 0u };
+			uint64_t lastPacketAtMs{ 0u };
+			// Whether MaxPackets was exceeded since the last key frame.
+			bool overflow{ false };
+		};
+
+	public:
+		void Insert(RTC::RtpPacket* packet, RTC::RtpPacket::SharedPtr& sharedPacket);
+		// Returns nullptr if there is nothing complete to be provided.
+		const std::vector<RTC::RtpPacket::SharedPtr>* Get(uint32_t ssrc) const;
+		void Clear();
+
+	private:
+		absl::flat_hash_map<uint32_t, Stream> mapSsrcStream;
+	};
+} // namespace RTC
+
+#endif
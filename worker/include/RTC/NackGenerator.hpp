@@ -5,14 +5,18 @@
 #include "RTC/RtpPacket.hpp"
 #include "RTC/SeqManager.hpp"
 #include "handles/Timer.hpp"
-#include <absl/container/btree_map.h>
-#include <absl/container/btree_set.h>
-#include <map>
-#include <set>
 #include <vector>
 
 namespace RTC
 {
+	// Lost, key frame and recovered packets are tracked in bitmaps indexed by
+	// sequence number within a sliding window of `WindowSize` packets, so
+	// marking a gap, recovering a packet or building a NACK batch are word
+	// level operations. Per lost packet state is kept in compact per slot
+	// arrays.
+	//
+	// The window covers `MaxPacketAge` packets up to the last seen seq, plus
+	// the rest for recovered (RTX) packets newer than it.
 	class NackGenerator : public Timer::Listener
 	{
 	public:
@@ -26,22 +30,14 @@ namespace RTC
 			virtual void OnNackGeneratorKeyFrameRequired()                                    = 0;
 		};
 
-	private:
-		struct NackInfo
-		{
-			NackInfo() = default;
-			explicit NackInfo(uint64_t createdAtMs, uint16_t seq, uint16_t sendAtSeq)
-			  : createdAtMs(createdAtMs), seq(seq), sendAtSeq(sendAtSeq)
-			{
-			}
+	public:
+		static constexpr size_t WindowSize{ 4096u };
+		static constexpr size_t MaxPacketAge{ 3072u };
 
-			uint64_t createdAtMs{ 0u };
-			uint16_t seq{ 0u };
-			uint16_t sendAtSeq{ 0u };
-			uint64_t sentAtMs{ 0u };
-			uint8_t retries{ 0u };
-		};
+	private:
+		static constexpr size_t WindowWords{ WindowSize / 64u };
 
+	private:
 		enum class NackFilter
 		{
 			SEQ,
@@ -53,9 +49,14 @@ namespace RTC
 		~NackGenerator() override;
 
 		bool ReceivePacket(RTC::RtpPacket* packet, bool isRecovered);
+		// Same as above with the current time given (used by tests).
+		bool ReceivePacket(RTC::RtpPacket* packet, bool isRecovered, uint64_t nowMs);
+		// NACKs again the packets not received within a RTT since their last
+		// NACK. Called by the timer.
+		void NackTimedOutPackets(uint64_t nowMs);
 		size_t GetNackListLength() const
 		{
-			return this->nackList.size();
+			return this->nackListLength;
 		}
 		void UpdateRtt(uint32_t rtt)
 		{
@@ -64,10 +65,28 @@ namespace RTC
 		void Reset();
 
 	private:
-		void AddPacketsToNackList(uint16_t seqStart, uint16_t seqEnd);
+		void AddPacketsToNackList(uint16_t seqStart, uint16_t seqEnd, uint64_t nowMs);
 		bool RemoveNackItemsUntilKeyFrame();
-		std::vector<uint16_t> GetNackBatch(NackFilter filter);
+		std::vector<uint16_t> GetNackBatch(NackFilter filter, uint64_t nowMs);
 		void MayRunTimer() const;
+		bool IsInWindow(uint16_t seq) const
+		{
+			return static_cast<uint16_t>(this->lastSeq - seq) < MaxPacketAge;
+		}
+		static size_t GetSlot(uint16_t seq)
+		{
+			return seq & (WindowSize - 1);
+		}
+		static bool IsSet(const uint64_t* bitmap, uint16_t seq)
+		{
+			return (bitmap[GetSlot(seq) / 64u] >> (GetSlot(seq) % 64u)) & 1u;
+		}
+		static void Set(uint64_t* bitmap, uint16_t seq)
+		{
+			bitmap[GetSlot(seq) / 64u] |= uint64_t{ 1u } << (GetSlot(seq) % 64u);
+		}
+		static size_t Clear(uint64_t* bitmap, uint16_t seq, size_t count);
+		static size_t FindFirst(const uint64_t* bitmap, uint16_t seq, size_t count);
 
 		/* Pure virtual methods inherited from Timer::Listener. */
 	public:
@@ -80,9 +99,15 @@ namespace RTC
 		// Allocated by this.
 		Timer* timer{ nullptr };
 		// Others.
-		absl::btree_map<uint16_t, NackInfo, RTC::SeqManager<uint16_t>::SeqLowerThan> nackList;
-		absl::btree_set<uint16_t, RTC::SeqManager<uint16_t>::SeqLowerThan> keyFrameList;
-		absl::btree_set<uint16_t, RTC::SeqManager<uint16_t>::SeqLowerThan> recoveredList;
+		uint64_t nackList[WindowWords]{};
+		uint64_t keyFrameList[WindowWords]{};
+		uint64_t recoveredList[WindowWords]{};
+		size_t nackListLength{ 0u };
+		// Per slot state of lost packets. Times are truncated to 16 bits since
+		// just short intervals (NACK delay and RTT) are measured with them.
+		uint16_t createdAtMs[WindowSize];
+		uint16_t sentAtMs[WindowSize];
+		uint8_t retries[WindowSize];
 		bool started{ false };
 		uint16_t lastSeq{ 0u }; // Seq number of last valid packet.
 		uint32_t rtt{ 0u };     // Round trip time (ms).
@@ -1,6 +1,7 @@
 #ifndef MS_RTC_PIPE_TRANSPORT_HPP
 #define MS_RTC_PIPE_TRANSPORT_HPP
 
+#include "RTC/InProcessPipe.hpp"
 #include "RTC/Shared.hpp"
 #include "RTC/SrtpSession.hpp"
 #include "RTC/Transport.hpp"
@@ -9,7 +10,9 @@
 
 namespace RTC
 {
-	class PipeTransport : public RTC::Transport, public RTC::UdpSocket::Listener
+	class PipeTransport : public RTC::Transport,
+	                      public RTC::UdpSocket::Listener,
+	                      public RTC::InProcessPipe::Listener
 	{
 	private:
 		struct ListenIp
@@ -31,6 +34,7 @@ namespace RTC
 	public:
 		void FillJson(json& jsonObject) const override;
 		void FillJsonStats(json& jsonArray) override;
+		void FillBinaryStats(Channel::BinaryBody::Writer& writer) override;
 
 		/* Methods inherited from Channel::ChannelSocket::RequestHandler. */
 	public:
@@ -68,12 +72,20 @@ namespace RTC
 		void OnUdpSocketPacketReceived(
 		  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr) override;
 
+		/* Pure virtual methods inherited from RTC::InProcessPipe::Listener. */
+	public:
+		void OnInProcessPipeDataReceived(
+		  RTC::InProcessPipe* inProcessPipe, const uint8_t* data, size_t len) override;
+		void OnInProcessPipeRtpPacketReceived(
+		  RTC::InProcessPipe* inProcessPipe, RTC::RtpPacket* packet) override;
+
 	private:
 		// Allocated by this.
 		RTC::UdpSocket* udpSocket{ nullptr };
 		RTC::TransportTuple* tuple{ nullptr };
 		RTC::SrtpSession* srtpRecvSession{ nullptr };
 		RTC::SrtpSession* srtpSendSession{ nullptr };
+		RTC::InProcessPipe* inProcessPipe{ nullptr };
 		// Others.
 		ListenIp listenIp;
 		struct sockaddr_storage remoteAddrStorage;
@@ -31,6 +31,7 @@ namespace RTC
 	public:
 		void FillJson(json& jsonObject) const override;
 		void FillJsonStats(json& jsonArray) override;
+		void FillBinaryStats(Channel::BinaryBody::Writer& writer) override;
 
 		/* Methods inherited from Channel::ChannelSocket::RequestHandler. */
 	public:
@@ -29,6 +29,23 @@ namespace RTC
 		{
 			return reinterpret_cast<uv_udp_t*>(Bind(Transport::UDP, ip, port));
 		}
+		/**
+		 * Bind with SO_REUSEPORT (and SO_REUSEADDR) so other workers (or sockets)
+		 * can bind the same IP and port.
+		 */
+		static uv_udp_t* BindUdpReusePort(std::string& ip, uint16_t port)
+		{
+			return reinterpret_cast<uv_udp_t*>(
+			  Bind(Transport::UDP, ip, port, /*reusePort*/ true, /*reuseAddr*/ true));
+		}
+		/**
+		 * Bind with SO_REUSEADDR and connect to the given remote address, so
+		 * the kernel delivers datagrams from it to this socket rather than to
+		 * the unconnected ones sharing the IP and port. Without SO_REUSEPORT it
+		 * does not join their group, so it does not change the indexes of the
+		 * sockets in it.
+		 */
+		static uv_udp_t* ConnectUdp(std::string& ip, uint16_t port, const struct sockaddr* remoteAddr);
 		static uv_tcp_t* BindTcp(std::string& ip)
 		{
 			return reinterpret_cast<uv_tcp_t*>(Bind(Transport::TCP, ip));
@@ -49,7 +66,12 @@ namespace RTC
 
 	private:
 		static uv_handle_t* Bind(Transport transport, std::string& ip);
-		static uv_handle_t* Bind(Transport transport, std::string& ip, uint16_t port);
+		static uv_handle_t* Bind(
+		  Transport transport,
+		  std::string& ip,
+		  uint16_t port,
+		  bool reusePort = false,
+		  bool reuseAddr = false);
 		static void Unbind(Transport transport, std::string& ip, uint16_t port);
 		static std::vector<bool>& GetPorts(Transport transport, const std::string& ip);
 
@@ -5,6 +5,7 @@
 #include "Channel/ChannelRequest.hpp"
 #include "Channel/ChannelSocket.hpp"
 #include "PayloadChannel/PayloadChannelSocket.hpp"
+#include "RTC/KeyFrameCache.hpp"
 #include "RTC/KeyFrameRequestManager.hpp"
 #include "RTC/RTCP/CompoundPacket.hpp"
 #include "RTC/RTCP/Packet.hpp"
@@ -15,6 +16,7 @@
 #include "RTC/RtpPacket.hpp"
 #include "RTC/RtpStreamRecv.hpp"
 #include "RTC/Shared.hpp"
+#include "RTC/StatsStreamer.hpp"
 #include <nlohmann/json.hpp>
 #include <string>
 #include <vector>
@@ -26,7 +28,8 @@ namespace RTC
 	class Producer : public RTC::RtpStreamRecv::Listener,
 	                 public RTC::KeyFrameRequestManager::Listener,
 	                 public Channel::ChannelSocket::RequestHandler,
-	                 public PayloadChannel::PayloadChannelSocket::NotificationHandler
+	                 public PayloadChannel::PayloadChannelSocket::NotificationHandler,
+	                 public RTC::StatsStreamer::Source
 	{
 	public:
 		class Listener
@@ -99,6 +102,7 @@ namespace RTC
 	public:
 		void FillJson(json& jsonObject) const;
 		void FillJsonStats(json& jsonArray) const;
+		void FillBinaryStats(Channel::BinaryBody::Writer& writer) const;
 		RTC::Media::Kind GetKind() const
 		{
 			return this->kind;
@@ -132,6 +136,10 @@ namespace RTC
 		void ReceiveRtcpXrDelaySinceLastRr(RTC::RTCP::DelaySinceLastRr::SsrcInfo* ssrcInfo);
 		bool GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t nowMs);
 		void RequestKeyFrame(uint32_t mappedSsrc);
+		RTC::KeyFrameCache* GetKeyFrameCache() const
+		{
+			return this->keyFrameCache;
+		}
 
 		/* Methods inherited from Channel::ChannelSocket::RequestHandler. */
 	public:
@@ -167,6 +175,10 @@ namespace RTC
 	public:
 		void OnKeyFrameNeeded(RTC::KeyFrameRequestManager* keyFrameRequestManager, uint32_t ssrc) override;
 
+		/* Pure virtual methods inherited from RTC::StatsStreamer::Source. */
+	public:
+		void FillStatsStream(uint64_t nowMs, RTC::StatsStreamer* statsStreamer) override;
+
 	public:
 		// Passed by argument.
 		const std::string id;
@@ -178,6 +190,7 @@ namespace RTC
 		// Allocated by this.
 		absl::flat_hash_map<uint32_t, RTC::RtpStreamRecv*> mapSsrcRtpStream;
 		RTC::KeyFrameRequestManager* keyFrameRequestManager{ nullptr };
+		RTC::KeyFrameCache* keyFrameCache{ nullptr };
 		// Others.
 		RTC::Media::Kind kind;
 		RTC::RtpParameters rtpParameters;
@@ -198,6 +211,8 @@ namespace RTC
 		bool videoOrientationDetected{ false };
 		struct VideoOrientation videoOrientation;
 		struct TraceEventTypes traceEventTypes;
+		// Handle in RTP traces.
+		RtcLogger::ObjectHandle traceHandle{ this->id };
 		// Static buffer.
 		thread_local static uint8_t* buffer;
 	};
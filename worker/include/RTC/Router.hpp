@@ -45,6 +45,7 @@ namespace RTC
 
 	public:
 		void FillJson(json& jsonObject) const;
+		void FillBinary(Channel::BinaryBody::Writer& writer) const;
 
 		/* Methods inherited from Channel::ChannelSocket::RequestHandler. */
 	public:
@@ -129,6 +130,8 @@ namespace RTC
 		  mapDataProducerDataConsumers;
 		absl::flat_hash_map<RTC::DataConsumer*, RTC::DataProducer*> mapDataConsumerDataProducer;
 		absl::flat_hash_map<std::string, RTC::DataProducer*> mapDataProducers;
+		// Handle in RTP traces.
+		RtcLogger::ObjectHandle traceHandle{ this->id };
 	};
 } // namespace RTC
 
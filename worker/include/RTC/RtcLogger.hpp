@@ -3,11 +3,33 @@
 
 #include "common.hpp"
 #include <absl/container/flat_hash_map.h>
+#include <nlohmann/json.hpp>
+#include <deque>
+#include <string>
+#include <utility> // std::pair
+#include <vector>
+
+using json = nlohmann::json;
 
 namespace RTC
 {
 	namespace RtcLogger
 	{
+		// Integer handle of an object (Router, Transport, Producer or Consumer)
+		// in RTP traces, so packets refer to it without copying its id. The id
+		// is registered for as long as the object lives.
+		class ObjectHandle
+		{
+		public:
+			explicit ObjectHandle(const std::string& id);
+			~ObjectHandle();
+			ObjectHandle(const ObjectHandle&)            = delete;
+			ObjectHandle& operator=(const ObjectHandle&) = delete;
+
+		public:
+			const uint32_t value;
+		};
+
 		class RtpPacket
 		{
 		public:
@@ -28,6 +50,11 @@ namespace RTC
 				SEND_RTP_STREAM_DISCARDED,
 			};
 
+			// Must be updated when adding a DropReason.
+			static constexpr size_t NumDropReasons{
+				static_cast<size_t>(DropReason::SEND_RTP_STREAM_DISCARDED) + 1u
+			};
+
 			static absl::flat_hash_map<DropReason, std::string> dropReason2String;
 
 			RtpPacket()  = default;
@@ -41,11 +68,12 @@ namespace RTC
 
 		public:
 			uint64_t timestamp;
-			std::string recvTransportId{};
-			std::string sendTransportId{};
-			std::string routerId{};
-			std::string producerId{};
-			std::string consumerId{};
+			uint32_t recvTransportHandle{ 0u };
+			uint32_t sendTransportHandle{ 0u };
+			uint32_t routerHandle{ 0u };
+			uint32_t producerHandle{ 0u };
+			uint32_t consumerHandle{ 0u };
+			uint32_t recvSsrc;
 			uint32_t recvRtpTimestamp;
 			uint32_t sendRtpTimestamp;
 			uint16_t recvSeqNumber;
@@ -53,6 +81,69 @@ namespace RTC
 			bool dropped;
 			DropReason dropReason{ DropReason::NONE };
 		};
+
+		// Per worker ring of fixed size binary records, one per sent or dropped
+		// RTP packet, so packets can be traced in production without formatting
+		// anything. It is disabled (and costs a branch per packet) unless the
+		// rtpTraceSize setting is given, and it is retrieved on demand through
+		// the channel along with the ids of the registered object handles.
+		class TraceRing
+		{
+		public:
+			static constexpr uint8_t Version{ 1u };
+			// So a full dump fits into a channel message.
+			static constexpr size_t MaxCapacity{ 32768u };
+
+		public:
+			// NOTE: This layout is part of the dump format, so any change must
+			// increase Version. Integers are in host byte order and handle 0
+			// means none.
+			struct Record
+			{
+				uint64_t timestamp;
+				uint32_t recvTransportHandle;
+				uint32_t sendTransportHandle;
+				uint32_t routerHandle;
+				uint32_t producerHandle;
+				uint32_t consumerHandle;
+				uint32_t recvSsrc;
+				uint32_t recvRtpTimestamp;
+				uint32_t sendRtpTimestamp;
+				uint16_t recvSeqNumber;
+				uint16_t sendSeqNumber;
+				uint8_t dropped;
+				uint8_t dropReason;
+				uint8_t reserved[2];
+			};
+
+			static_assert(sizeof(Record) == 48u, "unexpected RtcLogger::TraceRing::Record size");
+
+		public:
+			static void SetCapacity(size_t capacity);
+			static bool IsEnabled()
+			{
+				return !TraceRing::records.empty();
+			}
+			static void Write(const RtpPacket& packet);
+			static void FillJson(json& jsonObject);
+			static uint32_t RegisterObject(const std::string& id);
+			static void UnregisterObject(uint32_t handle);
+			static const std::string* GetObjectId(uint32_t handle);
+
+		private:
+			static void PruneUnregisteredObjects();
+
+		private:
+			thread_local static std::vector<Record> records;
+			thread_local static size_t position;
+			thread_local static uint64_t numWritten;
+			thread_local static uint32_t nextObjectHandle;
+			thread_local static absl::flat_hash_map<uint32_t, std::string> mapHandleObjectId;
+			// Handles of unregistered objects whose ids are kept in mapHandleObjectId
+			// while records may still refer to them, along with numWritten at the
+			// time they were unregistered (oldest first).
+			thread_local static std::deque<std::pair<uint32_t, uint64_t>> unregisteredObjects;
+		};
 	}; // namespace RtcLogger
 } // namespace RTC
 #endif
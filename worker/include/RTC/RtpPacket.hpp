@@ -7,8 +7,11 @@
 #include "RTC/RtcLogger.hpp"
 #include <absl/container/flat_hash_map.h>
 #include <array>
+#include <cstddef> // std::max_align_t
 #include <nlohmann/json.hpp>
+#include <new>     // placement new
 #include <string>
+#include <utility> // std::forward(), std::swap()
 #include <vector>
 
 using json = nlohmann::json;
@@ -20,6 +23,9 @@ namespace RTC
 	// MID header extension max length (just used when setting/updating MID
 	// extension).
 	constexpr uint8_t MidMaxLength{ 8u };
+	// Size of the in-place storage of the payload descriptor handler of a
+	// packet. It must fit the biggest codec PayloadDescriptorHandler.
+	constexpr size_t PayloadDescriptorHandlerStorageSize{ 96u };
 
 	class RtpPacket
 	{
@@ -113,6 +119,30 @@ namespace RTC
 			uint8_t tl0picidx;
 		};
 
+	public:
+		/*
+		 * Struct with the header rewrite that a Consumer applies to a packet. While
+		 * attached to a packet (see SetRewritePlan()) the packet getters return its
+		 * values, and Write() applies it into the egress copy so the packet itself
+		 * (shared by all the Consumers of a Producer) is never modified.
+		 */
+		struct RewritePlan
+		{
+			// Fixed RTP header fields.
+			uint32_t ssrc{ 0u };
+			uint16_t sequenceNumber{ 0u };
+			uint32_t timestamp{ 0u };
+			// MID extension value. Not rewritten if midLen is 0.
+			uint8_t mid[MidMaxLength];
+			uint8_t midLen{ 0u };
+			// Filled by UpdateAbsSendTime() and UpdateTransportWideCc01() while the
+			// plan is attached.
+			bool hasAbsSendTime{ false };
+			uint32_t absSendTime{ 0u };
+			bool hasTransportWideCc01{ false };
+			uint16_t wideSeqNumber{ 0u };
+		};
+
 	public:
 		static const size_t HeaderSize{ 12 };
 		static bool IsRtp(const uint8_t* data, size_t len)
@@ -132,7 +162,109 @@ namespace RTC
 			// clang-format on
 		}
 
+	public:
+		/**
+		 * Reference counted pointer to a RtpPacket. The count lives in the packet
+		 * itself so no control block is allocated. The packet is deleted once the
+		 * last SharedPtr pointing to it is gone.
+		 */
+		class SharedPtr
+		{
+		public:
+			SharedPtr() = default;
+			SharedPtr(std::nullptr_t) // NOLINT(google-explicit-constructor)
+			{
+			}
+			explicit SharedPtr(RtpPacket* packet) : packet(packet)
+			{
+				Ref();
+			}
+			SharedPtr(const SharedPtr& other) : packet(other.packet)
+			{
+				Ref();
+			}
+			SharedPtr(SharedPtr&& other) noexcept : packet(other.packet)
+			{
+				other.packet = nullptr;
+			}
+			~SharedPtr()
+			{
+				Unref();
+			}
+			SharedPtr& operator=(const SharedPtr& other)
+			{
+				// Ref the new packet before unreferencing the current one, which may
+				// be the same.
+				SharedPtr(other).swap(*this);
+
+				return *this;
+			}
+			SharedPtr& operator=(SharedPtr&& other) noexcept
+			{
+				if (this != &other)
+				{
+					Unref();
+
+					this->packet = other.packet;
+					other.packet = nullptr;
+				}
+
+				return *this;
+			}
+
+		public:
+			RtpPacket* get() const
+			{
+				return this->packet;
+			}
+			void reset(RtpPacket* packet = nullptr)
+			{
+				SharedPtr(packet).swap(*this);
+			}
+			void swap(SharedPtr& other) noexcept
+			{
+				std::swap(this->packet, other.packet);
+			}
+			size_t use_count() const
+			{
+				return this->packet ? this->packet->refCount : 0u;
+			}
+			RtpPacket* operator->() const
+			{
+				return this->packet;
+			}
+			RtpPacket& operator*() const
+			{
+				return *this->packet;
+			}
+			explicit operator bool() const
+			{
+				return this->packet != nullptr;
+			}
+
+		private:
+			void Ref()
+			{
+				if (this->packet)
+					this->packet->refCount++;
+			}
+			void Unref()
+			{
+				if (this->packet && --this->packet->refCount == 0u)
+					delete this->packet;
+
+				this->packet = nullptr;
+			}
+
+		private:
+			RtpPacket* packet{ nullptr };
+		};
+
+	public:
 		static RtpPacket* Parse(const uint8_t* data, size_t len);
+		// RtpPacket instances are allocated from the RtpPacketPool of the thread.
+		static void* operator new(size_t size);
+		static void operator delete(void* ptr);
 
 	private:
 		RtpPacket(
@@ -144,6 +276,8 @@ namespace RTC
 		  size_t size);
 
 	public:
+		RtpPacket& operator=(const RtpPacket&) = delete;
+		RtpPacket(const RtpPacket&)            = delete;
 		~RtpPacket();
 
 		void Dump() const;
@@ -187,6 +321,9 @@ namespace RTC
 
 		uint16_t GetSequenceNumber() const
 		{
+			if (this->rewritePlan)
+				return this->rewritePlan->sequenceNumber;
+
 			return uint16_t{ ntohs(this->header->sequenceNumber) };
 		}
 
@@ -197,6 +334,9 @@ namespace RTC
 
 		uint32_t GetTimestamp() const
 		{
+			if (this->rewritePlan)
+				return this->rewritePlan->timestamp;
+
 			return uint32_t{ ntohl(this->header->timestamp) };
 		}
 
@@ -207,6 +347,9 @@ namespace RTC
 
 		uint32_t GetSsrc() const
 		{
+			if (this->rewritePlan)
+				return this->rewritePlan->ssrc;
+
 			return uint32_t{ ntohl(this->header->ssrc) };
 		}
 
@@ -366,6 +509,14 @@ namespace RTC
 
 			auto absSendTime = Utils::Time::TimeMsToAbsSendTime(ms);
 
+			if (this->rewritePlan)
+			{
+				this->rewritePlan->hasAbsSendTime = true;
+				this->rewritePlan->absSendTime    = absSendTime;
+
+				return true;
+			}
+
 			Utils::Byte::Set3Bytes(extenValue, 0, absSendTime);
 
 			return true;
@@ -392,6 +543,14 @@ namespace RTC
 			if (!extenValue || extenLen != 2u)
 				return false;
 
+			if (this->rewritePlan)
+			{
+				this->rewritePlan->hasTransportWideCc01 = true;
+				this->rewritePlan->wideSeqNumber        = wideSeqNumber;
+
+				return true;
+			}
+
 			Utils::Byte::Set2Bytes(extenValue, 0, wideSeqNumber);
 
 			return true;
@@ -592,13 +751,68 @@ namespace RTC
 
 		RtpPacket* Clone() const;
 
+		// Clone the packet into the given storage (sizeof(RtpPacket) bytes aligned
+		// as std::max_align_t) and buffer (MtuSize + 100 bytes) applying the
+		// attached rewrite plan, if any. Neither of them comes from the pool, so
+		// the clone must be destroyed by calling its destructor instead of being
+		// deleted.
+		RtpPacket* CloneInto(void* storage, uint8_t* buffer) const;
+
+		RewritePlan* GetRewritePlan() const
+		{
+			return this->rewritePlan;
+		}
+
+		// Attach (or detach if nullptr) the rewrite plan of a Consumer. The plan
+		// must outlive the sending of the packet.
+		void SetRewritePlan(RewritePlan* rewritePlan)
+		{
+			if (rewritePlan)
+			{
+				rewritePlan->hasAbsSendTime       = false;
+				rewritePlan->hasTransportWideCc01 = false;
+			}
+
+			this->rewritePlan = rewritePlan;
+		}
+
+		// Copy the packet into the given buffer (with room for GetSize() bytes)
+		// applying the attached rewrite plan, if any.
+		void Write(uint8_t* buffer) const;
+
 		void RtxEncode(uint8_t payloadType, uint32_t ssrc, uint16_t seq);
 
 		bool RtxDecode(uint8_t payloadType, uint32_t ssrc);
 
-		void SetPayloadDescriptorHandler(RTC::Codecs::PayloadDescriptorHandler* payloadDescriptorHandler)
+		// Construct the payload descriptor handler in the storage of the packet
+		// so no memory is allocated.
+		template<typename T, typename... Args>
+		T* EmplacePayloadDescriptorHandler(Args&&... args)
 		{
-			this->payloadDescriptorHandler.reset(payloadDescriptorHandler);
+			static_assert(
+			  sizeof(T) <= PayloadDescriptorHandlerStorageSize,
+			  "PayloadDescriptorHandler does not fit into RtpPacket storage");
+			static_assert(
+			  alignof(T) <= alignof(std::max_align_t),
+			  "PayloadDescriptorHandler alignment not supported by RtpPacket storage");
+
+			ResetPayloadDescriptorHandler();
+
+			auto* payloadDescriptorHandler =
+			  new (this->payloadDescriptorHandlerStorage) T(std::forward<Args>(args)...);
+
+			this->payloadDescriptorHandler = payloadDescriptorHandler;
+
+			return payloadDescriptorHandler;
+		}
+
+		void ResetPayloadDescriptorHandler()
+		{
+			if (!this->payloadDescriptorHandler)
+				return;
+
+			this->payloadDescriptorHandler->~PayloadDescriptorHandler();
+			this->payloadDescriptorHandler = nullptr;
 		}
 
 		bool ProcessPayload(RTC::Codecs::EncodingContext* context, bool& marker);
@@ -612,6 +826,7 @@ namespace RTC
 
 	private:
 		void ParseExtensions();
+		void CloneState(RtpPacket* packet) const;
 
 	private:
 		// Passed by argument.
@@ -635,11 +850,17 @@ namespace RTC
 		size_t payloadLength{ 0u };
 		uint8_t payloadPadding{ 0u };
 		size_t size{ 0u }; // Full size of the packet in bytes.
-		// Codecs
-		std::shared_ptr<Codecs::PayloadDescriptorHandler> payloadDescriptorHandler;
+		// Codecs. The handler lives in payloadDescriptorHandlerStorage.
+		Codecs::PayloadDescriptorHandler* payloadDescriptorHandler{ nullptr };
+		alignas(std::max_align_t) uint8_t payloadDescriptorHandlerStorage[PayloadDescriptorHandlerStorageSize];
 		// Buffer where this packet is allocated, can be `nullptr` if packet was
-		// parsed from externally provided buffer.
+		// parsed from externally provided buffer. It comes from the
+		// RtpPacketPool.
 		uint8_t* buffer{ nullptr };
+		// Number of SharedPtr pointing to this packet.
+		size_t refCount{ 0u };
+		// Header rewrite of the Consumer currently sending this packet.
+		RewritePlan* rewritePlan{ nullptr };
 	};
 } // namespace RTC
 
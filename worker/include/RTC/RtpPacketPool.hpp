@@ -0,0 +1,72 @@
+#ifndef MS_RTC_RTP_PACKET_POOL_HPP
+#define MS_RTC_RTP_PACKET_POOL_HPP
+
+#include "common.hpp"
+#include "Channel/BinaryBody.hpp"
+#include <nlohmann/json.hpp>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace RTC
+{
+	// Per thread pools for RtpPacket instances and for the buffers of cloned
+	// packets. Memory is allocated in slabs of fixed size blocks and released
+	// blocks are reused, so parsing and cloning packets doesn't hit malloc once
+	// the pools have grown to the traffic of the worker.
+	class RtpPacketPool
+	{
+	public:
+		class BlockPool
+		{
+		public:
+			BlockPool(size_t blockSize, size_t blocksPerSlab);
+			~BlockPool();
+
+		public:
+			void* Allocate();
+			void Release(void* block);
+			void FillJson(json& jsonObject) const;
+			void FillBinary(Channel::BinaryBody::Writer& writer) const;
+			size_t GetBlockSize() const
+			{
+				return this->blockSize;
+			}
+			size_t GetCapacity() const
+			{
+				return this->slabs.size() * this->blocksPerSlab;
+			}
+			size_t GetInUse() const
+			{
+				return this->inUse;
+			}
+			size_t GetHighWater() const
+			{
+				return this->highWater;
+			}
+
+		private:
+			void AddSlab();
+
+		private:
+			size_t blockSize{ 0u };
+			size_t blocksPerSlab{ 0u };
+			std::vector<uint8_t*> slabs;
+			std::vector<void*> freeBlocks;
+			size_t inUse{ 0u };
+			size_t highWater{ 0u };
+		};
+
+	public:
+		static void* AllocatePacket();
+		static void ReleasePacket(void* ptr);
+		static uint8_t* AllocateBuffer();
+		static void ReleaseBuffer(uint8_t* buffer);
+		static const BlockPool& GetPacketPool();
+		static const BlockPool& GetBufferPool();
+		static void FillJson(json& jsonObject);
+		static void FillBinary(Channel::BinaryBody::Writer& writer);
+	};
+} // namespace RTC
+
+#endif
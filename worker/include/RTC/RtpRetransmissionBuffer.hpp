@@ -3,14 +3,20 @@
 
 #include "common.hpp"
 #include "RTC/RtpPacket.hpp"
-#include <deque>
+#include <vector>
 
 namespace RTC
 {
-	// Special container that stores `Item`* elements addressable by their `uint16_t`
+	// Special container that stores `Item` elements addressable by their `uint16_t`
 	// sequence number, while only taking as little memory as necessary to store
 	// the range covering a maximum of `MaxRetransmissionDelayForVideoMs` or
 	//  `MaxRetransmissionDelayForAudioMs` ms.
+	//
+	// The packet itself is cloned once per Producer packet and shared by the
+	// buffers of all Consumers (see Router), so an item is just the mapping of
+	// the Consumer's own SSRC, seq and timestamp to that packet. Items are
+	// stored inline in a ring which grows (up to the power of two above
+	// `maxItems`) but never shrinks, so storing a packet does not allocate.
 	class RtpRetransmissionBuffer
 	{
 	public:
@@ -18,8 +24,8 @@ namespace RTC
 		{
 			void Reset();
 
-			// Original packet.
-			std::shared_ptr<RTC::RtpPacket> packet{ nullptr };
+			// Original packet. Null in blank slots.
+			RTC::RtpPacket::SharedPtr packet{ nullptr };
 			// Correct SSRC since original packet may not have the same.
 			uint32_t ssrc{ 0u };
 			// Correct sequence number since original packet may not have the same.
@@ -37,29 +43,55 @@ namespace RTC
 		~RtpRetransmissionBuffer();
 
 		Item* Get(uint16_t seq) const;
-		void Insert(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket);
+		void Insert(RTC::RtpPacket* packet, RTC::RtpPacket::SharedPtr& sharedPacket);
 		void Clear();
 		void Dump() const;
 
 	private:
 		Item* GetOldest() const;
 		Item* GetNewest() const;
+		Item& Slot(size_t idx) const
+		{
+			return const_cast<Item&>(this->slots[(this->head + idx) & (this->slots.size() - 1)]);
+		}
+		// Returns nullptr for blank slots.
+		Item* At(size_t idx) const
+		{
+			auto& item = Slot(idx);
+
+			return item.packet.get() ? std::addressof(item) : nullptr;
+		}
+		Item& PushBack();
+		Item& PushFront();
+		void PopFront();
+		void Grow();
 		void RemoveOldest();
 		void RemoveOldest(uint16_t numItems);
 		bool ClearTooOldByTimestamp(uint32_t newestTimestamp);
 		bool IsTooOldTimestamp(uint32_t timestamp, uint32_t newestTimestamp) const;
-		Item* FillItem(
-		  Item* item, RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket) const;
+		void FillItem(
+		  Item& item, RTC::RtpPacket* packet, RTC::RtpPacket::SharedPtr& sharedPacket) const;
 
 	protected:
-		// Make buffer protected for testing purposes.
-		std::deque<Item*> buffer;
+		// Make buffer content accessible for testing purposes.
+		size_t GetBufferSize() const
+		{
+			return this->size;
+		}
+		Item* GetBufferItem(size_t idx) const
+		{
+			return At(idx);
+		}
 
 	private:
 		// Given as argument.
 		uint16_t maxItems;
 		uint32_t maxRetransmissionDelayMs;
 		uint32_t clockRate;
+		// Others.
+		std::vector<Item> slots;
+		size_t head{ 0u };
+		size_t size{ 0u };
 	};
 } // namespace RTC
 
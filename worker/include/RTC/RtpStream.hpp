@@ -3,6 +3,7 @@
 
 #include "common.hpp"
 #include "DepLibUV.hpp"
+#include "Channel/BinaryBody.hpp"
 #include "RTC/RTCP/FeedbackPsFir.hpp"
 #include "RTC/RTCP/FeedbackPsPli.hpp"
 #include "RTC/RTCP/FeedbackRtpNack.hpp"
@@ -15,6 +16,7 @@
 #include "RTC/RtpDictionaries.hpp"
 #include "RTC/RtpPacket.hpp"
 #include "RTC/RtxStream.hpp"
+#include "RTC/StatsStreamer.hpp"
 #include <nlohmann/json.hpp>
 #include <string>
 #include <vector>
@@ -64,6 +66,8 @@ namespace RTC
 
 		void FillJson(json& jsonObject) const;
 		virtual void FillJsonStats(json& jsonObject);
+		virtual void FillBinaryStats(Channel::BinaryBody::Writer& writer);
+		virtual void FillStatsValues(uint64_t nowMs, RTC::StatsStreamer::Values& values);
 		uint32_t GetEncodingIdx() const
 		{
 			return this->params.encodingIdx;
@@ -49,6 +49,8 @@ namespace RTC
 		~RtpStreamRecv();
 
 		void FillJsonStats(json& jsonObject) override;
+		void FillBinaryStats(Channel::BinaryBody::Writer& writer) override;
+		void FillStatsValues(uint64_t nowMs, RTC::StatsStreamer::Values& values) override;
 		bool ReceivePacket(RTC::RtpPacket* packet);
 		bool ReceiveRtxPacket(RTC::RtpPacket* packet);
 		RTC::RTCP::ReceiverReport* GetRtcpReceiverReport();
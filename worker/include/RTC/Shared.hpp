@@ -4,6 +4,7 @@
 #include "ChannelMessageRegistrator.hpp"
 #include "Channel/ChannelNotifier.hpp"
 #include "PayloadChannel/PayloadChannelNotifier.hpp"
+#include "RTC/StatsStreamer.hpp"
 
 namespace RTC
 {
@@ -13,13 +14,15 @@ namespace RTC
 		explicit Shared(
 		  ChannelMessageRegistrator* channelMessageRegistrator,
 		  Channel::ChannelNotifier* channelNotifier,
-		  PayloadChannel::PayloadChannelNotifier* payloadChannelNotifier);
+		  PayloadChannel::PayloadChannelNotifier* payloadChannelNotifier,
+		  RTC::StatsStreamer* statsStreamer);
 		~Shared();
 
 	public:
 		ChannelMessageRegistrator* channelMessageRegistrator{ nullptr };
 		Channel::ChannelNotifier* channelNotifier{ nullptr };
 		PayloadChannel::PayloadChannelNotifier* payloadChannelNotifier{ nullptr };
+		RTC::StatsStreamer* statsStreamer{ nullptr };
 	};
 } // namespace RTC
 
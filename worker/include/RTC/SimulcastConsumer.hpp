@@ -23,6 +23,7 @@ namespace RTC
 	public:
 		void FillJson(json& jsonObject) const override;
 		void FillJsonStats(json& jsonArray) const override;
+		void FillBinaryStats(Channel::BinaryBody::Writer& writer) const override;
 		void FillJsonScore(json& jsonObject) const override;
 		RTC::Consumer::Layers GetPreferredLayers() const override
 		{
@@ -57,7 +58,8 @@ namespace RTC
 		uint32_t IncreaseLayer(uint32_t bitrate, bool considerLoss) override;
 		void ApplyLayers() override;
 		uint32_t GetDesiredBitrate() const override;
-		void SendRtpPacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket) override;
+		void SendRtpPacket(RTC::RtpPacket* packet, RTC::RtpPacket::SharedPtr& sharedPacket) override;
+		bool NeedsKeyFrameToStart(uint32_t mappedSsrc) const override;
 		bool GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t nowMs) override;
 		const std::vector<RTC::RtpStreamSend*>& GetRtpStreams() const override
 		{
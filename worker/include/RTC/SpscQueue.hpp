@@ -0,0 +1,112 @@
+#ifndef MS_RTC_SPSC_QUEUE_HPP
+#define MS_RTC_SPSC_QUEUE_HPP
+
+#include "common.hpp"
+#include <atomic>
+#include <utility> // std::move()
+#include <vector>
+
+namespace RTC
+{
+	// Bounded lock-free queue for exactly one producer thread and one consumer
+	// thread. Push() must only be called from the producer thread and Pop()
+	// only from the consumer thread.
+	// T must be default constructible and move assignable.
+	template<typename T>
+	class SpscQueue
+	{
+	private:
+		static constexpr size_t CacheLineSize{ 64u };
+
+	private:
+		static size_t RoundUpToPowerOfTwo(size_t value)
+		{
+			size_t result{ 1u };
+
+			while (result < value)
+			{
+				result <<= 1;
+			}
+
+			return result;
+		}
+
+	public:
+		// Capacity is rounded up to the next power of two.
+		explicit SpscQueue(size_t capacity)
+		  : capacity(RoundUpToPowerOfTwo(capacity)), mask(this->capacity - 1),
+		    slots(this->capacity)
+		{
+		}
+		SpscQueue(const SpscQueue&)            = delete;
+		SpscQueue& operator=(const SpscQueue&) = delete;
+
+	public:
+		// Returns false if the queue is full.
+		bool Push(T item)
+		{
+			const size_t tail = this->tail.load(std::memory_order_relaxed);
+
+			if (tail - this->cachedHead == this->capacity)
+			{
+				this->cachedHead = this->head.load(std::memory_order_acquire);
+
+				if (tail - this->cachedHead == this->capacity)
+					return false;
+			}
+
+			this->slots[tail & this->mask] = std::move(item);
+
+			this->tail.store(tail + 1, std::memory_order_release);
+
+			return true;
+		}
+		// Returns false if the queue is empty.
+		bool Pop(T& item)
+		{
+			const size_t head = this->head.load(std::memory_order_relaxed);
+
+			if (head == this->cachedTail)
+			{
+				this->cachedTail = this->tail.load(std::memory_order_acquire);
+
+				if (head == this->cachedTail)
+					return false;
+			}
+
+			item = std::move(this->slots[head & this->mask]);
+
+			this->head.store(head + 1, std::memory_order_release);
+
+			return true;
+		}
+		// Approximate when called while the other thread is operating.
+		size_t GetSize() const
+		{
+			return this->tail.load(std::memory_order_acquire) -
+			       this->head.load(std::memory_order_acquire);
+		}
+		size_t GetCapacity() const
+		{
+			return this->capacity;
+		}
+
+	private:
+		// Passed by argument.
+		const size_t capacity;
+		const size_t mask;
+		std::vector<T> slots;
+		// Owned by the consumer thread. Padded to not share a cache line with
+		// the producer side.
+		uint8_t padding1[CacheLineSize];
+		std::atomic<size_t> head{ 0u };
+		size_t cachedTail{ 0u };
+		// Owned by the producer thread.
+		uint8_t padding2[CacheLineSize];
+		std::atomic<size_t> tail{ 0u };
+		size_t cachedHead{ 0u };
+		uint8_t padding3[CacheLineSize];
+	};
+} // namespace RTC
+
+#endif
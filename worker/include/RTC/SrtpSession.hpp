@@ -37,6 +37,9 @@ namespace RTC
 
 	public:
 		bool EncryptRtp(const uint8_t** data, int* len);
+		// Encrypt the RTP packet in place. size is the size of the buffer holding
+		// it, which must have room for the SRTP trailer.
+		bool EncryptRtp(uint8_t* data, int* len, size_t size);
 		bool DecryptSrtp(uint8_t* data, int* len);
 		bool EncryptRtcp(const uint8_t** data, int* len);
 		bool DecryptSrtcp(uint8_t* data, int* len);
@@ -0,0 +1,162 @@
+#ifndef MS_RTC_STATS_STREAMER_HPP
+#define MS_RTC_STATS_STREAMER_HPP
+
+#include "common.hpp"
+#include "PayloadChannel/PayloadChannelNotifier.hpp"
+#include "handles/Timer.hpp"
+#include <absl/container/flat_hash_map.h>
+#include <nlohmann/json.hpp>
+#include <array>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace RTC
+{
+	// Pushes the stats of every Transport, Producer and Consumer of the worker
+	// to the parent at a given interval, so it does not need to poll getStats()
+	// on each of them. Each interval produces one PayloadChannel notification
+	// whose payload only carries the values that changed since the previous
+	// one, as deltas.
+	//
+	// Payload: Version (uint8) followed by an entry per changed stream:
+	//   - entryId (varint)
+	//   - mask of changed values (varint, bit N is value N)
+	//   - delta of each changed value (zigzag varint)
+	//
+	// Entries (a Transport or an RTP stream of a Producer or Consumer) are
+	// announced in the notification data before their first values and
+	// reported once they are gone.
+	class StatsStreamer : public Timer::Listener
+	{
+	public:
+		class Source
+		{
+		public:
+			virtual ~Source() = default;
+
+		public:
+			// Must call AddStats() once per stream.
+			virtual void FillStatsStream(uint64_t nowMs, RTC::StatsStreamer* statsStreamer) = 0;
+		};
+
+	public:
+		enum class Type : uint8_t
+		{
+			TRANSPORT = 1,
+			INBOUND_RTP,
+			OUTBOUND_RTP
+		};
+
+	public:
+		// Index of each value of TRANSPORT entries.
+		enum TransportValue : size_t
+		{
+			BYTES_RECEIVED = 0,
+			RECV_BITRATE,
+			BYTES_SENT,
+			SEND_BITRATE,
+			RTP_BYTES_RECEIVED,
+			RTP_RECV_BITRATE,
+			RTP_BYTES_SENT,
+			RTP_SEND_BITRATE,
+			RTX_BYTES_RECEIVED,
+			RTX_RECV_BITRATE,
+			RTX_BYTES_SENT,
+			RTX_SEND_BITRATE,
+			PROBATION_BYTES_SENT,
+			PROBATION_SEND_BITRATE,
+			AVAILABLE_OUTGOING_BITRATE,
+			AVAILABLE_INCOMING_BITRATE
+		};
+
+		// Index of each value of INBOUND_RTP and OUTBOUND_RTP entries.
+		enum RtpStreamValue : size_t
+		{
+			PACKET_COUNT = 0,
+			BYTE_COUNT,
+			BITRATE,
+			PACKETS_LOST,
+			FRACTION_LOST,
+			PACKETS_DISCARDED,
+			PACKETS_RETRANSMITTED,
+			PACKETS_REPAIRED,
+			NACK_COUNT,
+			NACK_PACKET_COUNT,
+			PLI_COUNT,
+			FIR_COUNT,
+			SCORE,
+			// In microseconds.
+			ROUND_TRIP_TIME,
+			JITTER
+		};
+
+	public:
+		static constexpr uint8_t Version{ 1u };
+		static constexpr size_t MaxValues{ 16u };
+		static constexpr uint64_t MinIntervalMs{ 100u };
+		// Send what is pending once the payload gets this big, so it fits into a
+		// PayloadChannel message.
+		static constexpr size_t MaxPayloadSize{ 1024u * 1024u };
+
+	public:
+		using Values = std::array<int64_t, MaxValues>;
+
+	private:
+		struct Entry
+		{
+			uint32_t entryId;
+			Type type;
+			uint32_t ssrc;
+			bool present;
+			Values values;
+		};
+
+		struct SourceEntry
+		{
+			std::string id;
+			std::vector<Entry> entries;
+		};
+
+	public:
+		explicit StatsStreamer(PayloadChannel::PayloadChannelNotifier* payloadChannelNotifier);
+		~StatsStreamer();
+
+	public:
+		void Subscribe(uint64_t intervalMs);
+		void Unsubscribe();
+		bool IsSubscribed() const
+		{
+			return this->periodicTimer != nullptr;
+		}
+		void AddSource(Source* source, const std::string& id);
+		void RemoveSource(Source* source);
+		void AddStats(Type type, uint32_t ssrc, const Values& values);
+		void SendStats();
+
+	private:
+		void ResetEntries();
+		void Emit();
+
+		/* Pure virtual methods inherited from Timer::Listener. */
+	public:
+		void OnTimer(Timer* timer) override;
+
+	private:
+		// Passed by argument.
+		PayloadChannel::PayloadChannelNotifier* payloadChannelNotifier{ nullptr };
+		// Allocated by this.
+		Timer* periodicTimer{ nullptr };
+		// Others.
+		absl::flat_hash_map<Source*, SourceEntry> mapSourceEntry;
+		SourceEntry* currentSourceEntry{ nullptr };
+		uint32_t nextEntryId{ 1u };
+		uint64_t nowMs{ 0u };
+		std::vector<uint8_t> payload;
+		json addedEntries    = json::array();
+		json removedEntryIds = json::array();
+	};
+} // namespace RTC
+
+#endif
@@ -2,6 +2,7 @@
 #define MS_RTC_STUN_PACKET_HPP
 
 #include "common.hpp"
+#include "Utils.hpp"
 #include <string>
 
 namespace RTC
@@ -180,10 +181,11 @@ namespace RTC
 			return this->hasFingerprint;
 		}
 		Authentication CheckAuthentication(
-		  const std::string& localUsername, const std::string& localPassword);
+		  const std::string& localUsername, const Utils::Crypto::HmacSha1Key& localPassword);
 		StunPacket* CreateSuccessResponse();
 		StunPacket* CreateErrorResponse(uint16_t errorCode);
-		void Authenticate(const std::string& password);
+		// NOTE: The given password must outlive the call to Serialize().
+		void Authenticate(const Utils::Crypto::HmacSha1Key& password);
 		void Serialize(uint8_t* buffer);
 
 	private:
@@ -205,7 +207,7 @@ namespace RTC
 		bool hasFingerprint{ false };                       // 4 bytes.
 		const struct sockaddr* xorMappedAddress{ nullptr }; // 8 or 20 bytes.
 		uint16_t errorCode{ 0u };                           // 4 bytes (no reason phrase).
-		std::string password;
+		const Utils::Crypto::HmacSha1Key* password{ nullptr };
 	};
 } // namespace RTC
 
@@ -11,6 +11,7 @@
 #include "RTC/Consumer.hpp"
 #include "RTC/DataConsumer.hpp"
 #include "RTC/DataProducer.hpp"
+#include "RTC/EgressPacer.hpp"
 #include "RTC/Producer.hpp"
 #include "RTC/RTCP/CompoundPacket.hpp"
 #include "RTC/RTCP/Packet.hpp"
@@ -22,6 +23,7 @@
 #include "RTC/SctpAssociation.hpp"
 #include "RTC/SctpListener.hpp"
 #include "RTC/Shared.hpp"
+#include "RTC/StatsStreamer.hpp"
 #ifdef ENABLE_RTC_SENDER_BANDWIDTH_ESTIMATOR
 #include "RTC/SenderBandwidthEstimator.hpp"
 #endif
@@ -40,12 +42,14 @@ namespace RTC
 	                  public RTC::Consumer::Listener,
 	                  public RTC::DataProducer::Listener,
 	                  public RTC::DataConsumer::Listener,
+	                  public RTC::EgressPacer::Listener,
 	                  public RTC::SctpAssociation::Listener,
 	                  public RTC::TransportCongestionControlClient::Listener,
 	                  public RTC::TransportCongestionControlServer::Listener,
 	                  public Channel::ChannelSocket::RequestHandler,
 	                  public PayloadChannel::PayloadChannelSocket::RequestHandler,
 	                  public PayloadChannel::PayloadChannelSocket::NotificationHandler,
+	                  public RTC::StatsStreamer::Source,
 #ifdef ENABLE_RTC_SENDER_BANDWIDTH_ESTIMATOR
 	                  public RTC::SenderBandwidthEstimator::Listener,
 #endif
@@ -129,6 +133,9 @@ namespace RTC
 		// Subclasses must also invoke the parent Close().
 		virtual void FillJson(json& jsonObject) const;
 		virtual void FillJsonStats(json& jsonArray);
+		// Writes the fields common to all transports, subclasses complete and end
+		// the record.
+		virtual void FillBinaryStats(Channel::BinaryBody::Writer& writer);
 
 		/* Methods inherited from Channel::ChannelSocket::RequestHandler. */
 	public:
@@ -155,6 +162,8 @@ namespace RTC
 			this->sendTransmission.Update(len, DepLibUV::GetTimeMs());
 		}
 		void ReceiveRtpPacket(RTC::RtpPacket* packet);
+		// Like ReceiveRtpPacket() but the packet is not deleted.
+		void HandleRtpPacket(RTC::RtpPacket* packet);
 		void ReceiveRtcpPacket(RTC::RTCP::Packet* packet);
 		void ReceiveSctpData(const uint8_t* data, size_t len);
 		void SetNewProducerIdFromData(json& data, std::string& producerId) const;
@@ -185,6 +194,8 @@ namespace RTC
 		virtual void SendSctpData(const uint8_t* data, size_t len) = 0;
 		virtual void RecvStreamClosed(uint32_t ssrc)               = 0;
 		virtual void SendStreamClosed(uint32_t ssrc)               = 0;
+		void SendConsumerRtpPacket(RTC::Consumer* consumer, RTC::RtpPacket* packet);
+		void RetransmitConsumerRtpPacket(RTC::Consumer* consumer, RTC::RtpPacket* packet);
 		void DistributeAvailableOutgoingBitrate();
 		void ComputeOutgoingDesiredBitrate(bool forceBitrate = false);
 		void EmitTraceEventProbationType(RTC::RtpPacket* packet) const;
@@ -241,6 +252,14 @@ namespace RTC
 		  onQueuedCallback* = nullptr) override;
 		void OnDataConsumerDataProducerClosed(RTC::DataConsumer* dataConsumer) override;
 
+		/* Pure virtual methods inherited from RTC::EgressPacer::Listener. */
+	public:
+		void OnEgressPacerSendRtpPacket(
+		  RTC::EgressPacer* egressPacer,
+		  RTC::Consumer* consumer,
+		  RTC::RtpPacket* packet,
+		  RTC::EgressPacer::Priority priority) override;
+
 		/* Pure virtual methods inherited from RTC::SctpAssociation::Listener. */
 	public:
 		void OnSctpAssociationConnecting(RTC::SctpAssociation* sctpAssociation) override;
@@ -282,6 +301,10 @@ namespace RTC
 		  uint32_t previousAvailableBitrate) override;
 #endif
 
+		/* Pure virtual methods inherited from RTC::StatsStreamer::Source. */
+	public:
+		void FillStatsStream(uint64_t nowMs, RTC::StatsStreamer* statsStreamer) override;
+
 		/* Pure virtual methods inherited from Timer::Listener. */
 	public:
 		void OnTimer(Timer* timer) override;
@@ -309,6 +332,7 @@ namespace RTC
 		Timer* rtcpTimer{ nullptr };
 		std::shared_ptr<RTC::TransportCongestionControlClient> tccClient{ nullptr };
 		std::shared_ptr<RTC::TransportCongestionControlServer> tccServer{ nullptr };
+		RTC::EgressPacer* egressPacer{ nullptr };
 #ifdef ENABLE_RTC_SENDER_BANDWIDTH_ESTIMATOR
 		std::shared_ptr<RTC::SenderBandwidthEstimator> senderBwe{ nullptr };
 #endif
@@ -331,6 +355,8 @@ namespace RTC
 		uint32_t maxOutgoingBitrate{ 0u };
 		uint32_t minOutgoingBitrate{ 0u };
 		struct TraceEventTypes traceEventTypes;
+		// Handle in RTP traces.
+		RtcLogger::ObjectHandle traceHandle{ this->id };
 	};
 } // namespace RTC
 
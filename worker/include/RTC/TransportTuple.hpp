@@ -3,6 +3,7 @@
 
 #include "common.hpp"
 #include "Utils.hpp"
+#include "Channel/BinaryBody.hpp"
 #include "RTC/TcpConnection.hpp"
 #include "RTC/UdpSocket.hpp"
 #include <nlohmann/json.hpp>
@@ -64,6 +65,10 @@ namespace RTC
 		}
 
 		void FillJson(json& jsonObject) const;
+		// FillJson() plus the write queue stats of the TCP connection.
+		void FillJsonStats(json& jsonObject) const;
+		// Same as FillJsonStats().
+		void FillBinary(Channel::BinaryBody::Writer& writer) const;
 
 		void Dump() const;
 
@@ -93,6 +98,21 @@ namespace RTC
 				this->tcpConnection->Send(data, len, cb);
 		}
 
+		// It takes ownership of sendData.
+		void Send(::UdpSocketHandler::UvSendData* sendData, RTC::TransportTuple::onSendCallback* cb = nullptr)
+		{
+			if (this->protocol == Protocol::UDP)
+			{
+				this->udpSocket->Send(sendData, this->udpRemoteAddr, cb);
+			}
+			else
+			{
+				this->tcpConnection->Send(sendData->store, sendData->len, cb);
+
+				::UdpSocketHandler::ReleaseSendData(sendData);
+			}
+		}
+
 		Protocol GetProtocol() const
 		{
 			return this->protocol;
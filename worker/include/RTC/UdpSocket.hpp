@@ -23,6 +23,12 @@ namespace RTC
 	public:
 		UdpSocket(Listener* listener, std::string& ip);
 		UdpSocket(Listener* listener, std::string& ip, uint16_t port);
+		// Bound with SO_REUSEPORT.
+		UdpSocket(Listener* listener, std::string& ip, uint16_t port, bool reusePort);
+		// Bound with SO_REUSEADDR (out of the SO_REUSEPORT group) and connected to
+		// the given remote address.
+		UdpSocket(
+		  Listener* listener, std::string& ip, uint16_t port, const struct sockaddr* remoteAddr);
 		~UdpSocket() override;
 
 		/* Pure virtual methods inherited from ::UdpSocketHandler. */
@@ -13,8 +13,12 @@
 #include <absl/container/flat_hash_map.h>
 #include <absl/container/flat_hash_set.h>
 #include <nlohmann/json.hpp>
+#include <cstring> // std::memcmp(), std::memcpy()
 #include <string>
 #include <vector>
+#ifdef __linux__
+#include <linux/filter.h> // struct sock_filter
+#endif
 
 namespace RTC
 {
@@ -33,6 +37,18 @@ namespace RTC
 			uint16_t port;
 		};
 
+	public:
+		// Max index of a WebRtcServer among those sharing their UDP ports with
+		// SO_REUSEPORT (it must fit into a ICE usernameFragment char).
+		static constexpr uint8_t MaxReusePortIndex{ 61u };
+
+	public:
+#ifdef __linux__
+		// Classic BPF program attached to the UDP sockets shared by several
+		// WebRtcServers.
+		static const std::vector<struct sock_filter>& GetReusePortFilter();
+#endif
+
 	private:
 		struct UdpSocketOrTcpServer
 		{
@@ -47,6 +63,56 @@ namespace RTC
 			std::string announcedIp;
 		};
 
+	public:
+		// Local ICE usernameFragments are generated by WebRtcTransport and are
+		// short, so they are stored inline in the map slots. This also allows
+		// looking up the one in a received STUN packet without allocating a
+		// std::string for it.
+		class UsernameFragmentKey
+		{
+		public:
+			static constexpr size_t MaxLength{ 32u };
+
+		public:
+			UsernameFragmentKey(const char* data, size_t length)
+			{
+				// Longer ones cannot be ours, so leave the key empty.
+				if (length > MaxLength)
+					return;
+
+				this->length = static_cast<uint8_t>(length);
+				std::memcpy(this->data, data, length);
+			}
+			explicit UsernameFragmentKey(const std::string& usernameFragment)
+			  : UsernameFragmentKey(usernameFragment.c_str(), usernameFragment.length())
+			{
+			}
+
+		public:
+			bool IsEmpty() const
+			{
+				return this->length == 0u;
+			}
+			std::string ToString() const
+			{
+				return std::string(this->data, this->length);
+			}
+			bool operator==(const UsernameFragmentKey& other) const
+			{
+				return this->length == other.length &&
+				       std::memcmp(this->data, other.data, this->length) == 0;
+			}
+			template<typename H>
+			friend H AbslHashValue(H h, const UsernameFragmentKey& key)
+			{
+				return H::combine_contiguous(std::move(h), key.data, key.length);
+			}
+
+		private:
+			uint8_t length{ 0u };
+			char data[MaxLength]{};
+		};
+
 	public:
 		WebRtcServer(RTC::Shared* shared, const std::string& id, json& data);
 		~WebRtcServer();
@@ -61,15 +127,19 @@ namespace RTC
 		void HandleRequest(Channel::ChannelRequest* request) override;
 
 	private:
-		std::string GetLocalIceUsernameFragmentFromReceivedStunPacket(RTC::StunPacket* packet) const;
+		UsernameFragmentKey GetLocalIceUsernameFragmentFromReceivedStunPacket(
+		  RTC::StunPacket* packet) const;
 		void OnPacketReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnStunDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnNonStunDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
+		RTC::UdpSocket* CreateConnectedUdpSocket(const RTC::TransportTuple* tuple);
 
 		/* Pure virtual methods inherited from RTC::WebRtcTransport::WebRtcTransportListener. */
 	public:
 		void OnWebRtcTransportCreated(RTC::WebRtcTransport* webRtcTransport) override;
 		void OnWebRtcTransportClosed(RTC::WebRtcTransport* webRtcTransport) override;
+		void OnWebRtcTransportLocalIceUsernameFragmentGenerated(
+		  RTC::WebRtcTransport* webRtcTransport, std::string& usernameFragment) override;
 		void OnWebRtcTransportLocalIceUsernameFragmentAdded(
 		  RTC::WebRtcTransport* webRtcTransport, const std::string& usernameFragment) override;
 		void OnWebRtcTransportLocalIceUsernameFragmentRemoved(
@@ -105,9 +175,17 @@ namespace RTC
 		// Set of WebRtcTransports.
 		absl::flat_hash_set<RTC::WebRtcTransport*> webRtcTransports;
 		// Map of WebRtcTransports indexed by local ICE usernameFragment.
-		absl::flat_hash_map<std::string, RTC::WebRtcTransport*> mapLocalIceUsernameFragmentWebRtcTransport;
+		absl::flat_hash_map<UsernameFragmentKey, RTC::WebRtcTransport*>
+		  mapLocalIceUsernameFragmentWebRtcTransport;
 		// Map of WebRtcTransports indexed by TransportTuple.hash.
 		absl::flat_hash_map<uint64_t, RTC::WebRtcTransport*> mapTupleWebRtcTransport;
+		// Whether UDP sockets are shared (SO_REUSEPORT) with other WebRtcServers
+		// and the index of this one among them.
+		bool reusePort{ false };
+		uint8_t reusePortIndex{ 0u };
+		// Sockets connected to the remote address of each UDP tuple (if
+		// reusePort), indexed by TransportTuple.hash.
+		absl::flat_hash_map<uint64_t, RTC::UdpSocket*> mapTupleConnectedUdpSocket;
 	};
 } // namespace RTC
 
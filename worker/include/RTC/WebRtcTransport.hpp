@@ -39,6 +39,9 @@ namespace RTC
 		public:
 			virtual void OnWebRtcTransportCreated(RTC::WebRtcTransport* webRtcTransport) = 0;
 			virtual void OnWebRtcTransportClosed(RTC::WebRtcTransport* webRtcTransport)  = 0;
+			// The listener may change the generated usernameFragment.
+			virtual void OnWebRtcTransportLocalIceUsernameFragmentGenerated(
+			  RTC::WebRtcTransport* webRtcTransport, std::string& usernameFragment) = 0;
 			virtual void OnWebRtcTransportLocalIceUsernameFragmentAdded(
 			  RTC::WebRtcTransport* webRtcTransport, const std::string& usernameFragment) = 0;
 			virtual void OnWebRtcTransportLocalIceUsernameFragmentRemoved(
@@ -64,6 +67,7 @@ namespace RTC
 	public:
 		void FillJson(json& jsonObject) const override;
 		void FillJsonStats(json& jsonArray) override;
+		void FillBinaryStats(Channel::BinaryBody::Writer& writer) override;
 		void ProcessStunPacketFromWebRtcServer(RTC::TransportTuple* tuple, RTC::StunPacket* packet);
 		void ProcessNonStunPacketFromWebRtcServer(
 		  RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
@@ -79,6 +83,7 @@ namespace RTC
 
 	private:
 		bool IsConnected() const override;
+		std::string GenerateIceUsernameFragment();
 		void MayRunDtlsTransport();
 		void SendRtpPacket(
 		  RTC::Consumer* consumer,
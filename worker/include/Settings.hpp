@@ -39,6 +39,13 @@ public:
 		std::string dtlsCertificateFile;
 		std::string dtlsPrivateKeyFile;
 		std::string libwebrtcFieldTrials{ "WebRTC-Bwe-AlrLimitedBackoff/Enabled/" };
+		bool udpSendBatching{ false };
+		uint8_t udpRecvBatchSize{ 1u };
+		bool egressPacing{ false };
+		bool dtlsHandshakeOffload{ false };
+		bool tcpSendBatching{ false };
+		uint32_t rtpTraceSize{ 0u };
+		bool logBatching{ false };
 	};
 
 public:
@@ -50,6 +57,7 @@ private:
 	static void SetLogLevel(std::string& level);
 	static void SetLogTags(const std::vector<std::string>& tags);
 	static void SetDtlsCertificateAndPrivateKeyFiles();
+	static bool GetBooleanOption(const char* option, const std::string& value);
 
 public:
 	thread_local static struct Configuration configuration;
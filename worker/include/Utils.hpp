@@ -3,6 +3,7 @@
 
 #include "common.hpp"
 #include <openssl/evp.h>
+#include <array>
 #include <cmath>
 #include <cstring> // std::memcmp(), std::memcpy()
 #include <nlohmann/json.hpp>
@@ -202,10 +203,78 @@ namespace Utils
 		{
 			return static_cast<size_t>(__builtin_popcount(mask));
 		}
+
+		static size_t CountSetBits(const uint64_t mask)
+		{
+#ifdef _WIN32
+			return static_cast<size_t>(__popcnt64(mask));
+#else
+			return static_cast<size_t>(__builtin_popcountll(mask));
+#endif
+		}
+
+		// Index of the least significant bit set. mask must not be 0.
+		static size_t GetLowestSetBit(const uint64_t mask)
+		{
+#ifdef _WIN32
+			unsigned long idx;
+
+			_BitScanForward64(&idx, mask);
+
+			return static_cast<size_t>(idx);
+#else
+			return static_cast<size_t>(__builtin_ctzll(mask));
+#endif
+		}
+
+		// Index of the most significant bit set. mask must not be 0.
+		static size_t GetHighestSetBit(const uint64_t mask)
+		{
+#ifdef _WIN32
+			unsigned long idx;
+
+			_BitScanReverse64(&idx, mask);
+
+			return static_cast<size_t>(idx);
+#else
+			return static_cast<size_t>(63 - __builtin_clzll(mask));
+#endif
+		}
 	};
 
 	class Crypto
 	{
+	public:
+		// HMAC-SHA1 key whose key schedule (the digest states of the inner and
+		// outer padded keys) is computed once, so computing the HMAC of a message
+		// with it just hashes the message.
+		class HmacSha1Key
+		{
+		public:
+			HmacSha1Key() = default;
+			explicit HmacSha1Key(const std::string& key);
+			~HmacSha1Key();
+			HmacSha1Key(const HmacSha1Key&)            = delete;
+			HmacSha1Key& operator=(const HmacSha1Key&) = delete;
+
+		public:
+			const std::string& GetKey() const
+			{
+				return this->key;
+			}
+			bool IsEmpty() const
+			{
+				return this->key.empty();
+			}
+			void SetKey(const std::string& key);
+
+		private:
+			friend class Crypto;
+
+			std::string key;
+			EVP_MAC_CTX* ctx{ nullptr };
+		};
+
 	public:
 		static void ClassInit();
 		static void ClassDestroy();
@@ -255,25 +324,44 @@ namespace Utils
 
 		static uint32_t GetCRC32(const uint8_t* data, size_t size)
 		{
+			const auto& tables = Crypto::crc32Tables;
 			uint32_t crc{ 0xFFFFFFFF };
 			const uint8_t* p = data;
 
+			// Slicing-by-8: process 8 bytes per iteration with 8 lookups that do
+			// not depend on each other.
+			while (size >= 8)
+			{
+				crc ^= static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+				       (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+
+				crc = tables[7][crc & 0xFF] ^ tables[6][(crc >> 8) & 0xFF] ^
+				      tables[5][(crc >> 16) & 0xFF] ^ tables[4][crc >> 24] ^ tables[3][p[4]] ^
+				      tables[2][p[5]] ^ tables[1][p[6]] ^ tables[0][p[7]];
+
+				p += 8;
+				size -= 8;
+			}
+
 			while (size--)
 			{
-				crc = Crypto::crc32Table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+				crc = tables[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
 			}
 
 			return crc ^ ~0U;
 		}
 
 		static const uint8_t* GetHmacSha1(const std::string& key, const uint8_t* data, size_t len);
+		static const uint8_t* GetHmacSha1(const HmacSha1Key& key, const uint8_t* data, size_t len);
 
 	private:
 		thread_local static uint32_t seed;
 		thread_local static EVP_MAC* mac;
 		thread_local static EVP_MAC_CTX* hmacSha1Ctx;
 		thread_local static uint8_t hmacSha1Buffer[];
-		static const uint32_t crc32Table[256];
+		// crc32Tables[0] is the classic byte at a time table, crc32Tables[k] the
+		// CRC of a byte followed by k zero bytes.
+		static const std::array<std::array<uint32_t, 256>, 8> crc32Tables;
 	};
 
 	class String
@@ -29,6 +29,7 @@ public:
 private:
 	void Close();
 	void FillJson(json& jsonObject) const;
+	void FillBinary(Channel::BinaryBody::Writer& writer) const;
 	void FillJsonResourceUsage(json& jsonObject) const;
 	void SetNewWebRtcServerIdFromData(json& data, std::string& webRtcServerId) const;
 	RTC::WebRtcServer* GetWebRtcServerFromData(json& data) const;
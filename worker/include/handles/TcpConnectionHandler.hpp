@@ -4,6 +4,7 @@
 #include "common.hpp"
 #include <uv.h>
 #include <string>
+#include <vector>
 
 class TcpConnectionHandler
 {
@@ -36,11 +37,18 @@ public:
 		{
 			delete[] this->store;
 			delete this->cb;
+
+			for (auto* cb : this->batchCbs)
+			{
+				delete cb;
+			}
 		}
 
 		uv_write_t req;
 		uint8_t* store{ nullptr };
 		TcpConnectionHandler::onSendCallback* cb{ nullptr };
+		// Callbacks of the writes in a write batch.
+		std::vector<TcpConnectionHandler::onSendCallback*> batchCbs;
 	};
 
 public:
@@ -72,6 +80,17 @@ public:
 	  const uint8_t* data2,
 	  size_t len2,
 	  TcpConnectionHandler::onSendCallback* cb);
+	/**
+	 * If enabled, data given to Write() is appended to a buffer which is
+	 * written at the end of the current loop iteration (or once it's full),
+	 * so writes made in the same iteration take a single syscall.
+	 */
+	void SetWriteBatching(bool enabled);
+	bool IsWriteBatchingEnabled() const
+	{
+		return this->writeBatchingEnabled;
+	}
+	void FlushWriteBatch();
 	void ErrorReceiving();
 	const struct sockaddr* GetLocalAddress() const
 	{
@@ -109,15 +128,43 @@ public:
 	{
 		return this->sentBytes;
 	}
+	// Bytes given to libuv but not written into the socket yet.
+	size_t GetWriteQueueSize() const
+	{
+		return this->uvHandle->write_queue_size;
+	}
+	size_t GetMaxWriteQueueSize() const
+	{
+		return this->maxWriteQueueSize;
+	}
+	// Number of writes that could not be entirely done immediately.
+	size_t GetQueuedWrites() const
+	{
+		return this->queuedWrites;
+	}
+	size_t GetWriteBatchFlushes() const
+	{
+		return this->writeBatchFlushes;
+	}
+	size_t GetWriteBatchItems() const
+	{
+		return this->writeBatchItems;
+	}
 
 private:
 	bool SetPeerAddress();
+	void WriteBuffers(
+	  const uv_buf_t* buffers,
+	  size_t numBuffers,
+	  TcpConnectionHandler::onSendCallback* cb,
+	  std::vector<TcpConnectionHandler::onSendCallback*>* batchCbs);
 
 	/* Callbacks fired by UV events. */
 public:
 	void OnUvReadAlloc(size_t suggestedSize, uv_buf_t* buf);
 	void OnUvRead(ssize_t nread, const uv_buf_t* buf);
-	void OnUvWrite(int status, onSendCallback* cb);
+	void OnUvWrite(int status, UvWriteData* writeData);
+	void OnUvWriteBatchFlush();
 
 	/* Pure virtual methods that must be implemented by the subclass. */
 protected:
@@ -141,6 +188,9 @@ private:
 	Listener* listener{ nullptr };
 	// Allocated by this.
 	uv_tcp_t* uvHandle{ nullptr };
+	// Allocated by this (just if write batching is enabled).
+	uv_prepare_t* uvWriteBatchPrepareHandle{ nullptr };
+	uv_check_t* uvWriteBatchCheckHandle{ nullptr };
 	// Others.
 	struct sockaddr_storage* localAddr{ nullptr };
 	bool closed{ false };
@@ -148,6 +198,14 @@ private:
 	size_t sentBytes{ 0u };
 	bool isClosedByPeer{ false };
 	bool hasError{ false };
+	size_t maxWriteQueueSize{ 0u };
+	size_t queuedWrites{ 0u };
+	bool writeBatchingEnabled{ false };
+	bool flushingWriteBatch{ false };
+	std::vector<uint8_t> writeBatchBuffer;
+	std::vector<TcpConnectionHandler::onSendCallback*> writeBatchCbs;
+	size_t writeBatchFlushes{ 0u };
+	size_t writeBatchItems{ 0u };
 };
 
 #endif
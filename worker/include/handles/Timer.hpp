@@ -2,10 +2,14 @@
 #define MS_TIMER_HPP
 
 #include "common.hpp"
-#include <uv.h>
+#include "handles/TimerWheel.hpp"
 
+// Timers are not backed by a libuv handle each, but all of them in the thread
+// are driven by the TimerWheel.
 class Timer
 {
+	friend class TimerWheel;
+
 public:
 	class Listener
 	{
@@ -38,22 +42,25 @@ public:
 	}
 	bool IsActive() const
 	{
-		return uv_is_active(reinterpret_cast<uv_handle_t*>(this->uvHandle)) != 0;
+		return this->slot != nullptr;
 	}
 
-	/* Callbacks fired by UV events. */
-public:
-	void OnUvTimer();
+	/* Callbacks fired by TimerWheel. */
+private:
+	void OnTimerWheelTimer();
 
 private:
 	// Passed by argument.
 	Listener* listener{ nullptr };
-	// Allocated by this.
-	uv_timer_t* uvHandle{ nullptr };
 	// Others.
 	bool closed{ false };
 	uint64_t timeout{ 0u };
 	uint64_t repeat{ 0u };
+	// Managed by TimerWheel.
+	TimerWheel::Slot* slot{ nullptr };
+	Timer* prev{ nullptr };
+	Timer* next{ nullptr };
+	uint64_t expiresAtMs{ 0u };
 };
 
 #endif
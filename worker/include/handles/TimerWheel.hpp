@@ -0,0 +1,76 @@
+#ifndef MS_TIMER_WHEEL_HPP
+#define MS_TIMER_WHEEL_HPP
+
+#include "common.hpp"
+#include <uv.h>
+
+// Avoid cyclic #include problem by declaring classes instead of including
+// the corresponding header files.
+class Timer;
+
+// Hierarchical timer wheel holding all the Timer instances of the thread. A
+// single uv_timer_t handle is started for the nearest event, so starting,
+// stopping and restarting a Timer are O(1) and don't touch the libuv timer
+// heap.
+//
+// Each level has 64 slots of 64^level ms. A Timer is stored in the level of
+// the most significant 6-bit group in which its expiration time differs from
+// the current time, and it's moved to lower levels as the time gets there.
+// Timers whose expiration is beyond the top level wait in an overflow list
+// which is revisited each time the top level wraps.
+class TimerWheel
+{
+public:
+	struct Slot
+	{
+		Timer* head{ nullptr };
+	};
+
+public:
+	static constexpr size_t LevelBits{ 6u };
+	static constexpr size_t SlotsPerLevel{ 1u << LevelBits };
+	static constexpr size_t NumLevels{ 4u };
+
+private:
+	thread_local static TimerWheel* timerWheel;
+
+public:
+	static void AddTimer(Timer* timer);
+	static void RemoveTimer(Timer* timer);
+	static void Insert(Timer* timer, uint64_t timeoutMs);
+	static void Remove(Timer* timer);
+
+public:
+	TimerWheel();
+	TimerWheel& operator=(const TimerWheel&) = delete;
+	TimerWheel(const TimerWheel&)            = delete;
+	~TimerWheel();
+
+	/* Callbacks fired by UV events. */
+public:
+	void OnUvTimer();
+
+private:
+	void Link(Slot* slot, Timer* timer);
+	void Unlink(Timer* timer);
+	void Place(Timer* timer);
+	uint64_t GetNextEventMs() const;
+	void Advance(uint64_t nowMs);
+	void Process();
+	void Schedule();
+
+private:
+	// Allocated by this.
+	uv_timer_t* uvHandle{ nullptr };
+	// Others.
+	size_t numTimers{ 0u };
+	uint64_t currentMs{ 0u };
+	uint64_t scheduledMs{ 0u };
+	bool processing{ false };
+	Slot slots[NumLevels][SlotsPerLevel];
+	uint64_t occupied[NumLevels]{};
+	Slot overflow;
+	Slot expired;
+};
+
+#endif
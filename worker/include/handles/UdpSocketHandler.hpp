@@ -4,6 +4,9 @@
 #include "common.hpp"
 #include <uv.h>
 #include <string>
+#include <vector>
+
+struct sock_filter;
 
 class UdpSocketHandler
 {
@@ -14,7 +17,7 @@ public:
 	/* Struct for the data field of uv_req_t when sending a datagram. */
 	struct UvSendData
 	{
-		explicit UvSendData(size_t storeSize)
+		explicit UvSendData(size_t storeSize) : storeSize(storeSize)
 		{
 			this->store = new uint8_t[storeSize];
 		}
@@ -30,12 +33,39 @@ public:
 
 		uv_udp_send_t req;
 		uint8_t* store{ nullptr };
+		size_t storeSize{ 0u };
+		// Length of the datagram in the store.
+		size_t len{ 0u };
 		UdpSocketHandler::onSendCallback* cb{ nullptr };
 	};
 
+private:
+	/* Struct for a datagram waiting in the send batch. */
+	struct SendBatchItem
+	{
+		UvSendData* sendData;
+		struct sockaddr_storage addr;
+	};
+
 public:
+	static bool IsSendBatchingSupported();
+	static size_t GetMaxRecvBatchSize();
+	/**
+	 * Get a UvSendData with room for at least size bytes. It comes from a pool
+	 * owned by the current thread unless size is bigger than a pooled store.
+	 */
+	static UvSendData* AllocateSendData(size_t size);
 	/**
-	 * uvHandle must be an already initialized and binded uv_udp_t pointer.
+	 * Give back a UvSendData obtained with AllocateSendData() that was not
+	 * passed to Send(). Its cb (if any) is deleted.
+	 */
+	static void ReleaseSendData(UvSendData* sendData);
+
+public:
+	/**
+	 * uvHandle must be an already initialized and binded uv_udp_t pointer. It
+	 * may also be connected, in which case the destination address given to
+	 * Send() is ignored.
 	 */
 	explicit UdpSocketHandler(uv_udp_t* uvHandle);
 	UdpSocketHandler& operator=(const UdpSocketHandler&) = delete;
@@ -51,6 +81,34 @@ public:
 	virtual void Dump() const;
 	void Send(
 	  const uint8_t* data, size_t len, const struct sockaddr* addr, UdpSocketHandler::onSendCallback* cb);
+	/**
+	 * Send the datagram in the given UvSendData (obtained with
+	 * AllocateSendData()) without copying it. It takes ownership of sendData.
+	 */
+	void Send(UvSendData* sendData, const struct sockaddr* addr, UdpSocketHandler::onSendCallback* cb);
+	void SetSendBatching(bool enabled);
+	bool IsSendBatchingEnabled() const
+	{
+		return this->sendBatchingEnabled;
+	}
+	void FlushSendBatch();
+	void SetRecvBatchSize(size_t size);
+	/**
+	 * Attach a classic BPF program to the SO_REUSEPORT group of the socket. It
+	 * is run for each received datagram (pointing to the UDP payload) and
+	 * returns the index, in the group, of the socket to deliver it to. Any
+	 * other value lets the kernel pick the socket by hashing the tuple.
+	 * Returns false if not supported in this platform.
+	 */
+	bool SetReusePortFilter(const struct sock_filter* filter, size_t len);
+	bool IsConnected() const
+	{
+		return this->connected;
+	}
+	size_t GetRecvBatchSize() const
+	{
+		return this->recvBatchSize;
+	}
 	const struct sockaddr* GetLocalAddress() const
 	{
 		return reinterpret_cast<const struct sockaddr*>(&this->localAddr);
@@ -75,15 +133,39 @@ public:
 	{
 		return this->sentBytes;
 	}
+	size_t GetRecvDatagrams() const
+	{
+		return this->recvDatagrams;
+	}
+	size_t GetRecvBatches() const
+	{
+		return this->recvBatches;
+	}
+	size_t GetSendBatchFlushes() const
+	{
+		return this->sendBatchFlushes;
+	}
+	size_t GetSendBatchSyscalls() const
+	{
+		return this->sendBatchSyscalls;
+	}
 
 private:
 	bool SetLocalAddress();
+	bool TrySend(
+	  const uint8_t* data, size_t len, const struct sockaddr* addr, UdpSocketHandler::onSendCallback* cb);
+	void SendDirect(UvSendData* sendData, const struct sockaddr* addr);
+	void SendQueued(UvSendData* sendData, const struct sockaddr* addr);
+	void QueueSendBatchItem(UvSendData* sendData, const struct sockaddr* addr);
+	void SendBatchFallback(size_t fromIdx);
+	void CompleteSendBatchItem(SendBatchItem& item, bool sent);
 
 	/* Callbacks fired by UV events. */
 public:
 	void OnUvRecvAlloc(size_t suggestedSize, uv_buf_t* buf);
 	void OnUvRecv(ssize_t nread, const uv_buf_t* buf, const struct sockaddr* addr, unsigned int flags);
 	void OnUvSend(int status, UdpSocketHandler::onSendCallback* cb);
+	void OnUvSendBatchFlush();
 
 	/* Pure virtual methods that must be implemented by the subclass. */
 protected:
@@ -98,10 +180,23 @@ protected:
 private:
 	// Allocated by this (may be passed by argument).
 	uv_udp_t* uvHandle{ nullptr };
+	// Allocated by this (just if send batching is enabled).
+	uv_prepare_t* uvSendBatchPrepareHandle{ nullptr };
+	uv_check_t* uvSendBatchCheckHandle{ nullptr };
 	// Others.
 	bool closed{ false };
+	bool connected{ false };
 	size_t recvBytes{ 0u };
 	size_t sentBytes{ 0u };
+	bool sendBatchingEnabled{ false };
+	bool sendBatchGsoEnabled{ false };
+	bool flushingSendBatch{ false };
+	std::vector<SendBatchItem> sendBatchItems;
+	size_t sendBatchFlushes{ 0u };
+	size_t sendBatchSyscalls{ 0u };
+	size_t recvBatchSize{ 1u };
+	size_t recvDatagrams{ 0u };
+	size_t recvBatches{ 0u };
 };
 
 #endif
@@ -0,0 +1,494 @@
+#define MS_CLASS "Channel::BinaryBody"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "Channel/BinaryBody.hpp"
+#include "Logger.hpp"
+#include <cstring> // std::memcpy()
+
+namespace Channel
+{
+	/* Static. */
+
+	using ValueType = BinaryBody::ValueType;
+
+	// Indexed by BinaryBody::Key.
+	// clang-format off
+	static const BinaryBody::KeyInfo KeyInfos[] =
+	{
+		{ "",                                   ValueType::UINT        },
+		{ "type",                               ValueType::STRING      },
+		{ "id",                                 ValueType::STRING      },
+		{ "timestamp",                          ValueType::UINT        },
+		{ "transportId",                        ValueType::STRING      },
+		{ "sctpState",                          ValueType::STRING      },
+		{ "bytesReceived",                      ValueType::UINT        },
+		{ "recvBitrate",                        ValueType::UINT        },
+		{ "bytesSent",                          ValueType::UINT        },
+		{ "sendBitrate",                        ValueType::UINT        },
+		{ "rtpBytesReceived",                   ValueType::UINT        },
+		{ "rtpRecvBitrate",                     ValueType::UINT        },
+		{ "rtpBytesSent",                       ValueType::UINT        },
+		{ "rtpSendBitrate",                     ValueType::UINT        },
+		{ "rtxBytesReceived",                   ValueType::UINT        },
+		{ "rtxRecvBitrate",                     ValueType::UINT        },
+		{ "rtxBytesSent",                       ValueType::UINT        },
+		{ "rtxSendBitrate",                     ValueType::UINT        },
+		{ "probationBytesSent",                 ValueType::UINT        },
+		{ "probationSendBitrate",               ValueType::UINT        },
+		{ "availableOutgoingBitrate",           ValueType::UINT        },
+		{ "availableIncomingBitrate",           ValueType::UINT        },
+		{ "maxIncomingBitrate",                 ValueType::UINT        },
+		{ "rtpPacketLossReceived",              ValueType::DOUBLE      },
+		{ "rtpPacketLossSent",                  ValueType::DOUBLE      },
+		{ "iceRole",                            ValueType::STRING      },
+		{ "iceState",                           ValueType::STRING      },
+		{ "iceSelectedTuple",                   ValueType::RECORD      },
+		{ "dtlsState",                          ValueType::STRING      },
+		{ "rtcpMux",                            ValueType::BOOL        },
+		{ "comedia",                            ValueType::BOOL        },
+		{ "tuple",                              ValueType::RECORD      },
+		{ "rtcpTuple",                          ValueType::RECORD      },
+		{ "localIp",                            ValueType::STRING      },
+		{ "localPort",                          ValueType::UINT        },
+		{ "remoteIp",                           ValueType::STRING      },
+		{ "remotePort",                         ValueType::UINT        },
+		{ "protocol",                           ValueType::STRING      },
+		{ "ssrc",                               ValueType::UINT        },
+		{ "kind",                               ValueType::STRING      },
+		{ "mimeType",                           ValueType::STRING      },
+		{ "packetsLost",                        ValueType::INT         },
+		{ "fractionLost",                       ValueType::UINT        },
+		{ "packetsDiscarded",                   ValueType::UINT        },
+		{ "packetsRetransmitted",               ValueType::UINT        },
+		{ "packetsRepaired",                    ValueType::UINT        },
+		{ "nackCount",                          ValueType::UINT        },
+		{ "nackPacketCount",                    ValueType::UINT        },
+		{ "pliCount",                           ValueType::UINT        },
+		{ "firCount",                           ValueType::UINT        },
+		{ "score",                              ValueType::UINT        },
+		{ "rid",                                ValueType::STRING      },
+		{ "rtxSsrc",                            ValueType::UINT        },
+		{ "rtxPacketsDiscarded",                ValueType::UINT        },
+		{ "roundTripTime",                      ValueType::DOUBLE      },
+		{ "jitter",                             ValueType::UINT        },
+		{ "packetCount",                        ValueType::UINT        },
+		{ "byteCount",                          ValueType::UINT        },
+		{ "bitrate",                            ValueType::UINT        },
+		{ "bitrateByLayer",                     ValueType::UINT_MAP    },
+		{ "label",                              ValueType::STRING      },
+		{ "messagesReceived",                   ValueType::UINT        },
+		{ "messagesSent",                       ValueType::UINT        },
+		{ "bufferedAmount",                     ValueType::UINT        },
+		{ "pid",                                ValueType::UINT        },
+		{ "webRtcServerIds",                    ValueType::STRINGS     },
+		{ "routerIds",                          ValueType::STRINGS     },
+		{ "channelMessageHandlers",             ValueType::RECORD      },
+		{ "channelRequestHandlers",             ValueType::STRINGS     },
+		{ "payloadChannelRequestHandlers",      ValueType::STRINGS     },
+		{ "payloadChannelNotificationHandlers", ValueType::STRINGS     },
+		{ "rtpPacketPool",                      ValueType::RECORD      },
+		{ "packets",                            ValueType::RECORD      },
+		{ "buffers",                            ValueType::RECORD      },
+		{ "blockSize",                          ValueType::UINT        },
+		{ "capacity",                           ValueType::UINT        },
+		{ "inUse",                              ValueType::UINT        },
+		{ "highWater",                          ValueType::UINT        },
+		{ "transportIds",                       ValueType::STRINGS     },
+		{ "rtpObserverIds",                     ValueType::STRINGS     },
+		{ "mapProducerIdConsumerIds",           ValueType::STRINGS_MAP },
+		{ "mapConsumerIdProducerId",            ValueType::STRING_MAP  },
+		{ "mapProducerIdObserverIds",           ValueType::STRINGS_MAP },
+		{ "mapDataProducerIdDataConsumerIds",   ValueType::STRINGS_MAP },
+		{ "mapDataConsumerIdDataProducerId",    ValueType::STRING_MAP  },
+		{ "ppid",                               ValueType::UINT        },
+		{ "writeQueueSize",                     ValueType::UINT        },
+		{ "maxWriteQueueSize",                  ValueType::UINT        },
+		{ "queuedWrites",                       ValueType::UINT        },
+		{ "writeBatchFlushes",                  ValueType::UINT        },
+		{ "writeBatchItems",                    ValueType::UINT        }
+	};
+	// clang-format on
+
+	static constexpr size_t NumKeys{ sizeof(KeyInfos) / sizeof(KeyInfos[0]) };
+
+	static_assert(
+	  static_cast<size_t>(BinaryBody::Key::WRITE_BATCH_ITEMS) == NumKeys - 1,
+	  "KeyInfos does not match Key");
+
+	// Maximum nesting of records accepted by the decoder.
+	static constexpr size_t MaxDepth{ 8u };
+
+	class Reader
+	{
+	public:
+		Reader(const char* data, size_t dataLen)
+		  : ptr(reinterpret_cast<const uint8_t*>(data)),
+		    end(reinterpret_cast<const uint8_t*>(data) + dataLen)
+		{
+		}
+
+	public:
+		bool AtEnd() const
+		{
+			return this->ptr == this->end;
+		}
+		bool ReadVarint(uint64_t& value)
+		{
+			value = 0u;
+
+			for (size_t shift{ 0u }; shift < 64u; shift += 7u)
+			{
+				if (this->ptr == this->end)
+					return false;
+
+				const uint8_t byte = *this->ptr++;
+
+				value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+				if ((byte & 0x80) == 0u)
+					return true;
+			}
+
+			return false;
+		}
+		bool ReadString(std::string& value)
+		{
+			uint64_t len;
+
+			if (!ReadVarint(len) || len > static_cast<uint64_t>(this->end - this->ptr))
+				return false;
+
+			value.assign(reinterpret_cast<const char*>(this->ptr), len);
+			this->ptr += len;
+
+			return true;
+		}
+		bool ReadStrings(json& jsonValue)
+		{
+			uint64_t count;
+
+			if (!ReadVarint(count))
+				return false;
+
+			jsonValue = json::array();
+
+			std::string value;
+
+			for (uint64_t idx{ 0u }; idx < count; ++idx)
+			{
+				if (!ReadString(value))
+					return false;
+
+				jsonValue.emplace_back(value);
+			}
+
+			return true;
+		}
+		bool ReadRecord(json& jsonObject, size_t depth)
+		{
+			if (depth > MaxDepth)
+				return false;
+
+			jsonObject = json::object();
+
+			while (this->ptr != this->end)
+			{
+				const uint8_t key = *this->ptr++;
+
+				if (key == 0u)
+					return true;
+				else if (key >= NumKeys)
+					return false;
+
+				const auto& keyInfo = KeyInfos[key];
+
+				if (!ReadValue(keyInfo.type, jsonObject[keyInfo.name], depth))
+					return false;
+			}
+
+			// Missing END key.
+			return false;
+		}
+
+	private:
+		bool ReadValue(ValueType type, json& jsonValue, size_t depth)
+		{
+			uint64_t value;
+
+			switch (type)
+			{
+				case ValueType::UINT:
+				{
+					if (!ReadVarint(value))
+						return false;
+
+					jsonValue = value;
+
+					return true;
+				}
+
+				case ValueType::INT:
+				{
+					if (!ReadVarint(value))
+						return false;
+
+					jsonValue = static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1u);
+
+					return true;
+				}
+
+				case ValueType::DOUBLE:
+				{
+					double doubleValue;
+
+					if (static_cast<size_t>(this->end - this->ptr) < sizeof(double))
+						return false;
+
+					std::memcpy(&doubleValue, this->ptr, sizeof(double));
+					this->ptr += sizeof(double);
+
+					jsonValue = doubleValue;
+
+					return true;
+				}
+
+				case ValueType::BOOL:
+				{
+					if (!ReadVarint(value))
+						return false;
+
+					jsonValue = value != 0u;
+
+					return true;
+				}
+
+				case ValueType::STRING:
+				{
+					std::string stringValue;
+
+					if (!ReadString(stringValue))
+						return false;
+
+					jsonValue = stringValue;
+
+					return true;
+				}
+
+				case ValueType::STRINGS:
+				{
+					return ReadStrings(jsonValue);
+				}
+
+				case ValueType::RECORD:
+				{
+					return ReadRecord(jsonValue, depth + 1);
+				}
+
+				case ValueType::STRING_MAP:
+				case ValueType::STRINGS_MAP:
+				case ValueType::UINT_MAP:
+				{
+					uint64_t count;
+
+					if (!ReadVarint(count))
+						return false;
+
+					jsonValue = json::object();
+
+					std::string mapKey;
+
+					for (uint64_t idx{ 0u }; idx < count; ++idx)
+					{
+						if (!ReadString(mapKey))
+							return false;
+
+						const auto itemType = type == ValueType::STRING_MAP    ? ValueType::STRING
+						                      : type == ValueType::STRINGS_MAP ? ValueType::STRINGS
+						                                                       : ValueType::UINT;
+
+						if (!ReadValue(itemType, jsonValue[mapKey], depth))
+							return false;
+					}
+
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+	private:
+		const uint8_t* ptr{ nullptr };
+		const uint8_t* end{ nullptr };
+	};
+
+	/* Class methods. */
+
+	const BinaryBody::KeyInfo& BinaryBody::GetKeyInfo(Key key)
+	{
+		MS_ASSERT(static_cast<size_t>(key) < NumKeys, "unknown key");
+
+		return KeyInfos[static_cast<size_t>(key)];
+	}
+
+	bool BinaryBody::ToJson(
+	  BinaryMessage::BodyType bodyType, const char* data, size_t dataLen, json& jsonValue)
+	{
+		MS_TRACE();
+
+		Reader reader(data, dataLen);
+
+		switch (bodyType)
+		{
+			case BinaryMessage::BodyType::RECORD:
+			{
+				return reader.ReadRecord(jsonValue, 0u) && reader.AtEnd();
+			}
+
+			case BinaryMessage::BodyType::RECORDS:
+			{
+				jsonValue = json::array();
+
+				while (!reader.AtEnd())
+				{
+					jsonValue.emplace_back(json::value_t::object);
+
+					if (!reader.ReadRecord(jsonValue[jsonValue.size() - 1], 0u))
+						return false;
+				}
+
+				return true;
+			}
+
+			default:
+			{
+				MS_WARN_DEV("not a schema encoded body");
+
+				return false;
+			}
+		}
+	}
+
+	/* Instance methods. */
+
+	BinaryBody::Writer::Writer(BinaryMessage::BodyType bodyType) : bodyType(bodyType)
+	{
+		MS_TRACE();
+	}
+
+	void BinaryBody::Writer::WriteUint(Key key, uint64_t value)
+	{
+		MS_TRACE();
+
+		WriteKey(key, ValueType::UINT);
+		WriteVarint(value);
+	}
+
+	void BinaryBody::Writer::WriteInt(Key key, int64_t value)
+	{
+		MS_TRACE();
+
+		WriteKey(key, ValueType::INT);
+		// Zigzag encoding.
+		WriteVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+	}
+
+	void BinaryBody::Writer::WriteDouble(Key key, double value)
+	{
+		MS_TRACE();
+
+		WriteKey(key, ValueType::DOUBLE);
+
+		const size_t offset = this->buffer.size();
+
+		this->buffer.resize(offset + sizeof(double));
+		std::memcpy(this->buffer.data() + offset, &value, sizeof(double));
+	}
+
+	void BinaryBody::Writer::WriteBool(Key key, bool value)
+	{
+		MS_TRACE();
+
+		WriteKey(key, ValueType::BOOL);
+		WriteVarint(value ? 1u : 0u);
+	}
+
+	void BinaryBody::Writer::WriteString(Key key, const std::string& value)
+	{
+		MS_TRACE();
+
+		WriteKey(key, ValueType::STRING);
+		AppendString(value);
+	}
+
+	void BinaryBody::Writer::StartRecord(Key key)
+	{
+		MS_TRACE();
+
+		WriteKey(key, ValueType::RECORD);
+	}
+
+	void BinaryBody::Writer::EndRecord()
+	{
+		MS_TRACE();
+
+		this->buffer.push_back(static_cast<uint8_t>(Key::END));
+	}
+
+	void BinaryBody::Writer::StartItems(Key key, size_t count)
+	{
+		MS_TRACE();
+
+		// clang-format off
+		MS_ASSERT(
+			GetKeyInfo(key).type == ValueType::STRINGS ||
+			GetKeyInfo(key).type == ValueType::STRING_MAP ||
+			GetKeyInfo(key).type == ValueType::STRINGS_MAP ||
+			GetKeyInfo(key).type == ValueType::UINT_MAP,
+			"key is not a STRINGS or map key");
+		// clang-format on
+
+		this->buffer.push_back(static_cast<uint8_t>(key));
+		WriteVarint(count);
+	}
+
+	void BinaryBody::Writer::AppendString(const std::string& value)
+	{
+		MS_TRACE();
+
+		WriteVarint(value.length());
+		this->buffer.insert(this->buffer.end(), value.begin(), value.end());
+	}
+
+	void BinaryBody::Writer::AppendUint(uint64_t value)
+	{
+		MS_TRACE();
+
+		WriteVarint(value);
+	}
+
+	void BinaryBody::Writer::AppendCount(size_t count)
+	{
+		MS_TRACE();
+
+		WriteVarint(count);
+	}
+
+	inline void BinaryBody::Writer::WriteKey(Key key, ValueType type)
+	{
+		MS_ASSERT(GetKeyInfo(key).type == type, "wrong value type for key");
+
+		this->buffer.push_back(static_cast<uint8_t>(key));
+	}
+
+	inline void BinaryBody::Writer::WriteVarint(uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			this->buffer.push_back(static_cast<uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+
+		this->buffer.push_back(static_cast<uint8_t>(value));
+	}
+} // namespace Channel
@@ -0,0 +1,113 @@
+#define MS_CLASS "Channel::BinaryMessage"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "Channel/BinaryMessage.hpp"
+#include "Logger.hpp"
+#include <cstring> // std::memcpy(), std::strlen()
+
+namespace Channel
+{
+	/* Class methods. */
+
+	bool BinaryMessage::Parse(const char* msg, size_t msgLen, Fields& fields)
+	{
+		MS_TRACE();
+
+		if (!BinaryMessage::IsBinary(msg, msgLen))
+			return false;
+
+		uint16_t field1Len;
+		uint16_t field2Len;
+
+		fields.type = static_cast<Type>(msg[1]);
+		std::memcpy(&fields.code, msg + 2, sizeof(uint16_t));
+		std::memcpy(&fields.id, msg + 4, sizeof(uint32_t));
+		std::memcpy(&field1Len, msg + 8, sizeof(uint16_t));
+		std::memcpy(&field2Len, msg + 10, sizeof(uint16_t));
+		fields.bodyType = static_cast<BodyType>(msg[12]);
+
+		switch (fields.type)
+		{
+			case Type::REQUEST:
+			case Type::NOTIFICATION:
+			case Type::RESPONSE_ACCEPTED:
+			case Type::RESPONSE_ERROR:
+			case Type::RESPONSE_TYPE_ERROR:
+				break;
+
+			default:
+			{
+				MS_WARN_DEV("unknown type [type:%" PRIu8 "]", static_cast<uint8_t>(fields.type));
+
+				return false;
+			}
+		}
+
+		if (fields.bodyType > BodyType::RECORDS)
+		{
+			MS_WARN_DEV(
+			  "unknown body type [bodyType:%" PRIu8 "]", static_cast<uint8_t>(fields.bodyType));
+
+			return false;
+		}
+
+		if (HeaderSize + field1Len + field2Len > msgLen)
+		{
+			MS_WARN_DEV("fields exceed message length");
+
+			return false;
+		}
+
+		fields.field1    = msg + HeaderSize;
+		fields.field1Len = field1Len;
+		fields.field2    = fields.field1 + field1Len;
+		fields.field2Len = field2Len;
+		fields.data      = fields.field2 + field2Len;
+		fields.dataLen   = msgLen - HeaderSize - field1Len - field2Len;
+
+		return true;
+	}
+
+	void BinaryMessage::Write(
+	  std::vector<uint8_t>& buffer,
+	  Type type,
+	  uint16_t code,
+	  uint32_t id,
+	  const std::string& field1,
+	  const char* field2,
+	  BodyType bodyType,
+	  const char* data,
+	  size_t dataLen)
+	{
+		MS_TRACE();
+
+		const auto field1Len = static_cast<uint16_t>(field1.length());
+		const auto field2Len = static_cast<uint16_t>(field2 ? std::strlen(field2) : 0u);
+
+		buffer.resize(HeaderSize + field1Len + field2Len + dataLen);
+
+		auto* ptr = buffer.data();
+
+		ptr[0] = 0u;
+		ptr[1] = static_cast<uint8_t>(type);
+		std::memcpy(ptr + 2, &code, sizeof(uint16_t));
+		std::memcpy(ptr + 4, &id, sizeof(uint32_t));
+		std::memcpy(ptr + 8, &field1Len, sizeof(uint16_t));
+		std::memcpy(ptr + 10, &field2Len, sizeof(uint16_t));
+		ptr[12] = static_cast<uint8_t>(bodyType);
+
+		ptr += HeaderSize;
+
+		std::memcpy(ptr, field1.data(), field1Len);
+		ptr += field1Len;
+
+		if (field2Len != 0u)
+		{
+			std::memcpy(ptr, field2, field2Len);
+			ptr += field2Len;
+		}
+
+		if (dataLen != 0u)
+			std::memcpy(ptr, data, dataLen);
+	}
+} // namespace Channel
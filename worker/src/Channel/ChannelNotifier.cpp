@@ -15,6 +15,20 @@ namespace Channel
 	{
 		MS_TRACE();
 
+		if (this->channel->IsBinary())
+		{
+			this->channel->SendBinary(
+			  Channel::BinaryMessage::Type::NOTIFICATION,
+			  0u,
+			  std::to_string(targetId),
+			  event,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  nullptr,
+			  0u);
+
+			return;
+		}
+
 		json jsonNotification = json::object();
 
 		jsonNotification["targetId"] = targetId;
@@ -27,6 +41,20 @@ namespace Channel
 	{
 		MS_TRACE();
 
+		if (this->channel->IsBinary())
+		{
+			this->channel->SendBinary(
+			  Channel::BinaryMessage::Type::NOTIFICATION,
+			  0u,
+			  targetId,
+			  event,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  nullptr,
+			  0u);
+
+			return;
+		}
+
 		json jsonNotification = json::object();
 
 		jsonNotification["targetId"] = targetId;
@@ -39,6 +67,22 @@ namespace Channel
 	{
 		MS_TRACE();
 
+		if (this->channel->IsBinary())
+		{
+			const std::string jsonData = data.dump();
+
+			this->channel->SendBinary(
+			  Channel::BinaryMessage::Type::NOTIFICATION,
+			  0u,
+			  targetId,
+			  event,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  jsonData.c_str(),
+			  jsonData.length());
+
+			return;
+		}
+
 		json jsonNotification = json::object();
 
 		jsonNotification["targetId"] = targetId;
@@ -52,6 +96,20 @@ namespace Channel
 	{
 		MS_TRACE();
 
+		if (this->channel->IsBinary())
+		{
+			this->channel->SendBinary(
+			  Channel::BinaryMessage::Type::NOTIFICATION,
+			  0u,
+			  targetId,
+			  event,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  data.c_str(),
+			  data.length());
+
+			return;
+		}
+
 		std::string notification("{\"targetId\":\"");
 
 		notification.append(targetId);
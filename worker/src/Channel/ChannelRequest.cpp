@@ -2,9 +2,12 @@
 // #define MS_LOG_DEV_LEVEL 3
 
 #include "Channel/ChannelRequest.hpp"
+#include "Channel/BinaryMessage.hpp"
+#include "Channel/ChannelSocket.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
+#include <cstring> // std::strlen()
 
 namespace Channel
 {
@@ -70,20 +73,103 @@ namespace Channel
 		{ "rtpObserver.pause",                           ChannelRequest::MethodId::RTP_OBSERVER_PAUSE                               },
 		{ "rtpObserver.resume",                          ChannelRequest::MethodId::RTP_OBSERVER_RESUME                              },
 		{ "rtpObserver.addProducer",                     ChannelRequest::MethodId::RTP_OBSERVER_ADD_PRODUCER                        },
-		{ "rtpObserver.removeProducer",                  ChannelRequest::MethodId::RTP_OBSERVER_REMOVE_PRODUCER                     }
+		{ "rtpObserver.removeProducer",                  ChannelRequest::MethodId::RTP_OBSERVER_REMOVE_PRODUCER                     },
+		{ "worker.dumpRtpTrace",                         ChannelRequest::MethodId::WORKER_DUMP_RTP_TRACE                            },
+		{ "worker.subscribeStats",                       ChannelRequest::MethodId::WORKER_SUBSCRIBE_STATS                           },
+		{ "worker.unsubscribeStats",                     ChannelRequest::MethodId::WORKER_UNSUBSCRIBE_STATS                         },
+		{ "worker.getMetrics",                           ChannelRequest::MethodId::WORKER_GET_METRICS                               }
 	};
 	// clang-format on
+	absl::flat_hash_map<ChannelRequest::MethodId, std::string> ChannelRequest::methodId2String = []()
+	{
+		absl::flat_hash_map<ChannelRequest::MethodId, std::string> map;
+
+		for (const auto& kv : ChannelRequest::string2MethodId)
+		{
+			map[kv.second] = kv.first;
+		}
+
+		return map;
+	}();
 
 	/* Instance methods. */
 
+	ChannelRequest::ChannelRequest(Channel::ChannelSocket* channel, const char* msg, size_t msgLen)
+	  : channel(channel)
+	{
+		MS_TRACE();
+
+		if (Channel::BinaryMessage::IsBinary(msg, msgLen))
+			ParseBinary(msg, msgLen);
+		else
+			ParseText(msg, msgLen);
+	}
+
+	ChannelRequest::~ChannelRequest()
+	{
+		MS_TRACE();
+	}
+
+	/**
+	 * msg is a binary request (see BinaryMessage.hpp) whose data is a JSON object.
+	 */
+	void ChannelRequest::ParseBinary(const char* msg, size_t msgLen)
+	{
+		MS_TRACE();
+
+		Channel::BinaryMessage::Fields fields;
+
+		// clang-format off
+		if (
+			!Channel::BinaryMessage::Parse(msg, msgLen, fields) ||
+			fields.type != Channel::BinaryMessage::Type::REQUEST
+		)
+		// clang-format on
+		{
+			MS_THROW_ERROR("invalid binary request");
+		}
+
+		this->binary   = true;
+		this->id       = fields.id;
+		this->methodId = static_cast<MethodId>(fields.code);
+
+		auto methodIt = ChannelRequest::methodId2String.find(this->methodId);
+
+		if (methodIt == ChannelRequest::methodId2String.end())
+		{
+			Error("unknown method");
+
+			MS_THROW_ERROR("unknown method id %" PRIu16, fields.code);
+		}
+
+		this->method = methodIt->second;
+
+		if (fields.field1Len != 0u)
+			this->handlerId.assign(fields.field1, fields.field1Len);
+
+		if (fields.dataLen != 0u)
+		{
+			try
+			{
+				this->data = json::parse(fields.data, fields.data + fields.dataLen);
+
+				if (!this->data.is_object())
+					this->data = json::object();
+			}
+			catch (const json::parse_error& error)
+			{
+				MS_THROW_TYPE_ERROR("JSON parsing error: %s", error.what());
+			}
+		}
+	}
+
 	/**
 	 * msg contains "id:method:handlerId:data" where:
 	 * - id: The ID of the request.
 	 * - handlerId: The ID of the target entity
 	 * - data: JSON object.
 	 */
-	ChannelRequest::ChannelRequest(Channel::ChannelSocket* channel, const char* msg, size_t msgLen)
-	  : channel(channel)
+	void ChannelRequest::ParseText(const char* msg, size_t msgLen)
 	{
 		MS_TRACE();
 
@@ -135,11 +221,6 @@ namespace Channel
 		}
 	}
 
-	ChannelRequest::~ChannelRequest()
-	{
-		MS_TRACE();
-	}
-
 	void ChannelRequest::Accept()
 	{
 		MS_TRACE();
@@ -148,6 +229,20 @@ namespace Channel
 
 		this->replied = true;
 
+		if (this->binary)
+		{
+			this->channel->SendBinary(
+			  Channel::BinaryMessage::Type::RESPONSE_ACCEPTED,
+			  this->id,
+			  "",
+			  nullptr,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  nullptr,
+			  0u);
+
+			return;
+		}
+
 		std::string response("{\"id\":");
 
 		response.append(std::to_string(this->id));
@@ -164,15 +259,60 @@ namespace Channel
 
 		this->replied = true;
 
-		json jsonResponse = json::object();
-
-		jsonResponse["id"]       = this->id;
-		jsonResponse["accepted"] = true;
+		// Serialize the data directly rather than copying it into a response
+		// object first, it may be big (dump, getStats).
+		std::string jsonData;
 
 		if (data.is_structured())
-			jsonResponse["data"] = data;
+			jsonData = data.dump();
 
-		this->channel->Send(jsonResponse);
+		if (this->binary)
+		{
+			this->channel->SendBinary(
+			  Channel::BinaryMessage::Type::RESPONSE_ACCEPTED,
+			  this->id,
+			  "",
+			  nullptr,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  jsonData.c_str(),
+			  jsonData.length());
+
+			return;
+		}
+
+		std::string response("{\"id\":");
+
+		response.append(std::to_string(this->id));
+		response.append(",\"accepted\":true");
+
+		if (!jsonData.empty())
+		{
+			response.append(",\"data\":");
+			response.append(jsonData);
+		}
+
+		response.append("}");
+
+		this->channel->Send(response);
+	}
+
+	void ChannelRequest::Accept(const Channel::BinaryBody::Writer& body)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(!this->replied, "request already replied");
+		MS_ASSERT(this->binary, "not a binary request");
+
+		this->replied = true;
+
+		this->channel->SendBinary(
+		  Channel::BinaryMessage::Type::RESPONSE_ACCEPTED,
+		  this->id,
+		  "",
+		  nullptr,
+		  body.GetBodyType(),
+		  body.GetData(),
+		  body.GetSize());
 	}
 
 	void ChannelRequest::Error(const char* reason)
@@ -183,6 +323,20 @@ namespace Channel
 
 		this->replied = true;
 
+		if (this->binary)
+		{
+			this->channel->SendBinary(
+			  Channel::BinaryMessage::Type::RESPONSE_ERROR,
+			  this->id,
+			  "",
+			  nullptr,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  reason,
+			  reason ? std::strlen(reason) : 0u);
+
+			return;
+		}
+
 		json jsonResponse = json::object();
 
 		jsonResponse["id"]    = this->id;
@@ -202,6 +356,20 @@ namespace Channel
 
 		this->replied = true;
 
+		if (this->binary)
+		{
+			this->channel->SendBinary(
+			  Channel::BinaryMessage::Type::RESPONSE_TYPE_ERROR,
+			  this->id,
+			  "",
+			  nullptr,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  reason,
+			  reason ? std::strlen(reason) : 0u);
+
+			return;
+		}
+
 		json jsonResponse = json::object();
 
 		jsonResponse["id"]    = this->id;
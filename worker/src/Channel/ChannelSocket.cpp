@@ -159,6 +159,33 @@ namespace Channel
 		  reinterpret_cast<const uint8_t*>(message.c_str()), static_cast<uint32_t>(message.length()));
 	}
 
+	void ChannelSocket::SendBinary(
+	  Channel::BinaryMessage::Type type,
+	  uint32_t id,
+	  const std::string& field1,
+	  const char* field2,
+	  Channel::BinaryMessage::BodyType bodyType,
+	  const char* data,
+	  size_t dataLen)
+	{
+		MS_TRACE_STD();
+
+		if (this->closed)
+			return;
+
+		if (dataLen > PayloadMaxLen - Channel::BinaryMessage::HeaderSize)
+		{
+			MS_ERROR_STD("message too big");
+
+			return;
+		}
+
+		Channel::BinaryMessage::Write(
+		  this->binaryBuffer, type, 0u, id, field1, field2, bodyType, data, dataLen);
+
+		SendImpl(this->binaryBuffer.data(), static_cast<uint32_t>(this->binaryBuffer.size()));
+	}
+
 	void ChannelSocket::SendLog(const char* message, uint32_t messageLen)
 	{
 		MS_TRACE_STD();
@@ -176,6 +203,38 @@ namespace Channel
 		SendImpl(reinterpret_cast<const uint8_t*>(message), messageLen);
 	}
 
+	void ChannelSocket::SendLogs(const uint8_t* data, size_t len)
+	{
+		MS_TRACE_STD();
+
+		if (this->closed)
+			return;
+
+		// Messages are already framed as the pipe expects, so write them with
+		// a single call.
+		if (!this->channelWriteFn)
+		{
+			this->producerSocket->Write(data, len);
+
+			return;
+		}
+
+		size_t offset{ 0u };
+
+		while (offset + sizeof(uint32_t) <= len)
+		{
+			uint32_t messageLen;
+
+			std::memcpy(&messageLen, data + offset, sizeof(uint32_t));
+			offset += sizeof(uint32_t);
+
+			MS_ASSERT(offset + messageLen <= len, "truncated log message");
+
+			this->channelWriteFn(data + offset, messageLen, this->channelWriteCtx);
+			offset += messageLen;
+		}
+	}
+
 	bool ChannelSocket::CallbackRead()
 	{
 		MS_TRACE_STD();
@@ -196,37 +255,7 @@ namespace Channel
 		// freed later.
 		if (free)
 		{
-			try
-			{
-				char* charMessage{ reinterpret_cast<char*>(message) };
-
-				auto* request = new Channel::ChannelRequest(this, charMessage, messageLen);
-
-				// Notify the listener.
-				try
-				{
-					this->listener->HandleRequest(request);
-				}
-				catch (const MediaSoupTypeError& error)
-				{
-					request->TypeError(error.what());
-				}
-				catch (const MediaSoupError& error)
-				{
-					request->Error(error.what());
-				}
-
-				// Delete the Request.
-				delete request;
-			}
-			catch (const json::parse_error& error)
-			{
-				MS_ERROR_STD("message parsing error: %s", error.what());
-			}
-			catch (const MediaSoupError& error)
-			{
-				MS_ERROR_STD("discarding wrong Channel request: %s", error.what());
-			}
+			OnMessage(reinterpret_cast<char*>(message), static_cast<size_t>(messageLen));
 
 			// Message needs to be freed using stored function pointer.
 			free(message, messageLen, messageCtx);
@@ -260,10 +289,14 @@ namespace Channel
 		}
 	}
 
-	void ChannelSocket::OnConsumerSocketMessage(ConsumerSocket* /*consumerSocket*/, char* msg, size_t msgLen)
+	inline void ChannelSocket::OnMessage(const char* msg, size_t msgLen)
 	{
 		MS_TRACE_STD();
 
+		// Once the remote side sends a binary message, reply and notify in binary.
+		if (Channel::BinaryMessage::IsBinary(msg, msgLen))
+			this->binary = true;
+
 		try
 		{
 			auto* request = new Channel::ChannelRequest(this, msg, msgLen);
@@ -295,6 +328,13 @@ namespace Channel
 		}
 	}
 
+	void ChannelSocket::OnConsumerSocketMessage(ConsumerSocket* /*consumerSocket*/, char* msg, size_t msgLen)
+	{
+		MS_TRACE_STD();
+
+		OnMessage(msg, msgLen);
+	}
+
 	void ChannelSocket::OnConsumerSocketClosed(ConsumerSocket* /*consumerSocket*/)
 	{
 		MS_TRACE_STD();
@@ -58,6 +58,36 @@ void ChannelMessageRegistrator::FillJson(json& jsonObject)
 	}
 }
 
+void ChannelMessageRegistrator::FillBinary(Channel::BinaryBody::Writer& writer)
+{
+	MS_TRACE();
+
+	using Key = Channel::BinaryBody::Key;
+
+	writer.StartItems(Key::CHANNEL_REQUEST_HANDLERS, this->mapChannelRequestHandlers.size());
+
+	for (const auto& kv : this->mapChannelRequestHandlers)
+	{
+		writer.AppendString(kv.first);
+	}
+
+	writer.StartItems(
+	  Key::PAYLOAD_CHANNEL_REQUEST_HANDLERS, this->mapPayloadChannelRequestHandlers.size());
+
+	for (const auto& kv : this->mapPayloadChannelRequestHandlers)
+	{
+		writer.AppendString(kv.first);
+	}
+
+	writer.StartItems(
+	  Key::PAYLOAD_CHANNEL_NOTIFICATION_HANDLERS, this->mapPayloadChannelNotificationHandlers.size());
+
+	for (const auto& kv : this->mapPayloadChannelNotificationHandlers)
+	{
+		writer.AppendString(kv.first);
+	}
+}
+
 void ChannelMessageRegistrator::RegisterHandler(
   const std::string& id,
   Channel::ChannelSocket::RequestHandler* channelRequestHandler,
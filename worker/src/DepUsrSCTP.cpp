@@ -4,6 +4,7 @@
 #include "DepUsrSCTP.hpp"
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
 #include <usrsctp.h>
 #include <cstdio> // std::vsnprintf()
 #include <mutex>
@@ -55,8 +56,9 @@ inline static void sctpDebug(const char* format, ...)
 
 thread_local DepUsrSCTP::Checker* DepUsrSCTP::checker{ nullptr };
 uint64_t DepUsrSCTP::numSctpAssociations{ 0u };
-uintptr_t DepUsrSCTP::nextSctpAssociationId{ 0u };
-absl::flat_hash_map<uintptr_t, RTC::SctpAssociation*> DepUsrSCTP::mapIdSctpAssociation;
+std::atomic<std::atomic<RTC::SctpAssociation*>*> DepUsrSCTP::chunks[DepUsrSCTP::MaxChunks];
+std::vector<uintptr_t> DepUsrSCTP::slotGenerations;
+std::vector<uintptr_t> DepUsrSCTP::freeSlots;
 
 /* Static methods. */
 
@@ -94,10 +96,15 @@ void DepUsrSCTP::ClassDestroy()
 	{
 		usrsctp_finish();
 
-		numSctpAssociations   = 0u;
-		nextSctpAssociationId = 0u;
+		numSctpAssociations = 0u;
 
-		DepUsrSCTP::mapIdSctpAssociation.clear();
+		for (auto& chunk : DepUsrSCTP::chunks)
+		{
+			delete[] chunk.exchange(nullptr);
+		}
+
+		DepUsrSCTP::slotGenerations.clear();
+		DepUsrSCTP::freeSlots.clear();
 	}
 }
 
@@ -125,22 +132,60 @@ uintptr_t DepUsrSCTP::GetNextSctpAssociationId()
 
 	std::lock_guard<std::mutex> lock(GlobalSyncMutex);
 
-	// NOTE: usrsctp_connect() fails with a value of 0.
-	if (DepUsrSCTP::nextSctpAssociationId == 0u)
-		++DepUsrSCTP::nextSctpAssociationId;
+	uintptr_t slot;
 
-	// In case we've wrapped around and need to find an empty spot from a removed
-	// SctpAssociation. Assumes we'll never be full.
-	while (DepUsrSCTP::mapIdSctpAssociation.find(DepUsrSCTP::nextSctpAssociationId) !=
-	       DepUsrSCTP::mapIdSctpAssociation.end())
+	// Reuse the slot of a removed SctpAssociation if any.
+	if (!DepUsrSCTP::freeSlots.empty())
 	{
-		++DepUsrSCTP::nextSctpAssociationId;
+		slot = DepUsrSCTP::freeSlots.back();
 
-		if (DepUsrSCTP::nextSctpAssociationId == 0u)
-			++DepUsrSCTP::nextSctpAssociationId;
+		DepUsrSCTP::freeSlots.pop_back();
 	}
+	else
+	{
+		slot = DepUsrSCTP::slotGenerations.size();
+
+		if (slot >= MaxSlots)
+			MS_THROW_ERROR("too many SctpAssociations");
+
+		auto& chunk = DepUsrSCTP::chunks[slot / SlotsPerChunk];
+
+		if (!chunk.load(std::memory_order_relaxed))
+		{
+			auto* slots = new std::atomic<RTC::SctpAssociation*>[SlotsPerChunk];
+
+			for (size_t idx{ 0u }; idx < SlotsPerChunk; ++idx)
+			{
+				slots[idx].store(nullptr, std::memory_order_relaxed);
+			}
+
+			chunk.store(slots, std::memory_order_release);
+		}
+
+		DepUsrSCTP::slotGenerations.push_back(0u);
+	}
+
+	auto& generation = DepUsrSCTP::slotGenerations[slot];
+
+	generation = GetNextSlotGeneration(generation);
+
+	return (generation << SlotBits) | slot;
+}
+
+void DepUsrSCTP::ReleaseSctpAssociationId(uintptr_t id)
+{
+	MS_TRACE();
+
+	std::lock_guard<std::mutex> lock(GlobalSyncMutex);
+
+	const uintptr_t slot = id & SlotMask;
 
-	return DepUsrSCTP::nextSctpAssociationId++;
+	MS_ASSERT(slot < DepUsrSCTP::slotGenerations.size(), "slot of the id not allocated");
+	MS_ASSERT(
+	  DepUsrSCTP::GetSlot(id).load(std::memory_order_relaxed) == nullptr,
+	  "the slot of the id is in use by a registered SctpAssociation");
+
+	DepUsrSCTP::freeSlots.push_back(slot);
 }
 
 void DepUsrSCTP::RegisterSctpAssociation(RTC::SctpAssociation* sctpAssociation)
@@ -151,13 +196,13 @@ void DepUsrSCTP::RegisterSctpAssociation(RTC::SctpAssociation* sctpAssociation)
 
 	MS_ASSERT(DepUsrSCTP::checker != nullptr, "Checker not created");
 
-	auto it = DepUsrSCTP::mapIdSctpAssociation.find(sctpAssociation->id);
+	auto& slot = DepUsrSCTP::GetSlot(sctpAssociation->id);
 
 	MS_ASSERT(
-	  it == DepUsrSCTP::mapIdSctpAssociation.end(),
-	  "the id of the SctpAssociation is already in the map");
+	  slot.load(std::memory_order_relaxed) == nullptr,
+	  "the slot of the SctpAssociation is already in use");
 
-	DepUsrSCTP::mapIdSctpAssociation[sctpAssociation->id] = sctpAssociation;
+	slot.store(sctpAssociation, std::memory_order_release);
 
 	if (++DepUsrSCTP::numSctpAssociations == 1u)
 		DepUsrSCTP::checker->Start();
@@ -171,11 +216,15 @@ void DepUsrSCTP::DeregisterSctpAssociation(RTC::SctpAssociation* sctpAssociation
 
 	MS_ASSERT(DepUsrSCTP::checker != nullptr, "Checker not created");
 
-	auto found = DepUsrSCTP::mapIdSctpAssociation.erase(sctpAssociation->id);
+	auto& slot = DepUsrSCTP::GetSlot(sctpAssociation->id);
 
-	MS_ASSERT(found > 0, "SctpAssociation not found");
+	MS_ASSERT(slot.load(std::memory_order_relaxed) == sctpAssociation, "SctpAssociation not found");
 	MS_ASSERT(DepUsrSCTP::numSctpAssociations > 0u, "numSctpAssociations was not higher than 0");
 
+	slot.store(nullptr, std::memory_order_release);
+
+	DepUsrSCTP::freeSlots.push_back(sctpAssociation->id & SlotMask);
+
 	if (--DepUsrSCTP::numSctpAssociations == 0u)
 		DepUsrSCTP::checker->Stop();
 }
@@ -184,14 +233,29 @@ RTC::SctpAssociation* DepUsrSCTP::RetrieveSctpAssociation(uintptr_t id)
 {
 	MS_TRACE();
 
-	std::lock_guard<std::mutex> lock(GlobalSyncMutex);
+	// NOTE: No lock here since this is called for every SCTP packet and
+	// notification. Chunks are never freed while there are SctpAssociations.
+	const uintptr_t slot = id & SlotMask;
+	auto* chunk          = DepUsrSCTP::chunks[slot / SlotsPerChunk].load(std::memory_order_acquire);
+
+	if (!chunk)
+		return nullptr;
 
-	auto it = DepUsrSCTP::mapIdSctpAssociation.find(id);
+	auto* sctpAssociation = chunk[slot % SlotsPerChunk].load(std::memory_order_acquire);
 
-	if (it == DepUsrSCTP::mapIdSctpAssociation.end())
+	// The slot may be empty or belong to another SctpAssociation now.
+	if (!sctpAssociation || sctpAssociation->id != id)
 		return nullptr;
 
-	return it->second;
+	return sctpAssociation;
+}
+
+std::atomic<RTC::SctpAssociation*>& DepUsrSCTP::GetSlot(uintptr_t id)
+{
+	const uintptr_t slot = id & SlotMask;
+	auto* chunk          = DepUsrSCTP::chunks[slot / SlotsPerChunk].load(std::memory_order_relaxed);
+
+	return chunk[slot % SlotsPerChunk];
 }
 
 /* DepUsrSCTP::Checker instance methods. */
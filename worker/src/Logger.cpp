@@ -2,13 +2,49 @@
 // #define MS_LOG_DEV_LEVEL 3
 
 #include "Logger.hpp"
+#include "DepLibUV.hpp"
+#include "MediaSoupErrors.hpp"
 #include <uv.h>
+#include <algorithm> // std::min()
+#include <vector>
+
+/* Static. */
+
+// Buffered messages in batching mode, framed as ChannelSocket::SendLogs()
+// expects.
+thread_local static std::vector<uint8_t> BatchBuffer;
+thread_local static uv_prepare_t* FlushPrepareHandle{ nullptr };
+thread_local static uv_check_t* FlushCheckHandle{ nullptr };
+
+/* Static methods for UV callbacks. */
+
+inline static void onFlushPrepare(uv_prepare_t* /*handle*/)
+{
+	Logger::Flush();
+}
+
+inline static void onFlushCheck(uv_check_t* /*handle*/)
+{
+	Logger::Flush();
+}
+
+inline static void onClosePrepare(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_prepare_t*>(handle);
+}
+
+inline static void onCloseCheck(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_check_t*>(handle);
+}
 
 /* Class variables. */
 
 const uint64_t Logger::pid{ static_cast<uint64_t>(uv_os_getpid()) };
 thread_local Channel::ChannelSocket* Logger::channel{ nullptr };
 thread_local char Logger::buffer[Logger::bufferSize];
+thread_local bool Logger::batching{ false };
+thread_local uint64_t Logger::numSuppressed{ 0u };
 
 /* Class methods. */
 
@@ -18,3 +54,174 @@ void Logger::ClassInit(Channel::ChannelSocket* channel)
 
 	MS_TRACE();
 }
+
+void Logger::SetBatching(bool enabled)
+{
+	MS_TRACE();
+
+	if (enabled == Logger::batching)
+		return;
+
+	if (enabled)
+	{
+		int err;
+
+		FlushPrepareHandle = new uv_prepare_t;
+		FlushCheckHandle   = new uv_check_t;
+
+		err = uv_prepare_init(DepLibUV::GetLoop(), FlushPrepareHandle);
+
+		if (err != 0)
+		{
+			delete FlushPrepareHandle;
+			FlushPrepareHandle = nullptr;
+			delete FlushCheckHandle;
+			FlushCheckHandle = nullptr;
+
+			MS_THROW_ERROR("uv_prepare_init() failed: %s", uv_strerror(err));
+		}
+
+		err = uv_check_init(DepLibUV::GetLoop(), FlushCheckHandle);
+
+		if (err != 0)
+		{
+			uv_close(
+			  reinterpret_cast<uv_handle_t*>(FlushPrepareHandle),
+			  static_cast<uv_close_cb>(onClosePrepare));
+			FlushPrepareHandle = nullptr;
+			delete FlushCheckHandle;
+			FlushCheckHandle = nullptr;
+
+			MS_THROW_ERROR("uv_check_init() failed: %s", uv_strerror(err));
+		}
+
+		// Flush before the loop blocks for I/O and after processing it. These
+		// handles must not keep the loop alive.
+		uv_prepare_start(FlushPrepareHandle, static_cast<uv_prepare_cb>(onFlushPrepare));
+		uv_check_start(FlushCheckHandle, static_cast<uv_check_cb>(onFlushCheck));
+		uv_unref(reinterpret_cast<uv_handle_t*>(FlushPrepareHandle));
+		uv_unref(reinterpret_cast<uv_handle_t*>(FlushCheckHandle));
+
+		BatchBuffer.reserve(MaxBatchBufferSize);
+
+		Logger::batching = true;
+	}
+	else
+	{
+		Logger::Flush();
+
+		Logger::batching = false;
+
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(FlushPrepareHandle), static_cast<uv_close_cb>(onClosePrepare));
+		FlushPrepareHandle = nullptr;
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(FlushCheckHandle), static_cast<uv_close_cb>(onCloseCheck));
+		FlushCheckHandle = nullptr;
+
+		std::vector<uint8_t>().swap(BatchBuffer);
+	}
+}
+
+bool Logger::IsAllowed(CallSite& callSite)
+{
+	if (!Logger::batching)
+		return true;
+
+	const uint64_t nowMs = DepLibUV::GetTimeMs();
+
+	if (nowMs - callSite.windowStartMs >= RateLimitWindowMs)
+	{
+		callSite.windowStartMs = nowMs;
+		callSite.numLogged     = 0u;
+	}
+
+	if (callSite.numLogged >= MaxMessagesPerWindow)
+	{
+		++callSite.numSuppressed;
+		++Logger::numSuppressed;
+
+		return false;
+	}
+
+	++callSite.numLogged;
+
+	return true;
+}
+
+void Logger::SendLog(const char* message, int messageLen)
+{
+	if (messageLen < 0)
+		return;
+
+	// std::snprintf() returns the length the message would have had.
+	auto len = std::min(static_cast<size_t>(messageLen), Logger::bufferSize - 1);
+
+	if (!Logger::batching)
+	{
+		Logger::channel->SendLog(message, static_cast<uint32_t>(len));
+
+		return;
+	}
+
+	if (BatchBuffer.size() + sizeof(uint32_t) + len > MaxBatchBufferSize)
+		Logger::Flush();
+
+	const auto frameLen     = static_cast<uint32_t>(len);
+	const auto* frameLenPtr = reinterpret_cast<const uint8_t*>(&frameLen);
+
+	BatchBuffer.insert(BatchBuffer.end(), frameLenPtr, frameLenPtr + sizeof(uint32_t));
+	BatchBuffer.insert(
+	  BatchBuffer.end(),
+	  reinterpret_cast<const uint8_t*>(message),
+	  reinterpret_cast<const uint8_t*>(message) + len);
+}
+
+void Logger::SendErrorLog(const char* message, int messageLen)
+{
+	if (messageLen < 0)
+		return;
+
+	auto len = std::min(static_cast<size_t>(messageLen), Logger::bufferSize - 1);
+
+	// Written right away so it is not lost if the worker dies before the loop
+	// flushes, but after the messages buffered before.
+	Logger::Flush();
+
+	Logger::channel->SendLog(message, static_cast<uint32_t>(len));
+}
+
+void Logger::SendLog(CallSite& callSite, char* message, int messageLen)
+{
+	if (messageLen < 0)
+		return;
+
+	// Tell how many messages of this call site were suppressed since the
+	// previous one.
+	if (callSite.numSuppressed != 0u)
+	{
+		auto len = std::min(static_cast<size_t>(messageLen), Logger::bufferSize - 1);
+
+		const int suppressedLen = std::snprintf(
+		  message + len,
+		  Logger::bufferSize - len,
+		  " [%" PRIu32 " similar messages suppressed]",
+		  callSite.numSuppressed);
+
+		messageLen = static_cast<int>(len) + suppressedLen;
+
+		callSite.numSuppressed = 0u;
+	}
+
+	Logger::SendLog(message, messageLen);
+}
+
+void Logger::Flush()
+{
+	if (BatchBuffer.empty())
+		return;
+
+	Logger::channel->SendLogs(BatchBuffer.data(), BatchBuffer.size());
+
+	BatchBuffer.clear();
+}
@@ -0,0 +1,143 @@
+#define MS_CLASS "Metrics"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "Metrics.hpp"
+#include "Logger.hpp"
+#include <cinttypes> // PRIu64
+#include <cstdio>    // std::snprintf()
+#include <cstring>   // std::strcmp()
+
+/* Static. */
+
+struct CounterInfo
+{
+	const char* name;
+	const char* help;
+	const char* labels;
+};
+
+// Indexed by Metrics::Counter. Consecutive entries with same name are rendered
+// as a single family.
+// clang-format off
+static const CounterInfo CounterInfos[Metrics::NumCounters] =
+{
+	{ "mediasoup_worker_rtp_packets_routed", "RTP packets received by Producers and routed by Routers.", "" },
+	{ "mediasoup_worker_rtp_packets_sent",   "RTP packets sent to Consumers.",                           "" },
+	{ "mediasoup_worker_srtp_failures",      "Failed SRTP operations.",                                  "operation=\"protect_rtp\"" },
+	{ "mediasoup_worker_srtp_failures",      "Failed SRTP operations.",                                  "operation=\"unprotect_rtp\"" },
+	{ "mediasoup_worker_srtp_failures",      "Failed SRTP operations.",                                  "operation=\"protect_rtcp\"" },
+	{ "mediasoup_worker_srtp_failures",      "Failed SRTP operations.",                                  "operation=\"unprotect_rtcp\"" },
+	{ "mediasoup_worker_send_eagain",        "Sends that could not be done at once and were queued.",    "protocol=\"udp\"" },
+	{ "mediasoup_worker_send_eagain",        "Sends that could not be done at once and were queued.",    "protocol=\"tcp\"" }
+};
+// clang-format on
+
+static const char* DropsName{ "mediasoup_worker_rtp_packets_dropped" };
+static const char* LoopLagName{ "mediasoup_worker_event_loop_lag_seconds" };
+
+inline static void appendFamily(
+  std::string& text, const char* name, const char* type, const char* help)
+{
+	text.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+	text.append("# HELP ").append(name).append(" ").append(help).append("\n");
+}
+
+inline static void appendSample(
+  std::string& text,
+  const char* name,
+  const char* suffix,
+  const std::string& labels,
+  uint64_t value)
+{
+	text.append(name).append(suffix);
+
+	if (!labels.empty())
+		text.append("{").append(labels).append("}");
+
+	text.append(" ").append(std::to_string(value)).append("\n");
+}
+
+// Renders microseconds as seconds.
+inline static std::string toSeconds(uint64_t us)
+{
+	char buffer[32];
+
+	std::snprintf(buffer, sizeof(buffer), "%" PRIu64 ".%06" PRIu64, us / 1000000u, us % 1000000u);
+
+	return buffer;
+}
+
+/* Class variables. */
+
+constexpr uint64_t Metrics::LoopLagBucketsUs[];
+thread_local Metrics::Data Metrics::data{};
+
+/* Class methods. */
+
+void Metrics::ObserveLoopLag(uint64_t lagUs)
+{
+	size_t idx{ 0u };
+
+	while (idx < NumLoopLagBuckets && lagUs > LoopLagBucketsUs[idx])
+	{
+		++idx;
+	}
+
+	++Metrics::data.loopLagBuckets[idx];
+	Metrics::data.loopLagSumUs += lagUs;
+	++Metrics::data.loopLagCount;
+}
+
+std::string Metrics::Render()
+{
+	MS_TRACE();
+
+	std::string text;
+
+	text.reserve(4096u);
+
+	for (size_t idx{ 0u }; idx < NumCounters; ++idx)
+	{
+		const auto& info = CounterInfos[idx];
+
+		if (idx == 0u || std::strcmp(info.name, CounterInfos[idx - 1].name) != 0)
+			appendFamily(text, info.name, "counter", info.help);
+
+		appendSample(text, info.name, "_total", info.labels, Metrics::data.counters[idx]);
+	}
+
+	appendFamily(text, DropsName, "counter", "RTP packets dropped instead of sent to a Consumer.");
+
+	for (size_t idx{ 1u }; idx < NumDropReasons; ++idx)
+	{
+		const auto dropReason = static_cast<RTC::RtcLogger::RtpPacket::DropReason>(idx);
+		const auto& reason    = RTC::RtcLogger::RtpPacket::dropReason2String[dropReason];
+
+		appendSample(
+		  text, DropsName, "_total", "reason=\"" + reason + "\"", Metrics::data.rtpPacketsDropped[idx]);
+	}
+
+	appendFamily(
+	  text, LoopLagName, "histogram", "Delay of the event loop running timers after their due time.");
+
+	uint64_t cumulative{ 0u };
+
+	for (size_t idx{ 0u }; idx <= NumLoopLagBuckets; ++idx)
+	{
+		cumulative += Metrics::data.loopLagBuckets[idx];
+
+		const auto le = idx < NumLoopLagBuckets ? toSeconds(LoopLagBucketsUs[idx]) : "+Inf";
+
+		appendSample(text, LoopLagName, "_bucket", "le=\"" + le + "\"", cumulative);
+	}
+
+	text.append(LoopLagName)
+	  .append("_sum ")
+	  .append(toSeconds(Metrics::data.loopLagSumUs))
+	  .append("\n");
+	appendSample(text, LoopLagName, "_count", "", Metrics::data.loopLagCount);
+
+	text.append("# EOF\n");
+
+	return text;
+}
@@ -2,6 +2,7 @@
 // #define MS_LOG_DEV_LEVEL 3
 
 #include "PayloadChannel/PayloadChannelNotification.hpp"
+#include "Channel/BinaryMessage.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
@@ -18,6 +19,18 @@ namespace PayloadChannel
 		{ "dataProducer.send",  PayloadChannelNotification::EventId::DATA_PRODUCER_SEND  }
 	};
 	// clang-format on
+	absl::flat_hash_map<PayloadChannelNotification::EventId, std::string> PayloadChannelNotification::eventId2String =
+	  []()
+	{
+		absl::flat_hash_map<PayloadChannelNotification::EventId, std::string> map;
+
+		for (const auto& kv : PayloadChannelNotification::string2EventId)
+		{
+			map[kv.second] = kv.first;
+		}
+
+		return map;
+	}();
 
 	/* Class methods. */
 
@@ -25,7 +38,12 @@ namespace PayloadChannel
 	{
 		MS_TRACE();
 
-		return (msgLen > 2 && msg[0] == 'n' && msg[1] == ':');
+		// clang-format off
+		return (
+			(msgLen > 2 && msg[0] == 'n' && msg[1] == ':') ||
+			Channel::BinaryMessage::IsBinary(msg, msgLen, Channel::BinaryMessage::Type::NOTIFICATION)
+		);
+		// clang-format on
 	}
 
 	/* Instance methods. */
@@ -34,6 +52,67 @@ namespace PayloadChannel
 	{
 		MS_TRACE();
 
+		if (Channel::BinaryMessage::IsBinary(msg, msgLen))
+			ParseBinary(msg, msgLen);
+		else
+			ParseText(msg + 2, msgLen - 2);
+	}
+
+	PayloadChannelNotification::~PayloadChannelNotification()
+	{
+		MS_TRACE();
+	}
+
+	void PayloadChannelNotification::SetPayload(const uint8_t* payload, size_t payloadLen)
+	{
+		MS_TRACE();
+
+		this->payload    = payload;
+		this->payloadLen = payloadLen;
+	}
+
+	/**
+	 * msg is a binary notification (see BinaryMessage.hpp).
+	 */
+	void PayloadChannelNotification::ParseBinary(const char* msg, size_t msgLen)
+	{
+		MS_TRACE();
+
+		Channel::BinaryMessage::Fields fields;
+
+		// clang-format off
+		if (
+			!Channel::BinaryMessage::Parse(msg, msgLen, fields) ||
+			fields.type != Channel::BinaryMessage::Type::NOTIFICATION
+		)
+		// clang-format on
+		{
+			MS_THROW_ERROR("invalid binary notification");
+		}
+
+		this->eventId = static_cast<EventId>(fields.code);
+
+		auto eventIt = PayloadChannelNotification::eventId2String.find(this->eventId);
+
+		if (eventIt == PayloadChannelNotification::eventId2String.end())
+			MS_THROW_ERROR("unknown event id %" PRIu16, fields.code);
+
+		this->event = eventIt->second;
+
+		if (fields.field1Len != 0u)
+			this->handlerId.assign(fields.field1, fields.field1Len);
+
+		if (fields.dataLen != 0u)
+			this->data.assign(fields.data, fields.dataLen);
+	}
+
+	/**
+	 * msg contains "event:handlerId:data".
+	 */
+	void PayloadChannelNotification::ParseText(const char* msg, size_t msgLen)
+	{
+		MS_TRACE();
+
 		auto info = Utils::String::Split(std::string(msg, msgLen), ':');
 
 		if (info.size() < 1)
@@ -64,17 +143,4 @@ namespace PayloadChannel
 				this->data = data;
 		}
 	}
-
-	PayloadChannelNotification::~PayloadChannelNotification()
-	{
-		MS_TRACE();
-	}
-
-	void PayloadChannelNotification::SetPayload(const uint8_t* payload, size_t payloadLen)
-	{
-		MS_TRACE();
-
-		this->payload    = payload;
-		this->payloadLen = payloadLen;
-	}
 } // namespace PayloadChannel
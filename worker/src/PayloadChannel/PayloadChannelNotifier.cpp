@@ -12,11 +12,59 @@ namespace PayloadChannel
 		MS_TRACE();
 	}
 
+	void PayloadChannelNotifier::Emit(
+	  uint64_t targetId, const char* event, json& data, const uint8_t* payload, size_t payloadLen)
+	{
+		MS_TRACE();
+
+		if (this->payloadChannel->IsBinary())
+		{
+			const std::string jsonData = data.dump();
+
+			this->payloadChannel->SendBinary(
+			  Channel::BinaryMessage::Type::NOTIFICATION,
+			  0u,
+			  std::to_string(targetId),
+			  event,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  jsonData.c_str(),
+			  jsonData.length(),
+			  payload,
+			  payloadLen);
+
+			return;
+		}
+
+		json jsonNotification = json::object();
+
+		jsonNotification["targetId"] = targetId;
+		jsonNotification["event"]    = event;
+		jsonNotification["data"]     = data;
+
+		this->payloadChannel->Send(jsonNotification, payload, payloadLen);
+	}
+
 	void PayloadChannelNotifier::Emit(
 	  const std::string& targetId, const char* event, const uint8_t* payload, size_t payloadLen)
 	{
 		MS_TRACE();
 
+		if (this->payloadChannel->IsBinary())
+		{
+			this->payloadChannel->SendBinary(
+			  Channel::BinaryMessage::Type::NOTIFICATION,
+			  0u,
+			  targetId,
+			  event,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  nullptr,
+			  0u,
+			  payload,
+			  payloadLen);
+
+			return;
+		}
+
 		std::string notification("{\"targetId\":\"");
 
 		notification.append(targetId);
@@ -32,6 +80,24 @@ namespace PayloadChannel
 	{
 		MS_TRACE();
 
+		if (this->payloadChannel->IsBinary())
+		{
+			const std::string jsonData = data.dump();
+
+			this->payloadChannel->SendBinary(
+			  Channel::BinaryMessage::Type::NOTIFICATION,
+			  0u,
+			  targetId,
+			  event,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  jsonData.c_str(),
+			  jsonData.length(),
+			  payload,
+			  payloadLen);
+
+			return;
+		}
+
 		json jsonNotification = json::object();
 
 		jsonNotification["targetId"] = targetId;
@@ -40,4 +106,64 @@ namespace PayloadChannel
 
 		this->payloadChannel->Send(jsonNotification, payload, payloadLen);
 	}
+
+	void PayloadChannelNotifier::Emit(
+	  const std::string& targetId,
+	  const char* event,
+	  const std::string& data,
+	  const uint8_t* payload,
+	  size_t payloadLen)
+	{
+		MS_TRACE();
+
+		if (this->payloadChannel->IsBinary())
+		{
+			this->payloadChannel->SendBinary(
+			  Channel::BinaryMessage::Type::NOTIFICATION,
+			  0u,
+			  targetId,
+			  event,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  data.c_str(),
+			  data.length(),
+			  payload,
+			  payloadLen);
+
+			return;
+		}
+
+		std::string notification("{\"targetId\":\"");
+
+		notification.append(targetId);
+		notification.append("\",\"event\":\"");
+		notification.append(event);
+		notification.append("\",\"data\":");
+		notification.append(data);
+		notification.append("}");
+
+		this->payloadChannel->Send(notification, payload, payloadLen);
+	}
+
+	void PayloadChannelNotifier::Emit(
+	  const std::string& targetId,
+	  const char* event,
+	  const Channel::BinaryBody::Writer& body,
+	  const uint8_t* payload,
+	  size_t payloadLen)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(this->payloadChannel->IsBinary(), "not a binary PayloadChannel");
+
+		this->payloadChannel->SendBinary(
+		  Channel::BinaryMessage::Type::NOTIFICATION,
+		  0u,
+		  targetId,
+		  event,
+		  body.GetBodyType(),
+		  body.GetData(),
+		  body.GetSize(),
+		  payload,
+		  payloadLen);
+	}
 } // namespace PayloadChannel
@@ -5,7 +5,9 @@
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
+#include "Channel/BinaryMessage.hpp"
 #include "PayloadChannel/PayloadChannelSocket.hpp"
+#include <cstring> // std::strlen()
 
 namespace PayloadChannel
 {
@@ -17,6 +19,18 @@ namespace PayloadChannel
 		{ "dataConsumer.send", PayloadChannelRequest::MethodId::DATA_CONSUMER_SEND },
 	};
 	// clang-format on
+	absl::flat_hash_map<PayloadChannelRequest::MethodId, std::string> PayloadChannelRequest::methodId2String =
+	  []()
+	{
+		absl::flat_hash_map<PayloadChannelRequest::MethodId, std::string> map;
+
+		for (const auto& kv : PayloadChannelRequest::string2MethodId)
+		{
+			map[kv.second] = kv.first;
+		}
+
+		return map;
+	}();
 
 	/* Class methods. */
 
@@ -24,20 +38,81 @@ namespace PayloadChannel
 	{
 		MS_TRACE();
 
-		return (msgLen > 2 && msg[0] == 'r' && msg[1] == ':');
+		// clang-format off
+		return (
+			(msgLen > 2 && msg[0] == 'r' && msg[1] == ':') ||
+			Channel::BinaryMessage::IsBinary(msg, msgLen, Channel::BinaryMessage::Type::REQUEST)
+		);
+		// clang-format on
 	}
 
 	/* Instance methods. */
 
+	PayloadChannelRequest::PayloadChannelRequest(
+	  PayloadChannel::PayloadChannelSocket* channel, char* msg, size_t msgLen)
+	  : channel(channel)
+	{
+		MS_TRACE();
+
+		if (Channel::BinaryMessage::IsBinary(msg, msgLen))
+			ParseBinary(msg, msgLen);
+		else
+			ParseText(msg + 2, msgLen - 2);
+	}
+
+	PayloadChannelRequest::~PayloadChannelRequest()
+	{
+		MS_TRACE();
+	}
+
+	/**
+	 * msg is a binary request (see BinaryMessage.hpp).
+	 */
+	void PayloadChannelRequest::ParseBinary(const char* msg, size_t msgLen)
+	{
+		MS_TRACE();
+
+		Channel::BinaryMessage::Fields fields;
+
+		// clang-format off
+		if (
+			!Channel::BinaryMessage::Parse(msg, msgLen, fields) ||
+			fields.type != Channel::BinaryMessage::Type::REQUEST
+		)
+		// clang-format on
+		{
+			MS_THROW_ERROR("invalid binary request");
+		}
+
+		this->binary   = true;
+		this->id       = fields.id;
+		this->methodId = static_cast<MethodId>(fields.code);
+
+		auto methodIt = PayloadChannelRequest::methodId2String.find(this->methodId);
+
+		if (methodIt == PayloadChannelRequest::methodId2String.end())
+		{
+			Error("unknown method");
+
+			MS_THROW_ERROR("unknown method id %" PRIu16, fields.code);
+		}
+
+		this->method = methodIt->second;
+
+		if (fields.field1Len != 0u)
+			this->handlerId.assign(fields.field1, fields.field1Len);
+
+		if (fields.dataLen != 0u)
+			this->data.assign(fields.data, fields.dataLen);
+	}
+
 	/**
 	 * msg contains "id:method:handlerId:data" where:
 	 * - id: The ID of the request.
 	 * - handlerId: The ID of the target entity
 	 * - data: JSON object.
 	 */
-	PayloadChannelRequest::PayloadChannelRequest(
-	  PayloadChannel::PayloadChannelSocket* channel, char* msg, size_t msgLen)
-	  : channel(channel)
+	void PayloadChannelRequest::ParseText(const char* msg, size_t msgLen)
 	{
 		MS_TRACE();
 
@@ -77,11 +152,6 @@ namespace PayloadChannel
 		}
 	}
 
-	PayloadChannelRequest::~PayloadChannelRequest()
-	{
-		MS_TRACE();
-	}
-
 	void PayloadChannelRequest::Accept()
 	{
 		MS_TRACE();
@@ -90,6 +160,20 @@ namespace PayloadChannel
 
 		this->replied = true;
 
+		if (this->binary)
+		{
+			this->channel->SendBinary(
+			  Channel::BinaryMessage::Type::RESPONSE_ACCEPTED,
+			  this->id,
+			  "",
+			  nullptr,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  nullptr,
+			  0u);
+
+			return;
+		}
+
 		std::string response("{\"id\":");
 
 		response.append(std::to_string(this->id));
@@ -106,6 +190,25 @@ namespace PayloadChannel
 
 		this->replied = true;
 
+		if (this->binary)
+		{
+			std::string jsonData;
+
+			if (data.is_structured())
+				jsonData = data.dump();
+
+			this->channel->SendBinary(
+			  Channel::BinaryMessage::Type::RESPONSE_ACCEPTED,
+			  this->id,
+			  "",
+			  nullptr,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  jsonData.c_str(),
+			  jsonData.length());
+
+			return;
+		}
+
 		json jsonResponse = json::object();
 
 		jsonResponse["id"]       = this->id;
@@ -125,6 +228,20 @@ namespace PayloadChannel
 
 		this->replied = true;
 
+		if (this->binary)
+		{
+			this->channel->SendBinary(
+			  Channel::BinaryMessage::Type::RESPONSE_ERROR,
+			  this->id,
+			  "",
+			  nullptr,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  reason,
+			  reason ? std::strlen(reason) : 0u);
+
+			return;
+		}
+
 		json jsonResponse = json::object();
 
 		jsonResponse["id"]    = this->id;
@@ -144,6 +261,20 @@ namespace PayloadChannel
 
 		this->replied = true;
 
+		if (this->binary)
+		{
+			this->channel->SendBinary(
+			  Channel::BinaryMessage::Type::RESPONSE_TYPE_ERROR,
+			  this->id,
+			  "",
+			  nullptr,
+			  Channel::BinaryMessage::BodyType::JSON,
+			  reason,
+			  reason ? std::strlen(reason) : 0u);
+
+			return;
+		}
+
 		json jsonResponse = json::object();
 
 		jsonResponse["id"]    = this->id;
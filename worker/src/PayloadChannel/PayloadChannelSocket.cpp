@@ -200,6 +200,53 @@ namespace PayloadChannel
 		  reinterpret_cast<const uint8_t*>(message.c_str()), static_cast<uint32_t>(message.length()));
 	}
 
+	void PayloadChannelSocket::SendBinary(
+	  Channel::BinaryMessage::Type type,
+	  uint32_t id,
+	  const std::string& field1,
+	  const char* field2,
+	  Channel::BinaryMessage::BodyType bodyType,
+	  const char* data,
+	  size_t dataLen,
+	  const uint8_t* payload,
+	  size_t payloadLen)
+	{
+		MS_TRACE();
+
+		if (this->closed)
+			return;
+
+		if (dataLen > PayloadMaxLen - Channel::BinaryMessage::HeaderSize)
+		{
+			MS_ERROR("message too big");
+
+			return;
+		}
+		else if (payloadLen > PayloadMaxLen)
+		{
+			MS_ERROR("payload too big");
+
+			return;
+		}
+
+		Channel::BinaryMessage::Write(
+		  this->binaryBuffer, type, 0u, id, field1, field2, bodyType, data, dataLen);
+
+		// Notifications are always followed by their payload, even if empty.
+		if (type == Channel::BinaryMessage::Type::NOTIFICATION)
+		{
+			SendImpl(
+			  this->binaryBuffer.data(),
+			  static_cast<uint32_t>(this->binaryBuffer.size()),
+			  payload,
+			  static_cast<uint32_t>(payloadLen));
+		}
+		else
+		{
+			SendImpl(this->binaryBuffer.data(), static_cast<uint32_t>(this->binaryBuffer.size()));
+		}
+	}
+
 	bool PayloadChannelSocket::CallbackRead()
 	{
 		MS_TRACE();
@@ -235,12 +282,17 @@ namespace PayloadChannel
 			{
 				char* charMessage{ reinterpret_cast<char*>(message) };
 
+				// Once the remote side sends a binary message, reply and notify in
+				// binary.
+				if (Channel::BinaryMessage::IsBinary(charMessage, messageLen))
+					this->binary = true;
+
 				if (PayloadChannelRequest::IsRequest(charMessage, messageLen))
 				{
 					try
 					{
 						auto* request =
-						  new PayloadChannel::PayloadChannelRequest(this, charMessage + 2, messageLen - 2);
+						  new PayloadChannel::PayloadChannelRequest(this, charMessage, messageLen);
 						request->SetPayload(payload, payloadLen);
 
 						// Notify the listener.
@@ -275,7 +327,7 @@ namespace PayloadChannel
 					try
 					{
 						auto* notification =
-						  new PayloadChannel::PayloadChannelNotification(charMessage + 2, messageLen - 2);
+						  new PayloadChannel::PayloadChannelNotification(charMessage, messageLen);
 						notification->SetPayload(payload, payloadLen);
 
 						// Notify the listener.
@@ -373,11 +425,14 @@ namespace PayloadChannel
 
 		if (!this->ongoingNotification && !this->ongoingRequest)
 		{
+			if (Channel::BinaryMessage::IsBinary(msg, msgLen))
+				this->binary = true;
+
 			if (PayloadChannelRequest::IsRequest(msg, msgLen))
 			{
 				try
 				{
-					this->ongoingRequest = new PayloadChannel::PayloadChannelRequest(this, msg + 2, msgLen - 2);
+					this->ongoingRequest = new PayloadChannel::PayloadChannelRequest(this, msg, msgLen);
 				}
 				catch (const json::parse_error& error)
 				{
@@ -392,8 +447,7 @@ namespace PayloadChannel
 			{
 				try
 				{
-					this->ongoingNotification =
-					  new PayloadChannel::PayloadChannelNotification(msg + 2, msgLen - 2);
+					this->ongoingNotification = new PayloadChannel::PayloadChannelNotification(msg, msgLen);
 				}
 				catch (const json::parse_error& error)
 				{
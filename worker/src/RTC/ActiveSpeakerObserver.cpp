@@ -5,6 +5,8 @@
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
 #include "RTC/RtpDictionaries.hpp"
+#include <array>
+#include <cmath>
 
 namespace RTC
 {
@@ -94,6 +96,46 @@ namespace RTC
 		return changed;
 	}
 
+	// Logarithm of the activity score for every possible number of active
+	// subunits in an interval, so scoring a speaker is just a table lookup and
+	// comparing two of them is just a subtraction.
+	template<uint32_t N>
+	std::array<double, N + 1> ComputeLogActivityScores(const double lambda)
+	{
+		std::array<double, N + 1> logScores;
+
+		for (uint32_t vL{ 0u }; vL <= N; ++vL)
+		{
+			logScores[vL] = std::log(ComputeActivityScore(vL, N, 0.5, lambda));
+		}
+
+		return logScores;
+	}
+
+	static const std::array<double, N1 + 1> ImmediateLogScores{ ComputeLogActivityScores<N1>(0.78) };
+	static const std::array<double, N2 + 1> MediumLogScores{ ComputeLogActivityScores<N2>(24) };
+	static const std::array<double, N3 + 1> LongLogScores{ ComputeLogActivityScores<N3>(47) };
+	static const double MinLogActivityScore{ std::log(MinActivityScore) };
+
+	/* Class methods. */
+
+	double ActiveSpeakerObserver::GetLogActivityScore(uint8_t interval, uint8_t vL)
+	{
+		MS_TRACE();
+
+		switch (interval)
+		{
+			case 0:
+				return ImmediateLogScores.at(vL);
+			case 1:
+				return MediumLogScores.at(vL);
+			default:
+				return LongLogScores.at(vL);
+		}
+	}
+
+	/* Instance methods. */
+
 	ActiveSpeakerObserver::ActiveSpeakerObserver(
 	  RTC::Shared* shared, const std::string& id, RTC::RtpObserver::Listener* listener, json& data)
 	  : RTC::RtpObserver(shared, id, listener)
@@ -133,16 +175,6 @@ namespace RTC
 		this->shared->channelMessageRegistrator->UnregisterHandler(this->id);
 
 		delete this->periodicTimer;
-
-		// Must clear all entries in this->mapProducerSpeakers since RemoveProducer()
-		// won't be called for each existing Producer if the ActiveSpeakerObserver or
-		// its parent Router are directly closed.
-		for (auto& kv : this->mapProducerSpeakers)
-		{
-			auto* producerSpeaker = kv.second;
-			delete producerSpeaker;
-		}
-		this->mapProducerSpeakers.clear();
 	}
 
 	void ActiveSpeakerObserver::AddProducer(RTC::Producer* producer)
@@ -152,48 +184,76 @@ namespace RTC
 		if (producer->GetKind() != RTC::Media::Kind::AUDIO)
 			MS_THROW_TYPE_ERROR("not an audio Producer");
 
-		if (this->mapProducerSpeakers.find(producer->id) != this->mapProducerSpeakers.end())
+		if (this->mapProducerSpeakerIdx.find(producer) != this->mapProducerSpeakerIdx.end())
 			MS_THROW_ERROR("Producer already in map");
 
-		this->mapProducerSpeakers[producer->id] = new ProducerSpeaker(producer);
+		this->mapProducerSpeakerIdx[producer] = this->producers.size();
+
+		this->producers.push_back(producer);
+		this->speakers.emplace_back();
+		this->paused.push_back(producer->IsPaused());
+		this->immediateScores.push_back(MinLogActivityScore);
+		this->mediumScores.push_back(MinLogActivityScore);
+		this->longScores.push_back(MinLogActivityScore);
 	}
 
 	void ActiveSpeakerObserver::RemoveProducer(RTC::Producer* producer)
 	{
 		MS_TRACE();
 
-		auto it = this->mapProducerSpeakers.find(producer->id);
+		auto it = this->mapProducerSpeakerIdx.find(producer);
 
-		if (it == this->mapProducerSpeakers.end())
+		if (it == this->mapProducerSpeakerIdx.end())
 		{
 			return;
 		}
 
-		auto* producerSpeaker = it->second;
+		const size_t idx     = it->second;
+		const size_t lastIdx = this->producers.size() - 1;
 
-		delete producerSpeaker;
+		this->mapProducerSpeakerIdx.erase(it);
 
-		this->mapProducerSpeakers.erase(producer->id);
+		// Move the last speaker into the freed position.
+		if (idx != lastIdx)
+		{
+			this->producers[idx]       = this->producers[lastIdx];
+			this->speakers[idx]        = std::move(this->speakers[lastIdx]);
+			this->paused[idx]          = this->paused[lastIdx];
+			this->immediateScores[idx] = this->immediateScores[lastIdx];
+			this->mediumScores[idx]    = this->mediumScores[lastIdx];
+			this->longScores[idx]      = this->longScores[lastIdx];
+
+			this->mapProducerSpeakerIdx[this->producers[idx]] = idx;
+		}
+
+		this->producers.pop_back();
+		this->speakers.pop_back();
+		this->paused.pop_back();
+		this->immediateScores.pop_back();
+		this->mediumScores.pop_back();
+		this->longScores.pop_back();
 
-		if (producer->id == this->dominantId)
+		if (idx == this->dominantIdx)
 		{
-			this->dominantId.erase();
+			this->dominantIdx = NoSpeaker;
 
 			Update();
 		}
+		else if (lastIdx == this->dominantIdx)
+		{
+			this->dominantIdx = idx;
+		}
 	}
 
 	void ActiveSpeakerObserver::ProducerPaused(RTC::Producer* producer)
 	{
 		MS_TRACE();
 
-		auto it = this->mapProducerSpeakers.find(producer->id);
+		auto it = this->mapProducerSpeakerIdx.find(producer);
 
-		if (it != this->mapProducerSpeakers.end())
+		if (it != this->mapProducerSpeakerIdx.end())
 		{
-			auto* producerSpeaker = it->second;
-
-			producerSpeaker->speaker->paused = true;
+			this->paused[it->second] = true;
 		}
 	}
 
@@ -201,13 +261,11 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		auto it = this->mapProducerSpeakers.find(producer->id);
+		auto it = this->mapProducerSpeakerIdx.find(producer);
 
-		if (it != this->mapProducerSpeakers.end())
+		if (it != this->mapProducerSpeakerIdx.end())
 		{
-			auto* producerSpeaker = it->second;
-
-			producerSpeaker->speaker->paused = false;
+			this->paused[it->second] = false;
 		}
 	}
 
@@ -225,14 +283,13 @@ namespace RTC
 			return;
 		uint8_t volume = 127 - level;
 
-		auto it = this->mapProducerSpeakers.find(producer->id);
+		auto it = this->mapProducerSpeakerIdx.find(producer);
 
-		if (it != this->mapProducerSpeakers.end())
+		if (it != this->mapProducerSpeakerIdx.end())
 		{
-			auto* producerSpeaker = it->second;
-			uint64_t now          = DepLibUV::GetTimeMs();
+			uint64_t now = DepLibUV::GetTimeMs();
 
-			producerSpeaker->speaker->LevelChanged(volume, now);
+			this->speakers[it->second].LevelChanged(volume, now);
 		}
 	}
 
@@ -273,10 +330,10 @@ namespace RTC
 			this->lastLevelIdleTime = now;
 		}
 
-		if (!this->mapProducerSpeakers.empty() && CalculateActiveSpeaker())
+		if (!this->producers.empty() && CalculateActiveSpeaker())
 		{
 			json data          = json::object();
-			data["producerId"] = this->dominantId;
+			data["producerId"] = this->producers[this->dominantIdx]->id;
 
 			this->shared->channelNotifier->Emit(this->id, "dominantspeaker", data);
 		}
@@ -286,75 +343,55 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		std::string newDominantId;
-		int32_t speakerCount = this->mapProducerSpeakers.size();
+		size_t newDominantIdx{ NoSpeaker };
+		const size_t speakerCount = this->producers.size();
 
-		if (speakerCount == 0)
+		if (speakerCount == 1)
 		{
-			newDominantId = "";
+			newDominantIdx = 0u;
 		}
-		else if (speakerCount == 1)
+		else if (speakerCount > 1)
 		{
-			auto it               = this->mapProducerSpeakers.begin();
-			auto* producerSpeaker = it->second;
-			newDominantId         = producerSpeaker->producer->id;
-		}
-		else
-		{
-			Speaker* dominantSpeaker = (this->dominantId.empty())
-			                             ? nullptr
-			                             : this->mapProducerSpeakers.at(this->dominantId)->speaker;
+			size_t refIdx = this->dominantIdx;
 
-			if (dominantSpeaker == nullptr)
-			{
-				auto it               = this->mapProducerSpeakers.begin();
-				newDominantId         = it->first;
-				auto* producerSpeaker = it->second;
-				dominantSpeaker       = producerSpeaker->speaker;
-			}
-			else
+			if (refIdx == NoSpeaker)
 			{
-				newDominantId = "";
+				refIdx         = 0u;
+				newDominantIdx = 0u;
 			}
 
-			dominantSpeaker->EvalActivityScores();
-			double newDominantC2 = C2;
+			EvalActivityScores(refIdx);
 
-			for (auto& kv : this->mapProducerSpeakers)
-			{
-				auto* producerSpeaker = kv.second;
-				auto* speaker         = producerSpeaker->speaker;
-				auto& id              = producerSpeaker->producer->id;
+			const double refImmediateScore = this->immediateScores[refIdx];
+			const double refMediumScore    = this->mediumScores[refIdx];
+			const double refLongScore      = this->longScores[refIdx];
+			double newDominantC2           = C2;
 
-				if (id == this->dominantId || speaker->paused)
+			for (size_t idx{ 0u }; idx < speakerCount; ++idx)
+			{
+				if (idx == refIdx || this->paused[idx])
 				{
 					continue;
 				}
 
-				speaker->EvalActivityScores();
-
-				for (uint8_t interval = 0u; interval < ActiveSpeakerObserver::RelativeSpeachActivitiesLen;
-				     ++interval)
-				{
-					this->relativeSpeachActivities[interval] = std::log(
-					  speaker->GetActivityScore(interval) / dominantSpeaker->GetActivityScore(interval));
-				}
+				EvalActivityScores(idx);
 
-				double c1 = this->relativeSpeachActivities[0];
-				double c2 = this->relativeSpeachActivities[1];
-				double c3 = this->relativeSpeachActivities[2];
+				// Relative speech activities (log of the ratio of the scores).
+				const double c1 = this->immediateScores[idx] - refImmediateScore;
+				const double c2 = this->mediumScores[idx] - refMediumScore;
+				const double c3 = this->longScores[idx] - refLongScore;
 
 				if ((c1 > C1) && (c2 > C2) && (c3 > C3) && (c2 > newDominantC2))
 				{
-					newDominantC2 = c2;
-					newDominantId = id;
+					newDominantC2  = c2;
+					newDominantIdx = idx;
 				}
 			}
 		}
 
-		if (!newDominantId.empty() && newDominantId != this->dominantId)
+		if (newDominantIdx != NoSpeaker && newDominantIdx != this->dominantIdx)
 		{
-			this->dominantId = newDominantId;
+			this->dominantIdx = newDominantIdx;
 
 			return true;
 		}
@@ -362,90 +399,54 @@ namespace RTC
 		return false;
 	}
 
-	void ActiveSpeakerObserver::TimeoutIdleLevels(uint64_t now)
+	void ActiveSpeakerObserver::EvalActivityScores(size_t idx)
 	{
 		MS_TRACE();
 
-		for (auto& kv : this->mapProducerSpeakers)
+		auto& speaker = this->speakers[idx];
+
+		if (speaker.ComputeImmediates())
 		{
-			auto* producerSpeaker = kv.second;
-			auto* speaker         = producerSpeaker->speaker;
-			auto& id              = producerSpeaker->producer->id;
-			uint64_t idle         = now - speaker->lastLevelChangeTime;
+			this->immediateScores[idx] = ImmediateLogScores[speaker.GetImmediate()];
 
-			if (SpeakerIdleTimeout < idle && (this->dominantId.empty() || id != this->dominantId))
+			if (speaker.ComputeMediums())
 			{
-				speaker->paused = true;
-			}
-			else if (LevelIdleTimeout < idle)
-			{
-				speaker->LevelTimedOut(now);
+				this->mediumScores[idx] = MediumLogScores[speaker.GetMedium()];
+
+				if (speaker.ComputeLongs())
+				{
+					this->longScores[idx] = LongLogScores[speaker.GetLong()];
+				}
 			}
 		}
 	}
 
-	ActiveSpeakerObserver::ProducerSpeaker::ProducerSpeaker(RTC::Producer* producer)
-	  : producer(producer)
-	{
-		MS_TRACE();
-
-		this->speaker         = new Speaker();
-		this->speaker->paused = producer->IsPaused();
-	}
-
-	ActiveSpeakerObserver::ProducerSpeaker::~ProducerSpeaker()
-	{
-		MS_TRACE();
-
-		delete this->speaker;
-	}
-
-	ActiveSpeakerObserver::Speaker::Speaker()
-	  : immediateActivityScore(MinActivityScore), mediumActivityScore(MinActivityScore),
-	    longActivityScore(MinActivityScore), lastLevelChangeTime(DepLibUV::GetTimeMs()),
-	    minLevel(MinLevel), nextMinLevel(MinLevel), immediates(ImmediateBuffLen, 0),
-	    mediums(MediumsBuffLen, 0), longs(LongsBuffLen, 0), levels(LevelsBuffLen, 0), nextLevelIndex(0)
-	{
-		MS_TRACE();
-	}
-
-	void ActiveSpeakerObserver::Speaker::EvalActivityScores()
+	void ActiveSpeakerObserver::TimeoutIdleLevels(uint64_t now)
 	{
 		MS_TRACE();
 
-		if (ComputeImmediates())
+		for (size_t idx{ 0u }; idx < this->speakers.size(); ++idx)
 		{
-			EvalImmediateActivityScore();
+			auto& speaker = this->speakers[idx];
+			uint64_t idle = now - speaker.lastLevelChangeTime;
 
-			if (ComputeMediums())
+			if (SpeakerIdleTimeout < idle && idx != this->dominantIdx)
 			{
-				EvalMediumActivityScore();
-
-				if (ComputeLongs())
-				{
-					EvalLongActivityScore();
-				}
+				this->paused[idx] = true;
+			}
+			else if (LevelIdleTimeout < idle)
+			{
+				speaker.LevelTimedOut(now);
 			}
 		}
 	}
 
-	double ActiveSpeakerObserver::Speaker::GetActivityScore(uint8_t interval)
+	ActiveSpeakerObserver::Speaker::Speaker()
+	  : lastLevelChangeTime(DepLibUV::GetTimeMs()), minLevel(MinLevel), nextMinLevel(MinLevel),
+	    immediates(ImmediateBuffLen, 0), mediums(MediumsBuffLen, 0), longs(LongsBuffLen, 0),
+	    levels(LevelsBuffLen, 0), nextLevelIndex(0)
 	{
 		MS_TRACE();
-
-		switch (interval)
-		{
-			case 0u:
-				return this->immediateActivityScore;
-			case 1u:
-				return this->mediumActivityScore;
-			case 2u:
-				return this->longActivityScore;
-			default:
-				MS_ABORT("interval is invalid");
-		}
-
-		return 0;
 	}
 
 	void ActiveSpeakerObserver::Speaker::LevelChanged(uint32_t level, uint64_t now)
@@ -542,27 +543,6 @@ namespace RTC
 		return ComputeBigs(this->mediums, this->longs, LongThreashold);
 	}
 
-	void ActiveSpeakerObserver::Speaker::EvalImmediateActivityScore()
-	{
-		MS_TRACE();
-
-		this->immediateActivityScore = ComputeActivityScore(this->immediates[0], N1, 0.5, 0.78);
-	}
-
-	void ActiveSpeakerObserver::Speaker::EvalMediumActivityScore()
-	{
-		MS_TRACE();
-
-		this->mediumActivityScore = ComputeActivityScore(this->mediums[0], N2, 0.5, 24);
-	}
-
-	void ActiveSpeakerObserver::Speaker::EvalLongActivityScore()
-	{
-		MS_TRACE();
-
-		this->longActivityScore = ComputeActivityScore(this->longs[0], N3, 0.5, 47);
-	}
-
 	void ActiveSpeakerObserver::Speaker::UpdateMinLevel(int8_t level)
 	{
 		MS_TRACE();
@@ -16,42 +16,57 @@ namespace RTC
 		{
 			MS_TRACE();
 
+			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
+
+			if (!H264::Parse(data, len, *payloadDescriptor, frameMarking, frameMarkingLen))
+				return nullptr;
+
+			return payloadDescriptor.release();
+		}
+
+		bool H264::Parse(
+		  const uint8_t* data,
+		  size_t len,
+		  H264::PayloadDescriptor& payloadDescriptor,
+		  RTC::RtpPacket::FrameMarking* frameMarking,
+		  uint8_t frameMarkingLen)
+		{
+			MS_TRACE();
+
 			if (len < 2)
 			{
-				return nullptr;
+				return false;
 			}
 
-			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
-
 			// Use frame-marking.
 			if (frameMarking)
 			{
 				// Read fields.
-				payloadDescriptor->s   = frameMarking->start;
-				payloadDescriptor->e   = frameMarking->end;
-				payloadDescriptor->i   = frameMarking->independent;
-				payloadDescriptor->d   = frameMarking->discardable;
-				payloadDescriptor->b   = frameMarking->base;
-				payloadDescriptor->tid = frameMarking->tid;
+				payloadDescriptor.s   = frameMarking->start;
+				payloadDescriptor.e   = frameMarking->end;
+				payloadDescriptor.i   = frameMarking->independent;
+				payloadDescriptor.d   = frameMarking->discardable;
+				payloadDescriptor.b   = frameMarking->base;
+				payloadDescriptor.tid = frameMarking->tid;
 
-				payloadDescriptor->hasTid = true;
+				payloadDescriptor.hasTid = true;
 
 				if (frameMarkingLen >= 2)
 				{
-					payloadDescriptor->hasLid = true;
-					payloadDescriptor->lid    = frameMarking->lid;
+					payloadDescriptor.hasLid = true;
+					payloadDescriptor.lid    = frameMarking->lid;
 				}
 
 				if (frameMarkingLen == 3)
 				{
-					payloadDescriptor->hasTl0picidx = true;
-					payloadDescriptor->tl0picidx    = frameMarking->tl0picidx;
+					payloadDescriptor.hasTl0picidx = true;
+					payloadDescriptor.tl0picidx    = frameMarking->tl0picidx;
 				}
 
 				// Detect key frame.
 				if (frameMarking->start && frameMarking->independent)
 				{
-					payloadDescriptor->isKeyFrame = true;
+					payloadDescriptor.isKeyFrame = true;
 				}
 			}
 
@@ -61,7 +76,7 @@ namespace RTC
 			//
 			// As a temporal workaround, always do payload parsing to detect keyframes if
 			// there is no frame-marking or if there is but keyframe was not detected above.
-			if (!frameMarking || !payloadDescriptor->isKeyFrame)
+			if (!frameMarking || !payloadDescriptor.isKeyFrame)
 			{
 				const uint8_t nal = *data & 0x1F;
 
@@ -71,7 +86,7 @@ namespace RTC
 					// IDR (instantaneous decoding picture).
 					case 7:
 					{
-						payloadDescriptor->isKeyFrame = true;
+						payloadDescriptor.isKeyFrame = true;
 
 						break;
 					}
@@ -92,7 +107,7 @@ namespace RTC
 
 							if (subnal == 7)
 							{
-								payloadDescriptor->isKeyFrame = true;
+								payloadDescriptor.isKeyFrame = true;
 
 								break;
 							}
@@ -120,7 +135,7 @@ namespace RTC
 
 						if (subnal == 7 && startBit == 128)
 						{
-							payloadDescriptor->isKeyFrame = true;
+							payloadDescriptor.isKeyFrame = true;
 						}
 
 						break;
@@ -128,7 +143,7 @@ namespace RTC
 				}
 			}
 
-			return payloadDescriptor.release();
+			return true;
 		}
 
 		void H264::ProcessRtpPacket(RTC::RtpPacket* packet)
@@ -143,16 +158,14 @@ namespace RTC
 			// Read frame-marking.
 			packet->ReadFrameMarking(&frameMarking, frameMarkingLen);
 
-			PayloadDescriptor* payloadDescriptor = H264::Parse(data, len, frameMarking, frameMarkingLen);
+			PayloadDescriptor payloadDescriptor{};
 
-			if (!payloadDescriptor)
+			if (!H264::Parse(data, len, payloadDescriptor, frameMarking, frameMarkingLen))
 			{
 				return;
 			}
 
-			auto* payloadDescriptorHandler = new PayloadDescriptorHandler(payloadDescriptor);
-
-			packet->SetPayloadDescriptorHandler(payloadDescriptorHandler);
+			packet->EmplacePayloadDescriptorHandler<PayloadDescriptorHandler>(payloadDescriptor);
 		}
 
 		/* Instance methods. */
@@ -179,11 +192,11 @@ namespace RTC
 			MS_DUMP("</PayloadDescriptor>");
 		}
 
-		H264::PayloadDescriptorHandler::PayloadDescriptorHandler(H264::PayloadDescriptor* payloadDescriptor)
+		H264::PayloadDescriptorHandler::PayloadDescriptorHandler(
+		  const H264::PayloadDescriptor& payloadDescriptor)
+		  : payloadDescriptor(payloadDescriptor)
 		{
 			MS_TRACE();
-
-			this->payloadDescriptor.reset(payloadDescriptor);
 		}
 
 		bool H264::PayloadDescriptorHandler::Process(
@@ -196,15 +209,15 @@ namespace RTC
 			MS_ASSERT(context->GetTargetTemporalLayer() >= 0, "target temporal layer cannot be -1");
 
 			// Check if the payload should contain temporal layer info.
-			if (context->GetTemporalLayers() > 1 && !this->payloadDescriptor->hasTid)
+			if (context->GetTemporalLayers() > 1 && !this->payloadDescriptor.hasTid)
 			{
 				MS_WARN_DEV("stream is supposed to have >1 temporal layers but does not have tid field");
 			}
 
 			// clang-format off
 			if (
-				this->payloadDescriptor->hasTid &&
-				this->payloadDescriptor->tid > context->GetTargetTemporalLayer()
+				this->payloadDescriptor.hasTid &&
+				this->payloadDescriptor.tid > context->GetTargetTemporalLayer()
 			)
 			// clang-format on
 			{
@@ -216,9 +229,9 @@ namespace RTC
 			//
 			// clang-format off
 			else if (
-				this->payloadDescriptor->hasTid &&
-				this->payloadDescriptor->tid > context->GetCurrentTemporalLayer() &&
-				!this->payloadDescriptor->b
+				this->payloadDescriptor.hasTid &&
+				this->payloadDescriptor.tid > context->GetCurrentTemporalLayer() &&
+				!this->payloadDescriptor.b
 			)
 			// clang-format on
 			{
@@ -228,14 +241,14 @@ namespace RTC
 			// Update/fix current temporal layer.
 			// clang-format off
 			if (
-				this->payloadDescriptor->hasTid &&
-				this->payloadDescriptor->tid > context->GetCurrentTemporalLayer()
+				this->payloadDescriptor.hasTid &&
+				this->payloadDescriptor.tid > context->GetCurrentTemporalLayer()
 			)
 			// clang-format on
 			{
-				context->SetCurrentTemporalLayer(this->payloadDescriptor->tid);
+				context->SetCurrentTemporalLayer(this->payloadDescriptor.tid);
 			}
-			else if (!this->payloadDescriptor->hasTid)
+			else if (!this->payloadDescriptor.hasTid)
 			{
 				context->SetCurrentTemporalLayer(0);
 			}
@@ -16,13 +16,23 @@ namespace RTC
 
 			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
 
+			if (!Opus::Parse(data, len, *payloadDescriptor))
+				return nullptr;
+
+			return payloadDescriptor.release();
+		}
+
+		bool Opus::Parse(const uint8_t* data, size_t len, Opus::PayloadDescriptor& payloadDescriptor)
+		{
+			MS_TRACE();
+
 			// libopus generates a single byte payload (TOC, no frames) to generate DTX.
 			if (len == 1)
 			{
-				payloadDescriptor->isDtx = true;
+				payloadDescriptor.isDtx = true;
 			}
 
-			return payloadDescriptor.release();
+			return true;
 		}
 
 		void Opus::ProcessRtpPacket(RTC::RtpPacket* packet)
@@ -32,11 +42,14 @@ namespace RTC
 			auto* data = packet->GetPayload();
 			auto len   = packet->GetPayloadLength();
 
-			PayloadDescriptor* payloadDescriptor = Opus::Parse(data, len);
+			PayloadDescriptor payloadDescriptor{};
 
-			auto* payloadDescriptorHandler = new PayloadDescriptorHandler(payloadDescriptor);
+			if (!Opus::Parse(data, len, payloadDescriptor))
+			{
+				return;
+			}
 
-			packet->SetPayloadDescriptorHandler(payloadDescriptorHandler);
+			packet->EmplacePayloadDescriptorHandler<PayloadDescriptorHandler>(payloadDescriptor);
 		}
 
 		/* Instance methods. */
@@ -50,11 +63,11 @@ namespace RTC
 			MS_DUMP("</PayloadDescriptor>");
 		}
 
-		Opus::PayloadDescriptorHandler::PayloadDescriptorHandler(Opus::PayloadDescriptor* payloadDescriptor)
+		Opus::PayloadDescriptorHandler::PayloadDescriptorHandler(
+		  const Opus::PayloadDescriptor& payloadDescriptor)
+		  : payloadDescriptor(payloadDescriptor)
 		{
 			MS_TRACE();
-
-			this->payloadDescriptor.reset(payloadDescriptor);
 		}
 
 		bool Opus::PayloadDescriptorHandler::Process(
@@ -64,7 +77,7 @@ namespace RTC
 
 			auto* context = static_cast<RTC::Codecs::Opus::EncodingContext*>(encodingContext);
 
-			if (this->payloadDescriptor->isDtx && context->GetIgnoreDtx())
+			if (this->payloadDescriptor.isDtx && context->GetIgnoreDtx())
 			{
 				return false;
 			}
@@ -5,6 +5,7 @@
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include <cstring>  // std::memcpy()
 #include <iterator> // std::ostream_iterator
 #include <sstream>  // std::ostringstream
 
@@ -54,6 +55,22 @@ namespace RTC
 				MS_THROW_TYPE_ERROR("invalid encoding in rtpParameters (missing rtx.ssrc)");
 		}
 
+		// Compile the MID of the rewrite plan.
+		if (this->rtpParameters.mid.length() > RTC::MidMaxLength)
+		{
+			MS_ERROR(
+			  "no enough space for MID value [MidMaxLength:%" PRIu8 ", mid:'%s']",
+			  RTC::MidMaxLength,
+			  this->rtpParameters.mid.c_str());
+		}
+		else
+		{
+			std::memcpy(
+			  this->rewritePlan.mid, this->rtpParameters.mid.c_str(), this->rtpParameters.mid.length());
+
+			this->rewritePlan.midLen = static_cast<uint8_t>(this->rtpParameters.mid.length());
+		}
+
 		auto jsonConsumableRtpEncodingsIt = data.find("consumableRtpEncodings");
 
 		if (jsonConsumableRtpEncodingsIt == data.end() || !jsonConsumableRtpEncodingsIt->is_array())
@@ -151,11 +168,15 @@ namespace RTC
 			this->maxRtcpInterval = RTC::RTCP::MaxAudioIntervalMs;
 		else
 			this->maxRtcpInterval = RTC::RTCP::MaxVideoIntervalMs;
+
+		this->shared->statsStreamer->AddSource(this, this->id);
 	}
 
 	Consumer::~Consumer()
 	{
 		MS_TRACE();
+
+		this->shared->statsStreamer->RemoveSource(this);
 	}
 
 	void Consumer::FillJson(json& jsonObject) const
@@ -255,6 +276,17 @@ namespace RTC
 
 			case Channel::ChannelRequest::MethodId::CONSUMER_GET_STATS:
 			{
+				if (request->binary)
+				{
+					Channel::BinaryBody::Writer body(Channel::BinaryMessage::BodyType::RECORDS);
+
+					FillBinaryStats(body);
+
+					request->Accept(body);
+
+					break;
+				}
+
 				json data = json::array();
 
 				FillJsonStats(data);
@@ -548,4 +580,19 @@ namespace RTC
 
 		this->shared->channelNotifier->Emit(this->id, "trace", data);
 	}
+
+	void Consumer::FillStatsStream(uint64_t nowMs, RTC::StatsStreamer* statsStreamer)
+	{
+		MS_TRACE();
+
+		for (auto* rtpStream : GetRtpStreams())
+		{
+			RTC::StatsStreamer::Values values{};
+
+			rtpStream->FillStatsValues(nowMs, values);
+
+			statsStreamer->AddStats(
+			  RTC::StatsStreamer::Type::OUTBOUND_RTP, rtpStream->GetSsrc(), values);
+		}
+	}
 } // namespace RTC
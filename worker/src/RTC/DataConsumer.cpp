@@ -138,6 +138,22 @@ namespace RTC
 		jsonObject["bufferedAmount"] = this->bufferedAmount;
 	}
 
+	void DataConsumer::FillBinaryStats(Channel::BinaryBody::Writer& writer) const
+	{
+		MS_TRACE();
+
+		using Key = Channel::BinaryBody::Key;
+
+		writer.WriteString(Key::TYPE, "data-consumer");
+		writer.WriteUint(Key::TIMESTAMP, DepLibUV::GetTimeMs());
+		writer.WriteString(Key::LABEL, this->label);
+		writer.WriteString(Key::PROTOCOL, this->protocol);
+		writer.WriteUint(Key::MESSAGES_SENT, this->messagesSent);
+		writer.WriteUint(Key::BYTES_SENT, this->bytesSent);
+		writer.WriteUint(Key::BUFFERED_AMOUNT, this->bufferedAmount);
+		writer.EndRecord();
+	}
+
 	void DataConsumer::HandleRequest(Channel::ChannelRequest* request)
 	{
 		MS_TRACE();
@@ -157,6 +173,17 @@ namespace RTC
 
 			case Channel::ChannelRequest::MethodId::DATA_CONSUMER_GET_STATS:
 			{
+				if (request->binary)
+				{
+					Channel::BinaryBody::Writer body(Channel::BinaryMessage::BodyType::RECORDS);
+
+					FillBinaryStats(body);
+
+					request->Accept(body);
+
+					break;
+				}
+
 				json data = json::array();
 
 				FillJsonStats(data);
@@ -125,6 +125,21 @@ namespace RTC
 		jsonObject["bytesReceived"] = this->bytesReceived;
 	}
 
+	void DataProducer::FillBinaryStats(Channel::BinaryBody::Writer& writer) const
+	{
+		MS_TRACE();
+
+		using Key = Channel::BinaryBody::Key;
+
+		writer.WriteString(Key::TYPE, "data-producer");
+		writer.WriteUint(Key::TIMESTAMP, DepLibUV::GetTimeMs());
+		writer.WriteString(Key::LABEL, this->label);
+		writer.WriteString(Key::PROTOCOL, this->protocol);
+		writer.WriteUint(Key::MESSAGES_RECEIVED, this->messagesReceived);
+		writer.WriteUint(Key::BYTES_RECEIVED, this->bytesReceived);
+		writer.EndRecord();
+	}
+
 	void DataProducer::HandleRequest(Channel::ChannelRequest* request)
 	{
 		MS_TRACE();
@@ -144,6 +159,17 @@ namespace RTC
 
 			case Channel::ChannelRequest::MethodId::DATA_PRODUCER_GET_STATS:
 			{
+				if (request->binary)
+				{
+					Channel::BinaryBody::Writer body(Channel::BinaryMessage::BodyType::RECORDS);
+
+					FillBinaryStats(body);
+
+					request->Accept(body);
+
+					break;
+				}
+
 				json data = json::array();
 
 				FillJsonStats(data);
@@ -4,9 +4,15 @@
 #include "RTC/DirectTransport.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include <vector>
 
 namespace RTC
 {
+	/* Static. */
+
+	// Buffer where packets with a rewrite plan are copied before notifying them.
+	thread_local static std::vector<uint8_t> RtpBuffer;
+
 	/* Instance methods. */
 
 	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
@@ -52,6 +58,17 @@ namespace RTC
 		jsonObject["type"] = "direct-transport";
 	}
 
+	void DirectTransport::FillBinaryStats(Channel::BinaryBody::Writer& writer)
+	{
+		MS_TRACE();
+
+		// Call the parent method.
+		RTC::Transport::FillBinaryStats(writer);
+
+		writer.WriteString(Channel::BinaryBody::Key::TYPE, "direct-transport");
+		writer.EndRecord();
+	}
+
 	void DirectTransport::HandleRequest(Channel::ChannelRequest* request)
 	{
 		MS_TRACE();
@@ -124,6 +141,17 @@ namespace RTC
 		const uint8_t* data = packet->GetData();
 		const size_t len    = packet->GetSize();
 
+		// The packet must be copied to apply its rewrite plan.
+		if (packet->GetRewritePlan())
+		{
+			if (RtpBuffer.size() < len)
+				RtpBuffer.resize(len);
+
+			packet->Write(RtpBuffer.data());
+
+			data = RtpBuffer.data();
+		}
+
 		// Notify the Node DirectTransport.
 		this->shared->payloadChannelNotifier->Emit(consumer->id, "rtp", data, len);
 
@@ -173,11 +201,24 @@ namespace RTC
 		MS_TRACE();
 
 		// Notify the Node DirectTransport.
-		json data = json::object();
+		if (this->shared->payloadChannelNotifier->IsBinary())
+		{
+			Channel::BinaryBody::Writer body(Channel::BinaryMessage::BodyType::RECORD);
 
-		data["ppid"] = ppid;
+			body.WriteUint(Channel::BinaryBody::Key::PPID, ppid);
+			body.EndRecord();
 
-		this->shared->payloadChannelNotifier->Emit(dataConsumer->id, "message", data, msg, len);
+			this->shared->payloadChannelNotifier->Emit(dataConsumer->id, "message", body, msg, len);
+		}
+		else
+		{
+			std::string data("{\"ppid\":");
+
+			data.append(std::to_string(ppid));
+			data.append("}");
+
+			this->shared->payloadChannelNotifier->Emit(dataConsumer->id, "message", data, msg, len);
+		}
 
 		// Increase send transmission.
 		RTC::Transport::DataSent(len);
@@ -2,6 +2,7 @@
 // #define MS_LOG_DEV_LEVEL 3
 
 #include "RTC/DtlsTransport.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Settings.hpp"
@@ -32,7 +33,9 @@
 
 inline static int onSslCertificateVerify(int /*preverifyOk*/, X509_STORE_CTX* /*ctx*/)
 {
-	MS_TRACE();
+	// NOTE: No MS_TRACE() here since, with DTLS handshake offload, this is
+	// called in a thread of the libuv thread pool where nothing (not even
+	// logging) can be done.
 
 	// Always valid since DTLS certificates are self-signed.
 	return 1;
@@ -43,6 +46,12 @@ inline static void onSslInfo(const SSL* ssl, int where, int ret)
 	static_cast<RTC::DtlsTransport*>(SSL_get_ex_data(ssl, 0))->OnSslInfo(where, ret);
 }
 
+inline static void onSslInfoOffloaded(const SSL* /*ssl*/, int /*where*/, int /*ret*/)
+{
+	// Called in a thread of the libuv thread pool where nothing (not even
+	// logging) can be done.
+}
+
 inline static unsigned int onSslDtlsTimer(SSL* /*ssl*/, unsigned int timerUs)
 {
 	if (timerUs == 0)
@@ -72,6 +81,64 @@ namespace RTC
 	static constexpr size_t SrtpAesGcm128MasterSaltLength{ 12 };
 	static constexpr size_t SrtpAesGcm128MasterLength{ SrtpAesGcm128MasterKeyLength + SrtpAesGcm128MasterSaltLength };
 	// clang-format on
+	static constexpr size_t MaxPendingDtlsData{ 64u };
+
+	// Runs in a thread of the libuv thread pool.
+	static void onHandshakeJobWork(uv_work_t* req)
+	{
+		auto* job = static_cast<DtlsTransport::HandshakeJob*>(req->data);
+		thread_local static uint8_t readBuffer[SslReadBufferSize];
+		BIO* sslBioFromNetwork = SSL_get_rbio(job->ssl);
+		BIO* sslBioToNetwork   = SSL_get_wbio(job->ssl);
+
+		const int written = BIO_write(
+		  sslBioFromNetwork,
+		  static_cast<const void*>(job->data.data()),
+		  static_cast<int>(job->data.size()));
+
+		if (written != static_cast<int>(job->data.size()))
+			job->errors.emplace_back("BIO_write() wrote less than given data");
+
+		job->read          = SSL_read(job->ssl, static_cast<void*>(readBuffer), SslReadBufferSize);
+		job->err           = SSL_get_error(job->ssl, job->read);
+		job->handshakeDone = SSL_is_init_finished(job->ssl) == 1;
+
+		if (job->read > 0)
+			job->readData.assign(readBuffer, readBuffer + job->read);
+
+		char* data{ nullptr };
+		const int64_t len = BIO_get_mem_data(sslBioToNetwork, &data); // NOLINT
+
+		if (len > 0)
+		{
+			job->outgoingData.assign(data, data + len);
+
+			(void)BIO_reset(sslBioToNetwork);
+		}
+
+		// The OpenSSL error queue is per thread, so take its errors to the loop.
+		unsigned long err;
+		char errorString[256];
+
+		while ((err = ERR_get_error()) != 0)
+		{
+			ERR_error_string_n(err, errorString, sizeof(errorString));
+
+			job->errors.emplace_back(errorString);
+		}
+	}
+
+	static void onHandshakeJobDone(uv_work_t* req, int /*status*/)
+	{
+		auto* job = static_cast<DtlsTransport::HandshakeJob*>(req->data);
+
+		if (job->dtlsTransport)
+			job->dtlsTransport->OnHandshakeJobDone(job);
+		else
+			SSL_free(job->ssl);
+
+		delete job;
+	}
 
 	/* Class variables. */
 
@@ -501,7 +568,44 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		/* Set SSL. */
+		CreateSsl();
+
+		// Set the DTLS timer.
+		this->timer = new Timer(this);
+	}
+
+	DtlsTransport::~DtlsTransport()
+	{
+		MS_TRACE();
+
+		if (this->handshakeJob)
+		{
+			// The running HandshakeJob frees the SSL instance once done.
+			DetachHandshakeJob();
+		}
+		else if (IsRunning())
+		{
+			// Send close alert to the peer.
+			SSL_shutdown(this->ssl);
+			SendPendingOutgoingDtlsData();
+		}
+
+		if (this->ssl)
+		{
+			SSL_free(this->ssl);
+
+			this->ssl               = nullptr;
+			this->sslBioFromNetwork = nullptr;
+			this->sslBioToNetwork   = nullptr;
+		}
+
+		// Close the DTLS timer.
+		delete this->timer;
+	}
+
+	void DtlsTransport::CreateSsl()
+	{
+		MS_TRACE();
 
 		this->ssl = SSL_new(DtlsTransport::sslCtx);
 
@@ -547,9 +651,6 @@ namespace RTC
 		// Set callback handler for setting DTLS timer interval.
 		DTLS_set_timer_cb(this->ssl, onSslDtlsTimer);
 
-		// Set the DTLS timer.
-		this->timer = new Timer(this);
-
 		return;
 
 	error:
@@ -565,35 +666,15 @@ namespace RTC
 		if (this->ssl)
 			SSL_free(this->ssl);
 
+		this->ssl               = nullptr;
+		this->sslBioFromNetwork = nullptr;
+		this->sslBioToNetwork   = nullptr;
+
 		// NOTE: If this is not catched by the caller the program will abort, but
 		// this should never happen.
 		MS_THROW_ERROR("DtlsTransport instance creation failed");
 	}
 
-	DtlsTransport::~DtlsTransport()
-	{
-		MS_TRACE();
-
-		if (IsRunning())
-		{
-			// Send close alert to the peer.
-			SSL_shutdown(this->ssl);
-			SendPendingOutgoingDtlsData();
-		}
-
-		if (this->ssl)
-		{
-			SSL_free(this->ssl);
-
-			this->ssl               = nullptr;
-			this->sslBioFromNetwork = nullptr;
-			this->sslBioToNetwork   = nullptr;
-		}
-
-		// Close the DTLS timer.
-		delete this->timer;
-	}
-
 	void DtlsTransport::Dump() const
 	{
 		MS_TRACE();
@@ -737,6 +818,34 @@ namespace RTC
 			return;
 		}
 
+		// The SSL instance belongs to the running HandshakeJob, so process this
+		// data once it is done.
+		if (this->handshakeJob)
+		{
+			if (this->pendingDtlsData.size() >= MaxPendingDtlsData)
+			{
+				MS_WARN_TAG(dtls, "too many DTLS data pending, discarding it");
+
+				return;
+			}
+
+			this->pendingDtlsData.emplace_back(data, data + len);
+
+			return;
+		}
+
+		// Do the (CPU intensive) handshake out of the loop if so configured.
+		// clang-format off
+		if (
+			Settings::configuration.dtlsHandshakeOffload &&
+			!this->handshakeDone &&
+			StartHandshakeJob(data, len)
+		)
+		// clang-format on
+		{
+			return;
+		}
+
 		// Write the received DTLS data into the sslBioFromNetwork.
 		written =
 		  BIO_write(this->sslBioFromNetwork, static_cast<const void*>(data), static_cast<int>(len));
@@ -756,29 +865,7 @@ namespace RTC
 		// Send data if it's ready.
 		SendPendingOutgoingDtlsData();
 
-		// Check SSL status and return if it is bad/closed.
-		if (!CheckStatus(read))
-			return;
-
-		// Set/update the DTLS timeout.
-		if (!SetTimeout())
-			return;
-
-		// Application data received. Notify to the listener.
-		if (read > 0)
-		{
-			// It is allowed to receive DTLS data even before validating remote fingerprint.
-			if (!this->handshakeDone)
-			{
-				MS_WARN_TAG(dtls, "ignoring application data received while DTLS handshake not done");
-
-				return;
-			}
-
-			// Notify the listener.
-			this->listener->OnDtlsTransportApplicationDataReceived(
-			  this, (uint8_t*)DtlsTransport::sslReadBuffer, static_cast<size_t>(read));
-		}
+		ProcessSslRead(read, SSL_get_error(this->ssl, read), DtlsTransport::sslReadBuffer);
 	}
 
 	void DtlsTransport::SendApplicationData(const uint8_t* data, size_t len)
@@ -821,6 +908,85 @@ namespace RTC
 		SendPendingOutgoingDtlsData();
 	}
 
+	void DtlsTransport::ProcessSslRead(int read, int err, const uint8_t* readData)
+	{
+		MS_TRACE();
+
+		// Check SSL status and return if it is bad/closed.
+		if (!CheckSslError(err))
+			return;
+
+		// Set/update the DTLS timeout.
+		if (!SetTimeout())
+			return;
+
+		// Application data received. Notify to the listener.
+		if (read > 0)
+		{
+			// It is allowed to receive DTLS data even before validating remote fingerprint.
+			if (!this->handshakeDone)
+			{
+				MS_WARN_TAG(dtls, "ignoring application data received while DTLS handshake not done");
+
+				return;
+			}
+
+			// Notify the listener.
+			this->listener->OnDtlsTransportApplicationDataReceived(
+			  this, readData, static_cast<size_t>(read));
+		}
+	}
+
+	bool DtlsTransport::StartHandshakeJob(const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		auto* job = new HandshakeJob();
+
+		job->uvWork.data   = static_cast<void*>(job);
+		job->dtlsTransport = this;
+		job->ssl           = this->ssl;
+		job->data.assign(data, data + len);
+
+		// OnSslInfo() cannot be called in the thread pool.
+		SSL_set_info_callback(this->ssl, onSslInfoOffloaded);
+
+		const int err =
+		  uv_queue_work(DepLibUV::GetLoop(), &job->uvWork, onHandshakeJobWork, onHandshakeJobDone);
+
+		if (err != 0)
+		{
+			MS_ERROR("uv_queue_work() failed: %s", uv_strerror(err));
+
+			SSL_set_info_callback(this->ssl, nullptr);
+
+			delete job;
+
+			return false;
+		}
+
+		this->handshakeJob = job;
+
+		// The DTLS timer is set again once the job is done.
+		this->timer->Stop();
+
+		return true;
+	}
+
+	void DtlsTransport::DetachHandshakeJob()
+	{
+		MS_TRACE();
+
+		// Leave the SSL instance to the job.
+		this->handshakeJob->dtlsTransport = nullptr;
+		this->handshakeJob                = nullptr;
+		this->ssl                         = nullptr;
+		this->sslBioFromNetwork           = nullptr;
+		this->sslBioToNetwork             = nullptr;
+
+		this->pendingDtlsData.clear();
+	}
+
 	void DtlsTransport::Reset()
 	{
 		MS_TRACE();
@@ -835,10 +1001,22 @@ namespace RTC
 		// Stop the DTLS timer.
 		this->timer->Stop();
 
-		// We need to reset the SSL instance so we need to "shutdown" it, but we
-		// don't want to send a Close Alert to the peer, so just don't call
-		// SendPendingOutgoingDTLSData().
-		SSL_shutdown(this->ssl);
+		this->pendingDtlsData.clear();
+
+		if (this->handshakeJob)
+		{
+			// The running HandshakeJob frees the SSL instance once done, so use a
+			// new one.
+			DetachHandshakeJob();
+			CreateSsl();
+		}
+		else
+		{
+			// We need to reset the SSL instance so we need to "shutdown" it, but we
+			// don't want to send a Close Alert to the peer, so just don't call
+			// SendPendingOutgoingDTLSData().
+			SSL_shutdown(this->ssl);
+		}
 
 		this->localRole        = Role::NONE;
 		this->state            = DtlsState::NEW;
@@ -859,10 +1037,14 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		int err;
-		const bool wasHandshakeDone = this->handshakeDone;
+		return CheckSslError(SSL_get_error(this->ssl, returnCode));
+	}
 
-		err = SSL_get_error(this->ssl, returnCode);
+	bool DtlsTransport::CheckSslError(int err)
+	{
+		MS_TRACE();
+
+		const bool wasHandshakeDone = this->handshakeDone;
 
 		switch (err)
 		{
@@ -1409,6 +1591,46 @@ namespace RTC
 		// receipt of a close alert does not work (the flag is set after this callback).
 	}
 
+	void DtlsTransport::OnHandshakeJobDone(HandshakeJob* job)
+	{
+		MS_TRACE();
+
+		this->handshakeJob = nullptr;
+
+		SSL_set_info_callback(this->ssl, nullptr);
+
+		for (const auto& error : job->errors)
+		{
+			MS_ERROR("OpenSSL error [desc:'handshake job', error:'%s']", error.c_str());
+		}
+
+		if (job->handshakeDone)
+		{
+			MS_DEBUG_TAG(dtls, "DTLS handshake done");
+
+			this->handshakeDoneNow = true;
+		}
+
+		// Send data if it's ready.
+		if (!job->outgoingData.empty())
+		{
+			this->listener->OnDtlsTransportSendData(
+			  this, job->outgoingData.data(), job->outgoingData.size());
+		}
+
+		ProcessSslRead(job->read, job->err, job->readData.data());
+
+		// Process DTLS data received meanwhile (if still running).
+		while (!this->handshakeJob && !this->pendingDtlsData.empty() && IsRunning())
+		{
+			auto data = std::move(this->pendingDtlsData.front());
+
+			this->pendingDtlsData.pop_front();
+
+			ProcessDtlsData(data.data(), data.size());
+		}
+	}
+
 	inline void DtlsTransport::OnTimer(Timer* /*timer*/)
 	{
 		MS_TRACE();
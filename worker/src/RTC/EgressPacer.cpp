@@ -0,0 +1,286 @@
+#define MS_CLASS "RTC::EgressPacer"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/EgressPacer.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include <algorithm> // std::find(), std::max(), std::min()
+
+namespace RTC
+{
+	/* Static. */
+
+	thread_local EgressPacer::Scheduler* EgressPacer::scheduler{ nullptr };
+
+	/* Instance methods. */
+
+	EgressPacer::EgressPacer(Listener* listener) : listener(listener)
+	{
+		MS_TRACE();
+
+		if (!EgressPacer::scheduler)
+			EgressPacer::scheduler = new Scheduler();
+
+		EgressPacer::scheduler->numPacers++;
+	}
+
+	EgressPacer::~EgressPacer()
+	{
+		MS_TRACE();
+
+		Clear();
+
+		if (--EgressPacer::scheduler->numPacers == 0u)
+		{
+			delete EgressPacer::scheduler;
+			EgressPacer::scheduler = nullptr;
+		}
+	}
+
+	void EgressPacer::SetBitrate(uint32_t availableBitrate)
+	{
+		MS_TRACE();
+
+		this->bitrate = static_cast<uint32_t>(availableBitrate * PacingFactor);
+	}
+
+	bool EgressPacer::Enqueue(RTC::Consumer* consumer, RTC::RtpPacket* packet, Priority priority)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(priority != Priority::PROBATION, "probation packets cannot be queued");
+
+		// Nothing to pace against.
+		if (this->bitrate == 0u)
+			return false;
+
+		const uint64_t nowMs = DepLibUV::GetTimeMs();
+		const auto idx       = static_cast<size_t>(priority);
+
+		Refill(nowMs);
+
+		// Send it now if there is budget and no packet with same or higher
+		// priority is waiting.
+		if (this->budget > 0)
+		{
+			bool waiting{ false };
+
+			for (size_t i{ 0u }; i <= idx; ++i)
+			{
+				if (!this->queues[i].empty())
+				{
+					waiting = true;
+
+					break;
+				}
+			}
+
+			if (!waiting)
+			{
+				this->budget -= static_cast<int64_t>(packet->GetSize());
+
+				return false;
+			}
+		}
+
+		Item item;
+
+		// The given packet is shared by all Consumers of the Producer and its
+		// rewrite plan belongs to the Consumer, so keep copies of both.
+		item.consumer     = consumer;
+		item.packet       = packet->Clone();
+		item.enqueuedAtMs = nowMs;
+
+		if (packet->GetRewritePlan())
+		{
+			item.hasRewritePlan = true;
+			item.rewritePlan    = *packet->GetRewritePlan();
+		}
+
+		this->queues[idx].push_back(item);
+
+		if (++this->queueSize == 1u)
+			EgressPacer::scheduler->Add(this);
+
+		return true;
+	}
+
+	bool EgressPacer::MaySendProbation(RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		if (this->bitrate == 0u)
+			return true;
+
+		if (this->queueSize != 0u)
+			return false;
+
+		Refill(DepLibUV::GetTimeMs());
+
+		this->budget -= static_cast<int64_t>(packet->GetSize());
+
+		return true;
+	}
+
+	void EgressPacer::RemoveConsumer(RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		if (this->queueSize == 0u)
+			return;
+
+		for (auto& queue : this->queues)
+		{
+			for (auto it = queue.begin(); it != queue.end();)
+			{
+				if (it->consumer != consumer)
+				{
+					++it;
+
+					continue;
+				}
+
+				delete it->packet;
+
+				it = queue.erase(it);
+
+				--this->queueSize;
+			}
+		}
+
+		if (this->queueSize == 0u)
+			EgressPacer::scheduler->Remove(this);
+	}
+
+	inline void EgressPacer::Refill(uint64_t nowMs)
+	{
+		MS_TRACE();
+
+		// Budget is capped anyway, so no need to account for longer intervals.
+		const uint64_t elapsedMs = std::min(nowMs - this->lastRefillMs, uint64_t{ MaxBurstMs });
+		const int64_t maxBudget  = std::max(
+		  static_cast<int64_t>(this->bitrate * MaxBurstMs / 8000), static_cast<int64_t>(RTC::MtuSize));
+
+		this->lastRefillMs = nowMs;
+		this->budget += static_cast<int64_t>(this->bitrate * elapsedMs / 8000);
+
+		if (this->budget > maxBudget)
+			this->budget = maxBudget;
+	}
+
+	inline void EgressPacer::Process(uint64_t nowMs)
+	{
+		MS_TRACE();
+
+		Refill(nowMs);
+
+		for (size_t idx{ 0u }; idx < 3u; ++idx)
+		{
+			auto& queue = this->queues[idx];
+
+			while (!queue.empty())
+			{
+				// Packets waiting for too long are sent anyway.
+				if (this->budget <= 0 && queue.front().enqueuedAtMs + MaxQueueDelayMs > nowMs)
+					break;
+
+				Item item = queue.front();
+
+				queue.pop_front();
+				--this->queueSize;
+
+				this->budget -= static_cast<int64_t>(item.packet->GetSize());
+
+				if (item.hasRewritePlan)
+					item.packet->SetRewritePlan(&item.rewritePlan);
+
+				this->listener->OnEgressPacerSendRtpPacket(
+				  this, item.consumer, item.packet, static_cast<Priority>(idx));
+
+				delete item.packet;
+			}
+		}
+
+		if (this->queueSize == 0u)
+			EgressPacer::scheduler->Remove(this);
+	}
+
+	void EgressPacer::Clear()
+	{
+		MS_TRACE();
+
+		if (this->queueSize == 0u)
+			return;
+
+		for (auto& queue : this->queues)
+		{
+			for (auto& item : queue)
+			{
+				delete item.packet;
+			}
+
+			queue.clear();
+		}
+
+		this->queueSize = 0u;
+
+		EgressPacer::scheduler->Remove(this);
+	}
+
+	/* Scheduler instance methods. */
+
+	EgressPacer::Scheduler::Scheduler()
+	{
+		MS_TRACE();
+
+		this->timer = new Timer(this);
+	}
+
+	EgressPacer::Scheduler::~Scheduler()
+	{
+		MS_TRACE();
+
+		delete this->timer;
+	}
+
+	void EgressPacer::Scheduler::Add(EgressPacer* egressPacer)
+	{
+		MS_TRACE();
+
+		this->activePacers.push_back(egressPacer);
+
+		if (!this->timer->IsActive())
+			this->timer->Start(EgressPacer::ProcessIntervalMs, EgressPacer::ProcessIntervalMs);
+	}
+
+	void EgressPacer::Scheduler::Remove(EgressPacer* egressPacer)
+	{
+		MS_TRACE();
+
+		auto it = std::find(this->activePacers.begin(), this->activePacers.end(), egressPacer);
+
+		if (it != this->activePacers.end())
+			this->activePacers.erase(it);
+
+		if (this->activePacers.empty())
+			this->timer->Stop();
+	}
+
+	inline void EgressPacer::Scheduler::OnTimer(Timer* /*timer*/)
+	{
+		MS_TRACE();
+
+		const uint64_t nowMs = DepLibUV::GetTimeMs();
+
+		// Pacers are removed from the list once their queue is empty, so iterate
+		// a copy.
+		thread_local static std::vector<EgressPacer*> pacers;
+
+		pacers = this->activePacers;
+
+		for (auto* egressPacer : pacers)
+		{
+			egressPacer->Process(nowMs);
+		}
+	}
+} // namespace RTC
@@ -131,7 +131,7 @@ namespace RTC
 				{
 					case RTC::StunPacket::Authentication::OK:
 					{
-						if (!this->oldUsernameFragment.empty() && !this->oldPassword.empty())
+						if (!this->oldUsernameFragment.empty() && !this->oldPassword.IsEmpty())
 						{
 							MS_DEBUG_TAG(ice, "new ICE credentials applied");
 
@@ -139,7 +139,7 @@ namespace RTC
 							this->listener->OnIceServerLocalUsernameFragmentRemoved(this, this->oldUsernameFragment);
 
 							this->oldUsernameFragment.clear();
-							this->oldPassword.clear();
+							this->oldPassword.SetKey("");
 						}
 
 						break;
@@ -152,7 +152,7 @@ namespace RTC
 						// clang-format off
 						if (
 							!this->oldUsernameFragment.empty() &&
-							!this->oldPassword.empty() &&
+							!this->oldPassword.IsEmpty() &&
 							packet->CheckAuthentication(this->oldUsernameFragment, this->oldPassword) == RTC::StunPacket::Authentication::OK
 						)
 						// clang-format on
@@ -219,7 +219,7 @@ namespace RTC
 				response->SetXorMappedAddress(tuple->GetRemoteAddress());
 
 				// Authenticate the response.
-				if (this->oldPassword.empty())
+				if (this->oldPassword.IsEmpty())
 					response->Authenticate(this->password);
 				else
 					response->Authenticate(this->oldPassword);
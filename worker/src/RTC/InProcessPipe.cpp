@@ -0,0 +1,423 @@
+#define MS_CLASS "RTC::InProcessPipe"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/InProcessPipe.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "RTC/SpscQueue.hpp"
+#include <atomic>
+#include <cstddef> // std::max_align_t
+#include <cstring> // std::memcpy()
+#include <mutex>
+#include <unordered_map>
+
+/* Static methods for UV callbacks. */
+
+inline static void onAsync(uv_async_t* handle)
+{
+	auto* inProcessPipe = static_cast<RTC::InProcessPipe*>(handle->data);
+
+	if (inProcessPipe)
+		inProcessPipe->OnUvAsync();
+}
+
+inline static void onCheck(uv_check_t* handle)
+{
+	auto* inProcessPipe = static_cast<RTC::InProcessPipe*>(handle->data);
+
+	if (inProcessPipe)
+		inProcessPipe->OnUvCheck();
+}
+
+inline static void onCloseAsync(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_async_t*>(handle);
+}
+
+inline static void onCloseCheck(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_check_t*>(handle);
+}
+
+namespace RTC
+{
+	/* Slot. */
+
+	// NOTE: Packets cloned into a slot don't use the RtpPacketPool of any thread,
+	// so any of them can destroy the packet.
+	struct InProcessPipe::Slot
+	{
+		// Storage of the RtpPacket cloned into the buffer, if any.
+		alignas(std::max_align_t) uint8_t packetStorage[sizeof(RTC::RtpPacket)];
+		uint8_t buffer[BufferSize];
+	};
+
+	/* Inbox. */
+
+	// Shared by the receiving InProcessPipe (which owns it) and the sending one.
+	class InProcessPipe::Inbox
+	{
+	public:
+		struct Item
+		{
+			Slot* slot{ nullptr };
+			size_t len{ 0u };
+			// Set if a RTP packet was cloned into the slot.
+			RTC::RtpPacket* packet{ nullptr };
+		};
+
+	public:
+		Inbox() : items(InboxCapacity), freeSlots(InboxCapacity)
+		{
+		}
+		~Inbox()
+		{
+			Item item;
+			Slot* slot;
+
+			while (this->items.Pop(item))
+			{
+				if (item.packet)
+					item.packet->~RtpPacket();
+
+				delete item.slot;
+			}
+
+			while (this->freeSlots.Pop(slot))
+			{
+				delete slot;
+			}
+		}
+
+	public:
+		// Sender thread to receiver thread.
+		RTC::SpscQueue<Item> items;
+		// Receiver thread to sender thread.
+		RTC::SpscQueue<Slot*> freeSlots;
+		// Set once the receiver is closed so the sender can check it on every
+		// send without locking.
+		std::atomic<bool> closed{ false };
+		// Guards the fields below.
+		std::mutex mutex;
+		// Async handle of the receiver, nullptr once it's closed.
+		uv_async_t* uvAsyncHandle{ nullptr };
+		// Key of the attached sender.
+		std::string senderKey;
+	};
+
+	/* Static. */
+
+	// NOTE: Not thread_local, inboxes are shared by all Workers in the process.
+	static std::mutex RegistryMutex;
+	static std::unordered_map<std::string, std::weak_ptr<InProcessPipe::Inbox>> Registry;
+
+	static std::string GetKey(const std::string& ip, uint16_t port)
+	{
+		return ip + "/" + std::to_string(port);
+	}
+
+	/* Instance methods. */
+
+	InProcessPipe::InProcessPipe(Listener* listener, const std::string& localIp, uint16_t localPort)
+	  : listener(listener), localKey(GetKey(localIp, localPort)), localInbox(new Inbox())
+	{
+		MS_TRACE();
+
+		int err;
+
+		this->uvAsyncHandle       = new uv_async_t;
+		this->uvAsyncHandle->data = static_cast<void*>(this);
+
+		err = uv_async_init(
+		  DepLibUV::GetLoop(), this->uvAsyncHandle, reinterpret_cast<uv_async_cb>(onAsync));
+
+		if (err != 0)
+		{
+			delete this->uvAsyncHandle;
+			this->uvAsyncHandle = nullptr;
+
+			MS_THROW_ERROR("uv_async_init() failed: %s", uv_strerror(err));
+		}
+
+		this->uvCheckHandle       = new uv_check_t;
+		this->uvCheckHandle->data = static_cast<void*>(this);
+
+		err = uv_check_init(DepLibUV::GetLoop(), this->uvCheckHandle);
+
+		if (err != 0)
+		{
+			delete this->uvCheckHandle;
+			this->uvCheckHandle = nullptr;
+
+			this->uvAsyncHandle->data = nullptr;
+
+			uv_close(
+			  reinterpret_cast<uv_handle_t*>(this->uvAsyncHandle),
+			  static_cast<uv_close_cb>(onCloseAsync));
+
+			MS_THROW_ERROR("uv_check_init() failed: %s", uv_strerror(err));
+		}
+
+		// The check handle must not keep the loop alive.
+		uv_unref(reinterpret_cast<uv_handle_t*>(this->uvCheckHandle));
+
+		this->localInbox->uvAsyncHandle = this->uvAsyncHandle;
+
+		const std::lock_guard<std::mutex> lock(RegistryMutex);
+
+		auto& registeredInbox = Registry[this->localKey];
+
+		if (!registeredInbox.expired())
+		{
+			MS_WARN_TAG(
+			  info,
+			  "in-process pipe already registered, not registering it [key:%s]",
+			  this->localKey.c_str());
+
+			return;
+		}
+
+		registeredInbox = this->localInbox;
+	}
+
+	InProcessPipe::~InProcessPipe()
+	{
+		MS_TRACE();
+
+		{
+			const std::lock_guard<std::mutex> lock(RegistryMutex);
+
+			auto it = Registry.find(this->localKey);
+
+			if (it != Registry.end() && it->second.lock() == this->localInbox)
+				Registry.erase(it);
+		}
+
+		// Stop the sender from waking us up and make it detach.
+		{
+			const std::lock_guard<std::mutex> lock(this->localInbox->mutex);
+
+			this->localInbox->uvAsyncHandle = nullptr;
+			this->localInbox->closed.store(true, std::memory_order_release);
+		}
+
+		// Detach from the remote inbox so others can attach to it.
+		if (this->remoteInbox)
+		{
+			const std::lock_guard<std::mutex> lock(this->remoteInbox->mutex);
+
+			if (this->remoteInbox->senderKey == this->localKey)
+				this->remoteInbox->senderKey.clear();
+		}
+
+		this->uvAsyncHandle->data = nullptr;
+		this->uvCheckHandle->data = nullptr;
+
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(this->uvAsyncHandle), static_cast<uv_close_cb>(onCloseAsync));
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(this->uvCheckHandle), static_cast<uv_close_cb>(onCloseCheck));
+	}
+
+	bool InProcessPipe::Connect(const std::string& remoteIp, uint16_t remotePort)
+	{
+		MS_TRACE();
+
+		this->remoteKey = GetKey(remoteIp, remotePort);
+
+		return Attach();
+	}
+
+	bool InProcessPipe::Send(const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		if (len > MaxDataSize || !CheckRemoteInbox())
+			return false;
+
+		auto* slot = GetSlot();
+
+		std::memcpy(slot->buffer, data, len);
+
+		return Push(slot, len, nullptr);
+	}
+
+	bool InProcessPipe::Send(const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		const size_t len = packet->GetSize();
+
+		if (len > MaxDataSize || !CheckRemoteInbox())
+			return false;
+
+		auto* slot = GetSlot();
+
+		// Hand the packet over already parsed. Applies its rewrite plan, if any.
+		auto* clonedPacket = packet->CloneInto(slot->packetStorage, slot->buffer);
+
+		return Push(slot, len, clonedPacket);
+	}
+
+	bool InProcessPipe::Attach()
+	{
+		MS_TRACE();
+
+		std::shared_ptr<Inbox> inbox;
+
+		{
+			const std::lock_guard<std::mutex> lock(RegistryMutex);
+
+			auto it = Registry.find(this->remoteKey);
+
+			if (it != Registry.end())
+				inbox = it->second.lock();
+		}
+
+		if (!inbox || inbox == this->localInbox)
+			return false;
+
+		const std::lock_guard<std::mutex> lock(inbox->mutex);
+
+		// Inbox closed or already used by another sender (inboxes are SPSC).
+		if (!inbox->uvAsyncHandle || !inbox->senderKey.empty())
+			return false;
+
+		inbox->senderKey  = this->localKey;
+		this->remoteInbox = inbox;
+
+		return true;
+	}
+
+	inline bool InProcessPipe::CheckRemoteInbox()
+	{
+		if (!this->remoteInbox)
+			return false;
+
+		if (!this->remoteInbox->closed.load(std::memory_order_acquire))
+			return true;
+
+		// The remote pipe has been closed. It may have been created again under
+		// the same address, otherwise we are no longer connected.
+		this->remoteInbox.reset();
+
+		if (Attach())
+		{
+			MS_DEBUG_TAG(
+			  info,
+			  "remote in-process pipe closed, attached to a new one [key:%s]",
+			  this->remoteKey.c_str());
+
+			return true;
+		}
+
+		MS_WARN_TAG(
+		  info, "remote in-process pipe closed, pipe disconnected [key:%s]", this->remoteKey.c_str());
+
+		return false;
+	}
+
+	inline InProcessPipe::Slot* InProcessPipe::GetSlot()
+	{
+		Slot* slot;
+
+		if (this->remoteInbox->freeSlots.Pop(slot))
+			return slot;
+
+		return new Slot();
+	}
+
+	inline bool InProcessPipe::Push(Slot* slot, size_t len, RTC::RtpPacket* packet)
+	{
+		Inbox::Item item;
+
+		item.slot   = slot;
+		item.len    = len;
+		item.packet = packet;
+
+		// Inbox full, drop it.
+		if (!this->remoteInbox->items.Push(item))
+		{
+			MS_DEBUG_DEV("remote inbox full, dropping datagram");
+
+			if (packet)
+				packet->~RtpPacket();
+
+			delete slot;
+
+			return false;
+		}
+
+		// Wake up the receiver once per loop iteration rather than once per
+		// datagram.
+		if (!this->wakePending)
+		{
+			this->wakePending = true;
+
+			uv_check_start(this->uvCheckHandle, static_cast<uv_check_cb>(onCheck));
+		}
+
+		return true;
+	}
+
+	inline void InProcessPipe::OnUvAsync()
+	{
+		MS_TRACE();
+
+		auto& inbox = *this->localInbox;
+		bool accept;
+
+		// Just accept data from the remote PipeTransport we are connected to.
+		{
+			const std::lock_guard<std::mutex> lock(inbox.mutex);
+
+			accept = !this->remoteKey.empty() && inbox.senderKey == this->remoteKey;
+		}
+
+		Inbox::Item item;
+		size_t count{ 0u };
+
+		// Don't starve the loop if the sender is faster than us.
+		while (count < InboxCapacity && inbox.items.Pop(item))
+		{
+			++count;
+
+			if (item.packet)
+			{
+				if (accept)
+					this->listener->OnInProcessPipeRtpPacketReceived(this, item.packet);
+
+				item.packet->~RtpPacket();
+			}
+			else if (accept)
+			{
+				this->listener->OnInProcessPipeDataReceived(this, item.slot->buffer, item.len);
+			}
+
+			if (!inbox.freeSlots.Push(item.slot))
+				delete item.slot;
+		}
+
+		if (count == InboxCapacity)
+			uv_async_send(this->uvAsyncHandle);
+	}
+
+	inline void InProcessPipe::OnUvCheck()
+	{
+		MS_TRACE();
+
+		this->wakePending = false;
+
+		uv_check_stop(this->uvCheckHandle);
+
+		// Disconnected meanwhile.
+		if (!this->remoteInbox)
+			return;
+
+		const std::lock_guard<std::mutex> lock(this->remoteInbox->mutex);
+
+		if (this->remoteInbox->uvAsyncHandle)
+			uv_async_send(this->remoteInbox->uvAsyncHandle);
+	}
+} // namespace RTC
@@ -0,0 +1,144 @@
+#define MS_CLASS "RTC::KeyFrameCache"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/KeyFrameCache.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "RTC/SeqManager.hpp"
+
+namespace RTC
+{
+	/* Instance methods. */
+
+	void KeyFrameCache::Insert(RTC::RtpPacket* packet, RTC::RtpPacket::SharedPtr& sharedPacket)
+	{
+		MS_TRACE();
+
+		const auto seq = packet->GetSequenceNumber();
+		Stream* stream;
+
+		if (packet->IsKeyFrame())
+		{
+			stream = std::addressof(this->mapSsrcStream[packet->GetSsrc()]);
+
+			// Ignore late packets of a previous key frame.
+			// clang-format off
+			if (
+				!stream->packets.empty() &&
+				SeqManager<uint16_t>::IsSeqLowerThan(seq, stream->firstSeq)
+			)
+			// clang-format on
+			{
+				return;
+			}
+
+			// All the packets of a key frame may be flagged as such, so just start
+			// over if this one belongs to a new one.
+			// clang-format off
+			if (
+				stream->packets.empty() ||
+				stream->overflow ||
+				packet->GetTimestamp() != stream->timestamp
+			)
+			// clang-format on
+			{
+				MS_DEBUG_DEV(
+				  "new key frame [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32 "]",
+				  packet->GetSsrc(),
+				  seq,
+				  packet->GetTimestamp());
+
+				stream->packets.clear();
+				stream->numPackets = 0u;
+				stream->firstSeq   = seq;
+				stream->timestamp  = packet->GetTimestamp();
+				stream->overflow   = false;
+			}
+		}
+		else
+		{
+			auto it = this->mapSsrcStream.find(packet->GetSsrc());
+
+			if (it == this->mapSsrcStream.end())
+				return;
+
+			stream = std::addressof(it->second);
+
+			// clang-format off
+			if (
+				stream->packets.empty() ||
+				stream->overflow ||
+				SeqManager<uint16_t>::IsSeqLowerThan(seq, stream->firstSeq)
+			)
+			// clang-format on
+			{
+				return;
+			}
+		}
+
+		const size_t idx = static_cast<uint16_t>(seq - stream->firstSeq);
+
+		// Too long since the key frame, give up until the next one.
+		if (idx >= MaxPackets)
+		{
+			MS_DEBUG_DEV(
+			  "too many packets since the key frame, clearing [ssrc:%" PRIu32 "]", packet->GetSsrc());
+
+			stream->packets.clear();
+			stream->numPackets = 0u;
+			stream->overflow   = true;
+
+			return;
+		}
+
+		if (idx >= stream->packets.size())
+			stream->packets.resize(idx + 1);
+
+		auto& item = stream->packets[idx];
+
+		// Duplicated packet.
+		if (item.get())
+			return;
+
+		// Only clone once and only if necessary. See RtpRetransmissionBuffer.
+		if (!sharedPacket.get())
+			sharedPacket.reset(packet->Clone());
+
+		item = sharedPacket;
+
+		stream->numPackets++;
+		stream->lastPacketAtMs = DepLibUV::GetTimeMs();
+	}
+
+	const std::vector<RTC::RtpPacket::SharedPtr>* KeyFrameCache::Get(uint32_t ssrc) const
+	{
+		MS_TRACE();
+
+		auto it = this->mapSsrcStream.find(ssrc);
+
+		if (it == this->mapSsrcStream.end())
+			return nullptr;
+
+		const auto& stream = it->second;
+
+		// clang-format off
+		if (
+			stream.packets.empty() ||
+			stream.numPackets != stream.packets.size() ||
+			DepLibUV::GetTimeMs() - stream.lastPacketAtMs > MaxIdleMs
+		)
+		// clang-format on
+		{
+			return nullptr;
+		}
+
+		return std::addressof(stream.packets);
+	}
+
+	void KeyFrameCache::Clear()
+	{
+		MS_TRACE();
+
+		this->mapSsrcStream.clear();
+	}
+} // namespace RTC
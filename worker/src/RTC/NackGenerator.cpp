@@ -4,19 +4,94 @@
 #include "RTC/NackGenerator.hpp"
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
-#include <iterator> // std::ostream_iterator
-#include <sstream>  // std::ostringstream
-#include <utility>  // std::make_pair()
+#include "Utils.hpp"
+#include <algorithm> // std::min(), std::fill()
+#include <iterator>  // std::begin(), std::end(), std::ostream_iterator
+#include <sstream>   // std::ostringstream
 
 namespace RTC
 {
 	/* Static. */
 
-	static constexpr size_t MaxPacketAge{ 10000u };
 	static constexpr size_t MaxNackPackets{ 1000u };
 	static constexpr uint32_t DefaultRtt{ 100u };
 	static constexpr uint8_t MaxNackRetries{ 10u };
 	static constexpr uint64_t TimerInterval{ 40u };
+	// Room for recovered packets newer than the last seen seq.
+	static constexpr size_t MaxRecoveredAhead{ NackGenerator::WindowSize -
+		                                           NackGenerator::MaxPacketAge };
+
+	// Calls fn(word, mask, baseSeq) for each bitmap word covering the given
+	// range of seqs (in seq order), where mask selects the bits of the range in
+	// that word and baseSeq is the seq of its bit 0. Stops if fn returns false.
+	template<typename F>
+	inline static void forEachWord(uint16_t seq, size_t count, F fn)
+	{
+		size_t slot = seq & (NackGenerator::WindowSize - 1);
+
+		while (count != 0u)
+		{
+			const size_t bit = slot % 64u;
+			const size_t num = std::min(64u - bit, count);
+			const uint64_t mask =
+			  (num == 64u ? ~uint64_t{ 0u } : ((uint64_t{ 1u } << num) - 1u)) << bit;
+
+			if (!fn(slot / 64u, mask, static_cast<uint16_t>(seq - bit)))
+				return;
+
+			seq += static_cast<uint16_t>(num);
+			count -= num;
+			slot = (slot + num) & (NackGenerator::WindowSize - 1);
+		}
+	}
+
+	/* Class methods. */
+
+	// Returns the number of bits that were set.
+	size_t NackGenerator::Clear(uint64_t* bitmap, uint16_t seq, size_t count)
+	{
+		MS_TRACE();
+
+		size_t cleared{ 0u };
+
+		forEachWord(
+		  seq,
+		  count,
+		  [bitmap, &cleared](size_t word, uint64_t mask, uint16_t /*baseSeq*/)
+		  {
+			  cleared += Utils::Bits::CountSetBits(bitmap[word] & mask);
+			  bitmap[word] &= ~mask;
+
+			  return true;
+		  });
+
+		return cleared;
+	}
+
+	// Returns the offset of the first bit set, or count if none.
+	size_t NackGenerator::FindFirst(const uint64_t* bitmap, uint16_t seq, size_t count)
+	{
+		MS_TRACE();
+
+		size_t offset{ count };
+
+		forEachWord(
+		  seq,
+		  count,
+		  [bitmap, seq, &offset](size_t word, uint64_t mask, uint16_t baseSeq)
+		  {
+			  const uint64_t bits = bitmap[word] & mask;
+
+			  if (bits == 0u)
+				  return true;
+
+			  offset = static_cast<uint16_t>(baseSeq + Utils::Bits::GetLowestSetBit(bits) - seq);
+
+			  return false;
+		  });
+
+		return offset;
+	}
 
 	/* Instance methods. */
 
@@ -37,11 +112,18 @@ namespace RTC
 		delete this->timer;
 	}
 
-	// Returns true if this is a found nacked packet. False otherwise.
 	bool NackGenerator::ReceivePacket(RTC::RtpPacket* packet, bool isRecovered)
 	{
 		MS_TRACE();
 
+		return ReceivePacket(packet, isRecovered, DepLibUV::GetTimeMs());
+	}
+
+	// Returns true if this is a found nacked packet. False otherwise.
+	bool NackGenerator::ReceivePacket(RTC::RtpPacket* packet, bool isRecovered, uint64_t nowMs)
+	{
+		MS_TRACE();
+
 		uint16_t seq          = packet->GetSequenceNumber();
 		const bool isKeyFrame = packet->IsKeyFrame();
 
@@ -51,7 +133,7 @@ namespace RTC
 			this->lastSeq = seq;
 
 			if (isKeyFrame)
-				this->keyFrameList.insert(seq);
+				Set(this->keyFrameList, seq);
 
 			return false;
 		}
@@ -64,10 +146,8 @@ namespace RTC
 		// or a retransmitted packet.
 		if (SeqManager<uint16_t>::IsSeqLowerThan(seq, this->lastSeq))
 		{
-			auto it = this->nackList.find(seq);
-
 			// It was a nacked packet.
-			if (it != this->nackList.end())
+			if (IsInWindow(seq) && IsSet(this->nackList, seq))
 			{
 				MS_DEBUG_DEV(
 				  "NACKed packet received [ssrc:%" PRIu32 ", seq:%" PRIu16 ", recovered:%s]",
@@ -75,9 +155,9 @@ namespace RTC
 				  packet->GetSequenceNumber(),
 				  isRecovered ? "true" : "false");
 
-				auto retries = it->second.retries;
+				auto retries = this->retries[GetSlot(seq)];
 
-				this->nackList.erase(it);
+				this->nackListLength -= Clear(this->nackList, seq, 1u);
 
 				if (retries != 0)
 					return true;
@@ -100,38 +180,45 @@ namespace RTC
 		// If we are here it means that we may have lost some packets so seq is
 		// newer than the latest seq seen.
 
-		if (isKeyFrame)
-			this->keyFrameList.insert(seq);
-
-		// Remove old keyframes.
-		{
-			auto it = this->keyFrameList.lower_bound(seq - MaxPacketAge);
-
-			if (it != this->keyFrameList.begin())
-				this->keyFrameList.erase(this->keyFrameList.begin(), it);
-		}
+		const uint16_t distance = seq - this->lastSeq;
 
 		if (isRecovered)
 		{
-			this->recoveredList.insert(seq);
-
-			// Remove old ones so we don't accumulate recovered packets.
-			auto it = this->recoveredList.lower_bound(seq - MaxPacketAge);
+			// Do not send NACK for it once the gap is added to the NACK list. If
+			// it's too far ahead just forget about it.
+			if (distance <= MaxRecoveredAhead)
+			{
+				Set(this->recoveredList, seq);
 
-			if (it != this->recoveredList.begin())
-				this->recoveredList.erase(this->recoveredList.begin(), it);
+				if (isKeyFrame)
+					Set(this->keyFrameList, seq);
+			}
 
 			// Do not let a packet pass if it's newer than last seen seq and came via
 			// RTX.
 			return false;
 		}
 
-		AddPacketsToNackList(this->lastSeq + 1, seq);
+		// Move the window forward. Slots of packets getting too old are reused for
+		// the newest recovered ones.
+		{
+			const auto count            = std::min(static_cast<size_t>(distance), size_t{ WindowSize });
+			const uint16_t firstSlotSeq = this->lastSeq + MaxRecoveredAhead + 1u;
+
+			this->nackListLength -= Clear(this->nackList, firstSlotSeq, count);
+			Clear(this->keyFrameList, firstSlotSeq, count);
+			Clear(this->recoveredList, firstSlotSeq, count);
+		}
+
+		if (isKeyFrame)
+			Set(this->keyFrameList, seq);
+
+		AddPacketsToNackList(this->lastSeq + 1, seq, nowMs);
 
 		this->lastSeq = seq;
 
 		// Check if there are any nacks that are waiting for this seq number.
-		std::vector<uint16_t> nackBatch = GetNackBatch(NackFilter::SEQ);
+		std::vector<uint16_t> nackBatch = GetNackBatch(NackFilter::SEQ, nowMs);
 
 		if (!nackBatch.empty())
 			this->listener->OnNackGeneratorNackRequired(nackBatch);
@@ -144,165 +231,156 @@ namespace RTC
 		return false;
 	}
 
-	void NackGenerator::AddPacketsToNackList(uint16_t seqStart, uint16_t seqEnd)
+	void NackGenerator::AddPacketsToNackList(uint16_t seqStart, uint16_t seqEnd, uint64_t nowMs)
 	{
 		MS_TRACE();
 
-		// Remove old packets.
-		auto it = this->nackList.lower_bound(seqEnd - MaxPacketAge);
-
-		this->nackList.erase(this->nackList.begin(), it);
-
 		// If the nack list is too large, remove packets from the nack list until
 		// the latest first packet of a keyframe. If the list is still too large,
 		// clear it and request a keyframe.
 		const uint16_t numNewNacks = seqEnd - seqStart;
 
-		if (static_cast<uint16_t>(this->nackList.size()) + numNewNacks > MaxNackPackets)
+		if (this->nackListLength + numNewNacks > MaxNackPackets)
 		{
 			// clang-format off
 			while (
 				RemoveNackItemsUntilKeyFrame() &&
-				static_cast<uint16_t>(this->nackList.size()) + numNewNacks > MaxNackPackets
+				this->nackListLength + numNewNacks > MaxNackPackets
 			)
 			// clang-format on
 			{
 			}
 
-			if (static_cast<uint16_t>(this->nackList.size()) + numNewNacks > MaxNackPackets)
+			if (this->nackListLength + numNewNacks > MaxNackPackets)
 			{
 				MS_WARN_TAG(
 				  rtx, "NACK list full, clearing it and requesting a key frame [seqEnd:%" PRIu16 "]", seqEnd);
 
-				this->nackList.clear();
+				std::fill(std::begin(this->nackList), std::end(this->nackList), 0u);
+				this->nackListLength = 0u;
 				this->listener->OnNackGeneratorKeyFrameRequired();
 
 				return;
 			}
 		}
 
-		for (uint16_t seq = seqStart; seq != seqEnd; ++seq)
-		{
-			MS_ASSERT(this->nackList.find(seq) == this->nackList.end(), "packet already in the NACK list");
-
-			// Do not send NACK for packets that are already recovered by RTX.
-			if (this->recoveredList.find(seq) != this->recoveredList.end())
-				continue;
-
-			this->nackList.emplace(std::make_pair(
-			  seq,
-			  NackInfo{
-			    DepLibUV::GetTimeMs(),
-			    seq,
-			    seq,
-			  }));
-		}
-	}
+		const auto truncatedNowMs = static_cast<uint16_t>(nowMs);
 
-	bool NackGenerator::RemoveNackItemsUntilKeyFrame()
-	{
-		MS_TRACE();
+		forEachWord(
+		  seqStart,
+		  numNewNacks,
+		  [this, truncatedNowMs](size_t word, uint64_t mask, uint16_t /*baseSeq*/)
+		  {
+			  // Do not send NACK for packets that are already recovered by RTX.
+			  uint64_t bits = mask & ~this->recoveredList[word];
 
-		while (!this->keyFrameList.empty())
-		{
-			auto it = this->nackList.lower_bound(*this->keyFrameList.begin());
+			  this->nackList[word] |= bits;
+			  this->nackListLength += Utils::Bits::CountSetBits(bits);
 
-			if (it != this->nackList.begin())
-			{
-				// We have found a keyframe that actually is newer than at least one
-				// packet in the nack list.
-				this->nackList.erase(this->nackList.begin(), it);
-
-				return true;
-			}
+			  for (; bits != 0u; bits &= bits - 1u)
+			  {
+				  const size_t slot = (word * 64u) + Utils::Bits::GetLowestSetBit(bits);
 
-			// If this keyframe is so old it does not remove any packets from the list,
-			// remove it from the list of keyframes and try the next keyframe.
-			this->keyFrameList.erase(this->keyFrameList.begin());
-		}
+				  this->createdAtMs[slot] = truncatedNowMs;
+				  this->sentAtMs[slot]    = 0u;
+				  this->retries[slot]     = 0u;
+			  }
 
-		return false;
+			  return true;
+		  });
 	}
 
-	std::vector<uint16_t> NackGenerator::GetNackBatch(NackFilter filter)
+	bool NackGenerator::RemoveNackItemsUntilKeyFrame()
 	{
 		MS_TRACE();
 
-		const uint64_t nowMs = DepLibUV::GetTimeMs();
-		std::vector<uint16_t> nackBatch;
+		const uint16_t oldestSeq    = this->lastSeq - MaxPacketAge + 1u;
+		const auto oldestNackOffset = FindFirst(this->nackList, oldestSeq, MaxPacketAge);
 
-		auto it = this->nackList.begin();
+		// Key frames not newer than the oldest packet in the nack list do not
+		// remove any packet from it.
+		Clear(this->keyFrameList, oldestSeq, std::min(oldestNackOffset + 1u, size_t{ MaxPacketAge }));
 
-		while (it != this->nackList.end())
-		{
-			NackInfo& nackInfo = it->second;
-			uint16_t seq       = nackInfo.seq;
+		if (oldestNackOffset == MaxPacketAge)
+			return false;
 
-			if (this->sendNackDelayMs > 0 && nowMs - nackInfo.createdAtMs < this->sendNackDelayMs)
-			{
-				++it;
-				continue;
-			}
+		// Look for the oldest key frame newer than the oldest packet in the nack
+		// list (maybe a recovered one newer than the last seq).
+		const uint16_t oldestNackSeq = oldestSeq + oldestNackOffset;
+		const uint16_t count         = this->lastSeq + MaxRecoveredAhead - oldestNackSeq;
+		const auto keyFrameOffset    = FindFirst(this->keyFrameList, oldestNackSeq + 1u, count);
 
-			// clang-format off
-			if (
-				filter == NackFilter::SEQ &&
-				nackInfo.sentAtMs == 0 &&
-				(
-					nackInfo.sendAtSeq == this->lastSeq ||
-					SeqManager<uint16_t>::IsSeqHigherThan(this->lastSeq, nackInfo.sendAtSeq)
-				)
-			)
-			// clang-format on
-			{
-				nackBatch.emplace_back(seq);
-				nackInfo.retries++;
-				nackInfo.sentAtMs = nowMs;
-
-				if (nackInfo.retries >= MaxNackRetries)
-				{
-					MS_WARN_TAG(
-					  rtx,
-					  "sequence number removed from the NACK list due to max retries [filter:seq, seq:%" PRIu16
-					  "]",
-					  seq);
-
-					it = this->nackList.erase(it);
-				}
-				else
-				{
-					++it;
-				}
+		if (keyFrameOffset == count)
+			return false;
 
-				continue;
-			}
+		// We have found a keyframe that actually is newer than at least one packet
+		// in the nack list.
+		this->nackListLength -= Clear(this->nackList, oldestNackSeq, keyFrameOffset + 1u);
 
-			if (filter == NackFilter::TIME && (nackInfo.sentAtMs == 0 || nowMs - nackInfo.sentAtMs >= this->rtt))
-			{
-				nackBatch.emplace_back(seq);
-				nackInfo.retries++;
-				nackInfo.sentAtMs = nowMs;
-
-				if (nackInfo.retries >= MaxNackRetries)
-				{
-					MS_WARN_TAG(
-					  rtx,
-					  "sequence number removed from the NACK list due to max retries [filter:time, seq:%" PRIu16
-					  "]",
-					  seq);
-
-					it = this->nackList.erase(it);
-				}
-				else
-				{
-					++it;
-				}
+		return true;
+	}
 
-				continue;
-			}
+	std::vector<uint16_t> NackGenerator::GetNackBatch(NackFilter filter, uint64_t nowMs)
+	{
+		MS_TRACE();
 
-			++it;
-		}
+		const auto truncatedNowMs = static_cast<uint16_t>(nowMs);
+		const auto rtt            = static_cast<uint16_t>(std::min(this->rtt, uint32_t{ UINT16_MAX }));
+		std::vector<uint16_t> nackBatch;
+
+		forEachWord(
+		  this->lastSeq - MaxPacketAge + 1u,
+		  MaxPacketAge,
+		  [this, filter, truncatedNowMs, rtt, &nackBatch](size_t word, uint64_t mask, uint16_t baseSeq)
+		  {
+			  for (uint64_t bits = this->nackList[word] & mask; bits != 0u; bits &= bits - 1u)
+			  {
+				  const auto bit     = Utils::Bits::GetLowestSetBit(bits);
+				  const auto slot    = (word * 64u) + bit;
+				  const uint16_t seq = baseSeq + bit;
+
+				  if (this->retries[slot] == 0u)
+				  {
+					  // clang-format off
+					  if (
+						  this->sendNackDelayMs > 0 &&
+						  static_cast<uint16_t>(truncatedNowMs - this->createdAtMs[slot]) <
+						    this->sendNackDelayMs
+					  )
+					  // clang-format on
+					  {
+						  continue;
+					  }
+				  }
+				  // Packets in the list are never newer than the last seq, so the SEQ filter
+				  // just takes those not sent yet.
+				  else if (
+				    filter == NackFilter::SEQ ||
+				    static_cast<uint16_t>(truncatedNowMs - this->sentAtMs[slot]) < rtt)
+				  {
+					  continue;
+				  }
+
+				  nackBatch.emplace_back(seq);
+				  this->retries[slot]++;
+				  this->sentAtMs[slot] = truncatedNowMs;
+
+				  if (this->retries[slot] >= MaxNackRetries)
+				  {
+					  MS_WARN_TAG(
+					    rtx,
+					    "sequence number removed from the NACK list due to max retries [filter:%s, "
+					    "seq:%" PRIu16 "]",
+					    filter == NackFilter::SEQ ? "seq" : "time",
+					    seq);
+
+					  this->nackList[word] &= ~(uint64_t{ 1u } << bit);
+					  this->nackListLength--;
+				  }
+			  }
+
+			  return true;
+		  });
 
 #if MS_LOG_DEV_LEVEL == 3
 		if (!nackBatch.empty())
@@ -326,9 +404,10 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		this->nackList.clear();
-		this->keyFrameList.clear();
-		this->recoveredList.clear();
+		std::fill(std::begin(this->nackList), std::end(this->nackList), 0u);
+		std::fill(std::begin(this->keyFrameList), std::end(this->keyFrameList), 0u);
+		std::fill(std::begin(this->recoveredList), std::end(this->recoveredList), 0u);
+		this->nackListLength = 0u;
 
 		this->started = false;
 		this->lastSeq = 0u;
@@ -336,19 +415,26 @@ namespace RTC
 
 	inline void NackGenerator::MayRunTimer() const
 	{
-		if (!this->nackList.empty())
+		if (this->nackListLength != 0u)
 			this->timer->Start(TimerInterval);
 	}
 
-	inline void NackGenerator::OnTimer(Timer* /*timer*/)
+	void NackGenerator::NackTimedOutPackets(uint64_t nowMs)
 	{
 		MS_TRACE();
 
-		std::vector<uint16_t> nackBatch = GetNackBatch(NackFilter::TIME);
+		std::vector<uint16_t> nackBatch = GetNackBatch(NackFilter::TIME, nowMs);
 
 		if (!nackBatch.empty())
 			this->listener->OnNackGeneratorNackRequired(nackBatch);
 
 		MayRunTimer();
 	}
+
+	inline void NackGenerator::OnTimer(Timer* /*timer*/)
+	{
+		MS_TRACE();
+
+		NackTimedOutPackets(DepLibUV::GetTimeMs());
+	}
 } // namespace RTC
@@ -92,6 +92,18 @@ namespace RTC
 		}
 	}
 
+	void PipeConsumer::FillBinaryStats(Channel::BinaryBody::Writer& writer) const
+	{
+		MS_TRACE();
+
+		// Add stats of our send streams.
+		for (auto* rtpStream : this->rtpStreams)
+		{
+			rtpStream->FillBinaryStats(writer);
+			writer.EndRecord();
+		}
+	}
+
 	void PipeConsumer::FillJsonScore(json& jsonObject) const
 	{
 		MS_TRACE();
@@ -197,11 +209,11 @@ namespace RTC
 		return 0u;
 	}
 
-	void PipeConsumer::SendRtpPacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	void PipeConsumer::SendRtpPacket(RTC::RtpPacket* packet, RTC::RtpPacket::SharedPtr& sharedPacket)
 	{
 		MS_TRACE();
 
-		packet->logger.consumerId = this->id;
+		packet->logger.consumerHandle = this->traceHandle.value;
 
 		if (!IsActive())
 		{
@@ -260,9 +272,13 @@ namespace RTC
 		auto origSsrc = packet->GetSsrc();
 		auto origSeq  = packet->GetSequenceNumber();
 
-		// Rewrite packet.
-		packet->SetSsrc(ssrc);
-		packet->SetSequenceNumber(seq);
+		// Rewrite packet. The packet is not modified, the rewrite plan is applied
+		// when copying it into the egress buffer.
+		this->rewritePlan.ssrc           = ssrc;
+		this->rewritePlan.sequenceNumber = seq;
+		this->rewritePlan.timestamp      = packet->GetTimestamp();
+
+		packet->SetRewritePlan(std::addressof(this->rewritePlan));
 
 		packet->logger.sendRtpTimestamp = packet->GetTimestamp();
 		packet->logger.sendSeqNumber    = seq;
@@ -302,9 +318,8 @@ namespace RTC
 			  origSeq);
 		}
 
-		// Restore packet fields.
-		packet->SetSsrc(origSsrc);
-		packet->SetSequenceNumber(origSeq);
+		// Detach the rewrite plan.
+		packet->SetRewritePlan(nullptr);
 	}
 
 	bool PipeConsumer::GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t nowMs)
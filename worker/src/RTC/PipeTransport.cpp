@@ -87,6 +87,12 @@ namespace RTC
 			this->srtpKeyBase64 = Utils::String::Base64Encode(this->srtpKey);
 		}
 
+		bool enableInProcess{ false };
+		auto jsonEnableInProcessIt = data.find("enableInProcess");
+
+		if (jsonEnableInProcessIt != data.end() && jsonEnableInProcessIt->is_boolean())
+			enableInProcess = jsonEnableInProcessIt->get<bool>();
+
 		try
 		{
 			// This may throw.
@@ -95,6 +101,18 @@ namespace RTC
 			else
 				this->udpSocket = new RTC::UdpSocket(this, this->listenIp.ip);
 
+			// The in-process pipe is registered under the same address the remote
+			// PipeTransport will connect() to.
+			if (enableInProcess)
+			{
+				// This may throw.
+				this->inProcessPipe = new RTC::InProcessPipe(
+				  this,
+				  this->listenIp.announcedIp.empty() ? this->udpSocket->GetLocalIp()
+				                                     : this->listenIp.announcedIp,
+				  this->udpSocket->GetLocalPort());
+			}
+
 			// NOTE: This may throw.
 			this->shared->channelMessageRegistrator->RegisterHandler(
 			  this->id,
@@ -109,6 +127,9 @@ namespace RTC
 			delete this->udpSocket;
 			this->udpSocket = nullptr;
 
+			delete this->inProcessPipe;
+			this->inProcessPipe = nullptr;
+
 			throw;
 		}
 	}
@@ -130,6 +151,9 @@ namespace RTC
 
 		delete this->srtpRecvSession;
 		this->srtpRecvSession = nullptr;
+
+		delete this->inProcessPipe;
+		this->inProcessPipe = nullptr;
 	}
 
 	void PipeTransport::FillJson(json& jsonObject) const
@@ -204,6 +228,37 @@ namespace RTC
 		}
 	}
 
+	void PipeTransport::FillBinaryStats(Channel::BinaryBody::Writer& writer)
+	{
+		MS_TRACE();
+
+		using Key = Channel::BinaryBody::Key;
+
+		// Call the parent method.
+		RTC::Transport::FillBinaryStats(writer);
+
+		writer.WriteString(Key::TYPE, "pipe-transport");
+		writer.StartRecord(Key::TUPLE);
+
+		if (this->tuple)
+		{
+			this->tuple->FillBinary(writer);
+		}
+		else
+		{
+			if (this->listenIp.announcedIp.empty())
+				writer.WriteString(Key::LOCAL_IP, this->udpSocket->GetLocalIp());
+			else
+				writer.WriteString(Key::LOCAL_IP, this->listenIp.announcedIp);
+
+			writer.WriteUint(Key::LOCAL_PORT, this->udpSocket->GetLocalPort());
+			writer.WriteString(Key::PROTOCOL, "udp");
+		}
+
+		writer.EndRecord();
+		writer.EndRecord();
+	}
+
 	void PipeTransport::HandleRequest(Channel::ChannelRequest* request)
 	{
 		MS_TRACE();
@@ -388,6 +443,14 @@ namespace RTC
 
 					if (!this->listenIp.announcedIp.empty())
 						this->tuple->SetLocalAnnouncedIp(this->listenIp.announcedIp);
+
+					// If the remote PipeTransport lives in this process, bypass the
+					// socket. Otherwise keep using UDP.
+					if (this->inProcessPipe && this->inProcessPipe->Connect(ip, port))
+					{
+						MS_DEBUG_TAG(
+						  info, "in-process pipe connected [ip:%s, port:%" PRIu16 "]", ip.c_str(), port);
+					}
 				}
 				catch (const MediaSoupError& error)
 				{
@@ -459,23 +522,73 @@ namespace RTC
 			return;
 		}
 
-		const uint8_t* data = packet->GetData();
-		auto intLen         = static_cast<int>(packet->GetSize());
-
-		if (HasSrtp() && !this->srtpSendSession->EncryptRtp(&data, &intLen))
+		// NOTE: No SRTP needed since data doesn't leave the process.
+		if (this->inProcessPipe && this->inProcessPipe->Send(packet))
 		{
 			if (cb)
 			{
-				(*cb)(false);
+				(*cb)(true);
 				delete cb;
 			}
 
+			// Increase send transmission.
+			RTC::Transport::DataSent(packet->GetSize());
+
 			return;
 		}
 
-		auto len = static_cast<size_t>(intLen);
+		if (HasSrtp())
+		{
+			// Copy the packet (applying its rewrite plan) into a pooled send buffer
+			// with room for the SRTP trailer and encrypt it there. The buffer is then
+			// handed to the socket so the encrypted packet is not copied again.
+			auto* sendData = ::UdpSocketHandler::AllocateSendData(packet->GetSize() + SRTP_MAX_TRAILER_LEN);
+			auto intLen    = static_cast<int>(packet->GetSize());
+
+			packet->Write(sendData->store);
+
+			if (!this->srtpSendSession->EncryptRtp(sendData->store, &intLen, sendData->storeSize))
+			{
+				::UdpSocketHandler::ReleaseSendData(sendData);
+
+				if (cb)
+				{
+					(*cb)(false);
+					delete cb;
+				}
+
+				return;
+			}
+
+			auto len = static_cast<size_t>(intLen);
+
+			sendData->len = len;
+
+			this->tuple->Send(sendData, cb);
+
+			// Increase send transmission.
+			RTC::Transport::DataSent(len);
+
+			return;
+		}
+
+		auto len = packet->GetSize();
+
+		// The packet must be copied to apply its rewrite plan.
+		if (packet->GetRewritePlan())
+		{
+			auto* sendData = ::UdpSocketHandler::AllocateSendData(len);
+
+			packet->Write(sendData->store);
 
-		this->tuple->Send(data, len, cb);
+			sendData->len = len;
+
+			this->tuple->Send(sendData, cb);
+		}
+		else
+		{
+			this->tuple->Send(packet->GetData(), len, cb);
+		}
 
 		// Increase send transmission.
 		RTC::Transport::DataSent(len);
@@ -491,6 +604,14 @@ namespace RTC
 		const uint8_t* data = packet->GetData();
 		auto intLen         = static_cast<int>(packet->GetSize());
 
+		if (this->inProcessPipe && this->inProcessPipe->Send(data, packet->GetSize()))
+		{
+			// Increase send transmission.
+			RTC::Transport::DataSent(packet->GetSize());
+
+			return;
+		}
+
 		if (HasSrtp() && !this->srtpSendSession->EncryptRtcp(&data, &intLen))
 			return;
 
@@ -514,6 +635,14 @@ namespace RTC
 		const uint8_t* data = packet->GetData();
 		auto intLen         = static_cast<int>(packet->GetSize());
 
+		if (this->inProcessPipe && this->inProcessPipe->Send(data, packet->GetSize()))
+		{
+			// Increase send transmission.
+			RTC::Transport::DataSent(packet->GetSize());
+
+			return;
+		}
+
 		if (HasSrtp() && !this->srtpSendSession->EncryptRtcp(&data, &intLen))
 			return;
 
@@ -540,7 +669,8 @@ namespace RTC
 		if (!IsConnected())
 			return;
 
-		this->tuple->Send(data, len);
+		if (!this->inProcessPipe || !this->inProcessPipe->Send(data, len))
+			this->tuple->Send(data, len);
 
 		// Increase send transmission.
 		RTC::Transport::DataSent(len);
@@ -719,4 +849,60 @@ namespace RTC
 
 		OnPacketReceived(&tuple, data, len);
 	}
+
+	inline void PipeTransport::OnInProcessPipeDataReceived(
+	  RTC::InProcessPipe* /*inProcessPipe*/, const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		// The in-process pipe just delivers data sent by the remote PipeTransport
+		// we are connected to, and such data is never SRTP protected.
+		if (!IsConnected())
+			return;
+
+		// Increase receive transmission.
+		RTC::Transport::DataReceived(len);
+
+		// Check if it's RTCP.
+		if (RTC::RTCP::Packet::IsRtcp(data, len))
+		{
+			RTC::RTCP::Packet* packet = RTC::RTCP::Packet::Parse(data, len);
+
+			if (!packet)
+			{
+				MS_WARN_TAG(rtcp, "received data is not a valid RTCP compound or single packet");
+
+				return;
+			}
+
+			// Pass the packet to the parent transport.
+			RTC::Transport::ReceiveRtcpPacket(packet);
+		}
+		// Check if it's SCTP.
+		else if (RTC::SctpAssociation::IsSctp(data, len))
+		{
+			// Pass it to the parent transport.
+			RTC::Transport::ReceiveSctpData(data, len);
+		}
+		else
+		{
+			MS_WARN_DEV("ignoring received packet of unknown type");
+		}
+	}
+
+	inline void PipeTransport::OnInProcessPipeRtpPacketReceived(
+	  RTC::InProcessPipe* /*inProcessPipe*/, RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		if (!IsConnected())
+			return;
+
+		// Increase receive transmission.
+		RTC::Transport::DataReceived(packet->GetSize());
+
+		// Pass the packet to the parent transport. It's already parsed and it's
+		// owned by the pipe.
+		RTC::Transport::HandleRtpPacket(packet);
+	}
 } // namespace RTC
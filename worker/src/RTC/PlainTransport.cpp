@@ -5,6 +5,7 @@
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
+#include <cstring> // std::memcpy()
 
 namespace RTC
 {
@@ -336,6 +337,47 @@ namespace RTC
 			this->rtcpTuple->FillJson(jsonObject["rtcpTuple"]);
 	}
 
+	void PlainTransport::FillBinaryStats(Channel::BinaryBody::Writer& writer)
+	{
+		MS_TRACE();
+
+		using Key = Channel::BinaryBody::Key;
+
+		// Call the parent method.
+		RTC::Transport::FillBinaryStats(writer);
+
+		writer.WriteString(Key::TYPE, "plain-rtp-transport");
+		writer.WriteBool(Key::RTCP_MUX, this->rtcpMux);
+		writer.WriteBool(Key::COMEDIA, this->comedia);
+		writer.StartRecord(Key::TUPLE);
+
+		if (this->tuple)
+		{
+			this->tuple->FillBinary(writer);
+		}
+		else
+		{
+			if (this->listenIp.announcedIp.empty())
+				writer.WriteString(Key::LOCAL_IP, this->udpSocket->GetLocalIp());
+			else
+				writer.WriteString(Key::LOCAL_IP, this->listenIp.announcedIp);
+
+			writer.WriteUint(Key::LOCAL_PORT, this->udpSocket->GetLocalPort());
+			writer.WriteString(Key::PROTOCOL, "udp");
+		}
+
+		writer.EndRecord();
+
+		if (!this->rtcpMux && this->rtcpTuple)
+		{
+			writer.StartRecord(Key::RTCP_TUPLE);
+			this->rtcpTuple->FillBinary(writer);
+			writer.EndRecord();
+		}
+
+		writer.EndRecord();
+	}
+
 	void PlainTransport::HandleRequest(Channel::ChannelRequest* request)
 	{
 		MS_TRACE();
@@ -725,23 +767,58 @@ namespace RTC
 			return;
 		}
 
-		const uint8_t* data = packet->GetData();
-		auto intLen         = static_cast<int>(packet->GetSize());
-
-		if (HasSrtp() && !this->srtpSendSession->EncryptRtp(&data, &intLen))
+		if (HasSrtp())
 		{
-			if (cb)
+			// Copy the packet (applying its rewrite plan) into a pooled send buffer
+			// with room for the SRTP trailer and encrypt it there. The buffer is then
+			// handed to the socket so the encrypted packet is not copied again.
+			auto* sendData = ::UdpSocketHandler::AllocateSendData(packet->GetSize() + SRTP_MAX_TRAILER_LEN);
+			auto intLen    = static_cast<int>(packet->GetSize());
+
+			packet->Write(sendData->store);
+
+			if (!this->srtpSendSession->EncryptRtp(sendData->store, &intLen, sendData->storeSize))
 			{
-				(*cb)(false);
-				delete cb;
+				::UdpSocketHandler::ReleaseSendData(sendData);
+
+				if (cb)
+				{
+					(*cb)(false);
+					delete cb;
+				}
+
+				return;
 			}
 
+			auto len = static_cast<size_t>(intLen);
+
+			sendData->len = len;
+
+			this->tuple->Send(sendData, cb);
+
+			// Increase send transmission.
+			RTC::Transport::DataSent(len);
+
 			return;
 		}
 
-		auto len = static_cast<size_t>(intLen);
+		auto len = packet->GetSize();
+
+		// The packet must be copied to apply its rewrite plan.
+		if (packet->GetRewritePlan())
+		{
+			auto* sendData = ::UdpSocketHandler::AllocateSendData(len);
 
-		this->tuple->Send(data, len, cb);
+			packet->Write(sendData->store);
+
+			sendData->len = len;
+
+			this->tuple->Send(sendData, cb);
+		}
+		else
+		{
+			this->tuple->Send(packet->GetData(), len, cb);
+		}
 
 		// Increase send transmission.
 		RTC::Transport::DataSent(len);
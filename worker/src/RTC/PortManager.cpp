@@ -7,6 +7,7 @@
 #include "MediaSoupErrors.hpp"
 #include "Settings.hpp"
 #include "Utils.hpp"
+#include <cerrno>
 #include <tuple>   // std:make_tuple()
 #include <utility> // std::piecewise_construct
 
@@ -314,7 +315,33 @@ namespace RTC
 		return static_cast<uv_handle_t*>(uvHandle);
 	}
 
-	uv_handle_t* PortManager::Bind(Transport transport, std::string& ip, uint16_t port)
+	uv_udp_t* PortManager::ConnectUdp(
+	  std::string& ip, uint16_t port, const struct sockaddr* remoteAddr)
+	{
+		MS_TRACE();
+
+		// This may throw.
+		auto* uvHandle = reinterpret_cast<uv_udp_t*>(
+		  Bind(Transport::UDP, ip, port, /*reusePort*/ false, /*reuseAddr*/ true));
+
+		const int err = uv_udp_connect(uvHandle, remoteAddr);
+
+		if (err != 0)
+		{
+			uv_close(reinterpret_cast<uv_handle_t*>(uvHandle), static_cast<uv_close_cb>(onClose));
+
+			MS_THROW_ERROR(
+			  "uv_udp_connect() failed [ip:'%s', port:%" PRIu16 "]: %s",
+			  ip.c_str(),
+			  port,
+			  uv_strerror(err));
+		}
+
+		return uvHandle;
+	}
+
+	uv_handle_t* PortManager::Bind(
+	  Transport transport, std::string& ip, uint16_t port, bool reusePort, bool reuseAddr)
 	{
 		MS_TRACE();
 
@@ -388,8 +415,12 @@ namespace RTC
 		{
 			case Transport::UDP:
 				uvHandle = reinterpret_cast<uv_handle_t*>(new uv_udp_t());
-				err      = uv_udp_init_ex(
-          DepLibUV::GetLoop(), reinterpret_cast<uv_udp_t*>(uvHandle), UV_UDP_RECVMMSG);
+				// With reusePort or reuseAddr the socket must be created now (by
+				// passing the family) since the options must be set before binding it.
+				err = uv_udp_init_ex(
+				  DepLibUV::GetLoop(),
+				  reinterpret_cast<uv_udp_t*>(uvHandle),
+				  UV_UDP_RECVMMSG | (reusePort || reuseAddr ? family : AF_UNSPEC));
 				break;
 
 			case Transport::TCP:
@@ -414,6 +445,50 @@ namespace RTC
 			}
 		}
 
+		if (reusePort || reuseAddr)
+		{
+			MS_ASSERT(transport == Transport::UDP, "reusePort and reuseAddr are just supported for UDP");
+
+			// Sockets sharing the IP and port must all have SO_REUSEADDR (to bind
+			// those with just SO_REUSEADDR) or all SO_REUSEPORT (to join a group).
+			const char* option{ reusePort ? "SO_REUSEPORT" : "SO_REUSEADDR" };
+
+#ifdef SO_REUSEPORT
+			uv_os_fd_t fd;
+			const int on{ 1 };
+
+			err = uv_fileno(uvHandle, &fd);
+
+			// clang-format off
+			if (
+				err == 0 &&
+				(
+					setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) != 0 ||
+					(reusePort && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) != 0)
+				)
+			)
+			// clang-format on
+			{
+				err = uv_translate_sys_error(errno);
+			}
+#else
+			err = UV_ENOTSUP;
+#endif
+
+			if (err != 0)
+			{
+				uv_close(reinterpret_cast<uv_handle_t*>(uvHandle), static_cast<uv_close_cb>(onClose));
+
+				MS_THROW_ERROR(
+				  "setting %s failed [transport:%s, ip:'%s', port:%" PRIu16 "]: %s",
+				  option,
+				  transportStr.c_str(),
+				  ip.c_str(),
+				  port,
+				  uv_strerror(err));
+			}
+		}
+
 		switch (transport)
 		{
 			case Transport::UDP:
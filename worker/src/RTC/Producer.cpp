@@ -312,6 +312,19 @@ namespace RTC
 			}
 
 			this->keyFrameRequestManager = new RTC::KeyFrameRequestManager(this, keyFrameRequestDelay);
+
+			auto jsonKeyFrameCacheIt = data.find("keyFrameCache");
+
+			// clang-format off
+			if (
+				jsonKeyFrameCacheIt != data.end() &&
+				jsonKeyFrameCacheIt->is_boolean() &&
+				jsonKeyFrameCacheIt->get<bool>()
+			)
+			// clang-format on
+			{
+				this->keyFrameCache = new RTC::KeyFrameCache();
+			}
 		}
 
 		// NOTE: This may throw.
@@ -320,6 +333,8 @@ namespace RTC
 		  /*channelRequestHandler*/ this,
 		  /*payloadChannelRequestHandler*/ nullptr,
 		  /*payloadChannelNotificationHandler*/ this);
+
+		this->shared->statsStreamer->AddSource(this, this->id);
 	}
 
 	Producer::~Producer()
@@ -328,6 +343,8 @@ namespace RTC
 
 		this->shared->channelMessageRegistrator->UnregisterHandler(this->id);
 
+		this->shared->statsStreamer->RemoveSource(this);
+
 		// Delete all streams.
 		for (auto& kv : this->mapSsrcRtpStream)
 		{
@@ -345,6 +362,9 @@ namespace RTC
 
 		// Delete the KeyFrameRequestManager.
 		delete this->keyFrameRequestManager;
+
+		// Delete the KeyFrameCache.
+		delete this->keyFrameCache;
 	}
 
 	void Producer::FillJson(json& jsonObject) const
@@ -477,6 +497,20 @@ namespace RTC
 		}
 	}
 
+	void Producer::FillBinaryStats(Channel::BinaryBody::Writer& writer) const
+	{
+		MS_TRACE();
+
+		for (auto* rtpStream : this->rtpStreamByEncodingIdx)
+		{
+			if (!rtpStream)
+				continue;
+
+			rtpStream->FillBinaryStats(writer);
+			writer.EndRecord();
+		}
+	}
+
 	void Producer::HandleRequest(Channel::ChannelRequest* request)
 	{
 		MS_TRACE();
@@ -496,6 +530,17 @@ namespace RTC
 
 			case Channel::ChannelRequest::MethodId::PRODUCER_GET_STATS:
 			{
+				if (request->binary)
+				{
+					Channel::BinaryBody::Writer body(Channel::BinaryMessage::BodyType::RECORDS);
+
+					FillBinaryStats(body);
+
+					request->Accept(body);
+
+					break;
+				}
+
 				json data = json::array();
 
 				FillJsonStats(data);
@@ -524,6 +569,10 @@ namespace RTC
 
 				this->paused = true;
 
+				// Cached packets won't be valid once resumed.
+				if (this->keyFrameCache)
+					this->keyFrameCache->Clear();
+
 				MS_DEBUG_DEV("Producer paused [producerId:%s]", this->id.c_str());
 
 				this->listener->OnProducerPaused(this);
@@ -672,7 +721,7 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		packet->logger.producerId = this->id;
+		packet->logger.producerHandle = this->traceHandle.value;
 
 		// Reset current packet.
 		this->currentRtpPacket = nullptr;
@@ -1723,4 +1772,22 @@ namespace RTC
 
 		rtpStream->RequestKeyFrame();
 	}
+
+	inline void Producer::FillStatsStream(uint64_t nowMs, RTC::StatsStreamer* statsStreamer)
+	{
+		MS_TRACE();
+
+		for (auto* rtpStream : this->rtpStreamByEncodingIdx)
+		{
+			if (!rtpStream)
+				continue;
+
+			RTC::StatsStreamer::Values values{};
+
+			rtpStream->FillStatsValues(nowMs, values);
+
+			statsStreamer->AddStats(
+			  RTC::StatsStreamer::Type::INBOUND_RTP, rtpStream->GetSsrc(), values);
+		}
+	}
 } // namespace RTC
@@ -4,6 +4,7 @@
 #include "RTC/Router.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "Metrics.hpp"
 #include "Utils.hpp"
 #include "RTC/ActiveSpeakerObserver.hpp"
 #include "RTC/AudioLevelObserver.hpp"
@@ -171,6 +172,97 @@ namespace RTC
 		}
 	}
 
+	void Router::FillBinary(Channel::BinaryBody::Writer& writer) const
+	{
+		MS_TRACE();
+
+		using Key = Channel::BinaryBody::Key;
+
+		writer.WriteString(Key::ID, this->id);
+
+		writer.StartItems(Key::TRANSPORT_IDS, this->mapTransports.size());
+
+		for (const auto& kv : this->mapTransports)
+		{
+			writer.AppendString(kv.first);
+		}
+
+		writer.StartItems(Key::RTP_OBSERVER_IDS, this->mapRtpObservers.size());
+
+		for (const auto& kv : this->mapRtpObservers)
+		{
+			writer.AppendString(kv.first);
+		}
+
+		writer.StartItems(Key::MAP_PRODUCER_ID_CONSUMER_IDS, this->mapProducerConsumers.size());
+
+		for (const auto& kv : this->mapProducerConsumers)
+		{
+			auto* producer        = kv.first;
+			const auto& consumers = kv.second;
+
+			writer.AppendString(producer->id);
+			writer.AppendCount(consumers.size());
+
+			for (auto* consumer : consumers)
+			{
+				writer.AppendString(consumer->id);
+			}
+		}
+
+		writer.StartItems(Key::MAP_CONSUMER_ID_PRODUCER_ID, this->mapConsumerProducer.size());
+
+		for (const auto& kv : this->mapConsumerProducer)
+		{
+			writer.AppendString(kv.first->id);
+			writer.AppendString(kv.second->id);
+		}
+
+		writer.StartItems(Key::MAP_PRODUCER_ID_OBSERVER_IDS, this->mapProducerRtpObservers.size());
+
+		for (const auto& kv : this->mapProducerRtpObservers)
+		{
+			auto* producer           = kv.first;
+			const auto& rtpObservers = kv.second;
+
+			writer.AppendString(producer->id);
+			writer.AppendCount(rtpObservers.size());
+
+			for (auto* rtpObserver : rtpObservers)
+			{
+				writer.AppendString(rtpObserver->id);
+			}
+		}
+
+		writer.StartItems(
+		  Key::MAP_DATA_PRODUCER_ID_DATA_CONSUMER_IDS, this->mapDataProducerDataConsumers.size());
+
+		for (const auto& kv : this->mapDataProducerDataConsumers)
+		{
+			auto* dataProducer        = kv.first;
+			const auto& dataConsumers = kv.second;
+
+			writer.AppendString(dataProducer->id);
+			writer.AppendCount(dataConsumers.size());
+
+			for (auto* dataConsumer : dataConsumers)
+			{
+				writer.AppendString(dataConsumer->id);
+			}
+		}
+
+		writer.StartItems(
+		  Key::MAP_DATA_CONSUMER_ID_DATA_PRODUCER_ID, this->mapDataConsumerDataProducer.size());
+
+		for (const auto& kv : this->mapDataConsumerDataProducer)
+		{
+			writer.AppendString(kv.first->id);
+			writer.AppendString(kv.second->id);
+		}
+
+		writer.EndRecord();
+	}
+
 	void Router::HandleRequest(Channel::ChannelRequest* request)
 	{
 		MS_TRACE();
@@ -179,6 +271,17 @@ namespace RTC
 		{
 			case Channel::ChannelRequest::MethodId::ROUTER_DUMP:
 			{
+				if (request->binary)
+				{
+					Channel::BinaryBody::Writer body(Channel::BinaryMessage::BodyType::RECORD);
+
+					FillBinary(body);
+
+					request->Accept(body);
+
+					break;
+				}
+
 				json data = json::object();
 
 				FillJson(data);
@@ -706,25 +809,28 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		packet->logger.routerId = this->id;
+		packet->logger.routerHandle = this->traceHandle.value;
 
-		auto& consumers = this->mapProducerConsumers.at(producer);
+		Metrics::Increment(Metrics::Counter::RTP_PACKETS_ROUTED);
+
+		auto& consumers     = this->mapProducerConsumers.at(producer);
+		auto* keyFrameCache = producer->GetKeyFrameCache();
+
+		// Cloned ref-counted packet that RtpStreamSend will store for as long as
+		// needed avoiding multiple allocations unless absolutely necessary.
+		// Clone only happens if needed.
+		RTC::RtpPacket::SharedPtr sharedPacket;
+
+		// NOTE: Cache the packet before Consumers process its payload.
+		if (keyFrameCache)
+			keyFrameCache->Insert(packet, sharedPacket);
 
 		if (!consumers.empty())
 		{
-			// Cloned ref-counted packet that RtpStreamSend will store for as long as
-			// needed avoiding multiple allocations unless absolutely necessary.
-			// Clone only happens if needed.
-			std::shared_ptr<RTC::RtpPacket> sharedPacket;
-
+			// NOTE: Consumers do not modify the packet, they rewrite its header
+			// (including MID) while copying it into the egress buffer.
 			for (auto* consumer : consumers)
 			{
-				// Update MID RTP extension value.
-				const auto& mid = consumer->GetRtpParameters().mid;
-
-				if (!mid.empty())
-					packet->UpdateMid(mid);
-
 				consumer->SendRtpPacket(packet, sharedPacket);
 			}
 		}
@@ -857,7 +963,37 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		auto* producer = this->mapConsumerProducer.at(consumer);
+		auto* producer      = this->mapConsumerProducer.at(consumer);
+		auto* keyFrameCache = producer->GetKeyFrameCache();
+
+		// Start a new Consumer with the packets since the latest key frame instead
+		// of asking the sender for a new one.
+		if (keyFrameCache && consumer->NeedsKeyFrameToStart(mappedSsrc))
+		{
+			const auto* cachedPackets = keyFrameCache->Get(mappedSsrc);
+
+			if (cachedPackets)
+			{
+				MS_DEBUG_TAG(
+				  rtp,
+				  "starting Consumer with cached key frame [consumerId:%s, mappedSsrc:%" PRIu32
+				  ", packets:%zu]",
+				  consumer->id.c_str(),
+				  mappedSsrc,
+				  cachedPackets->size());
+
+				for (const auto& cachedPacket : *cachedPackets)
+				{
+					auto sharedPacket = cachedPacket;
+
+					consumer->SendRtpPacket(sharedPacket.get(), sharedPacket);
+				}
+
+				// Otherwise the Consumer did not take it, so ask the sender.
+				if (!consumer->NeedsKeyFrameToStart(mappedSsrc))
+					return;
+			}
+		}
 
 		producer->RequestKeyFrame(mappedSsrc);
 	}
@@ -931,6 +1067,10 @@ namespace RTC
 
 		auto& dataConsumers = this->mapDataProducerDataConsumers.at(dataProducer);
 
+		// The same payload is given to every DataConsumer (it is not copied in
+		// here). Those sending it over SCTP still get it copied into the buffers
+		// of their usrsctp association, since usrsctp_sendv() is the only way to
+		// give it a message.
 		for (auto* consumer : dataConsumers)
 		{
 			consumer->SendMessage(ppid, msg, len);
@@ -3,6 +3,11 @@
 
 #include "RTC/RtcLogger.hpp"
 #include "Logger.hpp"
+#include "Metrics.hpp"
+#include "Utils.hpp"
+#include <absl/container/flat_hash_set.h>
+#include <algorithm> // std::min(), std::remove_if()
+#include <cstring>   // std::memcpy()
 
 namespace RTC
 {
@@ -26,13 +31,32 @@ namespace RTC
 		};
 		// clang-format on
 
+		/* ObjectHandle instance methods. */
+
+		ObjectHandle::ObjectHandle(const std::string& id) : value(TraceRing::RegisterObject(id))
+		{
+		}
+
+		ObjectHandle::~ObjectHandle()
+		{
+			TraceRing::UnregisterObject(this->value);
+		}
+
+		/* RtpPacket instance methods. */
+
 		void RtpPacket::Sent()
 		{
 			MS_TRACE();
 
 			this->dropped = false;
 
+			Metrics::Increment(Metrics::Counter::RTP_PACKETS_SENT);
+
 			Log();
+
+			if (TraceRing::IsEnabled())
+				TraceRing::Write(*this);
+
 			Clear();
 		}
 
@@ -43,7 +67,13 @@ namespace RTC
 			this->dropped    = true;
 			this->dropReason = dropReason;
 
+			Metrics::IncrementRtpPacketsDropped(dropReason);
+
 			Log();
+
+			if (TraceRing::IsEnabled())
+				TraceRing::Write(*this);
+
 			Clear();
 		}
 
@@ -52,28 +82,43 @@ namespace RTC
 #ifdef MS_RTC_LOGGER_RTP
 			MS_TRACE();
 
+			static const std::string Empty;
+
+			auto getObjectId = [](uint32_t handle) -> const std::string&
+			{
+				const auto* id = TraceRing::GetObjectId(handle);
+
+				return id ? *id : Empty;
+			};
+
+			const auto& recvTransportId = getObjectId(this->recvTransportHandle);
+			const auto& sendTransportId = getObjectId(this->sendTransportHandle);
+			const auto& routerId        = getObjectId(this->routerHandle);
+			const auto& producerId      = getObjectId(this->producerHandle);
+			const auto& consumerId      = getObjectId(this->consumerHandle);
+
 			std::cout << "{";
 			std::cout << "\"timestamp\": " << this->timestamp;
 
-			if (!this->recvTransportId.empty())
+			if (!recvTransportId.empty())
 			{
-				std::cout << ", \"recvTransportId\": \"" << this->recvTransportId << "\"";
+				std::cout << ", \"recvTransportId\": \"" << recvTransportId << "\"";
 			}
-			if (!this->sendTransportId.empty())
+			if (!sendTransportId.empty())
 			{
-				std::cout << ", \"sendTransportId\": \"" << this->sendTransportId << "\"";
+				std::cout << ", \"sendTransportId\": \"" << sendTransportId << "\"";
 			}
-			if (!this->routerId.empty())
+			if (!routerId.empty())
 			{
-				std::cout << ", \"routerId\": \"" << this->routerId << "\"";
+				std::cout << ", \"routerId\": \"" << routerId << "\"";
 			}
-			if (!this->producerId.empty())
+			if (!producerId.empty())
 			{
-				std::cout << ", \"producerId\": \"" << this->producerId << "\"";
+				std::cout << ", \"producerId\": \"" << producerId << "\"";
 			}
-			if (!this->consumerId.empty())
+			if (!consumerId.empty())
 			{
-				std::cout << ", \"consumerId\": \"" << this->consumerId << "\"";
+				std::cout << ", \"consumerId\": \"" << consumerId << "\"";
 			}
 
 			std::cout << ", \"recvRtpTimestamp\": " << this->recvRtpTimestamp;
@@ -90,12 +135,230 @@ namespace RTC
 		{
 			MS_TRACE();
 
-			this->sendTransportId = {};
-			this->routerId        = {};
-			this->producerId      = {};
-			this->sendSeqNumber   = { 0 };
-			this->dropped         = { false };
-			this->dropReason      = { DropReason::NONE };
+			// Keep the fields of the receiving side since the packet may still be
+			// sent to other Consumers.
+			this->sendTransportHandle = { 0u };
+			this->consumerHandle      = { 0u };
+			this->sendRtpTimestamp    = { 0u };
+			this->sendSeqNumber       = { 0u };
+			this->dropped             = { false };
+			this->dropReason          = { DropReason::NONE };
+		}
+
+		/* TraceRing static variables. */
+
+		thread_local std::vector<TraceRing::Record> TraceRing::records;
+		thread_local size_t TraceRing::position{ 0u };
+		thread_local uint64_t TraceRing::numWritten{ 0u };
+		thread_local uint32_t TraceRing::nextObjectHandle{ 0u };
+		thread_local absl::flat_hash_map<uint32_t, std::string> TraceRing::mapHandleObjectId;
+		thread_local std::deque<std::pair<uint32_t, uint64_t>> TraceRing::unregisteredObjects;
+
+		/* TraceRing static methods. */
+
+		void TraceRing::SetCapacity(size_t capacity)
+		{
+			MS_TRACE();
+
+			MS_ASSERT(capacity <= MaxCapacity, "capacity too big");
+
+			TraceRing::position   = 0u;
+			TraceRing::numWritten = 0u;
+
+			// Release the memory if disabled.
+			std::vector<Record>(capacity).swap(TraceRing::records);
+
+			// No record refers to unregistered objects anymore.
+			for (const auto& handleAndNumWritten : TraceRing::unregisteredObjects)
+			{
+				TraceRing::mapHandleObjectId.erase(handleAndNumWritten.first);
+			}
+
+			TraceRing::unregisteredObjects.clear();
+		}
+
+		void TraceRing::Write(const RtpPacket& packet)
+		{
+			MS_TRACE();
+
+			auto& record = TraceRing::records[TraceRing::position];
+
+			record.timestamp           = packet.timestamp;
+			record.recvTransportHandle = packet.recvTransportHandle;
+			record.sendTransportHandle = packet.sendTransportHandle;
+			record.routerHandle        = packet.routerHandle;
+			record.producerHandle      = packet.producerHandle;
+			record.consumerHandle      = packet.consumerHandle;
+			record.recvSsrc            = packet.recvSsrc;
+			record.recvRtpTimestamp    = packet.recvRtpTimestamp;
+			record.sendRtpTimestamp    = packet.sendRtpTimestamp;
+			record.recvSeqNumber       = packet.recvSeqNumber;
+			record.sendSeqNumber       = packet.sendSeqNumber;
+			record.dropped             = packet.dropped ? 1u : 0u;
+			record.dropReason          = static_cast<uint8_t>(packet.dropReason);
+			record.reserved[0]         = 0u;
+			record.reserved[1]         = 0u;
+
+			if (++TraceRing::position == TraceRing::records.size())
+				TraceRing::position = 0u;
+
+			++TraceRing::numWritten;
+		}
+
+		void TraceRing::FillJson(json& jsonObject)
+		{
+			MS_TRACE();
+
+			// Base64 encoding is done in chunks since Utils::String::Base64Encode()
+			// has a limited output size.
+			static constexpr size_t ChunkRecords{ 1000u };
+
+			TraceRing::PruneUnregisteredObjects();
+
+			jsonObject["version"]    = static_cast<uint8_t>(Version);
+			jsonObject["recordSize"] = sizeof(Record);
+#ifdef MS_LITTLE_ENDIAN
+			jsonObject["byteOrder"] = "little";
+#else
+			jsonObject["byteOrder"] = "big";
+#endif
+			jsonObject["capacity"]   = TraceRing::records.size();
+			jsonObject["numWritten"] = TraceRing::numWritten;
+
+			// Add records (oldest first).
+			jsonObject["records"] = json::array();
+			auto jsonRecordsIt    = jsonObject.find("records");
+
+			const size_t numRecords =
+			  std::min(static_cast<uint64_t>(TraceRing::records.size()), TraceRing::numWritten);
+			size_t idx = numRecords < TraceRing::records.size() ? 0u : TraceRing::position;
+			std::vector<Record> chunk;
+
+			chunk.reserve(ChunkRecords);
+
+			for (size_t count{ 0u }; count < numRecords; ++count)
+			{
+				chunk.push_back(TraceRing::records[idx]);
+
+				if (++idx == TraceRing::records.size())
+					idx = 0u;
+
+				if (chunk.size() == ChunkRecords || count == numRecords - 1)
+				{
+					jsonRecordsIt->emplace_back(Utils::String::Base64Encode(
+					  reinterpret_cast<const uint8_t*>(chunk.data()), chunk.size() * sizeof(Record)));
+
+					chunk.clear();
+				}
+			}
+
+			// Add objects, including unregistered ones still referred by records.
+			jsonObject["objects"] = json::object();
+			auto jsonObjectsIt    = jsonObject.find("objects");
+
+			for (const auto& kv : TraceRing::mapHandleObjectId)
+			{
+				(*jsonObjectsIt)[std::to_string(kv.first)] = kv.second;
+			}
+
+			// Add dropReasons.
+			jsonObject["dropReasons"] = json::object();
+			auto jsonDropReasonsIt    = jsonObject.find("dropReasons");
+
+			for (const auto& kv : RtpPacket::dropReason2String)
+			{
+				(*jsonDropReasonsIt)[std::to_string(static_cast<uint8_t>(kv.first))] = kv.second;
+			}
+		}
+
+		uint32_t TraceRing::RegisterObject(const std::string& id)
+		{
+			MS_TRACE();
+
+			// Handle 0 means none.
+			if (++TraceRing::nextObjectHandle == 0u)
+				++TraceRing::nextObjectHandle;
+
+			TraceRing::mapHandleObjectId[TraceRing::nextObjectHandle] = id;
+
+			return TraceRing::nextObjectHandle;
+		}
+
+		void TraceRing::UnregisterObject(uint32_t handle)
+		{
+			MS_TRACE();
+
+			// Keep its id while records may still refer to it.
+			TraceRing::unregisteredObjects.emplace_back(handle, TraceRing::numWritten);
+
+			TraceRing::PruneUnregisteredObjects();
+		}
+
+		const std::string* TraceRing::GetObjectId(uint32_t handle)
+		{
+			MS_TRACE();
+
+			auto it = TraceRing::mapHandleObjectId.find(handle);
+
+			if (it == TraceRing::mapHandleObjectId.end())
+				return nullptr;
+
+			return std::addressof(it->second);
+		}
+
+		void TraceRing::PruneUnregisteredObjects()
+		{
+			MS_TRACE();
+
+			// Records written before an object was unregistered are all overwritten
+			// once the ring has been fully written since then (immediately if the
+			// ring is disabled).
+			while (!TraceRing::unregisteredObjects.empty())
+			{
+				const auto& handleAndNumWritten = TraceRing::unregisteredObjects.front();
+
+				if (TraceRing::numWritten - handleAndNumWritten.second < TraceRing::records.size())
+					break;
+
+				TraceRing::mapHandleObjectId.erase(handleAndNumWritten.first);
+				TraceRing::unregisteredObjects.pop_front();
+			}
+
+			// Objects may be unregistered faster than the ring wraps (i.e. no
+			// packets), so also drop those no record refers to. Records refer to
+			// up to 5 objects each, so at most half of the limit is kept here.
+			if (TraceRing::unregisteredObjects.size() > 10u * TraceRing::records.size())
+			{
+				absl::flat_hash_set<uint32_t> referredHandles;
+				const size_t numRecords =
+				  std::min(static_cast<uint64_t>(TraceRing::records.size()), TraceRing::numWritten);
+
+				for (size_t idx{ 0u }; idx < numRecords; ++idx)
+				{
+					const auto& record = TraceRing::records[idx];
+
+					referredHandles.insert(record.recvTransportHandle);
+					referredHandles.insert(record.sendTransportHandle);
+					referredHandles.insert(record.routerHandle);
+					referredHandles.insert(record.producerHandle);
+					referredHandles.insert(record.consumerHandle);
+				}
+
+				auto it = std::remove_if(
+				  TraceRing::unregisteredObjects.begin(),
+				  TraceRing::unregisteredObjects.end(),
+				  [&referredHandles](const std::pair<uint32_t, uint64_t>& handleAndNumWritten)
+				  {
+					  if (referredHandles.find(handleAndNumWritten.first) != referredHandles.end())
+						  return false;
+
+					  TraceRing::mapHandleObjectId.erase(handleAndNumWritten.first);
+
+					  return true;
+				  });
+
+				TraceRing::unregisteredObjects.erase(it, TraceRing::unregisteredObjects.end());
+			}
 		}
 	} // namespace RtcLogger
 } // namespace RTC
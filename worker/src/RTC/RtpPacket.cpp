@@ -4,6 +4,7 @@
 #include "RTC/RtpPacket.hpp"
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
+#include "RTC/RtpPacketPool.hpp"
 #include <cstring>  // std::memcpy(), std::memmove(), std::memset()
 #include <iterator> // std::ostream_iterator
 #include <sstream>  // std::ostringstream
@@ -121,6 +122,23 @@ namespace RTC
 		return new RtpPacket(header, headerExtension, payload, payloadLength, payloadPadding, len);
 	}
 
+	void* RtpPacket::operator new(size_t size)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(size == sizeof(RtpPacket), "unexpected RtpPacket size");
+
+		return RtpPacketPool::AllocatePacket();
+	}
+
+	void RtpPacket::operator delete(void* ptr)
+	{
+		MS_TRACE();
+
+		if (ptr)
+			RtpPacketPool::ReleasePacket(ptr);
+	}
+
 	/* Instance methods. */
 
 	RtpPacket::RtpPacket(
@@ -141,22 +159,28 @@ namespace RTC
 		// Parse RFC 5285 header extension.
 		ParseExtensions();
 
-// Avoid retrieving the time if RTC logger is disabled.
-#ifdef MS_RTC_LOGGER_RTP
-		// Initialize logger.
-		this->logger.timestamp        = DepLibUV::GetTimeMs();
-		this->logger.recvRtpTimestamp = this->GetTimestamp();
-		this->logger.recvSeqNumber    = this->GetSequenceNumber();
+// Avoid retrieving the time if RTC logger and trace ring are disabled.
+#ifndef MS_RTC_LOGGER_RTP
+		if (RtcLogger::TraceRing::IsEnabled())
 #endif
+		{
+			// Initialize logger.
+			this->logger.timestamp        = DepLibUV::GetTimeMs();
+			this->logger.recvSsrc         = this->GetSsrc();
+			this->logger.recvRtpTimestamp = this->GetTimestamp();
+			this->logger.recvSeqNumber    = this->GetSequenceNumber();
+		}
 	}
 
 	RtpPacket::~RtpPacket()
 	{
 		MS_TRACE();
 
+		ResetPayloadDescriptorHandler();
+
 		if (this->buffer)
 		{
-			delete[] this->buffer;
+			RtpPacketPool::ReleaseBuffer(this->buffer);
 		}
 	}
 
@@ -649,11 +673,77 @@ namespace RTC
 		SetPayloadPaddingFlag(false);
 	}
 
+	void RtpPacket::Write(uint8_t* buffer) const
+	{
+		MS_TRACE();
+
+		std::memcpy(buffer, GetData(), this->size);
+
+		if (!this->rewritePlan)
+			return;
+
+		auto* newHeader = reinterpret_cast<Header*>(buffer);
+
+		newHeader->sequenceNumber = uint16_t{ htons(this->rewritePlan->sequenceNumber) };
+		newHeader->timestamp      = uint32_t{ htonl(this->rewritePlan->timestamp) };
+		newHeader->ssrc           = uint32_t{ htonl(this->rewritePlan->ssrc) };
+
+		// Extensions are at the same offset in the copy.
+		uint8_t extenLen;
+		uint8_t* extenValue;
+
+		if (this->rewritePlan->midLen != 0u)
+		{
+			extenValue = GetExtension(this->midExtensionId, extenLen);
+
+			if (extenValue)
+			{
+				auto* newExtenValue = buffer + (extenValue - GetData());
+				const auto midLen   = this->rewritePlan->midLen;
+
+				std::memcpy(newExtenValue, this->rewritePlan->mid, midLen);
+
+				// Fill with 0's if new length is minor. As in UpdateMid(), assume that
+				// there are MidMaxLength available bytes.
+				if (midLen < extenLen)
+					std::memset(newExtenValue + midLen, 0, extenLen - midLen);
+
+				if (HasOneByteExtensions())
+				{
+					auto* newExtension = reinterpret_cast<OneByteExtension*>(newExtenValue - 1);
+
+					// In One-Byte extensions value length 0 means 1.
+					newExtension->len = midLen - 1;
+				}
+				else
+				{
+					auto* newExtension = reinterpret_cast<TwoBytesExtension*>(newExtenValue - 2);
+
+					newExtension->len = midLen;
+				}
+			}
+		}
+
+		if (this->rewritePlan->hasAbsSendTime)
+		{
+			extenValue = GetExtension(this->absSendTimeExtensionId, extenLen);
+
+			Utils::Byte::Set3Bytes(buffer + (extenValue - GetData()), 0, this->rewritePlan->absSendTime);
+		}
+
+		if (this->rewritePlan->hasTransportWideCc01)
+		{
+			extenValue = GetExtension(this->transportWideCc01ExtensionId, extenLen);
+
+			Utils::Byte::Set2Bytes(buffer + (extenValue - GetData()), 0, this->rewritePlan->wideSeqNumber);
+		}
+	}
+
 	RtpPacket* RtpPacket::Clone() const
 	{
 		MS_TRACE();
 
-		auto* buffer = new uint8_t[MtuSize + 100];
+		auto* buffer = RtpPacketPool::AllocateBuffer();
 		auto* ptr    = const_cast<uint8_t*>(buffer);
 
 		size_t numBytes{ 0 };
@@ -714,6 +804,43 @@ namespace RTC
 		auto* packet = new RtpPacket(
 		  newHeader, newHeaderExtension, newPayload, this->payloadLength, this->payloadPadding, this->size);
 
+		CloneState(packet);
+
+		// Store allocated buffer.
+		packet->buffer = buffer;
+
+		return packet;
+	}
+
+	RtpPacket* RtpPacket::CloneInto(void* storage, uint8_t* buffer) const
+	{
+		MS_TRACE();
+
+		// Applies the rewrite plan, if any. The layout of the copy is the same.
+		Write(buffer);
+
+		auto* newHeader = reinterpret_cast<Header*>(buffer);
+		HeaderExtension* newHeaderExtension{ nullptr };
+
+		if (this->headerExtension != nullptr)
+		{
+			newHeaderExtension = reinterpret_cast<HeaderExtension*>(
+			  buffer + (reinterpret_cast<uint8_t*>(this->headerExtension) - GetData()));
+		}
+
+		uint8_t* newPayload = buffer + (this->payload - GetData());
+
+		// NOTE: Bypass the pool, the storage is not owned by the packet.
+		auto* packet = ::new (storage) RtpPacket(
+		  newHeader, newHeaderExtension, newPayload, this->payloadLength, this->payloadPadding, this->size);
+
+		CloneState(packet);
+
+		return packet;
+	}
+
+	void RtpPacket::CloneState(RtpPacket* packet) const
+	{
 		// Keep already set extension ids.
 		packet->midExtensionId               = this->midExtensionId;
 		packet->ridExtensionId               = this->ridExtensionId;
@@ -724,12 +851,12 @@ namespace RTC
 		packet->frameMarkingExtensionId      = this->frameMarkingExtensionId;
 		packet->ssrcAudioLevelExtensionId    = this->ssrcAudioLevelExtensionId;
 		packet->videoOrientationExtensionId  = this->videoOrientationExtensionId;
-		// Assign the payload descriptor handler.
-		packet->payloadDescriptorHandler = this->payloadDescriptorHandler;
-		// Store allocated buffer.
-		packet->buffer = buffer;
-
-		return packet;
+		// Copy the payload descriptor handler.
+		if (this->payloadDescriptorHandler)
+		{
+			packet->payloadDescriptorHandler =
+			  this->payloadDescriptorHandler->CloneInto(packet->payloadDescriptorHandlerStorage);
+		}
 	}
 
 	// NOTE: The caller must ensure that the buffer/memmory of the packet has
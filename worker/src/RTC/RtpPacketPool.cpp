@@ -0,0 +1,183 @@
+#define MS_CLASS "RTC::RtpPacketPool"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/RtpPacketPool.hpp"
+#include "Logger.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <algorithm> // std::max()
+#include <cstddef>   // std::max_align_t
+
+namespace RTC
+{
+	/* Static. */
+
+	// Size of the buffer of a cloned packet.
+	static constexpr size_t BufferSize{ MtuSize + 100u };
+	static constexpr size_t PacketsPerSlab{ 256u };
+	static constexpr size_t BuffersPerSlab{ 64u };
+
+	thread_local static RtpPacketPool::BlockPool PacketPool(sizeof(RtpPacket), PacketsPerSlab);
+	thread_local static RtpPacketPool::BlockPool BufferPool(BufferSize, BuffersPerSlab);
+
+	/* Class methods. */
+
+	void* RtpPacketPool::AllocatePacket()
+	{
+		MS_TRACE();
+
+		return PacketPool.Allocate();
+	}
+
+	void RtpPacketPool::ReleasePacket(void* ptr)
+	{
+		MS_TRACE();
+
+		PacketPool.Release(ptr);
+	}
+
+	uint8_t* RtpPacketPool::AllocateBuffer()
+	{
+		MS_TRACE();
+
+		return static_cast<uint8_t*>(BufferPool.Allocate());
+	}
+
+	void RtpPacketPool::ReleaseBuffer(uint8_t* buffer)
+	{
+		MS_TRACE();
+
+		BufferPool.Release(buffer);
+	}
+
+	const RtpPacketPool::BlockPool& RtpPacketPool::GetPacketPool()
+	{
+		return PacketPool;
+	}
+
+	const RtpPacketPool::BlockPool& RtpPacketPool::GetBufferPool()
+	{
+		return BufferPool;
+	}
+
+	void RtpPacketPool::FillJson(json& jsonObject)
+	{
+		MS_TRACE();
+
+		// Add packets.
+		PacketPool.FillJson(jsonObject["packets"]);
+
+		// Add buffers.
+		BufferPool.FillJson(jsonObject["buffers"]);
+	}
+
+	void RtpPacketPool::FillBinary(Channel::BinaryBody::Writer& writer)
+	{
+		MS_TRACE();
+
+		writer.StartRecord(Channel::BinaryBody::Key::PACKETS);
+		PacketPool.FillBinary(writer);
+		writer.EndRecord();
+
+		writer.StartRecord(Channel::BinaryBody::Key::BUFFERS);
+		BufferPool.FillBinary(writer);
+		writer.EndRecord();
+	}
+
+	/* Instance methods. */
+
+	RtpPacketPool::BlockPool::BlockPool(size_t blockSize, size_t blocksPerSlab)
+	  : blockSize(blockSize), blocksPerSlab(blocksPerSlab)
+	{
+		MS_TRACE();
+
+		// Keep blocks aligned as malloc() does.
+		this->blockSize = (this->blockSize + alignof(std::max_align_t) - 1) &
+		                  ~(alignof(std::max_align_t) - 1);
+	}
+
+	RtpPacketPool::BlockPool::~BlockPool()
+	{
+		MS_TRACE();
+
+		// NOTE: If some block is still in use (a packet leaked or alive when the
+		// thread exits) don't free the slabs under its feet.
+		if (this->inUse != 0u)
+			return;
+
+		for (auto* slab : this->slabs)
+		{
+			delete[] slab;
+		}
+	}
+
+	void* RtpPacketPool::BlockPool::Allocate()
+	{
+		MS_TRACE();
+
+		if (this->freeBlocks.empty())
+			AddSlab();
+
+		auto* block = this->freeBlocks.back();
+
+		this->freeBlocks.pop_back();
+
+		this->inUse++;
+		this->highWater = std::max(this->highWater, this->inUse);
+
+		return block;
+	}
+
+	void RtpPacketPool::BlockPool::Release(void* block)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(this->inUse > 0u, "no block in use");
+
+		this->freeBlocks.push_back(block);
+
+		this->inUse--;
+	}
+
+	void RtpPacketPool::BlockPool::FillJson(json& jsonObject) const
+	{
+		MS_TRACE();
+
+		// Add blockSize.
+		jsonObject["blockSize"] = this->blockSize;
+
+		// Add capacity.
+		jsonObject["capacity"] = GetCapacity();
+
+		// Add inUse.
+		jsonObject["inUse"] = this->inUse;
+
+		// Add highWater.
+		jsonObject["highWater"] = this->highWater;
+	}
+
+	void RtpPacketPool::BlockPool::FillBinary(Channel::BinaryBody::Writer& writer) const
+	{
+		MS_TRACE();
+
+		writer.WriteUint(Channel::BinaryBody::Key::BLOCK_SIZE, this->blockSize);
+		writer.WriteUint(Channel::BinaryBody::Key::CAPACITY, GetCapacity());
+		writer.WriteUint(Channel::BinaryBody::Key::IN_USE, this->inUse);
+		writer.WriteUint(Channel::BinaryBody::Key::HIGH_WATER, this->highWater);
+	}
+
+	void RtpPacketPool::BlockPool::AddSlab()
+	{
+		MS_TRACE();
+
+		auto* slab = new uint8_t[this->blockSize * this->blocksPerSlab];
+
+		this->slabs.push_back(slab);
+		this->freeBlocks.reserve(GetCapacity());
+
+		// Push blocks in reverse order so they are handed out in memory order.
+		for (size_t idx{ this->blocksPerSlab }; idx > 0u; --idx)
+		{
+			this->freeBlocks.push_back(slab + ((idx - 1) * this->blockSize));
+		}
+	}
+} // namespace RTC
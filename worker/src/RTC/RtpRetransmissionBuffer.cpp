@@ -7,6 +7,10 @@
 
 namespace RTC
 {
+	/* Static. */
+
+	static constexpr size_t InitialSlots{ 64u };
+
 	/* Instance methods. */
 
 	RtpRetransmissionBuffer::RtpRetransmissionBuffer(
@@ -43,12 +47,12 @@ namespace RTC
 
 		const auto idx = static_cast<uint16_t>(seq - oldestItem->sequenceNumber);
 
-		if (idx > static_cast<uint16_t>(this->buffer.size() - 1))
+		if (idx > static_cast<uint16_t>(this->size - 1))
 		{
 			return nullptr;
 		}
 
-		return this->buffer.at(idx);
+		return At(idx);
 	}
 
 	/**
@@ -59,7 +63,7 @@ namespace RTC
 	 * ordered by increasing seq but also that their timestamp are incremental).
 	 */
 	void RtpRetransmissionBuffer::Insert(
-	  RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	  RTC::RtpPacket* packet, RTC::RtpPacket::SharedPtr& sharedPacket)
 	{
 		MS_TRACE();
 
@@ -70,13 +74,11 @@ namespace RTC
 		MS_DEBUG_DEV("packet [seq:%" PRIu16 ", timestamp:%" PRIu32 "]", seq, timestamp);
 
 		// Buffer is empty, so just insert new item.
-		if (this->buffer.empty())
+		if (this->size == 0u)
 		{
 			MS_DEBUG_DEV("buffer empty [seq:%" PRIu16 ", timestamp:%" PRIu32 "]", seq, timestamp);
 
-			auto* item = new Item();
-
-			this->buffer.push_back(FillItem(item, packet, sharedPacket));
+			FillItem(PushBack(), packet, sharedPacket);
 
 			return;
 		}
@@ -100,9 +102,7 @@ namespace RTC
 
 			Clear();
 
-			auto* item = new Item();
-
-			this->buffer.push_back(FillItem(item, packet, sharedPacket));
+			FillItem(PushBack(), packet, sharedPacket);
 
 			return;
 		}
@@ -122,7 +122,7 @@ namespace RTC
 		if (ClearTooOldByTimestamp(newestTimestamp))
 		{
 			// Buffer content has been modified so we must check it again.
-			if (this->buffer.empty())
+			if (this->size == 0u)
 			{
 				MS_WARN_TAG(
 				  rtp,
@@ -130,9 +130,7 @@ namespace RTC
 				  seq,
 				  timestamp);
 
-				auto* item = new Item();
-
-				this->buffer.push_back(FillItem(item, packet, sharedPacket));
+				FillItem(PushBack(), packet, sharedPacket);
 
 				return;
 			}
@@ -171,14 +169,14 @@ namespace RTC
 
 			// We may have to remove oldest items not to exceed the maximum size of
 			// the buffer.
-			if (this->buffer.size() + numBlankSlots + 1 > this->maxItems)
+			if (this->size + numBlankSlots + 1 > this->maxItems)
 			{
 				const auto numItemsToRemove =
-				  static_cast<uint16_t>(this->buffer.size() + numBlankSlots + 1 - this->maxItems);
+				  static_cast<uint16_t>(this->size + numBlankSlots + 1 - this->maxItems);
 
 				// If num of items to be removed exceed buffer size minus one (needed to
 				// allocate current packet) then we must clear the entire buffer.
-				if (numItemsToRemove > this->buffer.size() - 1)
+				if (numItemsToRemove > this->size - 1)
 				{
 					MS_WARN_TAG(
 					  rtp,
@@ -198,7 +196,7 @@ namespace RTC
 					  "calling RemoveOldest(%" PRIu16 ") [bufferSize:%zu, numBlankSlots:%" PRIu16
 					  ", maxItems:%" PRIu16 "]",
 					  numItemsToRemove,
-					  this->buffer.size(),
+					  this->size,
 					  numBlankSlots,
 					  this->maxItems);
 
@@ -209,13 +207,11 @@ namespace RTC
 			// Push blank slots to the back.
 			for (uint16_t i{ 0u }; i < numBlankSlots; ++i)
 			{
-				this->buffer.push_back(nullptr);
+				PushBack();
 			}
 
 			// Push the packet, which becomes the newest one in the buffer.
-			auto* item = new Item();
-
-			this->buffer.push_back(FillItem(item, packet, sharedPacket));
+			FillItem(PushBack(), packet, sharedPacket);
 		}
 		// Packet arrived out order and its seq is less than seq of the oldest
 		// stored packet, so will become the oldest one in the buffer.
@@ -259,7 +255,7 @@ namespace RTC
 
 			// If adding this packet (and needed blank slots) to the front makes the
 			// buffer exceed its max size, discard this packet.
-			if (this->buffer.size() + numBlankSlots + 1 > this->maxItems)
+			if (this->size + numBlankSlots + 1 > this->maxItems)
 			{
 				MS_WARN_TAG(
 				  rtp,
@@ -275,13 +271,11 @@ namespace RTC
 			// Push blank slots to the front.
 			for (uint16_t i{ 0u }; i < numBlankSlots; ++i)
 			{
-				this->buffer.push_front(nullptr);
+				PushFront();
 			}
 
 			// Insert the packet, which becomes the oldest one in the buffer.
-			auto* item = new Item();
-
-			this->buffer.push_front(FillItem(item, packet, sharedPacket));
+			FillItem(PushFront(), packet, sharedPacket);
 		}
 		// Otherwise packet must be inserted between oldest and newest stored items
 		// so there is already an allocated slot for it.
@@ -295,7 +289,7 @@ namespace RTC
 
 			// Let's check if an item already exist in same position. If so, assume
 			// it's duplicated.
-			auto* item = Get(seq);
+			const auto* item = Get(seq);
 
 			if (item)
 			{
@@ -314,7 +308,7 @@ namespace RTC
 			// the immediate older packet (if any).
 			for (auto idx2 = static_cast<int32_t>(idx - 1); idx2 >= 0; --idx2)
 			{
-				const auto* olderItem = this->buffer.at(idx2);
+				const auto* olderItem = At(idx2);
 
 				// Blank slot, continue.
 				if (!olderItem)
@@ -343,9 +337,9 @@ namespace RTC
 
 			// Validate that packet timestamp is equal or less than the timestamp of
 			// the immediate newer packet (if any).
-			for (auto idx2 = static_cast<size_t>(idx + 1); idx2 < this->buffer.size(); ++idx2)
+			for (auto idx2 = static_cast<size_t>(idx + 1); idx2 < this->size; ++idx2)
 			{
-				const auto* newerItem = this->buffer.at(idx2);
+				const auto* newerItem = At(idx2);
 
 				// Blank slot, continue.
 				if (!newerItem)
@@ -373,15 +367,13 @@ namespace RTC
 			}
 
 			// Store the packet.
-			item = new Item();
-
-			this->buffer[idx] = FillItem(item, packet, sharedPacket);
+			FillItem(Slot(idx), packet, sharedPacket);
 		}
 
 		MS_ASSERT(
-		  this->buffer.size() <= this->maxItems,
+		  this->size <= this->maxItems,
 		  "buffer contains %zu items (more than %" PRIu16 " max items)",
-		  this->buffer.size(),
+		  this->size,
 		  this->maxItems);
 	}
 
@@ -389,20 +381,14 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		for (auto* item : this->buffer)
+		for (size_t idx{ 0u }; idx < this->size; ++idx)
 		{
-			if (!item)
-			{
-				continue;
-			}
-
 			// Reset the stored item (decrease RTP packet shared pointer counter).
-			item->Reset();
-
-			delete item;
+			Slot(idx).Reset();
 		}
 
-		this->buffer.clear();
+		this->head = 0u;
+		this->size = 0u;
 	}
 
 	void RtpRetransmissionBuffer::Dump() const
@@ -410,8 +396,12 @@ namespace RTC
 		MS_TRACE();
 
 		MS_DUMP("<RtpRetransmissionBuffer>");
-		MS_DUMP("  buffer [size:%zu, maxSize:%" PRIu16 "]", this->buffer.size(), this->maxItems);
-		if (this->buffer.size() > 0)
+		MS_DUMP(
+		  "  buffer [size:%zu, maxSize:%" PRIu16 ", slots:%zu]",
+		  this->size,
+		  this->maxItems,
+		  this->slots.size());
+		if (this->size > 0)
 		{
 			const auto* oldestItem = GetOldest();
 			const auto* newestItem = GetNewest();
@@ -436,53 +426,46 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		if (this->buffer.empty())
+		if (this->size == 0u)
 		{
 			return nullptr;
 		}
 
-		return this->buffer.front();
+		return std::addressof(Slot(0u));
 	}
 
 	RtpRetransmissionBuffer::Item* RtpRetransmissionBuffer::GetNewest() const
 	{
 		MS_TRACE();
 
-		if (this->buffer.empty())
+		if (this->size == 0u)
 		{
 			return nullptr;
 		}
 
-		return this->buffer.back();
+		return std::addressof(Slot(this->size - 1));
 	}
 
 	void RtpRetransmissionBuffer::RemoveOldest()
 	{
 		MS_TRACE();
 
-		if (this->buffer.empty())
+		if (this->size == 0u)
 		{
 			return;
 		}
 
-		auto* item = this->buffer.front();
-
 		// Reset the stored item (decrease RTP packet shared pointer counter).
-		item->Reset();
-
-		delete item;
-
-		this->buffer.pop_front();
+		PopFront();
 
 		MS_DEBUG_DEV("removed 1 item from the front");
 
-		// Remove all nullptr elements from the beginning of the buffer.
-		// NOTE: Calling front on an empty container is undefined.
+		// Remove all blank slots from the beginning of the buffer.
 		size_t numItemsRemoved{ 0u };
 
-		while (!this->buffer.empty() && this->buffer.front() == nullptr)
+		while (this->size != 0u && !At(0u))
 		{
-			this->buffer.pop_front();
+			PopFront();
 
 			++numItemsRemoved;
 		}
@@ -498,15 +481,15 @@ namespace RTC
 		MS_TRACE();
 
 		MS_ASSERT(
-		  numItems <= this->buffer.size(),
+		  numItems <= this->size,
 		  "attempting to remove more items than current buffer size [numItems:%" PRIu16
 		  ", bufferSize:%zu]",
 		  numItems,
-		  this->buffer.size());
+		  this->size);
 
-		const auto intendedBufferSize = this->buffer.size() - numItems;
+		const auto intendedBufferSize = this->size - numItems;
 
-		while (this->buffer.size() > intendedBufferSize)
+		while (this->size > intendedBufferSize)
 		{
 			RemoveOldest();
 		}
@@ -554,20 +537,20 @@ namespace RTC
 		return static_cast<uint32_t>(diffTs * 1000 / this->clockRate) > this->maxRetransmissionDelayMs;
 	}
 
-	RtpRetransmissionBuffer::Item* RtpRetransmissionBuffer::FillItem(
-	  RtpRetransmissionBuffer::Item* item,
+	void RtpRetransmissionBuffer::FillItem(
+	  RtpRetransmissionBuffer::Item& item,
 	  RTC::RtpPacket* packet,
-	  std::shared_ptr<RTC::RtpPacket>& sharedPacket) const
+	  RTC::RtpPacket::SharedPtr& sharedPacket) const
 	{
 		MS_TRACE();
 
 		// Store original packet into the item. Only clone once and only if
 		// necessary.
 		//
-		// NOTE: This must be done BEFORE assigning item->packet = sharedPacket,
-		// otherwise the value being copied in item->packet will remain nullptr.
-		// This is because we are copying an **empty** shared_ptr into another
-		// shared_ptr (item->packet), so future value assigned via reset() in the
+		// NOTE: This must be done BEFORE assigning item.packet = sharedPacket,
+		// otherwise the value being copied in item.packet will remain nullptr.
+		// This is because we are copying an **empty** SharedPtr into another
+		// SharedPtr (item.packet), so future value assigned via reset() in the
 		// former doesn't update the value in the copy.
 		if (!sharedPacket.get())
 		{
@@ -575,12 +558,67 @@ namespace RTC
 		}
 
 		// Store original packet and some extra info into the item.
-		item->packet         = sharedPacket;
-		item->ssrc           = packet->GetSsrc();
-		item->sequenceNumber = packet->GetSequenceNumber();
-		item->timestamp      = packet->GetTimestamp();
+		item.packet         = sharedPacket;
+		item.ssrc           = packet->GetSsrc();
+		item.sequenceNumber = packet->GetSequenceNumber();
+		item.timestamp      = packet->GetTimestamp();
+	}
+
+	inline RtpRetransmissionBuffer::Item& RtpRetransmissionBuffer::PushBack()
+	{
+		MS_TRACE();
+
+		if (this->size == this->slots.size())
+		{
+			Grow();
+		}
+
+		++this->size;
+
+		return Slot(this->size - 1);
+	}
+
+	inline RtpRetransmissionBuffer::Item& RtpRetransmissionBuffer::PushFront()
+	{
+		MS_TRACE();
+
+		if (this->size == this->slots.size())
+		{
+			Grow();
+		}
+
+		this->head = (this->head + this->slots.size() - 1) & (this->slots.size() - 1);
+
+		++this->size;
+
+		return Slot(0u);
+	}
+
+	inline void RtpRetransmissionBuffer::PopFront()
+	{
+		MS_TRACE();
+
+		Slot(0u).Reset();
+
+		this->head = (this->head + 1) & (this->slots.size() - 1);
+
+		--this->size;
+	}
+
+	void RtpRetransmissionBuffer::Grow()
+	{
+		MS_TRACE();
+
+		// Size must be a power of two so indexes can be masked.
+		std::vector<Item> slots(this->slots.empty() ? InitialSlots : this->slots.size() * 2);
+
+		for (size_t idx{ 0u }; idx < this->size; ++idx)
+		{
+			slots[idx] = std::move(Slot(idx));
+		}
 
-		return item;
+		this->slots = std::move(slots);
+		this->head  = 0u;
 	}
 
 	void RtpRetransmissionBuffer::Item::Reset()
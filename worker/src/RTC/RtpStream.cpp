@@ -80,6 +80,63 @@ namespace RTC
 			jsonObject["roundTripTime"] = this->rtt;
 	}
 
+	void RtpStream::FillBinaryStats(Channel::BinaryBody::Writer& writer)
+	{
+		MS_TRACE();
+
+		using Key = Channel::BinaryBody::Key;
+
+		const uint64_t nowMs = DepLibUV::GetTimeMs();
+
+		writer.WriteUint(Key::TIMESTAMP, nowMs);
+		writer.WriteUint(Key::SSRC, this->params.ssrc);
+		writer.WriteString(Key::KIND, RtpCodecMimeType::type2String[this->params.mimeType.type]);
+		writer.WriteString(Key::MIME_TYPE, this->params.mimeType.ToString());
+		writer.WriteInt(Key::PACKETS_LOST, this->packetsLost);
+		writer.WriteUint(Key::FRACTION_LOST, this->fractionLost);
+		writer.WriteUint(Key::PACKETS_DISCARDED, this->packetsDiscarded);
+		writer.WriteUint(Key::PACKETS_RETRANSMITTED, this->packetsRetransmitted);
+		writer.WriteUint(Key::PACKETS_REPAIRED, this->packetsRepaired);
+		writer.WriteUint(Key::NACK_COUNT, this->nackCount);
+		writer.WriteUint(Key::NACK_PACKET_COUNT, this->nackPacketCount);
+		writer.WriteUint(Key::PLI_COUNT, this->pliCount);
+		writer.WriteUint(Key::FIR_COUNT, this->firCount);
+		writer.WriteUint(Key::SCORE, this->score);
+
+		if (!this->params.rid.empty())
+			writer.WriteString(Key::RID, this->params.rid);
+
+		if (this->params.rtxSsrc)
+			writer.WriteUint(Key::RTX_SSRC, this->params.rtxSsrc);
+
+		if (this->rtxStream)
+			writer.WriteUint(Key::RTX_PACKETS_DISCARDED, this->rtxStream->GetPacketsDiscarded());
+
+		if (this->hasRtt)
+			writer.WriteDouble(Key::ROUND_TRIP_TIME, this->rtt);
+	}
+
+	void RtpStream::FillStatsValues(uint64_t /*nowMs*/, RTC::StatsStreamer::Values& values)
+	{
+		MS_TRACE();
+
+		using Value = RTC::StatsStreamer::RtpStreamValue;
+
+		values[Value::PACKETS_LOST]          = this->packetsLost;
+		values[Value::FRACTION_LOST]         = this->fractionLost;
+		values[Value::PACKETS_DISCARDED]     = this->packetsDiscarded;
+		values[Value::PACKETS_RETRANSMITTED] = this->packetsRetransmitted;
+		values[Value::PACKETS_REPAIRED]      = this->packetsRepaired;
+		values[Value::NACK_COUNT]            = this->nackCount;
+		values[Value::NACK_PACKET_COUNT]     = this->nackPacketCount;
+		values[Value::PLI_COUNT]             = this->pliCount;
+		values[Value::FIR_COUNT]             = this->firCount;
+		values[Value::SCORE]                 = this->score;
+
+		if (this->hasRtt)
+			values[Value::ROUND_TRIP_TIME] = static_cast<int64_t>(this->rtt * 1000);
+	}
+
 	void RtpStream::SetRtx(uint8_t payloadType, uint32_t ssrc)
 	{
 		MS_TRACE();
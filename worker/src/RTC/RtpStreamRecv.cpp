@@ -254,6 +254,51 @@ namespace RTC
 		}
 	}
 
+	void RtpStreamRecv::FillBinaryStats(Channel::BinaryBody::Writer& writer)
+	{
+		MS_TRACE();
+
+		using Key = Channel::BinaryBody::Key;
+
+		const uint64_t nowMs = DepLibUV::GetTimeMs();
+
+		RTC::RtpStream::FillBinaryStats(writer);
+
+		writer.WriteString(Key::TYPE, "inbound-rtp");
+		writer.WriteUint(Key::JITTER, this->jitter);
+		writer.WriteUint(Key::PACKET_COUNT, this->transmissionCounter.GetPacketCount());
+		writer.WriteUint(Key::BYTE_COUNT, this->transmissionCounter.GetBytes());
+		writer.WriteUint(Key::BITRATE, this->transmissionCounter.GetBitrate(nowMs));
+
+		if (GetSpatialLayers() > 1 || GetTemporalLayers() > 1)
+		{
+			writer.StartItems(Key::BITRATE_BY_LAYER, GetSpatialLayers() * GetTemporalLayers());
+
+			for (uint8_t sIdx = 0; sIdx < GetSpatialLayers(); ++sIdx)
+			{
+				for (uint8_t tIdx = 0; tIdx < GetTemporalLayers(); ++tIdx)
+				{
+					writer.AppendString(std::to_string(sIdx) + "." + std::to_string(tIdx));
+					writer.AppendUint(GetBitrate(nowMs, sIdx, tIdx));
+				}
+			}
+		}
+	}
+
+	void RtpStreamRecv::FillStatsValues(uint64_t nowMs, RTC::StatsStreamer::Values& values)
+	{
+		MS_TRACE();
+
+		using Value = RTC::StatsStreamer::RtpStreamValue;
+
+		RTC::RtpStream::FillStatsValues(nowMs, values);
+
+		values[Value::PACKET_COUNT] = this->transmissionCounter.GetPacketCount();
+		values[Value::BYTE_COUNT]   = this->transmissionCounter.GetBytes();
+		values[Value::BITRATE]      = this->transmissionCounter.GetBitrate(nowMs);
+		values[Value::JITTER]       = this->jitter;
+	}
+
 	bool RtpStreamRecv::ReceivePacket(RTC::RtpPacket* packet)
 	{
 		MS_TRACE();
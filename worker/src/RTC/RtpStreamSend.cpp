@@ -86,6 +86,35 @@ namespace RTC
 		jsonObject["bitrate"]     = this->transmissionCounter.GetBitrate(nowMs);
 	}
 
+	void RtpStreamSend::FillBinaryStats(Channel::BinaryBody::Writer& writer)
+	{
+		MS_TRACE();
+
+		using Key = Channel::BinaryBody::Key;
+
+		const uint64_t nowMs = DepLibUV::GetTimeMs();
+
+		RTC::RtpStream::FillBinaryStats(writer);
+
+		writer.WriteString(Key::TYPE, "outbound-rtp");
+		writer.WriteUint(Key::PACKET_COUNT, this->transmissionCounter.GetPacketCount());
+		writer.WriteUint(Key::BYTE_COUNT, this->transmissionCounter.GetBytes());
+		writer.WriteUint(Key::BITRATE, this->transmissionCounter.GetBitrate(nowMs));
+	}
+
+	void RtpStreamSend::FillStatsValues(uint64_t nowMs, RTC::StatsStreamer::Values& values)
+	{
+		MS_TRACE();
+
+		using Value = RTC::StatsStreamer::RtpStreamValue;
+
+		RTC::RtpStream::FillStatsValues(nowMs, values);
+
+		values[Value::PACKET_COUNT] = this->transmissionCounter.GetPacketCount();
+		values[Value::BYTE_COUNT]   = this->transmissionCounter.GetBytes();
+		values[Value::BITRATE]      = this->transmissionCounter.GetBitrate(nowMs);
+	}
+
 	void RtpStreamSend::SetRtx(uint8_t payloadType, uint32_t ssrc)
 	{
 		MS_TRACE();
@@ -95,7 +124,7 @@ namespace RTC
 		this->rtxSeq = Utils::Crypto::GetRandomUInt(0u, 0xFFFF);
 	}
 
-	bool RtpStreamSend::ReceivePacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	bool RtpStreamSend::ReceivePacket(RTC::RtpPacket* packet, RTC::RtpPacket::SharedPtr& sharedPacket)
 	{
 		MS_TRACE();
 
@@ -352,7 +381,7 @@ namespace RTC
 		MS_ABORT("invalid method call");
 	}
 
-	void RtpStreamSend::StorePacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	void RtpStreamSend::StorePacket(RTC::RtpPacket* packet, RTC::RtpPacket::SharedPtr& sharedPacket)
 	{
 		MS_TRACE();
 
@@ -418,7 +447,7 @@ namespace RTC
 			if (requested)
 			{
 				auto* item = this->retransmissionBuffer->Get(currentSeq);
-				std::shared_ptr<RTC::RtpPacket> packet{ nullptr };
+				RTC::RtpPacket::SharedPtr packet{ nullptr };
 
 				// Calculate the elapsed time between the max timestamp seen and the
 				// requested packet's timestamp (in ms).
@@ -141,6 +141,7 @@ namespace RTC
 		if (!this->socket)
 		{
 			usrsctp_deregister_address(reinterpret_cast<void*>(this->id));
+			DepUsrSCTP::ReleaseSctpAssociationId(this->id);
 
 			MS_THROW_ERROR("usrsctp_socket() failed: %s", std::strerror(errno));
 		}
@@ -153,6 +154,7 @@ namespace RTC
 		if (ret < 0)
 		{
 			usrsctp_deregister_address(reinterpret_cast<void*>(this->id));
+			DepUsrSCTP::ReleaseSctpAssociationId(this->id);
 
 			MS_THROW_ERROR("usrsctp_set_non_blocking() failed: %s", std::strerror(errno));
 		}
@@ -171,6 +173,7 @@ namespace RTC
 		if (ret < 0)
 		{
 			usrsctp_deregister_address(reinterpret_cast<void*>(this->id));
+			DepUsrSCTP::ReleaseSctpAssociationId(this->id);
 
 			MS_THROW_ERROR("usrsctp_setsockopt(SO_LINGER) failed: %s", std::strerror(errno));
 		}
@@ -186,6 +189,7 @@ namespace RTC
 		if (ret < 0)
 		{
 			usrsctp_deregister_address(reinterpret_cast<void*>(this->id));
+			DepUsrSCTP::ReleaseSctpAssociationId(this->id);
 
 			MS_THROW_ERROR("usrsctp_setsockopt(SCTP_ENABLE_STREAM_RESET) failed: %s", std::strerror(errno));
 		}
@@ -198,6 +202,7 @@ namespace RTC
 		if (ret < 0)
 		{
 			usrsctp_deregister_address(reinterpret_cast<void*>(this->id));
+			DepUsrSCTP::ReleaseSctpAssociationId(this->id);
 
 			MS_THROW_ERROR("usrsctp_setsockopt(SCTP_NODELAY) failed: %s", std::strerror(errno));
 		}
@@ -217,6 +222,7 @@ namespace RTC
 			if (ret < 0)
 			{
 				usrsctp_deregister_address(reinterpret_cast<void*>(this->id));
+				DepUsrSCTP::ReleaseSctpAssociationId(this->id);
 
 				MS_THROW_ERROR("usrsctp_setsockopt(SCTP_EVENT) failed: %s", std::strerror(errno));
 			}
@@ -234,6 +240,7 @@ namespace RTC
 		if (ret < 0)
 		{
 			usrsctp_deregister_address(reinterpret_cast<void*>(this->id));
+			DepUsrSCTP::ReleaseSctpAssociationId(this->id);
 
 			MS_THROW_ERROR("usrsctp_setsockopt(SCTP_INITMSG) failed: %s", std::strerror(errno));
 		}
@@ -254,6 +261,7 @@ namespace RTC
 		if (ret < 0)
 		{
 			usrsctp_deregister_address(reinterpret_cast<void*>(this->id));
+			DepUsrSCTP::ReleaseSctpAssociationId(this->id);
 
 			MS_THROW_ERROR("usrsctp_bind() failed: %s", std::strerror(errno));
 		}
@@ -263,6 +271,7 @@ namespace RTC
 		if (usrsctp_setsockopt(this->socket, SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(int)) < 0)
 		{
 			usrsctp_deregister_address(reinterpret_cast<void*>(this->id));
+			DepUsrSCTP::ReleaseSctpAssociationId(this->id);
 
 			MS_THROW_ERROR("usrsctp_setsockopt(SO_SNDBUF) failed: %s", std::strerror(errno));
 		}
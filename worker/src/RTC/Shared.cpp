@@ -9,9 +9,10 @@ namespace RTC
 	Shared::Shared(
 	  ChannelMessageRegistrator* channelMessageRegistrator,
 	  Channel::ChannelNotifier* channelNotifier,
-	  PayloadChannel::PayloadChannelNotifier* payloadChannelNotifier)
+	  PayloadChannel::PayloadChannelNotifier* payloadChannelNotifier,
+	  RTC::StatsStreamer* statsStreamer)
 	  : channelMessageRegistrator(channelMessageRegistrator), channelNotifier(channelNotifier),
-	    payloadChannelNotifier(payloadChannelNotifier)
+	    payloadChannelNotifier(payloadChannelNotifier), statsStreamer(statsStreamer)
 	{
 		MS_TRACE();
 	}
@@ -20,6 +21,7 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		delete this->statsStreamer;
 		delete this->channelMessageRegistrator;
 		delete this->channelNotifier;
 		delete this->payloadChannelNotifier;
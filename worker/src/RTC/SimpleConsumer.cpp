@@ -98,6 +98,22 @@ namespace RTC
 		}
 	}
 
+	void SimpleConsumer::FillBinaryStats(Channel::BinaryBody::Writer& writer) const
+	{
+		MS_TRACE();
+
+		// Add stats of our send stream.
+		this->rtpStream->FillBinaryStats(writer);
+		writer.EndRecord();
+
+		// Add stats of our recv stream.
+		if (this->producerRtpStream)
+		{
+			this->producerRtpStream->FillBinaryStats(writer);
+			writer.EndRecord();
+		}
+	}
+
 	void SimpleConsumer::FillJsonScore(json& jsonObject) const
 	{
 		MS_TRACE();
@@ -261,11 +277,12 @@ namespace RTC
 		return desiredBitrate;
 	}
 
-	void SimpleConsumer::SendRtpPacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	void SimpleConsumer::SendRtpPacket(
+	  RTC::RtpPacket* packet, RTC::RtpPacket::SharedPtr& sharedPacket)
 	{
 		MS_TRACE();
 
-		packet->logger.consumerId = this->id;
+		packet->logger.consumerHandle = this->traceHandle.value;
 
 		if (!IsActive())
 		{
@@ -334,12 +351,15 @@ namespace RTC
 		this->rtpSeqManager.Input(packet->GetSequenceNumber(), seq);
 
 		// Save original packet fields.
-		auto origSsrc = packet->GetSsrc();
-		auto origSeq  = packet->GetSequenceNumber();
+		auto origSeq = packet->GetSequenceNumber();
 
-		// Rewrite packet.
-		packet->SetSsrc(this->rtpParameters.encodings[0].ssrc);
-		packet->SetSequenceNumber(seq);
+		// Rewrite packet. The packet is not modified, the rewrite plan is applied
+		// when copying it into the egress buffer.
+		this->rewritePlan.ssrc           = this->rtpParameters.encodings[0].ssrc;
+		this->rewritePlan.sequenceNumber = seq;
+		this->rewritePlan.timestamp      = packet->GetTimestamp();
+
+		packet->SetRewritePlan(std::addressof(this->rewritePlan));
 
 		packet->logger.sendRtpTimestamp = packet->GetTimestamp();
 		packet->logger.sendSeqNumber    = seq;
@@ -377,9 +397,15 @@ namespace RTC
 			  origSeq);
 		}
 
-		// Restore packet fields.
-		packet->SetSsrc(origSsrc);
-		packet->SetSequenceNumber(origSeq);
+		// Detach the rewrite plan.
+		packet->SetRewritePlan(nullptr);
+	}
+
+	bool SimpleConsumer::NeedsKeyFrameToStart(uint32_t /*mappedSsrc*/) const
+	{
+		MS_TRACE();
+
+		return this->syncRequired && this->keyFrameSupported && this->rtpStream->GetMaxPacketMs() == 0u;
 	}
 
 	bool SimpleConsumer::GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t nowMs)
@@ -189,6 +189,24 @@ namespace RTC
 		}
 	}
 
+	void SimulcastConsumer::FillBinaryStats(Channel::BinaryBody::Writer& writer) const
+	{
+		MS_TRACE();
+
+		// Add stats of our send stream.
+		this->rtpStream->FillBinaryStats(writer);
+		writer.EndRecord();
+
+		// Add stats of our recv stream.
+		auto* producerCurrentRtpStream = GetProducerCurrentRtpStream();
+
+		if (producerCurrentRtpStream)
+		{
+			producerCurrentRtpStream->FillBinaryStats(writer);
+			writer.EndRecord();
+		}
+	}
+
 	void SimulcastConsumer::FillJsonScore(json& jsonObject) const
 	{
 		MS_TRACE();
@@ -660,11 +678,11 @@ namespace RTC
 	}
 
 	void SimulcastConsumer::SendRtpPacket(
-	  RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	  RTC::RtpPacket* packet, RTC::RtpPacket::SharedPtr& sharedPacket)
 	{
 		MS_TRACE();
 
-		packet->logger.consumerId = this->id;
+		packet->logger.consumerHandle = this->traceHandle.value;
 
 		if (!IsActive())
 		{
@@ -945,10 +963,13 @@ namespace RTC
 		auto origSeq       = packet->GetSequenceNumber();
 		auto origTimestamp = packet->GetTimestamp();
 
-		// Rewrite packet.
-		packet->SetSsrc(this->rtpParameters.encodings[0].ssrc);
-		packet->SetSequenceNumber(seq);
-		packet->SetTimestamp(timestamp);
+		// Rewrite packet. The packet is not modified, the rewrite plan is applied
+		// when copying it into the egress buffer.
+		this->rewritePlan.ssrc           = this->rtpParameters.encodings[0].ssrc;
+		this->rewritePlan.sequenceNumber = seq;
+		this->rewritePlan.timestamp      = timestamp;
+
+		packet->SetRewritePlan(std::addressof(this->rewritePlan));
 
 		packet->logger.sendRtpTimestamp = timestamp;
 		packet->logger.sendSeqNumber    = seq;
@@ -995,15 +1016,25 @@ namespace RTC
 			packet->logger.Dropped(RtcLogger::RtpPacket::DropReason::SEND_RTP_STREAM_DISCARDED);
 		}
 
-		// Restore packet fields.
-		packet->SetSsrc(origSsrc);
-		packet->SetSequenceNumber(origSeq);
-		packet->SetTimestamp(origTimestamp);
+		// Detach the rewrite plan.
+		packet->SetRewritePlan(nullptr);
 
 		// Restore the original payload if needed.
 		packet->RestorePayload();
 	}
 
+	bool SimulcastConsumer::NeedsKeyFrameToStart(uint32_t mappedSsrc) const
+	{
+		MS_TRACE();
+
+		if (this->rtpStream->GetMaxPacketMs() != 0u || this->targetTemporalLayer == -1)
+			return false;
+
+		auto it = this->mapMappedSsrcSpatialLayer.find(mappedSsrc);
+
+		return it != this->mapMappedSsrcSpatialLayer.end() && it->second == this->targetSpatialLayer;
+	}
+
 	bool SimulcastConsumer::GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t nowMs)
 	{
 		MS_TRACE();
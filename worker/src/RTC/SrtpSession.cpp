@@ -5,6 +5,7 @@
 #include "DepLibSRTP.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "Metrics.hpp"
 #include <cstring> // std::memset(), std::memcpy()
 
 namespace RTC
@@ -155,6 +156,8 @@ namespace RTC
 		{
 			MS_WARN_TAG(srtp, "cannot encrypt RTP packet, size too big (%i bytes)", *len);
 
+			Metrics::Increment(Metrics::Counter::SRTP_PROTECT_RTP_FAILURES);
+
 			return false;
 		}
 
@@ -166,6 +169,8 @@ namespace RTC
 		{
 			MS_WARN_TAG(srtp, "srtp_protect() failed: %s", DepLibSRTP::GetErrorString(err));
 
+			Metrics::Increment(Metrics::Counter::SRTP_PROTECT_RTP_FAILURES);
+
 			return false;
 		}
 
@@ -175,6 +180,34 @@ namespace RTC
 		return true;
 	}
 
+	bool SrtpSession::EncryptRtp(uint8_t* data, int* len, size_t size)
+	{
+		MS_TRACE();
+
+		// Ensure that the resulting SRTP packet fits into the given buffer.
+		if (static_cast<size_t>(*len) + SRTP_MAX_TRAILER_LEN > size)
+		{
+			MS_WARN_TAG(srtp, "cannot encrypt RTP packet, size too big (%i bytes)", *len);
+
+			Metrics::Increment(Metrics::Counter::SRTP_PROTECT_RTP_FAILURES);
+
+			return false;
+		}
+
+		const srtp_err_status_t err = srtp_protect(this->session, static_cast<void*>(data), len);
+
+		if (DepLibSRTP::IsError(err))
+		{
+			MS_WARN_TAG(srtp, "srtp_protect() failed: %s", DepLibSRTP::GetErrorString(err));
+
+			Metrics::Increment(Metrics::Counter::SRTP_PROTECT_RTP_FAILURES);
+
+			return false;
+		}
+
+		return true;
+	}
+
 	bool SrtpSession::DecryptSrtp(uint8_t* data, int* len)
 	{
 		MS_TRACE();
@@ -185,6 +218,8 @@ namespace RTC
 		{
 			MS_DEBUG_TAG(srtp, "srtp_unprotect() failed: %s", DepLibSRTP::GetErrorString(err));
 
+			Metrics::Increment(Metrics::Counter::SRTP_UNPROTECT_RTP_FAILURES);
+
 			return false;
 		}
 
@@ -200,6 +235,8 @@ namespace RTC
 		{
 			MS_WARN_TAG(srtp, "cannot encrypt RTCP packet, size too big (%i bytes)", *len);
 
+			Metrics::Increment(Metrics::Counter::SRTP_PROTECT_RTCP_FAILURES);
+
 			return false;
 		}
 
@@ -212,6 +249,8 @@ namespace RTC
 		{
 			MS_WARN_TAG(srtp, "srtp_protect_rtcp() failed: %s", DepLibSRTP::GetErrorString(err));
 
+			Metrics::Increment(Metrics::Counter::SRTP_PROTECT_RTCP_FAILURES);
+
 			return false;
 		}
 
@@ -231,6 +270,8 @@ namespace RTC
 		{
 			MS_DEBUG_TAG(srtp, "srtp_unprotect_rtcp() failed: %s", DepLibSRTP::GetErrorString(err));
 
+			Metrics::Increment(Metrics::Counter::SRTP_UNPROTECT_RTCP_FAILURES);
+
 			return false;
 		}
 
@@ -0,0 +1,272 @@
+#define MS_CLASS "RTC::StatsStreamer"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "RTC/StatsStreamer.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+
+namespace RTC
+{
+	/* Static. */
+
+	inline static const char* typeToString(StatsStreamer::Type type)
+	{
+		switch (type)
+		{
+			case StatsStreamer::Type::TRANSPORT:
+				return "transport";
+			case StatsStreamer::Type::INBOUND_RTP:
+				return "inbound-rtp";
+			case StatsStreamer::Type::OUTBOUND_RTP:
+				return "outbound-rtp";
+		}
+
+		return "";
+	}
+
+	inline static void writeVarint(std::vector<uint8_t>& buffer, uint64_t value)
+	{
+		while (value >= 0x80u)
+		{
+			buffer.push_back(static_cast<uint8_t>(value) | 0x80u);
+			value >>= 7;
+		}
+
+		buffer.push_back(static_cast<uint8_t>(value));
+	}
+
+	inline static void writeZigZagVarint(std::vector<uint8_t>& buffer, int64_t value)
+	{
+		writeVarint(
+		  buffer, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+	}
+
+	/* Instance methods. */
+
+	StatsStreamer::StatsStreamer(PayloadChannel::PayloadChannelNotifier* payloadChannelNotifier)
+	  : payloadChannelNotifier(payloadChannelNotifier)
+	{
+		MS_TRACE();
+
+		this->payload.push_back(static_cast<uint8_t>(Version));
+	}
+
+	StatsStreamer::~StatsStreamer()
+	{
+		MS_TRACE();
+
+		delete this->periodicTimer;
+	}
+
+	void StatsStreamer::Subscribe(uint64_t intervalMs)
+	{
+		MS_TRACE();
+
+		if (intervalMs < MinIntervalMs)
+			MS_THROW_TYPE_ERROR("interval must be at least %" PRIu64 " ms", MinIntervalMs);
+
+		// Announce every entry again and send all its values.
+		ResetEntries();
+
+		if (!this->periodicTimer)
+			this->periodicTimer = new Timer(this);
+
+		this->periodicTimer->Start(intervalMs, intervalMs);
+	}
+
+	void StatsStreamer::Unsubscribe()
+	{
+		MS_TRACE();
+
+		delete this->periodicTimer;
+		this->periodicTimer = nullptr;
+
+		ResetEntries();
+	}
+
+	void StatsStreamer::AddSource(Source* source, const std::string& id)
+	{
+		MS_TRACE();
+
+		this->mapSourceEntry[source].id = id;
+	}
+
+	void StatsStreamer::RemoveSource(Source* source)
+	{
+		MS_TRACE();
+
+		auto it = this->mapSourceEntry.find(source);
+
+		if (it == this->mapSourceEntry.end())
+			return;
+
+		// Report its entries as gone in the next notification.
+		for (const auto& entry : it->second.entries)
+		{
+			this->removedEntryIds.push_back(entry.entryId);
+		}
+
+		this->mapSourceEntry.erase(it);
+	}
+
+	void StatsStreamer::AddStats(Type type, uint32_t ssrc, const Values& values)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(this->currentSourceEntry, "no source being filled");
+
+		auto& entries = this->currentSourceEntry->entries;
+		Entry* entry{ nullptr };
+
+		for (auto& existingEntry : entries)
+		{
+			if (existingEntry.type == type && existingEntry.ssrc == ssrc)
+			{
+				entry = std::addressof(existingEntry);
+
+				break;
+			}
+		}
+
+		// New entry, so its previous values are 0.
+		if (!entry)
+		{
+			entries.push_back(Entry{ this->nextEntryId++, type, ssrc, false, Values{} });
+
+			entry = std::addressof(entries.back());
+
+			json jsonEntry = json::object();
+
+			jsonEntry["entryId"] = entry->entryId;
+			jsonEntry["id"]      = this->currentSourceEntry->id;
+			jsonEntry["type"]    = typeToString(type);
+
+			if (type != Type::TRANSPORT)
+				jsonEntry["ssrc"] = ssrc;
+
+			this->addedEntries.push_back(jsonEntry);
+		}
+
+		entry->present = true;
+
+		uint64_t mask{ 0u };
+
+		for (size_t idx{ 0u }; idx < MaxValues; ++idx)
+		{
+			if (values[idx] != entry->values[idx])
+				mask |= uint64_t{ 1u } << idx;
+		}
+
+		if (mask == 0u)
+			return;
+
+		writeVarint(this->payload, entry->entryId);
+		writeVarint(this->payload, mask);
+
+		for (size_t idx{ 0u }; idx < MaxValues; ++idx)
+		{
+			if ((mask & (uint64_t{ 1u } << idx)) == 0u)
+				continue;
+
+			writeZigZagVarint(this->payload, values[idx] - entry->values[idx]);
+
+			entry->values[idx] = values[idx];
+		}
+	}
+
+	void StatsStreamer::SendStats()
+	{
+		MS_TRACE();
+
+		this->nowMs = DepLibUV::GetTimeMs();
+
+		for (auto& kv : this->mapSourceEntry)
+		{
+			auto* source      = kv.first;
+			auto& sourceEntry = kv.second;
+			auto& entries     = sourceEntry.entries;
+
+			this->currentSourceEntry = std::addressof(sourceEntry);
+
+			source->FillStatsStream(this->nowMs, this);
+
+			// Entries whose stream is gone.
+			for (auto it = entries.begin(); it != entries.end();)
+			{
+				if (!it->present)
+				{
+					this->removedEntryIds.push_back(it->entryId);
+
+					it = entries.erase(it);
+				}
+				else
+				{
+					it->present = false;
+
+					++it;
+				}
+			}
+
+			if (this->payload.size() >= MaxPayloadSize)
+				Emit();
+		}
+
+		this->currentSourceEntry = nullptr;
+
+		Emit();
+	}
+
+	void StatsStreamer::ResetEntries()
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->mapSourceEntry)
+		{
+			auto& sourceEntry = kv.second;
+
+			sourceEntry.entries.clear();
+		}
+
+		this->payload.resize(1u);
+		this->addedEntries    = json::array();
+		this->removedEntryIds = json::array();
+	}
+
+	void StatsStreamer::Emit()
+	{
+		MS_TRACE();
+
+		// Nothing changed.
+		// clang-format off
+		if (
+			this->payload.size() == 1u &&
+			this->addedEntries.empty() &&
+			this->removedEntryIds.empty()
+		)
+		// clang-format on
+		{
+			return;
+		}
+
+		json data = json::object();
+
+		data["timestamp"] = this->nowMs;
+		data["added"]     = std::move(this->addedEntries);
+		data["removed"]   = std::move(this->removedEntryIds);
+
+		this->payloadChannelNotifier->Emit(
+		  Logger::pid, "stats", data, this->payload.data(), this->payload.size());
+
+		this->payload.resize(1u);
+		this->addedEntries    = json::array();
+		this->removedEntryIds = json::array();
+	}
+
+	inline void StatsStreamer::OnTimer(Timer* /*timer*/)
+	{
+		MS_TRACE();
+
+		SendStats();
+	}
+} // namespace RTC
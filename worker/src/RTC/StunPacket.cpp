@@ -420,7 +420,7 @@ namespace RTC
 	}
 
 	StunPacket::Authentication StunPacket::CheckAuthentication(
-	  const std::string& localUsername, const std::string& localPassword)
+	  const std::string& localUsername, const Utils::Crypto::HmacSha1Key& localPassword)
 	{
 		MS_TRACE();
 
@@ -508,7 +508,7 @@ namespace RTC
 		return response;
 	}
 
-	void StunPacket::Authenticate(const std::string& password)
+	void StunPacket::Authenticate(const Utils::Crypto::HmacSha1Key& password)
 	{
 		// Just for Request, Indication and SuccessResponse messages.
 		if (this->klass == Class::ERROR_RESPONSE)
@@ -518,7 +518,7 @@ namespace RTC
 			return;
 		}
 
-		this->password = password;
+		this->password = std::addressof(password);
 	}
 
 	void StunPacket::Serialize(uint8_t* buffer)
@@ -533,7 +533,7 @@ namespace RTC
 		   this->klass == Class::SUCCESS_RESPONSE);
 		const bool addErrorCode = ((this->errorCode != 0u) && this->klass == Class::ERROR_RESPONSE);
 		const bool addMessageIntegrity =
-		  (this->klass != Class::ERROR_RESPONSE && !this->password.empty());
+		  (this->klass != Class::ERROR_RESPONSE && this->password && !this->password->IsEmpty());
 		const bool addFingerprint{ true }; // Do always.
 
 		// Update data pointer.
@@ -767,7 +767,7 @@ namespace RTC
 
 			// Calculate the HMAC-SHA1 of the packet according to MESSAGE-INTEGRITY rules.
 			const uint8_t* computedMessageIntegrity =
-			  Utils::Crypto::GetHmacSha1(this->password, buffer, pos);
+			  Utils::Crypto::GetHmacSha1(*this->password, buffer, pos);
 
 			Utils::Byte::Set2Bytes(buffer, pos, static_cast<uint16_t>(Attribute::MESSAGE_INTEGRITY));
 			Utils::Byte::Set2Bytes(buffer, pos + 2, 20);
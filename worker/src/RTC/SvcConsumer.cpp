@@ -168,6 +168,22 @@ namespace RTC
 		}
 	}
 
+	void SvcConsumer::FillBinaryStats(Channel::BinaryBody::Writer& writer) const
+	{
+		MS_TRACE();
+
+		// Add stats of our send stream.
+		this->rtpStream->FillBinaryStats(writer);
+		writer.EndRecord();
+
+		// Add stats of our recv stream.
+		if (this->producerRtpStream)
+		{
+			this->producerRtpStream->FillBinaryStats(writer);
+			writer.EndRecord();
+		}
+	}
+
 	void SvcConsumer::FillJsonScore(json& jsonObject) const
 	{
 		MS_TRACE();
@@ -589,11 +605,11 @@ namespace RTC
 		return desiredBitrate;
 	}
 
-	void SvcConsumer::SendRtpPacket(RTC::RtpPacket* packet, std::shared_ptr<RTC::RtpPacket>& sharedPacket)
+	void SvcConsumer::SendRtpPacket(RTC::RtpPacket* packet, RTC::RtpPacket::SharedPtr& sharedPacket)
 	{
 		MS_TRACE();
 
-		packet->logger.consumerId = this->id;
+		packet->logger.consumerHandle = this->traceHandle.value;
 
 		if (!IsActive())
 		{
@@ -685,9 +701,13 @@ namespace RTC
 		auto origSsrc = packet->GetSsrc();
 		auto origSeq  = packet->GetSequenceNumber();
 
-		// Rewrite packet.
-		packet->SetSsrc(this->rtpParameters.encodings[0].ssrc);
-		packet->SetSequenceNumber(seq);
+		// Rewrite packet. The packet is not modified, the rewrite plan is applied
+		// when copying it into the egress buffer.
+		this->rewritePlan.ssrc           = this->rtpParameters.encodings[0].ssrc;
+		this->rewritePlan.sequenceNumber = seq;
+		this->rewritePlan.timestamp      = packet->GetTimestamp();
+
+		packet->SetRewritePlan(std::addressof(this->rewritePlan));
 
 		packet->logger.sendRtpTimestamp = packet->GetTimestamp();
 		packet->logger.sendSeqNumber    = seq;
@@ -731,9 +751,8 @@ namespace RTC
 			  origSeq);
 		}
 
-		// Restore packet fields.
-		packet->SetSsrc(origSsrc);
-		packet->SetSequenceNumber(origSeq);
+		// Detach the rewrite plan and restore packet fields.
+		packet->SetRewritePlan(nullptr);
 		packet->SetMarker(origMarker);
 
 		// Restore the original payload if needed.
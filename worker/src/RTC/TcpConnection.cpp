@@ -3,6 +3,7 @@
 
 #include "RTC/TcpConnection.hpp"
 #include "Logger.hpp"
+#include "Settings.hpp"
 #include "Utils.hpp"
 #include <cstring> // std::memmove(), std::memcpy()
 
@@ -19,6 +20,9 @@ namespace RTC
 	  : ::TcpConnectionHandler::TcpConnectionHandler(bufferSize), listener(listener)
 	{
 		MS_TRACE();
+
+		if (Settings::configuration.tcpSendBatching)
+			SetWriteBatching(true);
 	}
 
 	TcpConnection::~TcpConnection()
@@ -4,6 +4,7 @@
 #include "RTC/Transport.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "Settings.hpp"
 #include "Utils.hpp"
 #include "RTC/BweType.hpp"
 #include "RTC/PipeConsumer.hpp"
@@ -176,6 +177,8 @@ namespace RTC
 
 		// Create the RTCP timer.
 		this->rtcpTimer = new Timer(this);
+
+		this->shared->statsStreamer->AddSource(this, this->id);
 	}
 
 	Transport::~Transport()
@@ -185,8 +188,14 @@ namespace RTC
 		// Set the destroying flag.
 		this->destroying = true;
 
+		this->shared->statsStreamer->RemoveSource(this);
+
 		// The destructor must delete and clear everything silently.
 
+		// Delete the egress pacer before the Consumers its queues refer to.
+		delete this->egressPacer;
+		this->egressPacer = nullptr;
+
 		// Delete all Producers.
 		for (auto& kv : this->mapProducers)
 		{
@@ -256,6 +265,10 @@ namespace RTC
 		}
 		this->mapProducers.clear();
 
+		// Delete the egress pacer before the Consumers its queues refer to.
+		delete this->egressPacer;
+		this->egressPacer = nullptr;
+
 		// Delete all Consumers.
 		for (auto& kv : this->mapConsumers)
 		{
@@ -583,6 +596,71 @@ namespace RTC
 		}
 	}
 
+	void Transport::FillBinaryStats(Channel::BinaryBody::Writer& writer)
+	{
+		MS_TRACE();
+
+		using Key = Channel::BinaryBody::Key;
+
+		auto nowMs = DepLibUV::GetTimeMs();
+
+		writer.WriteString(Key::TRANSPORT_ID, this->id);
+		writer.WriteUint(Key::TIMESTAMP, nowMs);
+
+		if (this->sctpAssociation)
+		{
+			switch (this->sctpAssociation->GetState())
+			{
+				case RTC::SctpAssociation::SctpState::NEW:
+					writer.WriteString(Key::SCTP_STATE, "new");
+					break;
+				case RTC::SctpAssociation::SctpState::CONNECTING:
+					writer.WriteString(Key::SCTP_STATE, "connecting");
+					break;
+				case RTC::SctpAssociation::SctpState::CONNECTED:
+					writer.WriteString(Key::SCTP_STATE, "connected");
+					break;
+				case RTC::SctpAssociation::SctpState::FAILED:
+					writer.WriteString(Key::SCTP_STATE, "failed");
+					break;
+				case RTC::SctpAssociation::SctpState::CLOSED:
+					writer.WriteString(Key::SCTP_STATE, "closed");
+					break;
+			}
+		}
+
+		writer.WriteUint(Key::BYTES_RECEIVED, this->recvTransmission.GetBytes());
+		writer.WriteUint(Key::RECV_BITRATE, this->recvTransmission.GetRate(nowMs));
+		writer.WriteUint(Key::BYTES_SENT, this->sendTransmission.GetBytes());
+		writer.WriteUint(Key::SEND_BITRATE, this->sendTransmission.GetRate(nowMs));
+		writer.WriteUint(Key::RTP_BYTES_RECEIVED, this->recvRtpTransmission.GetBytes());
+		writer.WriteUint(Key::RTP_RECV_BITRATE, this->recvRtpTransmission.GetBitrate(nowMs));
+		writer.WriteUint(Key::RTP_BYTES_SENT, this->sendRtpTransmission.GetBytes());
+		writer.WriteUint(Key::RTP_SEND_BITRATE, this->sendRtpTransmission.GetBitrate(nowMs));
+		writer.WriteUint(Key::RTX_BYTES_RECEIVED, this->recvRtxTransmission.GetBytes());
+		writer.WriteUint(Key::RTX_RECV_BITRATE, this->recvRtxTransmission.GetBitrate(nowMs));
+		writer.WriteUint(Key::RTX_BYTES_SENT, this->sendRtxTransmission.GetBytes());
+		writer.WriteUint(Key::RTX_SEND_BITRATE, this->sendRtxTransmission.GetBitrate(nowMs));
+		writer.WriteUint(Key::PROBATION_BYTES_SENT, this->sendProbationTransmission.GetBytes());
+		writer.WriteUint(
+		  Key::PROBATION_SEND_BITRATE, this->sendProbationTransmission.GetBitrate(nowMs));
+
+		if (this->tccClient)
+			writer.WriteUint(Key::AVAILABLE_OUTGOING_BITRATE, this->tccClient->GetAvailableBitrate());
+
+		if (this->tccServer && this->tccServer->GetAvailableBitrate() != 0u)
+			writer.WriteUint(Key::AVAILABLE_INCOMING_BITRATE, this->tccServer->GetAvailableBitrate());
+
+		if (this->maxIncomingBitrate != 0u)
+			writer.WriteUint(Key::MAX_INCOMING_BITRATE, this->maxIncomingBitrate);
+
+		if (this->tccServer)
+			writer.WriteDouble(Key::RTP_PACKET_LOSS_RECEIVED, this->tccServer->GetPacketLoss());
+
+		if (this->tccClient)
+			writer.WriteDouble(Key::RTP_PACKET_LOSS_SENT, this->tccClient->GetPacketLoss());
+	}
+
 	void Transport::HandleRequest(Channel::ChannelRequest* request)
 	{
 		MS_TRACE();
@@ -602,6 +680,17 @@ namespace RTC
 
 			case Channel::ChannelRequest::MethodId::TRANSPORT_GET_STATS:
 			{
+				if (request->binary)
+				{
+					Channel::BinaryBody::Writer body(Channel::BinaryMessage::BodyType::RECORDS);
+
+					FillBinaryStats(body);
+
+					request->Accept(body);
+
+					break;
+				}
+
 				json data = json::array();
 
 				FillJsonStats(data);
@@ -1106,6 +1195,13 @@ namespace RTC
 						{
 							this->tccClient->TransportConnected();
 						}
+
+						if (Settings::configuration.egressPacing)
+						{
+							this->egressPacer = new RTC::EgressPacer(this);
+
+							this->egressPacer->SetBitrate(this->tccClient->GetAvailableBitrate());
+						}
 					}
 				}
 
@@ -1486,6 +1582,12 @@ namespace RTC
 
 				MS_DEBUG_DEV("Consumer closed [consumerId:%s]", consumer->id.c_str());
 
+				// Drop its packets waiting in the egress pacer.
+				if (this->egressPacer)
+				{
+					this->egressPacer->RemoveConsumer(consumer);
+				}
+
 				// Delete it.
 				delete consumer;
 
@@ -1692,7 +1794,16 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		packet->logger.recvTransportId = this->id;
+		HandleRtpPacket(packet);
+
+		delete packet;
+	}
+
+	void Transport::HandleRtpPacket(RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		packet->logger.recvTransportHandle = this->traceHandle.value;
 
 		// Apply the Transport RTP header extension ids so the RTP listener can use them.
 		packet->SetMidExtensionId(this->recvRtpHeaderExtensionIds.mid);
@@ -1725,8 +1836,6 @@ namespace RTC
 			// Tell the child class to remove this SSRC.
 			RecvStreamClosed(packet->GetSsrc());
 
-			delete packet;
-
 			return;
 		}
 
@@ -1753,8 +1862,6 @@ namespace RTC
 				break;
 			default:;
 		}
-
-		delete packet;
 	}
 
 	void Transport::ReceiveRtcpPacket(RTC::RTCP::Packet* packet)
@@ -2667,7 +2774,41 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		packet->logger.sendTransportId = this->id;
+		if (this->egressPacer)
+		{
+			auto priority = consumer->GetKind() == RTC::Media::Kind::AUDIO
+			                  ? RTC::EgressPacer::Priority::AUDIO
+			                  : RTC::EgressPacer::Priority::VIDEO;
+
+			if (this->egressPacer->Enqueue(consumer, packet, priority))
+				return;
+		}
+
+		SendConsumerRtpPacket(consumer, packet);
+	}
+
+	inline void Transport::OnConsumerRetransmitRtpPacket(RTC::Consumer* consumer, RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		// clang-format off
+		if (
+			this->egressPacer &&
+			this->egressPacer->Enqueue(consumer, packet, RTC::EgressPacer::Priority::RETRANSMISSION)
+		)
+		// clang-format on
+		{
+			return;
+		}
+
+		RetransmitConsumerRtpPacket(consumer, packet);
+	}
+
+	void Transport::SendConsumerRtpPacket(RTC::Consumer* consumer, RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		packet->logger.sendTransportHandle = this->traceHandle.value;
 		packet->logger.Sent();
 
 		// Update abs-send-time if present.
@@ -2712,7 +2853,7 @@ namespace RTC
 			sentInfo.sendingAtMs = DepLibUV::GetTimeMs();
 
 			auto* cb = new onSendCallback(
-			  [tccClientWeakPtr, &packetInfo, senderBweWeakPtr, &sentInfo](bool sent)
+			  [tccClientWeakPtr, packetInfo, senderBweWeakPtr, sentInfo](bool sent) mutable
 			  {
 				  if (sent)
 				  {
@@ -2736,7 +2877,7 @@ namespace RTC
 			SendRtpPacket(consumer, packet, cb);
 #else
 			const auto* cb = new onSendCallback(
-			  [tccClientWeakPtr, &packetInfo](bool sent)
+			  [tccClientWeakPtr, packetInfo](bool sent) mutable
 			  {
 				  if (sent)
 				  {
@@ -2760,7 +2901,7 @@ namespace RTC
 		this->sendRtpTransmission.Update(packet);
 	}
 
-	inline void Transport::OnConsumerRetransmitRtpPacket(RTC::Consumer* consumer, RTC::RtpPacket* packet)
+	void Transport::RetransmitConsumerRtpPacket(RTC::Consumer* consumer, RTC::RtpPacket* packet)
 	{
 		MS_TRACE();
 
@@ -2801,7 +2942,7 @@ namespace RTC
 			sentInfo.sendingAtMs = DepLibUV::GetTimeMs();
 
 			auto* cb = new onSendCallback(
-			  [tccClientWeakPtr, &packetInfo, senderBweWeakPtr, &sentInfo](bool sent)
+			  [tccClientWeakPtr, packetInfo, senderBweWeakPtr, sentInfo](bool sent) mutable
 			  {
 				  if (sent)
 				  {
@@ -2825,7 +2966,7 @@ namespace RTC
 			SendRtpPacket(consumer, packet, cb);
 #else
 			const auto* cb = new onSendCallback(
-			  [tccClientWeakPtr, &packetInfo](bool sent)
+			  [tccClientWeakPtr, packetInfo](bool sent) mutable
 			  {
 				  if (sent)
 				  {
@@ -2911,6 +3052,12 @@ namespace RTC
 		// Notify the listener.
 		this->listener->OnTransportConsumerProducerClosed(this, consumer);
 
+		// Drop its packets waiting in the egress pacer.
+		if (this->egressPacer)
+		{
+			this->egressPacer->RemoveConsumer(consumer);
+		}
+
 		// Delete it.
 		delete consumer;
 
@@ -2957,6 +3104,20 @@ namespace RTC
 		delete dataConsumer;
 	}
 
+	inline void Transport::OnEgressPacerSendRtpPacket(
+	  RTC::EgressPacer* /*egressPacer*/,
+	  RTC::Consumer* consumer,
+	  RTC::RtpPacket* packet,
+	  RTC::EgressPacer::Priority priority)
+	{
+		MS_TRACE();
+
+		if (priority == RTC::EgressPacer::Priority::RETRANSMISSION)
+			RetransmitConsumerRtpPacket(consumer, packet);
+		else
+			SendConsumerRtpPacket(consumer, packet);
+	}
+
 	inline void Transport::OnSctpAssociationConnecting(RTC::SctpAssociation* /*sctpAssociation*/)
 	{
 		MS_TRACE();
@@ -3112,6 +3273,11 @@ namespace RTC
 
 		MS_DEBUG_DEV("outgoing available bitrate:%" PRIu32, bitrates.availableBitrate);
 
+		if (this->egressPacer)
+		{
+			this->egressPacer->SetBitrate(bitrates.availableBitrate);
+		}
+
 		DistributeAvailableOutgoingBitrate();
 		ComputeOutgoingDesiredBitrate();
 
@@ -3126,6 +3292,10 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		// Probation packets are not paced but dropped if media is waiting.
+		if (this->egressPacer && !this->egressPacer->MaySendProbation(packet))
+			return;
+
 		// Update abs-send-time if present.
 		packet->UpdateAbsSendTime(DepLibUV::GetTimeMs());
 
@@ -3166,7 +3336,7 @@ namespace RTC
 			sentInfo.sendingAtMs = DepLibUV::GetTimeMs();
 
 			auto* cb = new onSendCallback(
-			  [tccClientWeakPtr, &packetInfo, senderBweWeakPtr, &sentInfo](bool sent)
+			  [tccClientWeakPtr, packetInfo, senderBweWeakPtr, sentInfo](bool sent) mutable
 			  {
 				  if (sent)
 				  {
@@ -3190,7 +3360,7 @@ namespace RTC
 			SendRtpPacket(nullptr, packet, cb);
 #else
 			const auto* cb = new onSendCallback(
-			  [tccClientWeakPtr, &packetInfo](bool sent)
+			  [tccClientWeakPtr, packetInfo](bool sent) mutable
 			  {
 				  if (sent)
 				  {
@@ -3253,6 +3423,42 @@ namespace RTC
 	}
 #endif
 
+	inline void Transport::FillStatsStream(uint64_t nowMs, RTC::StatsStreamer* statsStreamer)
+	{
+		MS_TRACE();
+
+		using Value = RTC::StatsStreamer::TransportValue;
+
+		RTC::StatsStreamer::Values values{};
+
+		values[Value::BYTES_RECEIVED]         = this->recvTransmission.GetBytes();
+		values[Value::RECV_BITRATE]           = this->recvTransmission.GetRate(nowMs);
+		values[Value::BYTES_SENT]             = this->sendTransmission.GetBytes();
+		values[Value::SEND_BITRATE]           = this->sendTransmission.GetRate(nowMs);
+		values[Value::RTP_BYTES_RECEIVED]     = this->recvRtpTransmission.GetBytes();
+		values[Value::RTP_RECV_BITRATE]       = this->recvRtpTransmission.GetBitrate(nowMs);
+		values[Value::RTP_BYTES_SENT]         = this->sendRtpTransmission.GetBytes();
+		values[Value::RTP_SEND_BITRATE]       = this->sendRtpTransmission.GetBitrate(nowMs);
+		values[Value::RTX_BYTES_RECEIVED]     = this->recvRtxTransmission.GetBytes();
+		values[Value::RTX_RECV_BITRATE]       = this->recvRtxTransmission.GetBitrate(nowMs);
+		values[Value::RTX_BYTES_SENT]         = this->sendRtxTransmission.GetBytes();
+		values[Value::RTX_SEND_BITRATE]       = this->sendRtxTransmission.GetBitrate(nowMs);
+		values[Value::PROBATION_BYTES_SENT]   = this->sendProbationTransmission.GetBytes();
+		values[Value::PROBATION_SEND_BITRATE] = this->sendProbationTransmission.GetBitrate(nowMs);
+
+		if (this->tccClient)
+		{
+			values[Value::AVAILABLE_OUTGOING_BITRATE] = this->tccClient->GetAvailableBitrate();
+		}
+
+		if (this->tccServer)
+		{
+			values[Value::AVAILABLE_INCOMING_BITRATE] = this->tccServer->GetAvailableBitrate();
+		}
+
+		statsStreamer->AddStats(RTC::StatsStreamer::Type::TRANSPORT, 0u, values);
+	}
+
 	inline void Transport::OnTimer(Timer* timer)
 	{
 		MS_TRACE();
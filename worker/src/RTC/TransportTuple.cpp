@@ -49,6 +49,67 @@ namespace RTC
 		}
 	}
 
+	void TransportTuple::FillJsonStats(json& jsonObject) const
+	{
+		MS_TRACE();
+
+		FillJson(jsonObject);
+
+		if (this->protocol == Protocol::TCP)
+		{
+			jsonObject["writeQueueSize"]    = this->tcpConnection->GetWriteQueueSize();
+			jsonObject["maxWriteQueueSize"] = this->tcpConnection->GetMaxWriteQueueSize();
+			jsonObject["queuedWrites"]      = this->tcpConnection->GetQueuedWrites();
+			jsonObject["writeBatchFlushes"] = this->tcpConnection->GetWriteBatchFlushes();
+			jsonObject["writeBatchItems"]   = this->tcpConnection->GetWriteBatchItems();
+		}
+	}
+
+	void TransportTuple::FillBinary(Channel::BinaryBody::Writer& writer) const
+	{
+		MS_TRACE();
+
+		using Key = Channel::BinaryBody::Key;
+
+		int family;
+		std::string ip;
+		uint16_t port;
+
+		Utils::IP::GetAddressInfo(GetLocalAddress(), family, ip, port);
+
+		if (this->localAnnouncedIp.empty())
+			writer.WriteString(Key::LOCAL_IP, ip);
+		else
+			writer.WriteString(Key::LOCAL_IP, this->localAnnouncedIp);
+
+		writer.WriteUint(Key::LOCAL_PORT, port);
+
+		Utils::IP::GetAddressInfo(GetRemoteAddress(), family, ip, port);
+
+		writer.WriteString(Key::REMOTE_IP, ip);
+		writer.WriteUint(Key::REMOTE_PORT, port);
+
+		switch (GetProtocol())
+		{
+			case Protocol::UDP:
+				writer.WriteString(Key::PROTOCOL, "udp");
+				break;
+
+			case Protocol::TCP:
+				writer.WriteString(Key::PROTOCOL, "tcp");
+				break;
+		}
+
+		if (this->protocol == Protocol::TCP)
+		{
+			writer.WriteUint(Key::WRITE_QUEUE_SIZE, this->tcpConnection->GetWriteQueueSize());
+			writer.WriteUint(Key::MAX_WRITE_QUEUE_SIZE, this->tcpConnection->GetMaxWriteQueueSize());
+			writer.WriteUint(Key::QUEUED_WRITES, this->tcpConnection->GetQueuedWrites());
+			writer.WriteUint(Key::WRITE_BATCH_FLUSHES, this->tcpConnection->GetWriteBatchFlushes());
+			writer.WriteUint(Key::WRITE_BATCH_ITEMS, this->tcpConnection->GetWriteBatchItems());
+		}
+	}
+
 	void TransportTuple::Dump() const
 	{
 		MS_TRACE();
@@ -3,6 +3,7 @@
 
 #include "RTC/UdpSocket.hpp"
 #include "Logger.hpp"
+#include "Settings.hpp"
 #include "RTC/PortManager.hpp"
 #include <string>
 
@@ -15,6 +16,12 @@ namespace RTC
 	    ::UdpSocketHandler::UdpSocketHandler(PortManager::BindUdp(ip)), listener(listener)
 	{
 		MS_TRACE();
+
+		if (Settings::configuration.udpSendBatching)
+			SetSendBatching(true);
+
+		if (Settings::configuration.udpRecvBatchSize > 1u)
+			SetRecvBatchSize(Settings::configuration.udpRecvBatchSize);
 	}
 
 	UdpSocket::UdpSocket(Listener* listener, std::string& ip, uint16_t port)
@@ -23,6 +30,42 @@ namespace RTC
 	    fixedPort(true)
 	{
 		MS_TRACE();
+
+		if (Settings::configuration.udpSendBatching)
+			SetSendBatching(true);
+
+		if (Settings::configuration.udpRecvBatchSize > 1u)
+			SetRecvBatchSize(Settings::configuration.udpRecvBatchSize);
+	}
+
+	UdpSocket::UdpSocket(Listener* listener, std::string& ip, uint16_t port, bool reusePort)
+	  : // This may throw.
+	    ::UdpSocketHandler::UdpSocketHandler(
+	      reusePort ? PortManager::BindUdpReusePort(ip, port) : PortManager::BindUdp(ip, port)),
+	    listener(listener), fixedPort(true)
+	{
+		MS_TRACE();
+
+		if (Settings::configuration.udpSendBatching)
+			SetSendBatching(true);
+
+		if (Settings::configuration.udpRecvBatchSize > 1u)
+			SetRecvBatchSize(Settings::configuration.udpRecvBatchSize);
+	}
+
+	UdpSocket::UdpSocket(
+	  Listener* listener, std::string& ip, uint16_t port, const struct sockaddr* remoteAddr)
+	  : // This may throw.
+	    ::UdpSocketHandler::UdpSocketHandler(PortManager::ConnectUdp(ip, port, remoteAddr)),
+	    listener(listener), fixedPort(true)
+	{
+		MS_TRACE();
+
+		if (Settings::configuration.udpSendBatching)
+			SetSendBatching(true);
+
+		if (Settings::configuration.udpRecvBatchSize > 1u)
+			SetRecvBatchSize(Settings::configuration.udpRecvBatchSize);
 	}
 
 	UdpSocket::~UdpSocket()
@@ -25,6 +25,164 @@ namespace RTC
 		       std::pow(2, 0) * (256 - IceComponent);
 	}
 
+	// First char of the local ICE usernameFragments of the WebRtcServer with
+	// the given reusePort index.
+	static inline char getReusePortIndexChar(uint8_t reusePortIndex)
+	{
+		if (reusePortIndex < 10u)
+			return static_cast<char>('0' + reusePortIndex);
+		else if (reusePortIndex < 36u)
+			return static_cast<char>('a' + reusePortIndex - 10u);
+		else
+			return static_cast<char>('A' + reusePortIndex - 36u);
+	}
+
+#ifdef __linux__
+	// Max number of STUN attributes before USERNAME skipped by the reusePort
+	// filter. Browsers put USERNAME first.
+	static constexpr size_t ReusePortFilterMaxSkippedAttributes{ 4u };
+
+	// Classic BPF program attached to the UDP sockets shared by several
+	// WebRtcServers. It delivers a STUN Binding request to the socket (in the
+	// SO_REUSEPORT group) of the WebRtcServer given by the first char of the
+	// local ICE usernameFragment in its USERNAME attribute (the reverse of
+	// getReusePortIndexChar()). The kernel hashes the tuple of anything else,
+	// which does not matter since the next datagrams from a remote address are
+	// received by a socket connected to it.
+	//
+	// A load out of the packet makes the kernel return 0 (the first socket in
+	// the group) rather than hashing, so the length is checked before each one.
+	static std::vector<struct sock_filter> createReusePortFilter()
+	{
+		static constexpr uint32_t NoIndex{ 0xFFFFFFFF };
+
+		std::vector<struct sock_filter> filter;
+		// Jumps to be pointed to the end (when not found), when false and when
+		// true, and to the USERNAME.
+		std::vector<size_t> noIndexJumps;
+		std::vector<size_t> noIndexTrueJumps;
+		std::vector<size_t> usernameJumps;
+
+		// Requires count bytes from the offset in X, which is never greater than
+		// the packet length.
+		auto requireBytes = [&filter, &noIndexJumps](uint32_t count)
+		{
+			filter.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_LEN, 0));
+			filter.push_back(BPF_STMT(BPF_ALU | BPF_SUB | BPF_X, 0));
+			noIndexJumps.push_back(filter.size());
+			filter.push_back(BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, count, 0, 0));
+		};
+
+		// Binding request with the magic cookie.
+		filter.push_back(BPF_STMT(BPF_LDX | BPF_IMM, 0));
+		requireBytes(20);
+		filter.push_back(BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 0));
+		noIndexJumps.push_back(filter.size());
+		filter.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0x0001, 0, 0));
+		filter.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, 4));
+		noIndexJumps.push_back(filter.size());
+		filter.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0x2112A442, 0, 0));
+
+		// X is the offset of the current attribute.
+		filter.push_back(BPF_STMT(BPF_LDX | BPF_IMM, 20));
+
+		for (size_t i{ 0u }; i <= ReusePortFilterMaxSkippedAttributes; ++i)
+		{
+			requireBytes(4);
+			filter.push_back(BPF_STMT(BPF_LD | BPF_H | BPF_IND, 0));
+			usernameJumps.push_back(filter.size());
+			filter.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0x0006, 0, 0));
+
+			if (i == ReusePortFilterMaxSkippedAttributes)
+				break;
+
+			// X += 4 + attribute length padded to 4 bytes, if not beyond the end.
+			filter.push_back(BPF_STMT(BPF_LD | BPF_H | BPF_IND, 2));
+			filter.push_back(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 4 + 3));
+			filter.push_back(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, ~uint32_t{ 3u }));
+			filter.push_back(BPF_STMT(BPF_ALU | BPF_ADD | BPF_X, 0));
+			filter.push_back(BPF_STMT(BPF_ST, 0));
+			filter.push_back(BPF_STMT(BPF_LDX | BPF_MEM, 0));
+			filter.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_LEN, 0));
+			noIndexJumps.push_back(filter.size());
+			filter.push_back(BPF_JUMP(BPF_JMP | BPF_JGE | BPF_X, 0, 0, 0));
+		}
+
+		filter.push_back(BPF_STMT(BPF_RET | BPF_K, NoIndex));
+
+		const size_t usernameIdx = filter.size();
+
+		// First char of the USERNAME value, which must be one of those given by
+		// getReusePortIndexChar().
+		requireBytes(5);
+		filter.push_back(BPF_STMT(BPF_LD | BPF_B | BPF_IND, 4));
+		filter.push_back(BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, 'a', 8, 0));
+		filter.push_back(BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, 'A', 4, 0));
+		noIndexJumps.push_back(filter.size());
+		filter.push_back(BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, '0', 0, 0));
+		// '0' to '9'.
+		noIndexTrueJumps.push_back(filter.size());
+		filter.push_back(BPF_JUMP(BPF_JMP | BPF_JGT | BPF_K, '9', 0, 0));
+		filter.push_back(BPF_STMT(BPF_ALU | BPF_SUB | BPF_K, '0'));
+		filter.push_back(BPF_STMT(BPF_RET | BPF_A, 0));
+		// 'A' to 'Z'.
+		noIndexTrueJumps.push_back(filter.size());
+		filter.push_back(BPF_JUMP(BPF_JMP | BPF_JGT | BPF_K, 'Z', 0, 0));
+		filter.push_back(BPF_STMT(BPF_ALU | BPF_SUB | BPF_K, 'A' - 36));
+		filter.push_back(BPF_STMT(BPF_RET | BPF_A, 0));
+		// 'a' to 'z'.
+		noIndexTrueJumps.push_back(filter.size());
+		filter.push_back(BPF_JUMP(BPF_JMP | BPF_JGT | BPF_K, 'z', 0, 0));
+		filter.push_back(BPF_STMT(BPF_ALU | BPF_SUB | BPF_K, 'a' - 10));
+		filter.push_back(BPF_STMT(BPF_RET | BPF_A, 0));
+
+		const size_t noIndexIdx = filter.size();
+
+		filter.push_back(BPF_STMT(BPF_RET | BPF_K, NoIndex));
+
+		for (auto idx : noIndexJumps)
+		{
+			filter[idx].jf = static_cast<uint8_t>(noIndexIdx - idx - 1);
+		}
+
+		for (auto idx : noIndexTrueJumps)
+		{
+			filter[idx].jt = static_cast<uint8_t>(noIndexIdx - idx - 1);
+		}
+
+		for (auto idx : usernameJumps)
+		{
+			filter[idx].jt = static_cast<uint8_t>(usernameIdx - idx - 1);
+		}
+
+		return filter;
+	}
+#endif
+
+	static bool setReusePortFilter(RTC::UdpSocket* udpSocket)
+	{
+		MS_TRACE();
+
+#ifdef __linux__
+		const auto& filter = WebRtcServer::GetReusePortFilter();
+
+		return udpSocket->SetReusePortFilter(filter.data(), filter.size());
+#else
+		return false;
+#endif
+	}
+
+	/* Class methods. */
+
+#ifdef __linux__
+	const std::vector<struct sock_filter>& WebRtcServer::GetReusePortFilter()
+	{
+		static const std::vector<struct sock_filter> Filter = createReusePortFilter();
+
+		return Filter;
+	}
+#endif
+
 	/* Instance methods. */
 
 	WebRtcServer::WebRtcServer(RTC::Shared* shared, const std::string& id, json& data)
@@ -43,6 +201,28 @@ namespace RTC
 		else if (jsonListenInfosIt->size() > 8)
 			MS_THROW_TYPE_ERROR("wrong listenInfos (too many entries)");
 
+		auto jsonReusePortIndexIt = data.find("reusePortIndex");
+
+		if (jsonReusePortIndexIt != data.end())
+		{
+			// clang-format off
+			if (
+				!jsonReusePortIndexIt->is_number() ||
+				!Utils::Json::IsPositiveInteger(*jsonReusePortIndexIt)
+			)
+			// clang-format on
+			{
+				MS_THROW_TYPE_ERROR("wrong reusePortIndex (not a positive number)");
+			}
+			else if (jsonReusePortIndexIt->get<uint64_t>() > MaxReusePortIndex)
+			{
+				MS_THROW_TYPE_ERROR("wrong reusePortIndex (too big)");
+			}
+
+			this->reusePort      = true;
+			this->reusePortIndex = jsonReusePortIndexIt->get<uint8_t>();
+		}
+
 		std::vector<ListenInfo> listenInfos(jsonListenInfosIt->size());
 
 		for (size_t i{ 0 }; i < jsonListenInfosIt->size(); ++i)
@@ -104,6 +284,10 @@ namespace RTC
 				port = jsonPortIt->get<uint16_t>();
 			}
 
+			// Shared UDP ports must be given.
+			if (this->reusePort && listenInfo.protocol == RTC::TransportTuple::Protocol::UDP && port == 0)
+				MS_THROW_TYPE_ERROR("missing listenInfo.port (required with reusePortIndex)");
+
 			listenInfo.port = port;
 		}
 
@@ -116,11 +300,25 @@ namespace RTC
 					// This may throw.
 					RTC::UdpSocket* udpSocket;
 
-					if (listenInfo.port != 0)
+					if (this->reusePort)
+						udpSocket = new RTC::UdpSocket(this, listenInfo.ip, listenInfo.port, true);
+					else if (listenInfo.port != 0)
 						udpSocket = new RTC::UdpSocket(this, listenInfo.ip, listenInfo.port);
 					else
 						udpSocket = new RTC::UdpSocket(this, listenInfo.ip);
 
+					// NOTE: Attaching the same filter to every socket in the group is
+					// harmless (it replaces the existing one).
+					if (this->reusePort && !setReusePortFilter(udpSocket))
+					{
+						MS_WARN_TAG(
+						  ice,
+						  "could not set the reusePort filter, STUN requests will not be delivered to "
+						  "the proper WebRtcServer [ip:'%s', port:%" PRIu16 "]",
+						  listenInfo.ip.c_str(),
+						  listenInfo.port);
+					}
+
 					this->udpSocketOrTcpServers.emplace_back(udpSocket, nullptr, listenInfo.announcedIp);
 				}
 				else if (listenInfo.protocol == RTC::TransportTuple::Protocol::TCP)
@@ -183,6 +381,14 @@ namespace RTC
 			webRtcTransport->ListenServerClosed();
 		}
 		this->webRtcTransports.clear();
+
+		for (auto& kv : this->mapTupleConnectedUdpSocket)
+		{
+			auto* udpSocket = kv.second;
+
+			delete udpSocket;
+		}
+		this->mapTupleConnectedUdpSocket.clear();
 	}
 
 	void WebRtcServer::FillJson(json& jsonObject) const
@@ -252,7 +458,7 @@ namespace RTC
 
 			auto& jsonEntry = (*jsonLocalIceUsernamesIt)[idx];
 
-			jsonEntry["localIceUsernameFragment"] = localIceUsernameFragment;
+			jsonEntry["localIceUsernameFragment"] = localIceUsernameFragment.ToString();
 			jsonEntry["webRtcTransportId"]        = webRtcTransport->id;
 
 			++idx;
@@ -349,8 +555,8 @@ namespace RTC
 		return iceCandidates;
 	}
 
-	inline std::string WebRtcServer::GetLocalIceUsernameFragmentFromReceivedStunPacket(
-	  RTC::StunPacket* packet) const
+	inline WebRtcServer::UsernameFragmentKey WebRtcServer::
+	  GetLocalIceUsernameFragmentFromReceivedStunPacket(RTC::StunPacket* packet) const
 	{
 		MS_TRACE();
 
@@ -364,9 +570,9 @@ namespace RTC
 
 		// If no colon is found just return the whole USERNAME attribute anyway.
 		if (colonPos == std::string::npos)
-			return username;
+			return UsernameFragmentKey(username);
 
-		return username.substr(0, colonPos);
+		return { username.c_str(), colonPos };
 	}
 
 	inline void WebRtcServer::OnPacketReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len)
@@ -412,7 +618,8 @@ namespace RTC
 
 		// Otherwise try to match the local ICE username fragment.
 		auto key = GetLocalIceUsernameFragmentFromReceivedStunPacket(packet);
-		auto it2 = this->mapLocalIceUsernameFragmentWebRtcTransport.find(key);
+		auto it2 = key.IsEmpty() ? this->mapLocalIceUsernameFragmentWebRtcTransport.end()
+		                         : this->mapLocalIceUsernameFragmentWebRtcTransport.find(key);
 
 		if (it2 == this->mapLocalIceUsernameFragmentWebRtcTransport.end())
 		{
@@ -425,6 +632,40 @@ namespace RTC
 
 		auto* webRtcTransport = it2->second;
 
+		// If UDP sockets are shared with other WebRtcServers, handle the new tuple
+		// with a socket connected to its remote address so the kernel delivers
+		// the next datagrams from it to this WebRtcServer.
+		if (this->reusePort && tuple->GetProtocol() == RTC::TransportTuple::Protocol::UDP)
+		{
+			auto* connectedUdpSocket = CreateConnectedUdpSocket(tuple);
+
+			if (connectedUdpSocket)
+			{
+				RTC::TransportTuple connectedTuple(connectedUdpSocket, tuple->GetRemoteAddress());
+
+				webRtcTransport->ProcessStunPacketFromWebRtcServer(&connectedTuple, packet);
+
+				// Keep the socket just if the WebRtcTransport added the tuple.
+				// clang-format off
+				if (
+					this->mapTupleWebRtcTransport.find(connectedTuple.hash) !=
+					this->mapTupleWebRtcTransport.end()
+				)
+				// clang-format on
+				{
+					this->mapTupleConnectedUdpSocket[connectedTuple.hash] = connectedUdpSocket;
+				}
+				else
+				{
+					delete connectedUdpSocket;
+				}
+
+				delete packet;
+
+				return;
+			}
+		}
+
 		webRtcTransport->ProcessStunPacketFromWebRtcServer(tuple, packet);
 
 		delete packet;
@@ -449,6 +690,28 @@ namespace RTC
 		webRtcTransport->ProcessNonStunPacketFromWebRtcServer(tuple, data, len);
 	}
 
+	RTC::UdpSocket* WebRtcServer::CreateConnectedUdpSocket(const RTC::TransportTuple* tuple)
+	{
+		MS_TRACE();
+
+		int family;
+		std::string ip;
+		uint16_t port;
+
+		Utils::IP::GetAddressInfo(tuple->GetLocalAddress(), family, ip, port);
+
+		try
+		{
+			return new RTC::UdpSocket(this, ip, port, tuple->GetRemoteAddress());
+		}
+		catch (const MediaSoupError& error)
+		{
+			MS_WARN_TAG(ice, "could not create a connected UDP socket: %s", error.what());
+
+			return nullptr;
+		}
+	}
+
 	inline void WebRtcServer::OnWebRtcTransportCreated(RTC::WebRtcTransport* webRtcTransport)
 	{
 		MS_TRACE();
@@ -471,17 +734,30 @@ namespace RTC
 		this->webRtcTransports.erase(webRtcTransport);
 	}
 
+	inline void WebRtcServer::OnWebRtcTransportLocalIceUsernameFragmentGenerated(
+	  RTC::WebRtcTransport* /*webRtcTransport*/, std::string& usernameFragment)
+	{
+		MS_TRACE();
+
+		// Tag it so the reusePort filter delivers STUN requests to this one.
+		if (this->reusePort)
+			usernameFragment[0] = getReusePortIndexChar(this->reusePortIndex);
+	}
+
 	inline void WebRtcServer::OnWebRtcTransportLocalIceUsernameFragmentAdded(
 	  RTC::WebRtcTransport* webRtcTransport, const std::string& usernameFragment)
 	{
 		MS_TRACE();
 
+		const UsernameFragmentKey key(usernameFragment);
+
+		MS_ASSERT(!key.IsEmpty(), "local ICE username fragment is empty or too long");
 		MS_ASSERT(
-		  this->mapLocalIceUsernameFragmentWebRtcTransport.find(usernameFragment) ==
+		  this->mapLocalIceUsernameFragmentWebRtcTransport.find(key) ==
 		    this->mapLocalIceUsernameFragmentWebRtcTransport.end(),
 		  "local ICE username fragment already exists in the table");
 
-		this->mapLocalIceUsernameFragmentWebRtcTransport[usernameFragment] = webRtcTransport;
+		this->mapLocalIceUsernameFragmentWebRtcTransport[key] = webRtcTransport;
 	}
 
 	inline void WebRtcServer::OnWebRtcTransportLocalIceUsernameFragmentRemoved(
@@ -489,12 +765,14 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		const UsernameFragmentKey key(usernameFragment);
+
 		MS_ASSERT(
-		  this->mapLocalIceUsernameFragmentWebRtcTransport.find(usernameFragment) !=
+		  this->mapLocalIceUsernameFragmentWebRtcTransport.find(key) !=
 		    this->mapLocalIceUsernameFragmentWebRtcTransport.end(),
 		  "local ICE username fragment not found in the table");
 
-		this->mapLocalIceUsernameFragmentWebRtcTransport.erase(usernameFragment);
+		this->mapLocalIceUsernameFragmentWebRtcTransport.erase(key);
 	}
 
 	inline void WebRtcServer::OnWebRtcTransportTransportTupleAdded(
@@ -525,6 +803,17 @@ namespace RTC
 		}
 
 		this->mapTupleWebRtcTransport.erase(tuple->hash);
+
+		auto it = this->mapTupleConnectedUdpSocket.find(tuple->hash);
+
+		if (it != this->mapTupleConnectedUdpSocket.end())
+		{
+			auto* connectedUdpSocket = it->second;
+
+			this->mapTupleConnectedUdpSocket.erase(it);
+
+			delete connectedUdpSocket;
+		}
 	}
 
 	inline void WebRtcServer::OnUdpSocketPacketReceived(
@@ -265,7 +265,7 @@ namespace RTC
 
 			// Create a ICE server.
 			this->iceServer = new RTC::IceServer(
-			  this, Utils::Crypto::GetRandomString(32), Utils::Crypto::GetRandomString(32));
+			  this, GenerateIceUsernameFragment(), Utils::Crypto::GetRandomString(32));
 
 			// Create a DTLS transport.
 			this->dtlsTransport = new RTC::DtlsTransport(this);
@@ -486,7 +486,7 @@ namespace RTC
 		if (this->iceServer->GetSelectedTuple())
 		{
 			// Add iceSelectedTuple.
-			this->iceServer->GetSelectedTuple()->FillJson(jsonObject["iceSelectedTuple"]);
+			this->iceServer->GetSelectedTuple()->FillJsonStats(jsonObject["iceSelectedTuple"]);
 		}
 
 		// Add dtlsState.
@@ -510,6 +510,64 @@ namespace RTC
 		}
 	}
 
+	void WebRtcTransport::FillBinaryStats(Channel::BinaryBody::Writer& writer)
+	{
+		MS_TRACE();
+
+		using Key = Channel::BinaryBody::Key;
+
+		// Call the parent method.
+		RTC::Transport::FillBinaryStats(writer);
+
+		writer.WriteString(Key::TYPE, "webrtc-transport");
+		// We are always "controlled".
+		writer.WriteString(Key::ICE_ROLE, "controlled");
+
+		switch (this->iceServer->GetState())
+		{
+			case RTC::IceServer::IceState::NEW:
+				writer.WriteString(Key::ICE_STATE, "new");
+				break;
+			case RTC::IceServer::IceState::CONNECTED:
+				writer.WriteString(Key::ICE_STATE, "connected");
+				break;
+			case RTC::IceServer::IceState::COMPLETED:
+				writer.WriteString(Key::ICE_STATE, "completed");
+				break;
+			case RTC::IceServer::IceState::DISCONNECTED:
+				writer.WriteString(Key::ICE_STATE, "disconnected");
+				break;
+		}
+
+		if (this->iceServer->GetSelectedTuple())
+		{
+			writer.StartRecord(Key::ICE_SELECTED_TUPLE);
+			this->iceServer->GetSelectedTuple()->FillBinary(writer);
+			writer.EndRecord();
+		}
+
+		switch (this->dtlsTransport->GetState())
+		{
+			case RTC::DtlsTransport::DtlsState::NEW:
+				writer.WriteString(Key::DTLS_STATE, "new");
+				break;
+			case RTC::DtlsTransport::DtlsState::CONNECTING:
+				writer.WriteString(Key::DTLS_STATE, "connecting");
+				break;
+			case RTC::DtlsTransport::DtlsState::CONNECTED:
+				writer.WriteString(Key::DTLS_STATE, "connected");
+				break;
+			case RTC::DtlsTransport::DtlsState::FAILED:
+				writer.WriteString(Key::DTLS_STATE, "failed");
+				break;
+			case RTC::DtlsTransport::DtlsState::CLOSED:
+				writer.WriteString(Key::DTLS_STATE, "closed");
+				break;
+		}
+
+		writer.EndRecord();
+	}
+
 	void WebRtcTransport::HandleRequest(Channel::ChannelRequest* request)
 	{
 		MS_TRACE();
@@ -648,7 +706,7 @@ namespace RTC
 
 			case Channel::ChannelRequest::MethodId::TRANSPORT_RESTART_ICE:
 			{
-				const std::string usernameFragment = Utils::Crypto::GetRandomString(32);
+				const std::string usernameFragment = GenerateIceUsernameFragment();
 				const std::string password         = Utils::Crypto::GetRandomString(32);
 
 				this->iceServer->RestartIce(usernameFragment, password);
@@ -747,6 +805,21 @@ namespace RTC
 		// clang-format on
 	}
 
+	inline std::string WebRtcTransport::GenerateIceUsernameFragment()
+	{
+		MS_TRACE();
+
+		auto usernameFragment = Utils::Crypto::GetRandomString(32);
+
+		if (this->webRtcTransportListener)
+		{
+			this->webRtcTransportListener->OnWebRtcTransportLocalIceUsernameFragmentGenerated(
+			  this, usernameFragment);
+		}
+
+		return usernameFragment;
+	}
+
 	void WebRtcTransport::MayRunDtlsTransport()
 	{
 		MS_TRACE();
@@ -860,11 +933,18 @@ namespace RTC
 			return;
 		}
 
-		const uint8_t* data = packet->GetData();
-		auto intLen         = static_cast<int>(packet->GetSize());
+		// Copy the packet (applying its rewrite plan) into a pooled send buffer
+		// with room for the SRTP trailer and encrypt it there. The buffer is then
+		// handed to the socket so the encrypted packet is not copied again.
+		auto* sendData = ::UdpSocketHandler::AllocateSendData(packet->GetSize() + SRTP_MAX_TRAILER_LEN);
+		auto intLen    = static_cast<int>(packet->GetSize());
 
-		if (!this->srtpSendSession->EncryptRtp(&data, &intLen))
+		packet->Write(sendData->store);
+
+		if (!this->srtpSendSession->EncryptRtp(sendData->store, &intLen, sendData->storeSize))
 		{
+			::UdpSocketHandler::ReleaseSendData(sendData);
+
 			if (cb)
 			{
 				(*cb)(false);
@@ -876,7 +956,9 @@ namespace RTC
 
 		auto len = static_cast<size_t>(intLen);
 
-		this->iceServer->GetSelectedTuple()->Send(data, len, cb);
+		sendData->len = len;
+
+		this->iceServer->GetSelectedTuple()->Send(sendData, cb);
 
 		// Increase send transmission.
 		RTC::Transport::DataSent(len);
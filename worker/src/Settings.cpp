@@ -5,6 +5,8 @@
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
+#include "RTC/RtcLogger.hpp"
+#include "handles/UdpSocketHandler.hpp"
 #include <cctype>   // isprint()
 #include <iterator> // std::ostream_iterator
 #include <mutex>
@@ -60,6 +62,13 @@ void Settings::SetConfiguration(int argc, char* argv[])
 		{ "dtlsCertificateFile",  optional_argument, nullptr, 'c' },
 		{ "dtlsPrivateKeyFile",   optional_argument, nullptr, 'p' },
 		{ "libwebrtcFieldTrials", optional_argument, nullptr, 'W' },
+		{ "udpSendBatching",      optional_argument, nullptr, 'b' },
+		{ "udpRecvBatchSize",     optional_argument, nullptr, 'r' },
+		{ "egressPacing",         optional_argument, nullptr, 'e' },
+		{ "dtlsHandshakeOffload", optional_argument, nullptr, 'd' },
+		{ "tcpSendBatching",      optional_argument, nullptr, 'T' },
+		{ "rtpTraceSize",         optional_argument, nullptr, 'R' },
+		{ "logBatching",          optional_argument, nullptr, 'L' },
 		{ nullptr, 0, nullptr, 0 }
 	};
 	// clang-format on
@@ -156,6 +165,104 @@ void Settings::SetConfiguration(int argc, char* argv[])
 				break;
 			}
 
+			case 'b':
+			{
+				stringValue = std::string(optarg);
+
+				Settings::configuration.udpSendBatching =
+				  Settings::GetBooleanOption("udpSendBatching", stringValue);
+
+				break;
+			}
+
+			case 'r':
+			{
+				int value;
+
+				try
+				{
+					value = std::stoi(optarg);
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				if (value < 1 || static_cast<size_t>(value) > UdpSocketHandler::GetMaxRecvBatchSize())
+				{
+					MS_THROW_TYPE_ERROR(
+					  "udpRecvBatchSize must be between 1 and %zu", UdpSocketHandler::GetMaxRecvBatchSize());
+				}
+
+				Settings::configuration.udpRecvBatchSize = static_cast<uint8_t>(value);
+
+				break;
+			}
+
+			case 'e':
+			{
+				stringValue = std::string(optarg);
+
+				Settings::configuration.egressPacing =
+				  Settings::GetBooleanOption("egressPacing", stringValue);
+
+				break;
+			}
+
+			case 'd':
+			{
+				stringValue = std::string(optarg);
+
+				Settings::configuration.dtlsHandshakeOffload =
+				  Settings::GetBooleanOption("dtlsHandshakeOffload", stringValue);
+
+				break;
+			}
+
+			case 'T':
+			{
+				stringValue = std::string(optarg);
+
+				Settings::configuration.tcpSendBatching =
+				  Settings::GetBooleanOption("tcpSendBatching", stringValue);
+
+				break;
+			}
+
+			case 'R':
+			{
+				int value;
+
+				try
+				{
+					value = std::stoi(optarg);
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				if (value < 0 || static_cast<size_t>(value) > RTC::RtcLogger::TraceRing::MaxCapacity)
+				{
+					MS_THROW_TYPE_ERROR(
+					  "rtpTraceSize must be between 0 and %zu", RTC::RtcLogger::TraceRing::MaxCapacity);
+				}
+
+				Settings::configuration.rtpTraceSize = static_cast<uint32_t>(value);
+
+				break;
+			}
+
+			case 'L':
+			{
+				stringValue = std::string(optarg);
+
+				Settings::configuration.logBatching =
+				  Settings::GetBooleanOption("logBatching", stringValue);
+
+				break;
+			}
+
 			// Invalid option.
 			case '?':
 			{
@@ -256,6 +363,26 @@ void Settings::PrintConfiguration()
 		  info, "  libwebrtcFieldTrials : %s", Settings::configuration.libwebrtcFieldTrials.c_str());
 	}
 
+	MS_DEBUG_TAG(
+	  info,
+	  "  udpSendBatching      : %s",
+	  Settings::configuration.udpSendBatching ? "true" : "false");
+	MS_DEBUG_TAG(
+	  info, "  udpRecvBatchSize     : %" PRIu8, Settings::configuration.udpRecvBatchSize);
+	MS_DEBUG_TAG(
+	  info, "  egressPacing         : %s", Settings::configuration.egressPacing ? "true" : "false");
+	MS_DEBUG_TAG(
+	  info,
+	  "  dtlsHandshakeOffload : %s",
+	  Settings::configuration.dtlsHandshakeOffload ? "true" : "false");
+	MS_DEBUG_TAG(
+	  info,
+	  "  tcpSendBatching      : %s",
+	  Settings::configuration.tcpSendBatching ? "true" : "false");
+	MS_DEBUG_TAG(info, "  rtpTraceSize         : %" PRIu32, Settings::configuration.rtpTraceSize);
+	MS_DEBUG_TAG(
+	  info, "  logBatching          : %s", Settings::configuration.logBatching ? "true" : "false");
+
 	MS_DEBUG_TAG(info, "</configuration>");
 }
 
@@ -405,3 +532,15 @@ void Settings::SetDtlsCertificateAndPrivateKeyFiles()
 		MS_THROW_TYPE_ERROR("dtlsPrivateKeyFile: %s", error.what());
 	}
 }
+
+bool Settings::GetBooleanOption(const char* option, const std::string& value)
+{
+	MS_TRACE();
+
+	if (value == "true")
+		return true;
+	else if (value == "false")
+		return false;
+	else
+		MS_THROW_TYPE_ERROR("invalid value '%s' for %s", value.c_str(), option);
+}
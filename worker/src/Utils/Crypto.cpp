@@ -14,7 +14,7 @@ namespace Utils
 	thread_local EVP_MAC_CTX* Crypto::hmacSha1Ctx{ nullptr };
 	thread_local uint8_t Crypto::hmacSha1Buffer[SHA_DIGEST_LENGTH];
 	// clang-format off
-	const uint32_t Crypto::crc32Table[] =
+	static const uint32_t Crc32Table[] =
 	{
 		0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f, 0xe963a535, 0x9e6495a3,
 		0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988, 0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91,
@@ -50,6 +50,29 @@ namespace Utils
 		0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
 	};
 	// clang-format on
+	// clang-format off
+	const std::array<std::array<uint32_t, 256>, 8> Crypto::crc32Tables = []()
+	{
+		std::array<std::array<uint32_t, 256>, 8> tables;
+
+		for (size_t i{ 0u }; i < 256; ++i)
+		{
+			tables[0][i] = Crc32Table[i];
+		}
+
+		for (size_t k{ 1u }; k < 8; ++k)
+		{
+			for (size_t i{ 0u }; i < 256; ++i)
+			{
+				const uint32_t crc = tables[k - 1][i];
+
+				tables[k][i] = tables[0][crc & 0xFF] ^ (crc >> 8);
+			}
+		}
+
+		return tables;
+	}();
+	// clang-format on
 
 	/* Static methods. */
 
@@ -109,4 +132,86 @@ namespace Utils
 
 		return Crypto::hmacSha1Buffer;
 	}
+
+	const uint8_t* Crypto::GetHmacSha1(const HmacSha1Key& key, const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(key.ctx != nullptr, "empty HMAC-SHA1 key");
+
+		int ret;
+
+		// Passing no key makes OpenSSL reuse the key schedule of the context.
+		ret = EVP_MAC_init(key.ctx, nullptr, 0, nullptr);
+
+		MS_ASSERT(ret == 1, "OpenSSL EVP_MAC_init() failed with key '%s'", key.key.c_str());
+
+		ret = EVP_MAC_update(key.ctx, data, len);
+
+		MS_ASSERT(
+		  ret == 1,
+		  "OpenSSL EVP_MAC_update() failed with key '%s' and data length %zu bytes",
+		  key.key.c_str(),
+		  len);
+
+		size_t resultLen;
+
+		ret = EVP_MAC_final(key.ctx, Crypto::hmacSha1Buffer, &resultLen, SHA_DIGEST_LENGTH);
+
+		MS_ASSERT(
+		  ret == 1,
+		  "OpenSSL HMAC_Final() failed with key '%s' and data length %zu bytes",
+		  key.key.c_str(),
+		  len);
+		MS_ASSERT(
+		  resultLen == SHA_DIGEST_LENGTH, "OpenSSL HMAC_Final() resultLen is %zu instead of 20", resultLen);
+
+		return Crypto::hmacSha1Buffer;
+	}
+
+	/* Instance methods. */
+
+	Crypto::HmacSha1Key::HmacSha1Key(const std::string& key)
+	{
+		MS_TRACE();
+
+		SetKey(key);
+	}
+
+	Crypto::HmacSha1Key::~HmacSha1Key()
+	{
+		MS_TRACE();
+
+		if (this->ctx != nullptr)
+			EVP_MAC_CTX_free(this->ctx);
+	}
+
+	void Crypto::HmacSha1Key::SetKey(const std::string& key)
+	{
+		MS_TRACE();
+
+		if (this->ctx != nullptr)
+		{
+			EVP_MAC_CTX_free(this->ctx);
+
+			this->ctx = nullptr;
+		}
+
+		this->key = key;
+
+		if (this->key.empty())
+			return;
+
+		OSSL_PARAM sha1[] = { { "digest", OSSL_PARAM_UTF8_STRING, (void*)"sha1", 4, 0 }, OSSL_PARAM_END };
+
+		this->ctx = EVP_MAC_CTX_new(Crypto::mac);
+
+		const int ret = EVP_MAC_init(
+		  this->ctx,
+		  reinterpret_cast<const unsigned char*>(this->key.c_str()),
+		  this->key.length(),
+		  sha1);
+
+		MS_ASSERT(ret == 1, "OpenSSL EVP_MAC_init() failed with key '%s'", this->key.c_str());
+	}
 } // namespace Utils
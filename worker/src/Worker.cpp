@@ -7,9 +7,13 @@
 #include "DepUsrSCTP.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "Metrics.hpp"
 #include "Settings.hpp"
+#include "Utils.hpp"
 #include "Channel/ChannelNotifier.hpp"
 #include "PayloadChannel/PayloadChannelNotifier.hpp"
+#include "RTC/RtcLogger.hpp"
+#include "RTC/RtpPacketPool.hpp"
 
 /* Instance methods. */
 
@@ -28,10 +32,13 @@ Worker::Worker(::Channel::ChannelSocket* channel, PayloadChannel::PayloadChannel
 	this->signalsHandler = new SignalsHandler(this);
 
 	// Set up the RTC::Shared singleton.
+	auto* payloadChannelNotifier = new PayloadChannel::PayloadChannelNotifier(this->payloadChannel);
+
 	this->shared = new RTC::Shared(
 	  /*channelMessageRegistrator*/ new ChannelMessageRegistrator(),
 	  /*channelNotifier*/ new Channel::ChannelNotifier(this->channel),
-	  /*payloadChannelNotifier*/ new PayloadChannel::PayloadChannelNotifier(this->payloadChannel));
+	  /*payloadChannelNotifier*/ payloadChannelNotifier,
+	  /*statsStreamer*/ new RTC::StatsStreamer(payloadChannelNotifier));
 
 #ifdef MS_EXECUTABLE
 	{
@@ -44,6 +51,12 @@ Worker::Worker(::Channel::ChannelSocket* channel, PayloadChannel::PayloadChannel
 	// Create the Checker instance in DepUsrSCTP.
 	DepUsrSCTP::CreateChecker();
 
+	// Allocate the RTP trace ring (if enabled).
+	RTC::RtcLogger::TraceRing::SetCapacity(Settings::configuration.rtpTraceSize);
+
+	// Buffer log messages (if enabled).
+	Logger::SetBatching(Settings::configuration.logBatching);
+
 	// Tell the Node process that we are running.
 	this->shared->channelNotifier->Emit(Logger::pid, "running");
 
@@ -96,6 +109,12 @@ void Worker::Close()
 	// Close the Checker instance in DepUsrSCTP.
 	DepUsrSCTP::CloseChecker();
 
+	// Free the RTP trace ring.
+	RTC::RtcLogger::TraceRing::SetCapacity(0u);
+
+	// Write buffered log messages before closing the Channel.
+	Logger::SetBatching(false);
+
 	// Close the Channel.
 	this->channel->Close();
 
@@ -137,6 +156,45 @@ void Worker::FillJson(json& jsonObject) const
 	auto jsonChannelMessageHandlersIt    = jsonObject.find("channelMessageHandlers");
 
 	this->shared->channelMessageRegistrator->FillJson(*jsonChannelMessageHandlersIt);
+
+	// Add rtpPacketPool.
+	jsonObject["rtpPacketPool"] = json::object();
+	auto jsonRtpPacketPoolIt    = jsonObject.find("rtpPacketPool");
+
+	RTC::RtpPacketPool::FillJson(*jsonRtpPacketPoolIt);
+}
+
+void Worker::FillBinary(Channel::BinaryBody::Writer& writer) const
+{
+	MS_TRACE();
+
+	using Key = Channel::BinaryBody::Key;
+
+	writer.WriteUint(Key::PID, Logger::pid);
+
+	writer.StartItems(Key::WEBRTC_SERVER_IDS, this->mapWebRtcServers.size());
+
+	for (const auto& kv : this->mapWebRtcServers)
+	{
+		writer.AppendString(kv.first);
+	}
+
+	writer.StartItems(Key::ROUTER_IDS, this->mapRouters.size());
+
+	for (const auto& kv : this->mapRouters)
+	{
+		writer.AppendString(kv.first);
+	}
+
+	writer.StartRecord(Key::CHANNEL_MESSAGE_HANDLERS);
+	this->shared->channelMessageRegistrator->FillBinary(writer);
+	writer.EndRecord();
+
+	writer.StartRecord(Key::RTP_PACKET_POOL);
+	RTC::RtpPacketPool::FillBinary(writer);
+	writer.EndRecord();
+
+	writer.EndRecord();
 }
 
 void Worker::FillJsonResourceUsage(json& jsonObject) const
@@ -293,6 +351,17 @@ inline void Worker::HandleRequest(Channel::ChannelRequest* request)
 
 		case Channel::ChannelRequest::MethodId::WORKER_DUMP:
 		{
+			if (request->binary)
+			{
+				Channel::BinaryBody::Writer body(Channel::BinaryMessage::BodyType::RECORD);
+
+				FillBinary(body);
+
+				request->Accept(body);
+
+				break;
+			}
+
 			json data = json::object();
 
 			FillJson(data);
@@ -313,6 +382,53 @@ inline void Worker::HandleRequest(Channel::ChannelRequest* request)
 			break;
 		}
 
+		case Channel::ChannelRequest::MethodId::WORKER_DUMP_RTP_TRACE:
+		{
+			json data = json::object();
+
+			RTC::RtcLogger::TraceRing::FillJson(data);
+
+			request->Accept(data);
+
+			break;
+		}
+
+		case Channel::ChannelRequest::MethodId::WORKER_SUBSCRIBE_STATS:
+		{
+			auto jsonIntervalIt = request->data.find("interval");
+
+			if (jsonIntervalIt == request->data.end() || !Utils::Json::IsPositiveInteger(*jsonIntervalIt))
+			{
+				MS_THROW_TYPE_ERROR("missing interval");
+			}
+
+			this->shared->statsStreamer->Subscribe(jsonIntervalIt->get<uint64_t>());
+
+			request->Accept();
+
+			break;
+		}
+
+		case Channel::ChannelRequest::MethodId::WORKER_UNSUBSCRIBE_STATS:
+		{
+			this->shared->statsStreamer->Unsubscribe();
+
+			request->Accept();
+
+			break;
+		}
+
+		case Channel::ChannelRequest::MethodId::WORKER_GET_METRICS:
+		{
+			json data = json::object();
+
+			data["text"] = Metrics::Render();
+
+			request->Accept(data);
+
+			break;
+		}
+
 		case Channel::ChannelRequest::MethodId::WORKER_UPDATE_SETTINGS:
 		{
 			Settings::HandleRequest(request);
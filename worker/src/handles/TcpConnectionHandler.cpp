@@ -5,9 +5,16 @@
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "Metrics.hpp"
 #include "Utils.hpp"
 #include <cstring> // std::memcpy()
 
+/* Static. */
+
+// Size of the write batch buffer of a connection. The batch is flushed once
+// it has this many bytes.
+static constexpr size_t WriteBatchMaxSize{ 65536 };
+
 /* Static methods for UV callbacks. */
 
 inline static void onAlloc(uv_handle_t* handle, size_t suggestedSize, uv_buf_t* buf)
@@ -31,20 +38,69 @@ inline static void onWrite(uv_write_t* req, int status)
 	auto* writeData  = static_cast<TcpConnectionHandler::UvWriteData*>(req->data);
 	auto* handle     = req->handle;
 	auto* connection = static_cast<TcpConnectionHandler*>(handle->data);
-	auto* cb         = writeData->cb;
 
 	if (connection)
-		connection->OnUvWrite(status, cb);
+		connection->OnUvWrite(status, writeData);
 
-	// Delete the UvWriteData struct and the cb.
+	// Delete the UvWriteData struct and the cbs.
 	delete writeData;
 }
 
+inline static void onWriteBatchPrepare(uv_prepare_t* handle)
+{
+	auto* connection = static_cast<TcpConnectionHandler*>(handle->data);
+
+	if (connection)
+		connection->OnUvWriteBatchFlush();
+}
+
+inline static void onWriteBatchCheck(uv_check_t* handle)
+{
+	auto* connection = static_cast<TcpConnectionHandler*>(handle->data);
+
+	if (connection)
+		connection->OnUvWriteBatchFlush();
+}
+
 inline static void onClose(uv_handle_t* handle)
 {
 	delete handle;
 }
 
+inline static void onClosePrepare(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_prepare_t*>(handle);
+}
+
+inline static void onCloseCheck(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_check_t*>(handle);
+}
+
+// Call the given callbacks and delete them.
+inline static void completeCallbacks(
+  const std::function<void(bool sent)>* cb,
+  std::vector<const std::function<void(bool sent)>*>* batchCbs,
+  bool sent)
+{
+	if (cb)
+	{
+		(*cb)(sent);
+		delete cb;
+	}
+
+	if (batchCbs)
+	{
+		for (auto* batchCb : *batchCbs)
+		{
+			(*batchCb)(sent);
+			delete batchCb;
+		}
+
+		batchCbs->clear();
+	}
+}
+
 inline static void onShutdown(uv_shutdown_t* req, int /*status*/)
 {
 	auto* handle = req->handle;
@@ -87,11 +143,37 @@ void TcpConnectionHandler::Close()
 
 	int err;
 
+	// Write pending data in the write batch (if any) before closing.
+	if (this->writeBatchingEnabled)
+		FlushWriteBatch();
+
 	this->closed = true;
 
 	// Tell the UV handle that the TcpConnectionHandler has been closed.
 	this->uvHandle->data = nullptr;
 
+	if (this->uvWriteBatchPrepareHandle)
+	{
+		this->uvWriteBatchPrepareHandle->data = nullptr;
+
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(this->uvWriteBatchPrepareHandle),
+		  static_cast<uv_close_cb>(onClosePrepare));
+
+		this->uvWriteBatchPrepareHandle = nullptr;
+	}
+
+	if (this->uvWriteBatchCheckHandle)
+	{
+		this->uvWriteBatchCheckHandle->data = nullptr;
+
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(this->uvWriteBatchCheckHandle),
+		  static_cast<uv_close_cb>(onCloseCheck));
+
+		this->uvWriteBatchCheckHandle = nullptr;
+	}
+
 	// Don't read more.
 	err = uv_read_stop(reinterpret_cast<uv_stream_t*>(this->uvHandle));
 
@@ -126,6 +208,17 @@ void TcpConnectionHandler::Dump() const
 	MS_DUMP("  remoteIp   : %s", this->peerIp.c_str());
 	MS_DUMP("  remotePort : %" PRIu16, static_cast<uint16_t>(this->peerPort));
 	MS_DUMP("  closed     : %s", !this->closed ? "open" : "closed");
+	MS_DUMP("  batching   : %s", this->writeBatchingEnabled ? "yes" : "no");
+
+	if (this->writeBatchingEnabled)
+	{
+		MS_DUMP("  flushes    : %zu", this->writeBatchFlushes);
+		MS_DUMP("  items      : %zu", this->writeBatchItems);
+	}
+
+	MS_DUMP("  queued     : %zu", this->queuedWrites);
+	MS_DUMP("  queueSize  : %zu", this->uvHandle ? this->uvHandle->write_queue_size : 0u);
+	MS_DUMP("  maxQueue   : %zu", this->maxWriteQueueSize);
 	MS_DUMP("</TcpConnectionHandler>");
 }
 
@@ -205,17 +298,160 @@ void TcpConnectionHandler::Write(
 		return;
 	}
 
-	const size_t totalLen = len1 + len2;
+	// If write batching is enabled, append the data to the batch. It will be
+	// written at the end of the current loop iteration.
+	// NOTE: Data written while the batch is being flushed (from a send callback)
+	// is directly written.
+	if (this->writeBatchingEnabled && !this->flushingWriteBatch)
+	{
+		// Flush the batch if there is no room for the data.
+		if (this->writeBatchBuffer.size() + len1 + len2 > WriteBatchMaxSize)
+			FlushWriteBatch();
+
+		// Start flush handles when the first data is queued. The prepare handle
+		// flushes data queued by timers (before the loop blocks for I/O) and the
+		// check handle flushes data queued by I/O callbacks.
+		if (this->writeBatchBuffer.empty())
+		{
+			uv_prepare_start(
+			  this->uvWriteBatchPrepareHandle, static_cast<uv_prepare_cb>(onWriteBatchPrepare));
+			uv_check_start(this->uvWriteBatchCheckHandle, static_cast<uv_check_cb>(onWriteBatchCheck));
+		}
+
+		this->writeBatchBuffer.insert(this->writeBatchBuffer.end(), data1, data1 + len1);
+		this->writeBatchBuffer.insert(this->writeBatchBuffer.end(), data2, data2 + len2);
+
+		if (cb)
+			this->writeBatchCbs.push_back(cb);
+
+		this->writeBatchItems++;
+
+		return;
+	}
+
 	uv_buf_t buffers[2];
+
+	buffers[0] = uv_buf_init(reinterpret_cast<char*>(const_cast<uint8_t*>(data1)), len1);
+	buffers[1] = uv_buf_init(reinterpret_cast<char*>(const_cast<uint8_t*>(data2)), len2);
+
+	WriteBuffers(buffers, 2, cb, nullptr);
+}
+
+void TcpConnectionHandler::SetWriteBatching(bool enabled)
+{
+	MS_TRACE();
+
+	if (enabled == this->writeBatchingEnabled)
+		return;
+
+	if (!enabled)
+	{
+		// Write pending data first.
+		FlushWriteBatch();
+
+		this->writeBatchingEnabled = false;
+
+		return;
+	}
+
+	if (this->closed)
+		return;
+
+	int err;
+
+	if (!this->uvWriteBatchPrepareHandle)
+	{
+		this->uvWriteBatchPrepareHandle       = new uv_prepare_t;
+		this->uvWriteBatchPrepareHandle->data = static_cast<void*>(this);
+
+		err = uv_prepare_init(DepLibUV::GetLoop(), this->uvWriteBatchPrepareHandle);
+
+		if (err != 0)
+		{
+			delete this->uvWriteBatchPrepareHandle;
+			this->uvWriteBatchPrepareHandle = nullptr;
+
+			MS_THROW_ERROR("uv_prepare_init() failed: %s", uv_strerror(err));
+		}
+
+		// The prepare handle must not keep the loop alive.
+		uv_unref(reinterpret_cast<uv_handle_t*>(this->uvWriteBatchPrepareHandle));
+	}
+
+	if (!this->uvWriteBatchCheckHandle)
+	{
+		this->uvWriteBatchCheckHandle       = new uv_check_t;
+		this->uvWriteBatchCheckHandle->data = static_cast<void*>(this);
+
+		err = uv_check_init(DepLibUV::GetLoop(), this->uvWriteBatchCheckHandle);
+
+		if (err != 0)
+		{
+			delete this->uvWriteBatchCheckHandle;
+			this->uvWriteBatchCheckHandle = nullptr;
+
+			MS_THROW_ERROR("uv_check_init() failed: %s", uv_strerror(err));
+		}
+
+		// The check handle must not keep the loop alive.
+		uv_unref(reinterpret_cast<uv_handle_t*>(this->uvWriteBatchCheckHandle));
+	}
+
+	this->writeBatchBuffer.reserve(WriteBatchMaxSize);
+
+	this->writeBatchingEnabled = true;
+}
+
+void TcpConnectionHandler::FlushWriteBatch()
+{
+	MS_TRACE();
+
+	// NOTE: A callback called while flushing may close the connection.
+	if (this->writeBatchBuffer.empty() || this->flushingWriteBatch)
+		return;
+
+	uv_prepare_stop(this->uvWriteBatchPrepareHandle);
+	uv_check_stop(this->uvWriteBatchCheckHandle);
+
+	this->flushingWriteBatch = true;
+	this->writeBatchFlushes++;
+
+	const uv_buf_t buffer = uv_buf_init(
+	  reinterpret_cast<char*>(this->writeBatchBuffer.data()), this->writeBatchBuffer.size());
+
+	// Callbacks may write again, so take them (and the data) out of the batch
+	// first.
+	std::vector<TcpConnectionHandler::onSendCallback*> batchCbs;
+
+	batchCbs.swap(this->writeBatchCbs);
+
+	WriteBuffers(std::addressof(buffer), 1, nullptr, std::addressof(batchCbs));
+
+	this->writeBatchBuffer.clear();
+	this->flushingWriteBatch = false;
+}
+
+void TcpConnectionHandler::WriteBuffers(
+  const uv_buf_t* buffers,
+  size_t numBuffers,
+  TcpConnectionHandler::onSendCallback* cb,
+  std::vector<TcpConnectionHandler::onSendCallback*>* batchCbs)
+{
+	MS_TRACE();
+
+	size_t totalLen{ 0 };
 	int written{ 0 };
 	int err;
 
+	for (size_t i{ 0 }; i < numBuffers; ++i)
+	{
+		totalLen += buffers[i].len;
+	}
+
 	// First try uv_try_write(). In case it can not directly write all the given
 	// data then build a uv_req_t and use uv_write().
 
-	buffers[0] = uv_buf_init(reinterpret_cast<char*>(const_cast<uint8_t*>(data1)), len1);
-	buffers[1] = uv_buf_init(reinterpret_cast<char*>(const_cast<uint8_t*>(data2)), len2);
-	written    = uv_try_write(reinterpret_cast<uv_stream_t*>(this->uvHandle), buffers, 2);
+	written = uv_try_write(reinterpret_cast<uv_stream_t*>(this->uvHandle), buffers, numBuffers);
 
 	// All the data was written. Done.
 	if (written == static_cast<int>(totalLen))
@@ -223,17 +459,15 @@ void TcpConnectionHandler::Write(
 		// Update sent bytes.
 		this->sentBytes += written;
 
-		if (cb)
-		{
-			(*cb)(true);
-			delete cb;
-		}
+		completeCallbacks(cb, batchCbs, true);
 
 		return;
 	}
 	// Cannot write any data at first time. Use uv_write().
 	else if (written == UV_EAGAIN || written == UV_ENOSYS)
 	{
+		Metrics::Increment(Metrics::Counter::TCP_SEND_EAGAIN);
+
 		// Set written to 0 so pendingLen can be properly calculated.
 		written = 0;
 	}
@@ -246,29 +480,38 @@ void TcpConnectionHandler::Write(
 		written = 0;
 	}
 
+	this->queuedWrites++;
+
 	const size_t pendingLen = totalLen - written;
 	auto* writeData         = new UvWriteData(pendingLen);
+	size_t skipLen          = static_cast<size_t>(written);
+	size_t storeLen{ 0 };
 
 	writeData->req.data = static_cast<void*>(writeData);
 
-	// If the first buffer was not entirely written then splice it.
-	if (static_cast<size_t>(written) < len1)
+	// Copy the pending data of each buffer (skipping the written one).
+	for (size_t i{ 0 }; i < numBuffers; ++i)
 	{
-		std::memcpy(
-		  writeData->store, data1 + static_cast<size_t>(written), len1 - static_cast<size_t>(written));
-		std::memcpy(writeData->store + (len1 - static_cast<size_t>(written)), data2, len2);
-	}
-	// Otherwise just take the pending data in the second buffer.
-	else
-	{
-		std::memcpy(
-		  writeData->store,
-		  data2 + (static_cast<size_t>(written) - len1),
-		  len2 - (static_cast<size_t>(written) - len1));
+		const auto& buffer = buffers[i];
+
+		if (skipLen >= buffer.len)
+		{
+			skipLen -= buffer.len;
+
+			continue;
+		}
+
+		std::memcpy(writeData->store + storeLen, buffer.base + skipLen, buffer.len - skipLen);
+
+		storeLen += buffer.len - skipLen;
+		skipLen = 0;
 	}
 
 	writeData->cb = cb;
 
+	if (batchCbs)
+		writeData->batchCbs.swap(*batchCbs);
+
 	const uv_buf_t buffer = uv_buf_init(reinterpret_cast<char*>(writeData->store), pendingLen);
 
 	err = uv_write(
@@ -282,16 +525,20 @@ void TcpConnectionHandler::Write(
 	{
 		MS_WARN_DEV("uv_write() failed: %s", uv_strerror(err));
 
-		if (cb)
-			(*cb)(false);
+		completeCallbacks(writeData->cb, std::addressof(writeData->batchCbs), false);
+
+		writeData->cb = nullptr;
 
-		// Delete the UvWriteData struct (it will delete the store and cb too).
+		// Delete the UvWriteData struct (it will delete the store too).
 		delete writeData;
 	}
 	else
 	{
 		// Update sent bytes.
 		this->sentBytes += pendingLen;
+
+		if (this->uvHandle->write_queue_size > this->maxWriteQueueSize)
+			this->maxWriteQueueSize = this->uvHandle->write_queue_size;
 	}
 }
 
@@ -399,16 +646,23 @@ inline void TcpConnectionHandler::OnUvRead(ssize_t nread, const uv_buf_t* /*buf*
 	}
 }
 
-inline void TcpConnectionHandler::OnUvWrite(int status, TcpConnectionHandler::onSendCallback* cb)
+inline void TcpConnectionHandler::OnUvWrite(
+  int status, TcpConnectionHandler::UvWriteData* writeData)
 {
 	MS_TRACE();
 
-	// NOTE: Do not delete cb here since it will be delete in onWrite() above.
+	// NOTE: Do not delete cbs here since they will be deleted in onWrite() above.
+	auto* cb = writeData->cb;
 
 	if (status == 0)
 	{
 		if (cb)
 			(*cb)(true);
+
+		for (auto* batchCb : writeData->batchCbs)
+		{
+			(*batchCb)(true);
+		}
 	}
 	else
 	{
@@ -420,8 +674,20 @@ inline void TcpConnectionHandler::OnUvWrite(int status, TcpConnectionHandler::on
 		if (cb)
 			(*cb)(false);
 
+		for (auto* batchCb : writeData->batchCbs)
+		{
+			(*batchCb)(false);
+		}
+
 		Close();
 
 		this->listener->OnTcpConnectionClosed(this);
 	}
 }
+
+inline void TcpConnectionHandler::OnUvWriteBatchFlush()
+{
+	MS_TRACE();
+
+	FlushWriteBatch();
+}
@@ -2,40 +2,16 @@
 // #define MS_LOG_DEV_LEVEL 3
 
 #include "handles/Timer.hpp"
-#include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 
-/* Static methods for UV callbacks. */
-
-inline static void onTimer(uv_timer_t* handle)
-{
-	static_cast<Timer*>(handle->data)->OnUvTimer();
-}
-
-inline static void onClose(uv_handle_t* handle)
-{
-	delete handle;
-}
-
 /* Instance methods. */
 
 Timer::Timer(Listener* listener) : listener(listener)
 {
 	MS_TRACE();
 
-	this->uvHandle       = new uv_timer_t;
-	this->uvHandle->data = static_cast<void*>(this);
-
-	const int err = uv_timer_init(DepLibUV::GetLoop(), this->uvHandle);
-
-	if (err != 0)
-	{
-		delete this->uvHandle;
-		this->uvHandle = nullptr;
-
-		MS_THROW_ERROR("uv_timer_init() failed: %s", uv_strerror(err));
-	}
+	TimerWheel::AddTimer(this);
 }
 
 Timer::~Timer()
@@ -46,6 +22,8 @@ Timer::~Timer()
 	{
 		Close();
 	}
+
+	TimerWheel::RemoveTimer(this);
 }
 
 void Timer::Close()
@@ -59,7 +37,7 @@ void Timer::Close()
 
 	this->closed = true;
 
-	uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
+	TimerWheel::Remove(this);
 }
 
 void Timer::Start(uint64_t timeout, uint64_t repeat)
@@ -74,17 +52,7 @@ void Timer::Start(uint64_t timeout, uint64_t repeat)
 	this->timeout = timeout;
 	this->repeat  = repeat;
 
-	if (uv_is_active(reinterpret_cast<uv_handle_t*>(this->uvHandle)) != 0)
-	{
-		Stop();
-	}
-
-	const int err = uv_timer_start(this->uvHandle, static_cast<uv_timer_cb>(onTimer), timeout, repeat);
-
-	if (err != 0)
-	{
-		MS_THROW_ERROR("uv_timer_start() failed: %s", uv_strerror(err));
-	}
+	TimerWheel::Insert(this, timeout);
 }
 
 void Timer::Stop()
@@ -96,12 +64,7 @@ void Timer::Stop()
 		MS_THROW_ERROR("closed");
 	}
 
-	const int err = uv_timer_stop(this->uvHandle);
-
-	if (err != 0)
-	{
-		MS_THROW_ERROR("uv_timer_stop() failed: %s", uv_strerror(err));
-	}
+	TimerWheel::Remove(this);
 }
 
 void Timer::Reset()
@@ -113,7 +76,7 @@ void Timer::Reset()
 		MS_THROW_ERROR("closed");
 	}
 
-	if (uv_is_active(reinterpret_cast<uv_handle_t*>(this->uvHandle)) == 0)
+	if (!IsActive())
 	{
 		return;
 	}
@@ -123,13 +86,7 @@ void Timer::Reset()
 		return;
 	}
 
-	const int err =
-	  uv_timer_start(this->uvHandle, static_cast<uv_timer_cb>(onTimer), this->repeat, this->repeat);
-
-	if (err != 0)
-	{
-		MS_THROW_ERROR("uv_timer_start() failed: %s", uv_strerror(err));
-	}
+	TimerWheel::Insert(this, this->repeat);
 }
 
 void Timer::Restart()
@@ -141,21 +98,10 @@ void Timer::Restart()
 		MS_THROW_ERROR("closed");
 	}
 
-	if (uv_is_active(reinterpret_cast<uv_handle_t*>(this->uvHandle)) != 0)
-	{
-		Stop();
-	}
-
-	const int err =
-	  uv_timer_start(this->uvHandle, static_cast<uv_timer_cb>(onTimer), this->timeout, this->repeat);
-
-	if (err != 0)
-	{
-		MS_THROW_ERROR("uv_timer_start() failed: %s", uv_strerror(err));
-	}
+	TimerWheel::Insert(this, this->timeout);
 }
 
-inline void Timer::OnUvTimer()
+void Timer::OnTimerWheelTimer()
 {
 	MS_TRACE();
 
@@ -0,0 +1,377 @@
+#define MS_CLASS "TimerWheel"
+// #define MS_LOG_DEV_LEVEL 3
+
+#include "handles/TimerWheel.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Metrics.hpp"
+#include "Utils.hpp"
+#include "handles/Timer.hpp"
+#include <algorithm> // std::max()
+
+/* Static. */
+
+static constexpr uint64_t NoEventMs{ UINT64_MAX };
+
+thread_local TimerWheel* TimerWheel::timerWheel{ nullptr };
+
+/* Static methods for UV callbacks. */
+
+inline static void onTimer(uv_timer_t* handle)
+{
+	static_cast<TimerWheel*>(handle->data)->OnUvTimer();
+}
+
+inline static void onClose(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_timer_t*>(handle);
+}
+
+/* Class methods. */
+
+void TimerWheel::AddTimer(Timer* /*timer*/)
+{
+	MS_TRACE();
+
+	if (!TimerWheel::timerWheel)
+		TimerWheel::timerWheel = new TimerWheel();
+
+	TimerWheel::timerWheel->numTimers++;
+}
+
+void TimerWheel::RemoveTimer(Timer* timer)
+{
+	MS_TRACE();
+
+	auto* wheel = TimerWheel::timerWheel;
+
+	if (timer->slot)
+		wheel->Unlink(timer);
+
+	// If this happens within a Timer callback, the wheel is deleted once done.
+	if (--wheel->numTimers == 0u && !wheel->processing)
+	{
+		delete wheel;
+		TimerWheel::timerWheel = nullptr;
+	}
+}
+
+void TimerWheel::Insert(Timer* timer, uint64_t timeoutMs)
+{
+	MS_TRACE();
+
+	auto* wheel      = TimerWheel::timerWheel;
+	const auto nowMs = uv_now(DepLibUV::GetLoop());
+
+	if (timer->slot)
+		wheel->Unlink(timer);
+
+	// Nothing pending up to now, so the current time can be moved forward and
+	// the Timer be placed in the lowest possible level.
+	if (!wheel->processing && nowMs > wheel->currentMs && wheel->GetNextEventMs() > nowMs)
+	{
+		wheel->currentMs = nowMs;
+	}
+
+	// Timers started within a Timer callback don't expire in the same run.
+	const auto minExpiresAtMs = (wheel->processing ? nowMs : wheel->currentMs) + 1;
+
+	timer->expiresAtMs = std::max(nowMs + timeoutMs, minExpiresAtMs);
+
+	wheel->Place(timer);
+
+	// Otherwise it's scheduled once all expired Timers are processed.
+	if (!wheel->processing)
+		wheel->Schedule();
+}
+
+void TimerWheel::Remove(Timer* timer)
+{
+	MS_TRACE();
+
+	// NOTE: The uv_timer_t is not stopped. If it fires for nothing it will be
+	// just rescheduled.
+	if (timer->slot)
+		TimerWheel::timerWheel->Unlink(timer);
+}
+
+/* Instance methods. */
+
+TimerWheel::TimerWheel()
+{
+	MS_TRACE();
+
+	this->uvHandle       = new uv_timer_t;
+	this->uvHandle->data = static_cast<void*>(this);
+
+	const int err = uv_timer_init(DepLibUV::GetLoop(), this->uvHandle);
+
+	if (err != 0)
+	{
+		delete this->uvHandle;
+		this->uvHandle = nullptr;
+
+		MS_THROW_ERROR("uv_timer_init() failed: %s", uv_strerror(err));
+	}
+
+	this->currentMs   = uv_now(DepLibUV::GetLoop());
+	this->scheduledMs = NoEventMs;
+}
+
+TimerWheel::~TimerWheel()
+{
+	MS_TRACE();
+
+	uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
+}
+
+inline void TimerWheel::Link(Slot* slot, Timer* timer)
+{
+	MS_TRACE();
+
+	timer->slot = slot;
+	timer->prev = nullptr;
+	timer->next = slot->head;
+
+	if (slot->head)
+		slot->head->prev = timer;
+
+	slot->head = timer;
+
+	if (slot != &this->overflow && slot != &this->expired)
+	{
+		const auto idx = static_cast<size_t>(slot - &this->slots[0][0]);
+
+		this->occupied[idx / SlotsPerLevel] |= uint64_t{ 1u } << (idx % SlotsPerLevel);
+	}
+}
+
+inline void TimerWheel::Unlink(Timer* timer)
+{
+	MS_TRACE();
+
+	auto* slot = timer->slot;
+
+	if (timer->prev)
+		timer->prev->next = timer->next;
+	else
+		slot->head = timer->next;
+
+	if (timer->next)
+		timer->next->prev = timer->prev;
+
+	timer->slot = nullptr;
+	timer->prev = nullptr;
+	timer->next = nullptr;
+
+	if (!slot->head && slot != &this->overflow && slot != &this->expired)
+	{
+		const auto idx = static_cast<size_t>(slot - &this->slots[0][0]);
+
+		this->occupied[idx / SlotsPerLevel] &= ~(uint64_t{ 1u } << (idx % SlotsPerLevel));
+	}
+}
+
+inline void TimerWheel::Place(Timer* timer)
+{
+	MS_TRACE();
+
+	if (timer->expiresAtMs <= this->currentMs)
+	{
+		Link(&this->expired, timer);
+
+		return;
+	}
+
+	// Level of the most significant bit in which the expiration time differs
+	// from current time.
+	const auto diff  = timer->expiresAtMs ^ this->currentMs;
+	const auto level = Utils::Bits::GetHighestSetBit(diff) / LevelBits;
+
+	if (level >= NumLevels)
+	{
+		Link(&this->overflow, timer);
+
+		return;
+	}
+
+	const auto idx = (timer->expiresAtMs >> (level * LevelBits)) & (SlotsPerLevel - 1);
+
+	Link(&this->slots[level][idx], timer);
+}
+
+uint64_t TimerWheel::GetNextEventMs() const
+{
+	MS_TRACE();
+
+	if (this->expired.head)
+		return this->currentMs;
+
+	// Occupied slots are always ahead of the current time in their level, and
+	// any slot in a level is later than all the slots in lower levels.
+	for (size_t level{ 0u }; level < NumLevels; ++level)
+	{
+		if (this->occupied[level] == 0u)
+			continue;
+
+		const auto shift = level * LevelBits;
+		const auto idx   = static_cast<uint64_t>(Utils::Bits::GetLowestSetBit(this->occupied[level]));
+		const auto base  = (this->currentMs >> (shift + LevelBits)) << (shift + LevelBits);
+
+		return base | (idx << shift);
+	}
+
+	if (this->overflow.head)
+	{
+		const auto shift = NumLevels * LevelBits;
+
+		return ((this->currentMs >> shift) + 1) << shift;
+	}
+
+	return NoEventMs;
+}
+
+void TimerWheel::Advance(uint64_t nowMs)
+{
+	MS_TRACE();
+
+	uint64_t nextMs;
+
+	while ((nextMs = GetNextEventMs()) <= nowMs)
+	{
+		this->currentMs = nextMs;
+
+		Process();
+
+		while (this->expired.head)
+		{
+			auto* timer = this->expired.head;
+
+			Unlink(timer);
+
+			// As libuv does, repeating timers are started again before calling the
+			// listener.
+			if (timer->repeat != 0u)
+			{
+				timer->expiresAtMs = std::max(nowMs + timer->repeat, this->currentMs + 1);
+
+				Place(timer);
+			}
+
+			// NOTE: The listener may delete this or any other Timer.
+			timer->OnTimerWheelTimer();
+		}
+	}
+
+	this->currentMs = nowMs;
+}
+
+inline void TimerWheel::Process()
+{
+	MS_TRACE();
+
+	// Move the Timers in the slots reached at current time to lower levels (or
+	// to the expired list).
+	for (size_t level{ NumLevels }; level-- > 0u;)
+	{
+		const auto shift = level * LevelBits;
+		const auto idx   = (this->currentMs >> shift) & (SlotsPerLevel - 1);
+		const auto mask  = (uint64_t{ 1u } << shift) - 1;
+
+		if ((this->currentMs & mask) != 0u || (this->occupied[level] & (uint64_t{ 1u } << idx)) == 0u)
+			continue;
+
+		auto* timer = this->slots[level][idx].head;
+
+		this->slots[level][idx].head = nullptr;
+		this->occupied[level] &= ~(uint64_t{ 1u } << idx);
+
+		while (timer)
+		{
+			auto* next = timer->next;
+
+			timer->slot = nullptr;
+
+			Place(timer);
+
+			timer = next;
+		}
+	}
+
+	const auto overflowMask = (uint64_t{ 1u } << (NumLevels * LevelBits)) - 1;
+
+	if (this->overflow.head && (this->currentMs & overflowMask) == 0u)
+	{
+		auto* timer = this->overflow.head;
+
+		this->overflow.head = nullptr;
+
+		while (timer)
+		{
+			auto* next = timer->next;
+
+			timer->slot = nullptr;
+
+			Place(timer);
+
+			timer = next;
+		}
+	}
+}
+
+void TimerWheel::Schedule()
+{
+	MS_TRACE();
+
+	const auto nextMs = GetNextEventMs();
+
+	if (nextMs == this->scheduledMs)
+		return;
+
+	this->scheduledMs = nextMs;
+
+	if (nextMs == NoEventMs)
+	{
+		uv_timer_stop(this->uvHandle);
+
+		return;
+	}
+
+	const auto nowMs   = uv_now(DepLibUV::GetLoop());
+	const auto timeout = nextMs > nowMs ? nextMs - nowMs : 0u;
+
+	const int err = uv_timer_start(this->uvHandle, static_cast<uv_timer_cb>(onTimer), timeout, 0u);
+
+	if (err != 0)
+		MS_THROW_ERROR("uv_timer_start() failed: %s", uv_strerror(err));
+}
+
+inline void TimerWheel::OnUvTimer()
+{
+	MS_TRACE();
+
+	const auto nowMs = uv_now(DepLibUV::GetLoop());
+
+	// How late the loop runs the nearest Timer (in the same clock it was
+	// scheduled with).
+	Metrics::ObserveLoopLag(nowMs > this->scheduledMs ? (nowMs - this->scheduledMs) * 1000u : 0u);
+
+	this->scheduledMs = NoEventMs;
+	this->processing  = true;
+
+	Advance(nowMs);
+
+	this->processing = false;
+
+	// All Timers were deleted by their listeners.
+	if (this->numTimers == 0u)
+	{
+		delete this;
+		TimerWheel::timerWheel = nullptr;
+
+		return;
+	}
+
+	Schedule();
+}
@@ -2,15 +2,75 @@
 // #define MS_LOG_DEV_LEVEL 3
 
 #include "handles/UdpSocketHandler.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "Metrics.hpp"
 #include "Utils.hpp"
-#include <cstring> // std::memcpy()
+#include <cstring> // std::memcpy(), std::memset(), std::strerror()
+#ifdef __linux__
+#include <linux/filter.h> // struct sock_fprog
+#include <netinet/udp.h>  // UDP_SEGMENT
+#include <cerrno>
+#endif
 
 /* Static. */
 
 static constexpr size_t ReadBufferSize{ 65536 };
 thread_local static uint8_t ReadBuffer[ReadBufferSize];
+// Max number of datagrams that libuv reads with a single recvmmsg() call
+// (UV__MMSG_MAXWIDTH in libuv). Each one needs its own ReadBufferSize slot
+// (UV__UDP_DGRAM_MAXSIZE in libuv).
+static constexpr size_t RecvBatchMaxDatagrams{ 20 };
+// Buffer with as many slots as the biggest recv batch size in this thread.
+thread_local static std::vector<uint8_t> RecvBatchBuffer;
+// Max number of datagrams held in the send batch of a socket. The batch is
+// flushed once this limit is reached.
+static constexpr size_t SendBatchMaxDatagrams{ 64 };
+#ifdef __linux__
+// Max total size of a GSO message (it must fit into a single IP packet before
+// segmentation).
+static constexpr size_t SendBatchGsoMaxSize{ 65000 };
+// Max number of segments in a GSO message (UDP_MAX_SEGMENTS in Linux).
+static constexpr size_t SendBatchGsoMaxSegments{ 64 };
+
+union SendBatchCmsg
+{
+	uint8_t buf[CMSG_SPACE(sizeof(uint16_t))];
+	struct cmsghdr align;
+};
+
+thread_local static struct mmsghdr SendBatchMsgs[SendBatchMaxDatagrams];
+// An iovec per datagram (a GSO message points to several of them).
+thread_local static struct iovec SendBatchIovecs[SendBatchMaxDatagrams];
+thread_local static union SendBatchCmsg SendBatchCmsgs[SendBatchMaxDatagrams];
+// Index of the first datagram in the send batch and number of datagrams
+// carried by each message.
+thread_local static size_t SendBatchMsgFirstItems[SendBatchMaxDatagrams];
+thread_local static size_t SendBatchMsgNumItems[SendBatchMaxDatagrams];
+#endif
+
+// Size of the store of pooled UvSendData structs. It fits a MTU sized packet
+// plus the SRTP trailer. Bigger datagrams get a dedicated UvSendData.
+static constexpr size_t SendDataPoolStoreSize{ 2048 };
+// Max number of idle UvSendData structs kept in the pool of a thread.
+static constexpr size_t SendDataPoolMaxSize{ 4096 };
+
+// Idle UvSendData structs ready to be reused.
+struct UvSendDataPool
+{
+	~UvSendDataPool()
+	{
+		for (auto* sendData : this->items)
+		{
+			delete sendData;
+		}
+	}
+
+	std::vector<UdpSocketHandler::UvSendData*> items;
+};
+
+thread_local static UvSendDataPool SendDataPool;
 
 /* Static methods for UV callbacks. */
 
@@ -41,8 +101,24 @@ inline static void onSend(uv_udp_send_t* req, int status)
 	if (socket)
 		socket->OnUvSend(status, cb);
 
-	// Delete the UvSendData struct (it will delete the store and cb too).
-	delete sendData;
+	// Give the UvSendData struct back to the pool (it will delete the cb).
+	UdpSocketHandler::ReleaseSendData(sendData);
+}
+
+inline static void onSendBatchPrepare(uv_prepare_t* handle)
+{
+	auto* socket = static_cast<UdpSocketHandler*>(handle->data);
+
+	if (socket)
+		socket->OnUvSendBatchFlush();
+}
+
+inline static void onSendBatchCheck(uv_check_t* handle)
+{
+	auto* socket = static_cast<UdpSocketHandler*>(handle->data);
+
+	if (socket)
+		socket->OnUvSendBatchFlush();
 }
 
 inline static void onClose(uv_handle_t* handle)
@@ -50,6 +126,77 @@ inline static void onClose(uv_handle_t* handle)
 	delete handle;
 }
 
+inline static void onClosePrepare(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_prepare_t*>(handle);
+}
+
+inline static void onCloseCheck(uv_handle_t* handle)
+{
+	delete reinterpret_cast<uv_check_t*>(handle);
+}
+
+/* Class methods. */
+
+bool UdpSocketHandler::IsSendBatchingSupported()
+{
+#ifdef __linux__
+	return true;
+#else
+	return false;
+#endif
+}
+
+size_t UdpSocketHandler::GetMaxRecvBatchSize()
+{
+	return RecvBatchMaxDatagrams;
+}
+
+UdpSocketHandler::UvSendData* UdpSocketHandler::AllocateSendData(size_t size)
+{
+	MS_TRACE();
+
+	UvSendData* sendData;
+
+	if (size > SendDataPoolStoreSize)
+	{
+		sendData = new UvSendData(size);
+	}
+	else if (!SendDataPool.items.empty())
+	{
+		sendData = SendDataPool.items.back();
+
+		SendDataPool.items.pop_back();
+	}
+	else
+	{
+		sendData = new UvSendData(SendDataPoolStoreSize);
+	}
+
+	sendData->req.data = static_cast<void*>(sendData);
+
+	return sendData;
+}
+
+void UdpSocketHandler::ReleaseSendData(UvSendData* sendData)
+{
+	MS_TRACE();
+
+	delete sendData->cb;
+
+	sendData->cb  = nullptr;
+	sendData->len = 0u;
+
+	if (sendData->storeSize != SendDataPoolStoreSize || SendDataPool.items.size() >= SendDataPoolMaxSize)
+	{
+		delete sendData;
+
+		return;
+	}
+
+	SendDataPool.items.push_back(sendData);
+}
+
 /* Instance methods. */
 
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
@@ -78,6 +225,15 @@ UdpSocketHandler::UdpSocketHandler(uv_udp_t* uvHandle) : uvHandle(uvHandle)
 
 		MS_THROW_ERROR("error setting local IP and port");
 	}
+
+	struct sockaddr_storage peerAddr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+	int peerAddrLen = sizeof(peerAddr);
+
+	// Check whether it's connected.
+	err = uv_udp_getpeername(
+	  this->uvHandle, reinterpret_cast<struct sockaddr*>(&peerAddr), &peerAddrLen);
+
+	this->connected = (err == 0);
 }
 
 UdpSocketHandler::~UdpSocketHandler()
@@ -95,11 +251,37 @@ void UdpSocketHandler::Close()
 	if (this->closed)
 		return;
 
+	// Send pending datagrams in the send batch (if any) before closing.
+	if (this->sendBatchingEnabled)
+		FlushSendBatch();
+
 	this->closed = true;
 
 	// Tell the UV handle that the UdpSocketHandler has been closed.
 	this->uvHandle->data = nullptr;
 
+	if (this->uvSendBatchPrepareHandle)
+	{
+		this->uvSendBatchPrepareHandle->data = nullptr;
+
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(this->uvSendBatchPrepareHandle),
+		  static_cast<uv_close_cb>(onClosePrepare));
+
+		this->uvSendBatchPrepareHandle = nullptr;
+	}
+
+	if (this->uvSendBatchCheckHandle)
+	{
+		this->uvSendBatchCheckHandle->data = nullptr;
+
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(this->uvSendBatchCheckHandle),
+		  static_cast<uv_close_cb>(onCloseCheck));
+
+		this->uvSendBatchCheckHandle = nullptr;
+	}
+
 	// Don't read more.
 	const int err = uv_udp_recv_stop(this->uvHandle);
 
@@ -115,6 +297,14 @@ void UdpSocketHandler::Dump() const
 	MS_DUMP("  localIp   : %s", this->localIp.c_str());
 	MS_DUMP("  localPort : %" PRIu16, static_cast<uint16_t>(this->localPort));
 	MS_DUMP("  closed    : %s", !this->closed ? "open" : "closed");
+	MS_DUMP("  recvBatch : %zu", this->recvBatchSize);
+	MS_DUMP("  batching  : %s", this->sendBatchingEnabled ? "yes" : "no");
+	if (this->sendBatchingEnabled)
+	{
+		MS_DUMP("  gso       : %s", this->sendBatchGsoEnabled ? "yes" : "no");
+		MS_DUMP("  flushes   : %zu", this->sendBatchFlushes);
+		MS_DUMP("  syscalls  : %zu", this->sendBatchSyscalls);
+	}
 	MS_DUMP("</UdpSocketHandler>");
 }
 
@@ -145,11 +335,379 @@ void UdpSocketHandler::Send(
 		return;
 	}
 
-	// First try uv_udp_try_send(). In case it can not directly send the datagram
-	// then build a uv_req_t and use uv_udp_send().
+	// If send batching is enabled, append the datagram to the batch. It will be
+	// sent at the end of the current loop iteration.
+	// NOTE: Datagrams sent while the batch is being flushed (from a send
+	// callback) are directly sent.
+	if (this->sendBatchingEnabled && !this->flushingSendBatch)
+	{
+		auto* sendData = UdpSocketHandler::AllocateSendData(len);
+
+		std::memcpy(sendData->store, data, len);
+		sendData->len = len;
+		sendData->cb  = cb;
+
+		QueueSendBatchItem(sendData, addr);
+
+		return;
+	}
+
+	if (TrySend(data, len, addr, cb))
+		return;
+
+	// The datagram must be copied since libuv sends it later.
+	auto* sendData = UdpSocketHandler::AllocateSendData(len);
+
+	std::memcpy(sendData->store, data, len);
+	sendData->len = len;
+	sendData->cb  = cb;
+
+	SendQueued(sendData, addr);
+}
+
+void UdpSocketHandler::Send(
+  UdpSocketHandler::UvSendData* sendData, const struct sockaddr* addr, UdpSocketHandler::onSendCallback* cb)
+{
+	MS_TRACE();
+
+	sendData->cb = cb;
+
+	if (this->closed || sendData->len == 0)
+	{
+		if (cb)
+			(*cb)(false);
+
+		// Give the UvSendData struct back to the pool (it will delete the cb).
+		UdpSocketHandler::ReleaseSendData(sendData);
+
+		return;
+	}
+
+	// If send batching is enabled, append the datagram to the batch. It will be
+	// sent at the end of the current loop iteration.
+	if (this->sendBatchingEnabled && !this->flushingSendBatch)
+	{
+		QueueSendBatchItem(sendData, addr);
+
+		return;
+	}
+
+	SendDirect(sendData, addr);
+}
+
+void UdpSocketHandler::SetSendBatching(bool enabled)
+{
+	MS_TRACE();
+
+	if (enabled == this->sendBatchingEnabled)
+		return;
+
+	if (!enabled)
+	{
+		// Send pending datagrams first.
+		FlushSendBatch();
+
+		this->sendBatchingEnabled = false;
+
+		return;
+	}
+
+	if (!UdpSocketHandler::IsSendBatchingSupported())
+	{
+		MS_WARN_TAG(info, "UDP send batching not supported in this platform, ignoring it");
+
+		return;
+	}
+
+	if (this->closed)
+		return;
+
+	int err;
+
+	if (!this->uvSendBatchPrepareHandle)
+	{
+		this->uvSendBatchPrepareHandle       = new uv_prepare_t;
+		this->uvSendBatchPrepareHandle->data = static_cast<void*>(this);
+
+		err = uv_prepare_init(DepLibUV::GetLoop(), this->uvSendBatchPrepareHandle);
+
+		if (err != 0)
+		{
+			delete this->uvSendBatchPrepareHandle;
+			this->uvSendBatchPrepareHandle = nullptr;
+
+			MS_THROW_ERROR("uv_prepare_init() failed: %s", uv_strerror(err));
+		}
+
+		// The prepare handle must not keep the loop alive.
+		uv_unref(reinterpret_cast<uv_handle_t*>(this->uvSendBatchPrepareHandle));
+	}
+
+	if (!this->uvSendBatchCheckHandle)
+	{
+		this->uvSendBatchCheckHandle       = new uv_check_t;
+		this->uvSendBatchCheckHandle->data = static_cast<void*>(this);
+
+		err = uv_check_init(DepLibUV::GetLoop(), this->uvSendBatchCheckHandle);
+
+		if (err != 0)
+		{
+			delete this->uvSendBatchCheckHandle;
+			this->uvSendBatchCheckHandle = nullptr;
+
+			MS_THROW_ERROR("uv_check_init() failed: %s", uv_strerror(err));
+		}
+
+		// The check handle must not keep the loop alive.
+		uv_unref(reinterpret_cast<uv_handle_t*>(this->uvSendBatchCheckHandle));
+	}
+
+	this->sendBatchItems.reserve(SendBatchMaxDatagrams);
+
+#if defined(__linux__) && defined(UDP_SEGMENT)
+	this->sendBatchGsoEnabled = true;
+#endif
+
+	this->sendBatchingEnabled = true;
+}
+
+void UdpSocketHandler::SetRecvBatchSize(size_t size)
+{
+	MS_TRACE();
+
+	if (size == 0u || size > RecvBatchMaxDatagrams)
+		MS_THROW_TYPE_ERROR("invalid recv batch size %zu", size);
+
+	this->recvBatchSize = size;
+
+	// Make room for the required number of slots.
+	if (RecvBatchBuffer.size() < size * ReadBufferSize)
+		RecvBatchBuffer.resize(size * ReadBufferSize);
+}
+
+void UdpSocketHandler::FlushSendBatch()
+{
+	MS_TRACE();
+
+	if (this->sendBatchItems.empty())
+		return;
+
+	uv_prepare_stop(this->uvSendBatchPrepareHandle);
+	uv_check_stop(this->uvSendBatchCheckHandle);
+
+	this->flushingSendBatch = true;
+	this->sendBatchFlushes++;
+
+#ifdef __linux__
+	uv_os_fd_t fd;
+	const int err = uv_fileno(reinterpret_cast<const uv_handle_t*>(this->uvHandle), &fd);
+
+	// If libuv has datagrams waiting in its send queue they must be sent first,
+	// so let libuv also queue the datagrams in the batch.
+	if (err != 0 || this->uvHandle->send_queue_count > 0)
+	{
+		SendBatchFallback(0);
+
+		return;
+	}
+
+	const size_t numItems = this->sendBatchItems.size();
+	size_t numMsgs{ 0 };
+	size_t itemIdx{ 0 };
+
+	// Build a message per datagram. If GSO is enabled, consecutive datagrams
+	// with same destination and same size (the last one may be smaller) are
+	// carried into a single message to be segmented by the kernel.
+	while (itemIdx < numItems)
+	{
+		auto& firstItem = this->sendBatchItems[itemIdx];
+		size_t numSegments{ 1 };
+		size_t msgLen{ firstItem.sendData->len };
+
+		while (this->sendBatchGsoEnabled && itemIdx + numSegments < numItems)
+		{
+			const auto& prevItem = this->sendBatchItems[itemIdx + numSegments - 1];
+			const auto& nextItem = this->sendBatchItems[itemIdx + numSegments];
+
+			// clang-format off
+			if (
+				prevItem.sendData->len != firstItem.sendData->len ||
+				nextItem.sendData->len > firstItem.sendData->len ||
+				msgLen + nextItem.sendData->len > SendBatchGsoMaxSize ||
+				numSegments == SendBatchGsoMaxSegments ||
+				!Utils::IP::CompareAddresses(
+				  reinterpret_cast<const struct sockaddr*>(&firstItem.addr),
+				  reinterpret_cast<const struct sockaddr*>(&nextItem.addr))
+			)
+			// clang-format on
+			{
+				break;
+			}
+
+			msgLen += nextItem.sendData->len;
+			numSegments++;
+		}
+
+		auto& msg = SendBatchMsgs[numMsgs];
+
+		std::memset(std::addressof(msg), 0, sizeof(msg));
+
+		// Point to the store of each datagram so they are not copied.
+		for (size_t i{ itemIdx }; i < itemIdx + numSegments; ++i)
+		{
+			auto& iovec = SendBatchIovecs[i];
+
+			iovec.iov_base = this->sendBatchItems[i].sendData->store;
+			iovec.iov_len  = this->sendBatchItems[i].sendData->len;
+		}
+
+		// Connected sockets just send to their peer.
+		if (!this->connected)
+		{
+			msg.msg_hdr.msg_name    = std::addressof(firstItem.addr);
+			msg.msg_hdr.msg_namelen = firstItem.addr.ss_family == AF_INET6
+			                            ? sizeof(struct sockaddr_in6)
+			                            : sizeof(struct sockaddr_in);
+		}
+
+		msg.msg_hdr.msg_iov    = SendBatchIovecs + itemIdx;
+		msg.msg_hdr.msg_iovlen = numSegments;
+
+#ifdef UDP_SEGMENT
+		if (numSegments > 1)
+		{
+			auto& cmsgBuffer = SendBatchCmsgs[numMsgs];
+
+			msg.msg_hdr.msg_control    = cmsgBuffer.buf;
+			msg.msg_hdr.msg_controllen = sizeof(cmsgBuffer.buf);
+
+			auto* cmsg       = CMSG_FIRSTHDR(std::addressof(msg.msg_hdr));
+			cmsg->cmsg_level = SOL_UDP;
+			cmsg->cmsg_type  = UDP_SEGMENT;
+			cmsg->cmsg_len   = CMSG_LEN(sizeof(uint16_t));
+
+			const auto segmentSize = static_cast<uint16_t>(firstItem.sendData->len);
+
+			std::memcpy(CMSG_DATA(cmsg), std::addressof(segmentSize), sizeof(segmentSize));
+		}
+#endif
+
+		SendBatchMsgFirstItems[numMsgs] = itemIdx;
+		SendBatchMsgNumItems[numMsgs]   = numSegments;
+
+		numMsgs++;
+		itemIdx += numSegments;
+	}
+
+	size_t msgIdx{ 0 };
+
+	while (msgIdx < numMsgs)
+	{
+		const int ret = sendmmsg(fd, SendBatchMsgs + msgIdx, numMsgs - msgIdx, 0);
+
+		this->sendBatchSyscalls++;
+
+		if (ret > 0)
+		{
+			for (size_t i{ msgIdx }; i < msgIdx + static_cast<size_t>(ret); ++i)
+			{
+				for (size_t j{ 0 }; j < SendBatchMsgNumItems[i]; ++j)
+				{
+					CompleteSendBatchItem(this->sendBatchItems[SendBatchMsgFirstItems[i] + j], true);
+				}
+			}
+
+			msgIdx += static_cast<size_t>(ret);
+
+			continue;
+		}
+
+		const int error = errno;
+
+		if (error == EINTR)
+			continue;
+
+		// Socket send buffer is full. Let libuv queue the remaining datagrams.
+		if (error == EAGAIN || error == EWOULDBLOCK || error == ENOBUFS)
+		{
+			Metrics::Increment(Metrics::Counter::UDP_SEND_EAGAIN);
+
+			SendBatchFallback(SendBatchMsgFirstItems[msgIdx]);
+
+			return;
+		}
+
+		// GSO not supported by the kernel or by the network device. Disable it and
+		// send the remaining datagrams without it.
+		if (SendBatchMsgNumItems[msgIdx] > 1 && (error == EIO || error == EINVAL || error == ENOPROTOOPT))
+		{
+			MS_WARN_DEV("sendmmsg() with GSO failed, disabling GSO: %s", std::strerror(error));
+
+			this->sendBatchGsoEnabled = false;
+
+			SendBatchFallback(SendBatchMsgFirstItems[msgIdx]);
+
+			return;
+		}
+
+		// Any other error just affects the first message so discard it and go on.
+		MS_WARN_DEV("sendmmsg() failed: %s", std::strerror(error));
+
+		for (size_t j{ 0 }; j < SendBatchMsgNumItems[msgIdx]; ++j)
+		{
+			CompleteSendBatchItem(this->sendBatchItems[SendBatchMsgFirstItems[msgIdx] + j], false);
+		}
+
+		msgIdx++;
+	}
+
+	this->sendBatchItems.clear();
+	this->flushingSendBatch = false;
+#else
+	SendBatchFallback(0);
+#endif
+}
+
+bool UdpSocketHandler::SetReusePortFilter(const struct sock_filter* filter, size_t len)
+{
+	MS_TRACE();
+
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+	if (this->closed)
+		return false;
+
+	uv_os_fd_t fd;
+	struct sock_fprog program; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+	if (uv_fileno(reinterpret_cast<uv_handle_t*>(this->uvHandle), &fd) != 0)
+		return false;
+
+	program.len    = static_cast<unsigned short>(len);
+	program.filter = const_cast<struct sock_filter*>(filter);
+
+	if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) != 0)
+	{
+		MS_WARN_TAG(info, "setsockopt(SO_ATTACH_REUSEPORT_CBPF) failed: %s", std::strerror(errno));
+
+		return false;
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool UdpSocketHandler::TrySend(
+  const uint8_t* data, size_t len, const struct sockaddr* addr, UdpSocketHandler::onSendCallback* cb)
+{
+	MS_TRACE();
+
+	// Try uv_udp_try_send(). In case it can not directly send the datagram the
+	// caller must use uv_udp_send().
 
 	uv_buf_t buffer = uv_buf_init(reinterpret_cast<char*>(const_cast<uint8_t*>(data)), len);
-	const int sent  = uv_udp_try_send(this->uvHandle, &buffer, 1, addr);
+	const int sent  = uv_udp_try_send(this->uvHandle, &buffer, 1, this->connected ? nullptr : addr);
 
 	// Entire datagram was sent. Done.
 	if (sent == static_cast<int>(len))
@@ -163,7 +721,7 @@ void UdpSocketHandler::Send(
 			delete cb;
 		}
 
-		return;
+		return true;
 	}
 	else if (sent >= 0)
 	{
@@ -178,24 +736,55 @@ void UdpSocketHandler::Send(
 			delete cb;
 		}
 
-		return;
+		return true;
+	}
+	else if (sent == UV_EAGAIN)
+	{
+		Metrics::Increment(Metrics::Counter::UDP_SEND_EAGAIN);
 	}
 	// Any error but legit EAGAIN. Use uv_udp_send().
-	else if (sent != UV_EAGAIN)
+	else
 	{
 		MS_WARN_DEV("uv_udp_try_send() failed, trying uv_udp_send(): %s", uv_strerror(sent));
 	}
 
-	auto* sendData = new UvSendData(len);
+	return false;
+}
+
+void UdpSocketHandler::SendDirect(UdpSocketHandler::UvSendData* sendData, const struct sockaddr* addr)
+{
+	MS_TRACE();
+
+	auto* cb = sendData->cb;
+
+	sendData->cb = nullptr;
+
+	if (TrySend(sendData->store, sendData->len, addr, cb))
+	{
+		UdpSocketHandler::ReleaseSendData(sendData);
+
+		return;
+	}
 
-	sendData->req.data = static_cast<void*>(sendData);
-	std::memcpy(sendData->store, data, len);
 	sendData->cb = cb;
 
-	buffer = uv_buf_init(reinterpret_cast<char*>(sendData->store), len);
+	SendQueued(sendData, addr);
+}
 
-	int err = uv_udp_send(
-	  &sendData->req, this->uvHandle, &buffer, 1, addr, static_cast<uv_udp_send_cb>(onSend));
+void UdpSocketHandler::SendQueued(UdpSocketHandler::UvSendData* sendData, const struct sockaddr* addr)
+{
+	MS_TRACE();
+
+	const size_t len = sendData->len;
+	uv_buf_t buffer  = uv_buf_init(reinterpret_cast<char*>(sendData->store), len);
+
+	const int err = uv_udp_send(
+	  &sendData->req,
+	  this->uvHandle,
+	  &buffer,
+	  1,
+	  this->connected ? nullptr : addr,
+	  static_cast<uv_udp_send_cb>(onSend));
 
 	if (err != 0)
 	{
@@ -203,11 +792,11 @@ void UdpSocketHandler::Send(
 		// (IPv6 destination on a IPv4 binded socket), so be ready.
 		MS_WARN_DEV("uv_udp_send() failed: %s", uv_strerror(err));
 
-		if (cb)
-			(*cb)(false);
+		if (sendData->cb)
+			(*sendData->cb)(false);
 
-		// Delete the UvSendData struct (it will delete the store and cb too).
-		delete sendData;
+		// Give the UvSendData struct back to the pool (it will delete the cb).
+		UdpSocketHandler::ReleaseSendData(sendData);
 	}
 	else
 	{
@@ -216,6 +805,66 @@ void UdpSocketHandler::Send(
 	}
 }
 
+void UdpSocketHandler::QueueSendBatchItem(
+  UdpSocketHandler::UvSendData* sendData, const struct sockaddr* addr)
+{
+	MS_TRACE();
+
+	// Flush the batch if it's full.
+	if (this->sendBatchItems.size() == SendBatchMaxDatagrams)
+		FlushSendBatch();
+
+	// Start flush handles when the first datagram is queued. The prepare handle
+	// flushes datagrams queued by timers (before the loop blocks for I/O) and
+	// the check handle flushes those queued by I/O callbacks.
+	if (this->sendBatchItems.empty())
+	{
+		uv_prepare_start(this->uvSendBatchPrepareHandle, static_cast<uv_prepare_cb>(onSendBatchPrepare));
+		uv_check_start(this->uvSendBatchCheckHandle, static_cast<uv_check_cb>(onSendBatchCheck));
+	}
+
+	SendBatchItem item; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+	item.sendData = sendData;
+	item.addr     = Utils::IP::CopyAddress(addr);
+
+	this->sendBatchItems.push_back(item);
+}
+
+void UdpSocketHandler::SendBatchFallback(size_t fromIdx)
+{
+	MS_TRACE();
+
+	for (size_t idx{ fromIdx }; idx < this->sendBatchItems.size(); ++idx)
+	{
+		auto& item = this->sendBatchItems[idx];
+
+		SendDirect(item.sendData, reinterpret_cast<const struct sockaddr*>(&item.addr));
+	}
+
+	this->sendBatchItems.clear();
+	this->flushingSendBatch = false;
+}
+
+inline void UdpSocketHandler::CompleteSendBatchItem(SendBatchItem& item, bool sent)
+{
+	MS_TRACE();
+
+	if (sent)
+	{
+		// Update sent bytes.
+		this->sentBytes += item.sendData->len;
+	}
+
+	if (item.sendData->cb)
+		(*item.sendData->cb)(sent);
+
+	// Give the UvSendData struct back to the pool (it will delete the cb).
+	UdpSocketHandler::ReleaseSendData(item.sendData);
+
+	item.sendData = nullptr;
+}
+
 bool UdpSocketHandler::SetLocalAddress()
 {
 	MS_TRACE();
@@ -245,6 +894,18 @@ inline void UdpSocketHandler::OnUvRecvAlloc(size_t /*suggestedSize*/, uv_buf_t*
 {
 	MS_TRACE();
 
+	// If recv batching is enabled, tell UV to write into the batch buffer so it
+	// reads up to recvBatchSize datagrams with a single recvmmsg() call.
+	// NOTE: The handle must have been initialized with UV_UDP_RECVMMSG flag,
+	// otherwise UV just uses the first slot.
+	if (this->recvBatchSize > 1u)
+	{
+		buf->base = reinterpret_cast<char*>(RecvBatchBuffer.data());
+		buf->len  = this->recvBatchSize * ReadBufferSize;
+
+		return;
+	}
+
 	// Tell UV to write into the static buffer.
 	buf->base = reinterpret_cast<char*>(ReadBuffer);
 	// Give UV all the buffer space.
@@ -256,6 +917,15 @@ inline void UdpSocketHandler::OnUvRecv(
 {
 	MS_TRACE();
 
+	// Last callback of a recvmmsg() batch. It's called to free the buffer given
+	// in OnUvRecvAlloc() but we don't need it.
+	if ((flags & UV_UDP_MMSG_FREE) != 0u)
+	{
+		this->recvBatches++;
+
+		return;
+	}
+
 	// NOTE: Ignore if there is nothing to read or if it was an empty datagram.
 	if (nread == 0)
 		return;
@@ -271,8 +941,9 @@ inline void UdpSocketHandler::OnUvRecv(
 	// Data received.
 	if (nread > 0)
 	{
-		// Update received bytes.
+		// Update received bytes and datagrams.
 		this->recvBytes += nread;
+		this->recvDatagrams++;
 
 		// Notify the subclass.
 		UserOnUdpDatagramReceived(reinterpret_cast<uint8_t*>(buf->base), nread, addr);
@@ -305,3 +976,10 @@ inline void UdpSocketHandler::OnUvSend(int status, UdpSocketHandler::onSendCallb
 			(*cb)(false);
 	}
 }
+
+inline void UdpSocketHandler::OnUvSendBatchFlush()
+{
+	MS_TRACE();
+
+	FlushSendBatch();
+}
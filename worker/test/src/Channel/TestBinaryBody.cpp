@@ -0,0 +1,177 @@
+#include "common.hpp"
+#include "Channel/BinaryBody.hpp"
+#include "RTC/RtpStreamSend.hpp"
+#include <catch2/catch.hpp>
+#include <cstring> // std::strlen()
+#include <set>
+#include <string>
+
+using namespace Channel;
+
+using Key = BinaryBody::Key;
+
+SCENARIO("BinaryBody", "[channel][binary]")
+{
+	SECTION("written record is decoded as the equivalent JSON")
+	{
+		BinaryBody::Writer writer(BinaryMessage::BodyType::RECORD);
+
+		writer.WriteString(Key::TYPE, "webrtc-transport");
+		writer.WriteUint(Key::TIMESTAMP, 1234567890123u);
+		writer.WriteInt(Key::PACKETS_LOST, -3);
+		writer.WriteDouble(Key::ROUND_TRIP_TIME, 12.5);
+		writer.WriteBool(Key::RTCP_MUX, true);
+		writer.StartRecord(Key::TUPLE);
+		writer.WriteString(Key::LOCAL_IP, "1.2.3.4");
+		writer.WriteUint(Key::LOCAL_PORT, 40000u);
+		writer.EndRecord();
+		writer.StartItems(Key::ROUTER_IDS, 2u);
+		writer.AppendString("r1");
+		writer.AppendString("r2");
+		writer.StartItems(Key::MAP_CONSUMER_ID_PRODUCER_ID, 1u);
+		writer.AppendString("c1");
+		writer.AppendString("p1");
+		writer.StartItems(Key::MAP_PRODUCER_ID_CONSUMER_IDS, 1u);
+		writer.AppendString("p1");
+		writer.AppendCount(2u);
+		writer.AppendString("c1");
+		writer.AppendString("c2");
+		writer.StartItems(Key::BITRATE_BY_LAYER, 1u);
+		writer.AppendString("0.1");
+		writer.AppendUint(300000u);
+		writer.EndRecord();
+
+		json expected = json::parse(R"({
+			"type": "webrtc-transport",
+			"timestamp": 1234567890123,
+			"packetsLost": -3,
+			"roundTripTime": 12.5,
+			"rtcpMux": true,
+			"tuple": { "localIp": "1.2.3.4", "localPort": 40000 },
+			"routerIds": [ "r1", "r2" ],
+			"mapConsumerIdProducerId": { "c1": "p1" },
+			"mapProducerIdConsumerIds": { "p1": [ "c1", "c2" ] },
+			"bitrateByLayer": { "0.1": 300000 }
+		})");
+		json jsonValue;
+
+		REQUIRE(writer.GetBodyType() == BinaryMessage::BodyType::RECORD);
+		REQUIRE(
+		  BinaryBody::ToJson(writer.GetBodyType(), writer.GetData(), writer.GetSize(), jsonValue));
+		REQUIRE(jsonValue == expected);
+	}
+
+	SECTION("written records are decoded as an array")
+	{
+		BinaryBody::Writer writer(BinaryMessage::BodyType::RECORDS);
+
+		writer.WriteUint(Key::SSRC, 1111u);
+		writer.EndRecord();
+		writer.WriteUint(Key::SSRC, 2222u);
+		writer.EndRecord();
+
+		json jsonValue;
+
+		REQUIRE(
+		  BinaryBody::ToJson(writer.GetBodyType(), writer.GetData(), writer.GetSize(), jsonValue));
+		REQUIRE(jsonValue == json::parse(R"([ { "ssrc": 1111 }, { "ssrc": 2222 } ])"));
+	}
+
+	SECTION("invalid data is not decoded")
+	{
+		BinaryBody::Writer writer(BinaryMessage::BodyType::RECORD);
+
+		writer.WriteString(Key::LABEL, "foo");
+		writer.EndRecord();
+
+		json jsonValue;
+
+		// Missing END key.
+		REQUIRE(!BinaryBody::ToJson(
+		  BinaryMessage::BodyType::RECORD, writer.GetData(), writer.GetSize() - 1, jsonValue));
+
+		// Truncated string.
+		REQUIRE(!BinaryBody::ToJson(
+		  BinaryMessage::BodyType::RECORD, writer.GetData(), writer.GetSize() - 2, jsonValue));
+		// Trailing data after the record.
+		std::string trailing(writer.GetData(), writer.GetSize());
+
+		trailing.push_back(0);
+
+		REQUIRE(!BinaryBody::ToJson(
+		  BinaryMessage::BodyType::RECORD, trailing.data(), trailing.size(), jsonValue));
+
+		// Unknown key.
+		const char unknownKey[]{ static_cast<char>(0xFE), 0 };
+
+		REQUIRE(!BinaryBody::ToJson(BinaryMessage::BodyType::RECORD, unknownKey, 2u, jsonValue));
+
+		// Not a schema body.
+		REQUIRE(!BinaryBody::ToJson(
+		  BinaryMessage::BodyType::JSON, writer.GetData(), writer.GetSize(), jsonValue));
+	}
+
+	SECTION("key names are unique")
+	{
+		std::set<std::string> names;
+		size_t numKeys{ static_cast<size_t>(Key::WRITE_BATCH_ITEMS) + 1 };
+
+		for (size_t idx{ 1u }; idx < numKeys; ++idx)
+		{
+			const auto& keyInfo = BinaryBody::GetKeyInfo(static_cast<Key>(idx));
+
+			REQUIRE(std::strlen(keyInfo.name) != 0u);
+			REQUIRE(names.insert(keyInfo.name).second);
+		}
+	}
+
+	SECTION("RtpStreamSend binary stats match the JSON ones")
+	{
+		class TestRtpStreamListener : public RTC::RtpStreamSend::Listener
+		{
+		public:
+			void OnRtpStreamScore(
+			  RTC::RtpStream* /*rtpStream*/, uint8_t /*score*/, uint8_t /*previousScore*/) override
+			{
+			}
+
+			void OnRtpStreamRetransmitRtpPacket(
+			  RTC::RtpStreamSend* /*rtpStream*/, RTC::RtpPacket* /*packet*/) override
+			{
+			}
+		};
+
+		TestRtpStreamListener listener;
+		RTC::RtpStream::Params params;
+
+		params.ssrc          = 1111;
+		params.rid           = "h";
+		params.clockRate     = 90000;
+		params.mimeType.type = RTC::RtpCodecMimeType::Type::VIDEO;
+
+		std::string mid;
+		RTC::RtpStreamSend stream(&listener, params, mid);
+
+		stream.SetRtx(97, 2222);
+
+		json jsonStats = json::object();
+		BinaryBody::Writer writer(BinaryMessage::BodyType::RECORDS);
+
+		stream.FillJsonStats(jsonStats);
+		stream.FillBinaryStats(writer);
+		writer.EndRecord();
+
+		json jsonValue;
+
+		REQUIRE(
+		  BinaryBody::ToJson(writer.GetBodyType(), writer.GetData(), writer.GetSize(), jsonValue));
+		REQUIRE(jsonValue.size() == 1u);
+
+		// Both got their own timestamp.
+		REQUIRE(jsonValue[0].find("timestamp") != jsonValue[0].end());
+		jsonValue[0].erase("timestamp");
+		jsonStats.erase("timestamp");
+
+		REQUIRE(jsonValue[0] == jsonStats);
+	}
+}
@@ -0,0 +1,156 @@
+#include "common.hpp"
+#include "Channel/BinaryMessage.hpp"
+#include "Channel/ChannelRequest.hpp"
+#include "PayloadChannel/PayloadChannelNotification.hpp"
+#include "PayloadChannel/PayloadChannelRequest.hpp"
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace Channel;
+
+SCENARIO("BinaryMessage", "[channel][binary]")
+{
+	std::vector<uint8_t> buffer;
+
+	SECTION("written message is parsed back")
+	{
+		std::string data{ R"({"foo":1})" };
+
+		BinaryMessage::Write(
+		  buffer,
+		  BinaryMessage::Type::NOTIFICATION,
+		  3u,
+		  1234u,
+		  "target",
+		  "event",
+		  BinaryMessage::BodyType::JSON,
+		  data.c_str(),
+		  data.length());
+
+		auto* msg = reinterpret_cast<const char*>(buffer.data());
+		BinaryMessage::Fields fields;
+
+		REQUIRE(buffer.size() == BinaryMessage::HeaderSize + 6 + 5 + data.length());
+		REQUIRE(BinaryMessage::IsBinary(msg, buffer.size()));
+		REQUIRE(BinaryMessage::IsBinary(msg, buffer.size(), BinaryMessage::Type::NOTIFICATION));
+		REQUIRE(!BinaryMessage::IsBinary(msg, buffer.size(), BinaryMessage::Type::REQUEST));
+		REQUIRE(BinaryMessage::Parse(msg, buffer.size(), fields));
+		REQUIRE(fields.type == BinaryMessage::Type::NOTIFICATION);
+		REQUIRE(fields.code == 3u);
+		REQUIRE(fields.id == 1234u);
+		REQUIRE(std::string(fields.field1, fields.field1Len) == "target");
+		REQUIRE(std::string(fields.field2, fields.field2Len) == "event");
+		REQUIRE(fields.bodyType == BinaryMessage::BodyType::JSON);
+		REQUIRE(std::string(fields.data, fields.dataLen) == data);
+	}
+
+	SECTION("text messages are not binary")
+	{
+		char foo[]{ "1:worker.dump:undefined:undefined" };
+
+		REQUIRE(!BinaryMessage::IsBinary(foo, sizeof(foo) - 1));
+	}
+
+	SECTION("truncated or unknown messages are not parsed")
+	{
+		BinaryMessage::Write(
+		  buffer,
+		  BinaryMessage::Type::REQUEST,
+		  1u,
+		  1u,
+		  "handler",
+		  nullptr,
+		  BinaryMessage::BodyType::JSON,
+		  nullptr,
+		  0u);
+
+		auto* msg = reinterpret_cast<const char*>(buffer.data());
+		BinaryMessage::Fields fields;
+
+		REQUIRE(!BinaryMessage::Parse(msg, buffer.size() - 1, fields));
+
+		buffer[12] = 0xFF;
+
+		REQUIRE(!BinaryMessage::Parse(msg, buffer.size(), fields));
+
+		buffer[12] = 0u;
+		buffer[1]  = 0xFF;
+
+		REQUIRE(!BinaryMessage::Parse(msg, buffer.size(), fields));
+	}
+
+	SECTION("ChannelRequest is parsed from a binary request")
+	{
+		std::string data{ R"({"producerId":"p1"})" };
+
+		BinaryMessage::Write(
+		  buffer,
+		  BinaryMessage::Type::REQUEST,
+		  static_cast<uint16_t>(ChannelRequest::MethodId::TRANSPORT_GET_STATS),
+		  42u,
+		  "transport1",
+		  nullptr,
+		  BinaryMessage::BodyType::JSON,
+		  data.c_str(),
+		  data.length());
+
+		ChannelRequest request(nullptr, reinterpret_cast<const char*>(buffer.data()), buffer.size());
+
+		REQUIRE(request.binary);
+		REQUIRE(request.id == 42u);
+		REQUIRE(request.methodId == ChannelRequest::MethodId::TRANSPORT_GET_STATS);
+		REQUIRE(request.method == "transport.getStats");
+		REQUIRE(request.handlerId == "transport1");
+		REQUIRE(request.data["producerId"] == "p1");
+	}
+
+	SECTION("PayloadChannel request and notification are parsed from binary messages")
+	{
+		BinaryMessage::Write(
+		  buffer,
+		  BinaryMessage::Type::REQUEST,
+		  static_cast<uint16_t>(PayloadChannel::PayloadChannelRequest::MethodId::DATA_CONSUMER_SEND),
+		  7u,
+		  "dataConsumer1",
+		  nullptr,
+		  BinaryMessage::BodyType::JSON,
+		  "51",
+		  2u);
+
+		auto* msg = reinterpret_cast<char*>(buffer.data());
+
+		REQUIRE(PayloadChannel::PayloadChannelRequest::IsRequest(msg, buffer.size()));
+		REQUIRE(!PayloadChannel::PayloadChannelNotification::IsNotification(msg, buffer.size()));
+
+		PayloadChannel::PayloadChannelRequest request(nullptr, msg, buffer.size());
+
+		REQUIRE(request.id == 7u);
+		REQUIRE(request.method == "dataConsumer.send");
+		REQUIRE(request.handlerId == "dataConsumer1");
+		REQUIRE(request.data == "51");
+
+		BinaryMessage::Write(
+		  buffer,
+		  BinaryMessage::Type::NOTIFICATION,
+		  static_cast<uint16_t>(PayloadChannel::PayloadChannelNotification::EventId::PRODUCER_SEND),
+		  0u,
+		  "producer1",
+		  nullptr,
+		  BinaryMessage::BodyType::JSON,
+		  nullptr,
+		  0u);
+
+		msg = reinterpret_cast<char*>(buffer.data());
+
+		REQUIRE(PayloadChannel::PayloadChannelNotification::IsNotification(msg, buffer.size()));
+
+		PayloadChannel::PayloadChannelNotification notification(msg, buffer.size());
+
+		REQUIRE(
+		  notification.eventId == PayloadChannel::PayloadChannelNotification::EventId::PRODUCER_SEND);
+		REQUIRE(notification.event == "producer.send");
+		REQUIRE(notification.handlerId == "producer1");
+		REQUIRE(notification.data.empty());
+	}
+}
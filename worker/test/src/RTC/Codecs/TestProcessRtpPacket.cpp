@@ -0,0 +1,135 @@
+#include "common.hpp"
+#include "RTC/Codecs/H264.hpp"
+#include "RTC/Codecs/H264_SVC.hpp"
+#include "RTC/Codecs/Opus.hpp"
+#include "RTC/Codecs/VP8.hpp"
+#include "RTC/Codecs/VP9.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <catch2/catch.hpp>
+#include <cstring> // std::memcpy()
+
+using namespace RTC;
+
+// RTP header (PT 96, seq 1, SSRC 0x01020304) followed by the codec payload.
+// clang-format off
+static uint8_t vp8Buffer[] =
+{
+	0x80, 0x60, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x02, 0x03, 0x04,
+	0x90, 0xe0, 0x80, 0x01, 0x00, 0x20, 0x10, 0x02, 0x00, 0x9d, 0x01, 0x2a
+};
+static uint8_t vp9Buffer[] =
+{
+	0x80, 0x60, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x02, 0x03, 0x04,
+	0xAD, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+static uint8_t h264Buffer[] =
+{
+	0x80, 0x60, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x02, 0x03, 0x04,
+	0x65, 0x88, 0x84, 0x00, 0x33, 0xff
+};
+static uint8_t h264SvcBuffer[] =
+{
+	0x80, 0x60, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x02, 0x03, 0x04,
+	0x67, 0x42, 0xc0, 0x33
+};
+static uint8_t opusBuffer[] =
+{
+	0x80, 0x6f, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x02, 0x03, 0x04,
+	0xfc, 0xff, 0xfe
+};
+// clang-format on
+
+static RtpPacket* CreateRtpPacket(uint8_t* buffer, const uint8_t* original, size_t len)
+{
+	std::memcpy(buffer, original, len);
+
+	auto* packet = RtpPacket::Parse(buffer, len);
+
+	REQUIRE(packet);
+
+	return packet;
+}
+
+SCENARIO("codecs ProcessRtpPacket()", "[codecs]")
+{
+	uint8_t buffer[MtuSize];
+
+	SECTION("payload descriptor handler is stored in the packet")
+	{
+		std::unique_ptr<RtpPacket> packet(CreateRtpPacket(buffer, vp8Buffer, sizeof(vp8Buffer)));
+
+		REQUIRE(!packet->IsKeyFrame());
+
+		Codecs::VP8::ProcessRtpPacket(packet.get());
+
+		REQUIRE(packet->IsKeyFrame());
+		REQUIRE(packet->GetTemporalLayer() == 0);
+
+		std::unique_ptr<RtpPacket> clonedPacket(packet->Clone());
+
+		REQUIRE(clonedPacket->IsKeyFrame());
+		REQUIRE(clonedPacket->GetTemporalLayer() == 0);
+
+		// Replacing the handler must not affect the clone.
+		Codecs::Opus::ProcessRtpPacket(packet.get());
+
+		REQUIRE(!packet->IsKeyFrame());
+		REQUIRE(clonedPacket->IsKeyFrame());
+	}
+
+	SECTION("packets failing to parse get no handler")
+	{
+		std::unique_ptr<RtpPacket> packet(
+		  CreateRtpPacket(buffer, h264SvcBuffer, sizeof(h264SvcBuffer) - 3));
+
+		Codecs::H264_SVC::ProcessRtpPacket(packet.get());
+
+		REQUIRE(!packet->IsKeyFrame());
+	}
+}
+
+// Run it with `make test MEDIASOUP_TEST_TAGS="[benchmark]"`. Each iteration
+// parses the RTP packet and runs the codec parse path on it, which is what a
+// Producer does for every received media packet.
+SCENARIO("codecs ProcessRtpPacket() benchmark", "[codecs][.benchmark]")
+{
+	uint8_t buffer[MtuSize];
+
+	auto process = [&buffer](const uint8_t* original, size_t len, void (*processRtpPacket)(RtpPacket*))
+	{
+		auto* packet = CreateRtpPacket(buffer, original, len);
+
+		processRtpPacket(packet);
+
+		const auto isKeyFrame = packet->IsKeyFrame();
+
+		delete packet;
+
+		return isKeyFrame;
+	};
+
+	BENCHMARK("VP8")
+	{
+		return process(vp8Buffer, sizeof(vp8Buffer), &Codecs::VP8::ProcessRtpPacket);
+	};
+
+	BENCHMARK("VP9")
+	{
+		return process(vp9Buffer, sizeof(vp9Buffer), &Codecs::VP9::ProcessRtpPacket);
+	};
+
+	BENCHMARK("H264")
+	{
+		return process(h264Buffer, sizeof(h264Buffer), &Codecs::H264::ProcessRtpPacket);
+	};
+
+	BENCHMARK("H264_SVC")
+	{
+		return process(h264SvcBuffer, sizeof(h264SvcBuffer), &Codecs::H264_SVC::ProcessRtpPacket);
+	};
+
+	BENCHMARK("Opus")
+	{
+		return process(opusBuffer, sizeof(opusBuffer), &Codecs::Opus::ProcessRtpPacket);
+	};
+}
@@ -251,10 +251,10 @@ std::unique_ptr<Codecs::VP8::PayloadDescriptor> ProcessPacket(
 	};
 	// clang-format on
 	bool marker;
-	auto* payloadDescriptor =
-	  CreatePacket(buffer, sizeof(buffer), pictureId, tl0PictureIndex, tlIndex, layerSync);
+	std::unique_ptr<Codecs::VP8::PayloadDescriptor> payloadDescriptor(
+	  CreatePacket(buffer, sizeof(buffer), pictureId, tl0PictureIndex, tlIndex, layerSync));
 	std::unique_ptr<Codecs::VP8::PayloadDescriptorHandler> payloadDescriptorHandler(
-	  new Codecs::VP8::PayloadDescriptorHandler(payloadDescriptor));
+	  new Codecs::VP8::PayloadDescriptorHandler(*payloadDescriptor));
 
 	if (payloadDescriptorHandler->Process(&context, buffer, marker))
 	{
@@ -33,9 +33,10 @@ std::unique_ptr<Codecs::VP9::PayloadDescriptor> ProcessVP9Packet(
 	};
 	// clang-format on
 	bool marker;
-	auto* payloadDescriptor = CreateVP9Packet(buffer, sizeof(buffer), pictureId, tlIndex);
+	std::unique_ptr<Codecs::VP9::PayloadDescriptor> payloadDescriptor(
+	  CreateVP9Packet(buffer, sizeof(buffer), pictureId, tlIndex));
 	std::unique_ptr<Codecs::VP9::PayloadDescriptorHandler> payloadDescriptorHandler(
-	  new Codecs::VP9::PayloadDescriptorHandler(payloadDescriptor));
+	  new Codecs::VP9::PayloadDescriptorHandler(*payloadDescriptor));
 
 	if (payloadDescriptorHandler->Process(&context, buffer, marker))
 	{
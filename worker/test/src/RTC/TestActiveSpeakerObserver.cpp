@@ -0,0 +1,239 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "RTC/ActiveSpeakerObserver.hpp"
+#include "RTC/Producer.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/Shared.hpp"
+#include <catch2/catch.hpp>
+#include <algorithm> // std::max()
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace RTC;
+
+static ChannelReadFreeFn channelRead(
+  uint8_t** /*message*/,
+  uint32_t* /*messageLen*/,
+  size_t* /*messageCtx*/,
+  const void* /*handle*/,
+  ChannelReadCtx /*ctx*/)
+{
+	return nullptr;
+}
+
+static void channelWrite(const uint8_t* message, uint32_t messageLen, ChannelWriteCtx ctx)
+{
+	auto* messages = static_cast<std::vector<std::string>*>(ctx);
+
+	messages->emplace_back(reinterpret_cast<const char*>(message), messageLen);
+}
+
+static PayloadChannelReadFreeFn payloadChannelRead(
+  uint8_t** /*message*/,
+  uint32_t* /*messageLen*/,
+  size_t* /*messageCtx*/,
+  uint8_t** /*payload*/,
+  uint32_t* /*payloadLen*/,
+  size_t* /*payloadCapacity*/,
+  const void* /*handle*/,
+  PayloadChannelReadCtx /*ctx*/)
+{
+	return nullptr;
+}
+
+static void payloadChannelWrite(
+  const uint8_t* /*message*/,
+  uint32_t /*messageLen*/,
+  const uint8_t* /*payload*/,
+  uint32_t /*payloadLen*/,
+  ChannelWriteCtx /*ctx*/)
+{
+}
+
+// Activity score as computed before the scores were tabulated.
+static double computeActivityScore(uint8_t vL, uint32_t nR, double p, double lambda)
+{
+	const int32_t r = std::max<int32_t>(vL, nR - vL);
+	int64_t binomialCoefficient{ 1 };
+
+	for (int64_t i = nR, j = 1; i > r; i--, ++j)
+	{
+		binomialCoefficient = binomialCoefficient * i / j;
+	}
+
+	const double activityScore = std::log(binomialCoefficient) + vL * std::log(p) +
+	                             (nR - vL) * std::log(1 - p) - std::log(lambda) + lambda * vL;
+
+	return std::max(activityScore, 0.0000000001);
+}
+
+static json producerData(uint32_t ssrc)
+{
+	json data = json::parse(R"({
+		"kind": "audio",
+		"rtpParameters":
+		{
+			"mid": "0",
+			"codecs":
+			[
+				{ "mimeType": "audio/opus", "payloadType": 100, "clockRate": 48000, "channels": 2 }
+			],
+			"headerExtensions":
+			[
+				{ "uri": "urn:ietf:params:rtp-hdrext:ssrc-audio-level", "id": 1 }
+			],
+			"encodings": [ {} ],
+			"rtcp": { "cname": "foo" }
+		},
+		"rtpMapping":
+		{
+			"codecs": [ { "payloadType": 100, "mappedPayloadType": 100 } ],
+			"encodings": [ {} ]
+		}
+	})");
+
+	data["rtpParameters"]["encodings"][0]["ssrc"]    = ssrc;
+	data["rtpMapping"]["encodings"][0]["ssrc"]       = ssrc;
+	data["rtpMapping"]["encodings"][0]["mappedSsrc"] = ssrc + 1u;
+
+	return data;
+}
+
+SCENARIO("ActiveSpeakerObserver", "[rtp][activespeakerobserver]")
+{
+	SECTION("activity scores match the previous formulas")
+	{
+		// Number of subunits and lambda of each interval.
+		const uint32_t nRs[]{ 13u, 5u, 10u };
+		const double lambdas[]{ 0.78, 24, 47 };
+
+		for (uint8_t interval{ 0u }; interval < 3u; ++interval)
+		{
+			const auto nR = nRs[interval];
+
+			for (uint8_t vL{ 0u }; vL <= nR; ++vL)
+			{
+				const double score = computeActivityScore(vL, nR, 0.5, lambdas[interval]);
+
+				REQUIRE(
+				  ActiveSpeakerObserver::GetLogActivityScore(interval, vL) == Approx(std::log(score)));
+
+				// Relative speech activities were the log of the ratio of the scores.
+				for (uint8_t refVL{ 0u }; refVL <= nR; ++refVL)
+				{
+					const double refScore = computeActivityScore(refVL, nR, 0.5, lambdas[interval]);
+
+					REQUIRE(
+					  ActiveSpeakerObserver::GetLogActivityScore(interval, vL) -
+					    ActiveSpeakerObserver::GetLogActivityScore(interval, refVL) ==
+					  Approx(std::log(score / refScore)).margin(1e-9));
+				}
+			}
+		}
+	}
+
+	SECTION("dominant speaker follows removed speakers")
+	{
+		std::vector<std::string> messages;
+		Channel::ChannelSocket channel(channelRead, nullptr, channelWrite, &messages);
+		PayloadChannel::PayloadChannelSocket payloadChannel(
+		  payloadChannelRead, nullptr, payloadChannelWrite, nullptr);
+		auto* payloadChannelNotifier = new PayloadChannel::PayloadChannelNotifier(&payloadChannel);
+		Shared shared(
+		  new ChannelMessageRegistrator(),
+		  new Channel::ChannelNotifier(&channel),
+		  payloadChannelNotifier,
+		  new StatsStreamer(payloadChannelNotifier));
+		json observerData = json::parse(R"({ "interval": 100 })");
+		ActiveSpeakerObserver observer(&shared, "observer", nullptr, observerData);
+		Timer::Listener* timerListener = &observer;
+
+		json data1 = producerData(1111u);
+		json data2 = producerData(2222u);
+		json data3 = producerData(3333u);
+		json data4 = producerData(4444u);
+		std::unique_ptr<Producer> producer1(new Producer(&shared, "producer1", nullptr, data1));
+		std::unique_ptr<Producer> producer2(new Producer(&shared, "producer2", nullptr, data2));
+		std::unique_ptr<Producer> producer3(new Producer(&shared, "producer3", nullptr, data3));
+		std::unique_ptr<Producer> producer4(new Producer(&shared, "producer4", nullptr, data4));
+
+		// clang-format off
+		uint8_t buffer[] =
+		{
+			0x90, 0x64, 0x00, 0x01,
+			0x00, 0x00, 0x00, 0x04,
+			0x00, 0x00, 0x0d, 0x05,
+			0xbe, 0xde, 0x00, 0x01, // Header extension.
+			0x10, 0x80, 0x00, 0x00, // ssrc-audio-level (id:1, voice, level:0).
+			0x01, 0x02, 0x03, 0x04
+		};
+		// clang-format on
+
+		std::unique_ptr<RtpPacket> packet(RtpPacket::Parse(buffer, sizeof(buffer)));
+
+		packet->SetSsrcAudioLevelExtensionId(1u);
+
+		// Fills the whole level history of the given Producer with loud levels.
+		auto speak = [&observer, &packet](Producer* producer)
+		{
+			for (size_t i{ 0u }; i < 50u; ++i)
+			{
+				observer.ReceiveRtpPacket(producer, packet.get());
+			}
+		};
+
+		auto lastDominantSpeaker = [&messages]() -> std::string
+		{
+			auto jsonNotification = json::parse(messages.back());
+
+			REQUIRE(jsonNotification["targetId"] == "observer");
+			REQUIRE(jsonNotification["event"] == "dominantspeaker");
+
+			return jsonNotification["data"]["producerId"].get<std::string>();
+		};
+
+		observer.AddProducer(producer1.get());
+		observer.AddProducer(producer2.get());
+		observer.AddProducer(producer3.get());
+
+		// The loudest speaker, the last one, gets dominant.
+		speak(producer3.get());
+		timerListener->OnTimer(nullptr);
+
+		REQUIRE(messages.size() == 1u);
+		REQUIRE(lastDominantSpeaker() == "producer3");
+
+		// The dominant speaker is moved into the slot of the removed one.
+		observer.RemoveProducer(producer1.get());
+		speak(producer3.get());
+		timerListener->OnTimer(nullptr);
+
+		REQUIRE(messages.size() == 1u);
+
+		// Removing the dominant speaker elects a new one right away.
+		observer.RemoveProducer(producer3.get());
+
+		REQUIRE(messages.size() == 2u);
+		REQUIRE(lastDominantSpeaker() == "producer2");
+
+		// Removing the last speaker leaves no dominant one.
+		observer.RemoveProducer(producer2.get());
+		timerListener->OnTimer(nullptr);
+
+		REQUIRE(messages.size() == 2u);
+
+		observer.AddProducer(producer4.get());
+		timerListener->OnTimer(nullptr);
+
+		REQUIRE(messages.size() == 3u);
+		REQUIRE(lastDominantSpeaker() == "producer4");
+
+		channel.Close();
+		payloadChannel.Close();
+	}
+
+	// Must run the loop to wait for UV timers and close them.
+	DepLibUV::RunLoop();
+}
@@ -0,0 +1,184 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "Settings.hpp"
+#include "RTC/DtlsTransport.hpp"
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <vector>
+
+using namespace RTC;
+
+class TestDtlsTransportListener : public DtlsTransport::Listener
+{
+public:
+	void OnDtlsTransportConnecting(const DtlsTransport* /*dtlsTransport*/) override
+	{
+	}
+	void OnDtlsTransportConnected(
+	  const DtlsTransport* /*dtlsTransport*/,
+	  SrtpSession::CryptoSuite srtpCryptoSuite,
+	  uint8_t* srtpLocalKey,
+	  size_t srtpLocalKeyLen,
+	  uint8_t* srtpRemoteKey,
+	  size_t srtpRemoteKeyLen,
+	  std::string& /*remoteCert*/) override
+	{
+		this->connected       = true;
+		this->srtpCryptoSuite = srtpCryptoSuite;
+		this->srtpLocalKey.assign(srtpLocalKey, srtpLocalKey + srtpLocalKeyLen);
+		this->srtpRemoteKey.assign(srtpRemoteKey, srtpRemoteKey + srtpRemoteKeyLen);
+	}
+	void OnDtlsTransportFailed(const DtlsTransport* /*dtlsTransport*/) override
+	{
+		this->failed = true;
+	}
+	void OnDtlsTransportClosed(const DtlsTransport* /*dtlsTransport*/) override
+	{
+	}
+	void OnDtlsTransportSendData(
+	  const DtlsTransport* /*dtlsTransport*/, const uint8_t* data, size_t len) override
+	{
+		this->sent.emplace_back(data, data + len);
+	}
+	void OnDtlsTransportApplicationDataReceived(
+	  const DtlsTransport* /*dtlsTransport*/, const uint8_t* /*data*/, size_t /*len*/) override
+	{
+	}
+
+public:
+	bool connected{ false };
+	bool failed{ false };
+	SrtpSession::CryptoSuite srtpCryptoSuite{ SrtpSession::CryptoSuite::NONE };
+	std::vector<uint8_t> srtpLocalKey;
+	std::vector<uint8_t> srtpRemoteKey;
+	std::deque<std::vector<uint8_t>> sent;
+};
+
+// Deliver the data sent by each DtlsTransport to the other one until both
+// are connected (or give up).
+static void runHandshake(
+  DtlsTransport& client,
+  TestDtlsTransportListener& clientListener,
+  DtlsTransport& server,
+  TestDtlsTransportListener& serverListener)
+{
+	for (size_t i{ 0u }; i < 5000u && !(clientListener.connected && serverListener.connected); ++i)
+	{
+		while (!clientListener.sent.empty())
+		{
+			auto data = std::move(clientListener.sent.front());
+
+			clientListener.sent.pop_front();
+			server.ProcessDtlsData(data.data(), data.size());
+		}
+
+		while (!serverListener.sent.empty())
+		{
+			auto data = std::move(serverListener.sent.front());
+
+			serverListener.sent.pop_front();
+			client.ProcessDtlsData(data.data(), data.size());
+		}
+
+		// Let offloaded handshake jobs complete.
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+SCENARIO("DtlsTransport", "[dtls]")
+{
+	DtlsTransport::ClassInit();
+
+	auto handshakeOffload = GENERATE(false, true);
+
+	Settings::configuration.dtlsHandshakeOffload = handshakeOffload;
+
+	SECTION("handshake completes and both ends get the same SRTP keys")
+	{
+		TestDtlsTransportListener clientListener;
+		TestDtlsTransportListener serverListener;
+		DtlsTransport client(&clientListener);
+		DtlsTransport server(&serverListener);
+
+		for (auto& fingerprint : client.GetLocalFingerprints())
+		{
+			if (fingerprint.algorithm == DtlsTransport::FingerprintAlgorithm::SHA256)
+			{
+				client.SetRemoteFingerprint(fingerprint);
+				server.SetRemoteFingerprint(fingerprint);
+			}
+		}
+
+		server.Run(DtlsTransport::Role::SERVER);
+		client.Run(DtlsTransport::Role::CLIENT);
+
+		runHandshake(client, clientListener, server, serverListener);
+
+		REQUIRE(clientListener.connected);
+		REQUIRE(serverListener.connected);
+		REQUIRE(!clientListener.failed);
+		REQUIRE(!serverListener.failed);
+		REQUIRE(client.GetState() == DtlsTransport::DtlsState::CONNECTED);
+		REQUIRE(server.GetState() == DtlsTransport::DtlsState::CONNECTED);
+		REQUIRE(clientListener.srtpCryptoSuite == serverListener.srtpCryptoSuite);
+		REQUIRE(!clientListener.srtpLocalKey.empty());
+		REQUIRE(clientListener.srtpLocalKey == serverListener.srtpRemoteKey);
+		REQUIRE(clientListener.srtpRemoteKey == serverListener.srtpLocalKey);
+	}
+
+	SECTION("wrong remote fingerprint fails")
+	{
+		TestDtlsTransportListener clientListener;
+		TestDtlsTransportListener serverListener;
+		DtlsTransport client(&clientListener);
+		DtlsTransport server(&serverListener);
+		DtlsTransport::Fingerprint fingerprint;
+
+		fingerprint.algorithm = DtlsTransport::FingerprintAlgorithm::SHA256;
+		fingerprint.value     = "00:00:00:00:00:00:00:00:00:00:00:00:00:00:00:00:00:00:00:00:00:00:"
+		                        "00:00:00:00:00:00:00:00:00:00";
+
+		client.SetRemoteFingerprint(fingerprint);
+		server.SetRemoteFingerprint(fingerprint);
+
+		server.Run(DtlsTransport::Role::SERVER);
+		client.Run(DtlsTransport::Role::CLIENT);
+
+		runHandshake(client, clientListener, server, serverListener);
+
+		REQUIRE((clientListener.failed || serverListener.failed));
+		REQUIRE(!(clientListener.connected && serverListener.connected));
+	}
+
+	SECTION("closing it while a handshake job is running")
+	{
+		TestDtlsTransportListener clientListener;
+		TestDtlsTransportListener serverListener;
+		DtlsTransport client(&clientListener);
+		auto* server = new DtlsTransport(&serverListener);
+
+		server->Run(DtlsTransport::Role::SERVER);
+		client.Run(DtlsTransport::Role::CLIENT);
+
+		REQUIRE(!clientListener.sent.empty());
+
+		// ClientHello.
+		server->ProcessDtlsData(clientListener.sent.front().data(), clientListener.sent.front().size());
+
+		delete server;
+
+		// Let the job (if any) complete.
+		for (size_t i{ 0u }; i < 100u; ++i)
+		{
+			uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	Settings::configuration.dtlsHandshakeOffload = false;
+
+	DtlsTransport::ClassDestroy();
+}
@@ -0,0 +1,162 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "RTC/EgressPacer.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <catch2/catch.hpp>
+#include <vector>
+
+using namespace RTC;
+
+class TestEgressPacerListener : public EgressPacer::Listener
+{
+public:
+	struct Sent
+	{
+		Consumer* consumer;
+		EgressPacer::Priority priority;
+		uint16_t seq;
+		bool hasRewritePlan;
+		uint32_t rewrittenSsrc;
+	};
+
+public:
+	void OnEgressPacerSendRtpPacket(
+	  EgressPacer* /*egressPacer*/,
+	  Consumer* consumer,
+	  RtpPacket* packet,
+	  EgressPacer::Priority priority) override
+	{
+		const auto* plan = packet->GetRewritePlan();
+
+		this->sent.push_back(
+		  { consumer, priority, packet->GetSequenceNumber(), plan != nullptr, plan ? plan->ssrc : 0u });
+	}
+
+public:
+	std::vector<Sent> sent;
+};
+
+static void runUntilEmpty(EgressPacer& egressPacer)
+{
+	for (size_t i{ 0u }; i < 1000u && egressPacer.GetQueueSize() != 0u; ++i)
+	{
+		uv_run(DepLibUV::GetLoop(), UV_RUN_ONCE);
+	}
+}
+
+SCENARIO("EgressPacer", "[egresspacer]")
+{
+	static uint8_t buffer[600];
+
+	buffer[0] = 0b10000000;
+	buffer[1] = 0b01111011;
+
+	auto* packet = RtpPacket::Parse(buffer, sizeof(buffer));
+
+	REQUIRE(packet);
+
+	// Consumers are never dereferenced by the pacer.
+	int dummy1;
+	int dummy2;
+	auto* consumer1 = reinterpret_cast<Consumer*>(&dummy1);
+	auto* consumer2 = reinterpret_cast<Consumer*>(&dummy2);
+
+	TestEgressPacerListener listener;
+	EgressPacer egressPacer(&listener);
+
+	SECTION("nothing is queued without bitrate")
+	{
+		for (int i{ 0 }; i < 100; ++i)
+		{
+			REQUIRE(!egressPacer.Enqueue(consumer1, packet, EgressPacer::Priority::VIDEO));
+		}
+
+		REQUIRE(egressPacer.GetQueueSize() == 0);
+		REQUIRE(egressPacer.MaySendProbation(packet));
+	}
+
+	SECTION("packets are queued once the budget is exhausted and sent by priority")
+	{
+		// 1.2 Mbps pacing bitrate, so the max budget is 1500 bytes.
+		egressPacer.SetBitrate(800000);
+
+		packet->SetSequenceNumber(1);
+		REQUIRE(!egressPacer.Enqueue(consumer1, packet, EgressPacer::Priority::VIDEO));
+		REQUIRE(!egressPacer.Enqueue(consumer1, packet, EgressPacer::Priority::VIDEO));
+		REQUIRE(!egressPacer.Enqueue(consumer1, packet, EgressPacer::Priority::VIDEO));
+
+		packet->SetSequenceNumber(2);
+		REQUIRE(egressPacer.Enqueue(consumer1, packet, EgressPacer::Priority::VIDEO));
+		packet->SetSequenceNumber(3);
+		REQUIRE(egressPacer.Enqueue(consumer1, packet, EgressPacer::Priority::RETRANSMISSION));
+		packet->SetSequenceNumber(4);
+		REQUIRE(egressPacer.Enqueue(consumer2, packet, EgressPacer::Priority::AUDIO));
+
+		REQUIRE(egressPacer.GetQueueSize() == 3);
+		REQUIRE(!egressPacer.MaySendProbation(packet));
+		REQUIRE(listener.sent.empty());
+
+		runUntilEmpty(egressPacer);
+
+		REQUIRE(egressPacer.GetQueueSize() == 0);
+		REQUIRE(listener.sent.size() == 3);
+		REQUIRE(listener.sent[0].consumer == consumer2);
+		REQUIRE(listener.sent[0].priority == EgressPacer::Priority::AUDIO);
+		REQUIRE(listener.sent[0].seq == 4);
+		REQUIRE(listener.sent[1].priority == EgressPacer::Priority::RETRANSMISSION);
+		REQUIRE(listener.sent[1].seq == 3);
+		REQUIRE(listener.sent[2].priority == EgressPacer::Priority::VIDEO);
+		REQUIRE(listener.sent[2].seq == 2);
+	}
+
+	SECTION("rewrite plan is kept with the queued packet")
+	{
+		egressPacer.SetBitrate(800000);
+
+		for (int i{ 0 }; i < 3; ++i)
+		{
+			egressPacer.Enqueue(consumer1, packet, EgressPacer::Priority::VIDEO);
+		}
+
+		RtpPacket::RewritePlan plan;
+
+		plan.ssrc = 1234;
+
+		packet->SetRewritePlan(&plan);
+		REQUIRE(egressPacer.Enqueue(consumer1, packet, EgressPacer::Priority::VIDEO));
+		packet->SetRewritePlan(nullptr);
+		REQUIRE(egressPacer.Enqueue(consumer1, packet, EgressPacer::Priority::VIDEO));
+
+		runUntilEmpty(egressPacer);
+
+		REQUIRE(listener.sent.size() == 2);
+		REQUIRE(listener.sent[0].hasRewritePlan);
+		REQUIRE(listener.sent[0].rewrittenSsrc == 1234);
+		REQUIRE(!listener.sent[1].hasRewritePlan);
+	}
+
+	SECTION("RemoveConsumer() drops its queued packets")
+	{
+		egressPacer.SetBitrate(800000);
+
+		for (int i{ 0 }; i < 3; ++i)
+		{
+			egressPacer.Enqueue(consumer1, packet, EgressPacer::Priority::VIDEO);
+		}
+
+		REQUIRE(egressPacer.Enqueue(consumer1, packet, EgressPacer::Priority::VIDEO));
+		REQUIRE(egressPacer.Enqueue(consumer2, packet, EgressPacer::Priority::AUDIO));
+		REQUIRE(egressPacer.Enqueue(consumer1, packet, EgressPacer::Priority::RETRANSMISSION));
+
+		egressPacer.RemoveConsumer(consumer1);
+
+		REQUIRE(egressPacer.GetQueueSize() == 1);
+
+		runUntilEmpty(egressPacer);
+
+		REQUIRE(listener.sent.size() == 1);
+		REQUIRE(listener.sent[0].consumer == consumer2);
+	}
+
+	delete packet;
+}
@@ -0,0 +1,191 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "RTC/InProcessPipe.hpp"
+#include <catch2/catch.hpp>
+#include <cstring> // std::memcmp()
+#include <memory>
+#include <vector>
+
+using namespace RTC;
+
+class TestInProcessPipeListener : public InProcessPipe::Listener
+{
+public:
+	void OnInProcessPipeDataReceived(
+	  InProcessPipe* /*inProcessPipe*/, const uint8_t* data, size_t len) override
+	{
+		this->received.emplace_back(data, data + len);
+	}
+	void OnInProcessPipeRtpPacketReceived(
+	  InProcessPipe* /*inProcessPipe*/, RtpPacket* packet) override
+	{
+		this->receivedPackets.emplace_back(packet->GetData(), packet->GetData() + packet->GetSize());
+		this->receivedSequenceNumbers.push_back(packet->GetSequenceNumber());
+		this->receivedSsrcs.push_back(packet->GetSsrc());
+	}
+
+public:
+	std::vector<std::vector<uint8_t>> received;
+	std::vector<std::vector<uint8_t>> receivedPackets;
+	std::vector<uint16_t> receivedSequenceNumbers;
+	std::vector<uint32_t> receivedSsrcs;
+};
+
+SCENARIO("InProcessPipe", "[inprocesspipe]")
+{
+	TestInProcessPipeListener listener1;
+	TestInProcessPipeListener listener2;
+
+	InProcessPipe pipe1(&listener1, "127.0.0.1", 10001);
+	InProcessPipe pipe2(&listener2, "127.0.0.1", 10002);
+
+	uint8_t data[] = { 0x80, 0x01, 0x02, 0x03, 0x04, 0x05 };
+
+	SECTION("Connect() fails if remote pipe is not in this process")
+	{
+		REQUIRE(pipe1.Connect("127.0.0.1", 10003) == false);
+		REQUIRE(pipe1.IsConnected() == false);
+		REQUIRE(pipe1.Send(data, sizeof(data)) == false);
+	}
+
+	SECTION("a pipe cannot connect to itself")
+	{
+		REQUIRE(pipe1.Connect("127.0.0.1", 10001) == false);
+	}
+
+	SECTION("data is delivered in order in the next loop iterations")
+	{
+		REQUIRE(pipe1.Connect("127.0.0.1", 10002));
+		REQUIRE(pipe2.Connect("127.0.0.1", 10001));
+
+		REQUIRE(pipe1.Send(data, sizeof(data)));
+		data[1] = 0xFF;
+		REQUIRE(pipe1.Send(data, 3));
+		REQUIRE(pipe2.Send(data, sizeof(data)));
+
+		// Nothing delivered synchronously.
+		REQUIRE(listener1.received.empty());
+		REQUIRE(listener2.received.empty());
+
+		// First iteration runs the check handles that signal the async ones.
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		REQUIRE(listener2.received.size() == 2);
+		REQUIRE(listener2.received[0].size() == sizeof(data));
+		REQUIRE(listener2.received[0][1] == 0x01);
+		REQUIRE(listener2.received[1].size() == 3);
+		REQUIRE(listener2.received[1][1] == 0xFF);
+
+		REQUIRE(listener1.received.size() == 1);
+		REQUIRE(std::memcmp(listener1.received[0].data(), data, sizeof(data)) == 0);
+	}
+
+	SECTION("only one sender can be attached to a pipe")
+	{
+		TestInProcessPipeListener listener3;
+		InProcessPipe pipe3(&listener3, "127.0.0.1", 10003);
+
+		REQUIRE(pipe1.Connect("127.0.0.1", 10002));
+		REQUIRE(pipe3.Connect("127.0.0.1", 10002) == false);
+	}
+
+	SECTION("data bigger than MTU is not sent")
+	{
+		std::vector<uint8_t> big(InProcessPipe::MaxDataSize + 1, 0x80);
+
+		REQUIRE(pipe1.Connect("127.0.0.1", 10002));
+		REQUIRE(pipe1.Send(big.data(), big.size()) == false);
+	}
+
+	SECTION("data from a pipe the receiver is not connected to is dropped")
+	{
+		REQUIRE(pipe1.Connect("127.0.0.1", 10002));
+		REQUIRE(pipe1.Send(data, sizeof(data)));
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		REQUIRE(listener2.received.empty());
+	}
+
+	SECTION("RTP packets are handed over parsed with their rewrite plan applied")
+	{
+		// clang-format off
+		uint8_t buffer[] =
+		{
+			0x80, 0x01, 0x00, 0x08,
+			0x00, 0x00, 0x00, 0x04,
+			0x00, 0x00, 0x00, 0x05,
+			0x01, 0x02, 0x03, 0x04
+		};
+		// clang-format on
+
+		RtpPacket* packet = RtpPacket::Parse(buffer, sizeof(buffer));
+
+		if (!packet)
+			FAIL("not a RTP packet");
+
+		RtpPacket::RewritePlan rewritePlan;
+
+		rewritePlan.ssrc           = 6;
+		rewritePlan.sequenceNumber = 9;
+		rewritePlan.timestamp      = 7;
+
+		packet->SetRewritePlan(&rewritePlan);
+
+		REQUIRE(pipe1.Connect("127.0.0.1", 10002));
+		REQUIRE(pipe2.Connect("127.0.0.1", 10001));
+		REQUIRE(pipe1.Send(packet));
+
+		delete packet;
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		REQUIRE(listener2.received.empty());
+		REQUIRE(listener2.receivedPackets.size() == 1);
+		REQUIRE(listener2.receivedPackets[0].size() == sizeof(buffer));
+		REQUIRE(listener2.receivedSequenceNumbers[0] == 9);
+		REQUIRE(listener2.receivedSsrcs[0] == 6);
+		REQUIRE(std::memcmp(listener2.receivedPackets[0].data() + 12, buffer + 12, 4) == 0);
+	}
+
+	SECTION("a pipe attaches to the remote pipe created again under the same address")
+	{
+		std::unique_ptr<TestInProcessPipeListener> listener3(new TestInProcessPipeListener());
+		std::unique_ptr<InProcessPipe> pipe3(new InProcessPipe(listener3.get(), "127.0.0.1", 10003));
+
+		REQUIRE(pipe1.Connect("127.0.0.1", 10003));
+		REQUIRE(pipe3->Connect("127.0.0.1", 10001));
+
+		pipe3.reset();
+
+		listener3.reset(new TestInProcessPipeListener());
+		pipe3.reset(new InProcessPipe(listener3.get(), "127.0.0.1", 10003));
+
+		REQUIRE(pipe3->Connect("127.0.0.1", 10001));
+		REQUIRE(pipe1.Send(data, sizeof(data)));
+		REQUIRE(pipe1.IsConnected());
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		REQUIRE(listener3->received.size() == 1);
+	}
+
+	SECTION("a pipe gets disconnected once the remote pipe is closed")
+	{
+		std::unique_ptr<InProcessPipe> pipe3(new InProcessPipe(&listener2, "127.0.0.1", 10003));
+
+		REQUIRE(pipe1.Connect("127.0.0.1", 10003));
+		REQUIRE(pipe1.Send(data, sizeof(data)));
+
+		pipe3.reset();
+
+		REQUIRE(pipe1.Send(data, sizeof(data)) == false);
+		REQUIRE(pipe1.IsConnected() == false);
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+	}
+}
@@ -0,0 +1,185 @@
+#include "common.hpp"
+#include "RTC/Codecs/PayloadDescriptorHandler.hpp"
+#include "RTC/KeyFrameCache.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <catch2/catch.hpp>
+#include <vector>
+
+using namespace RTC;
+
+class TestKeyFramePayloadDescriptorHandler : public Codecs::PayloadDescriptorHandler
+{
+public:
+	explicit TestKeyFramePayloadDescriptorHandler(bool isKeyFrame) : isKeyFrame(isKeyFrame){};
+	~TestKeyFramePayloadDescriptorHandler() override = default;
+	void Dump() const override
+	{
+		return;
+	};
+	bool Process(Codecs::EncodingContext* /*context*/, uint8_t* /*data*/, bool& /*marker*/) override
+	{
+		return true;
+	};
+	void Restore(uint8_t* /*data*/) override
+	{
+		return;
+	};
+	uint8_t GetSpatialLayer() const override
+	{
+		return 0;
+	};
+	uint8_t GetTemporalLayer() const override
+	{
+		return 0;
+	};
+	bool IsKeyFrame() const override
+	{
+		return this->isKeyFrame;
+	};
+	Codecs::PayloadDescriptorHandler* CloneInto(uint8_t* storage) const override
+	{
+		return new (storage) TestKeyFramePayloadDescriptorHandler(*this);
+	};
+
+private:
+	bool isKeyFrame{ false };
+};
+
+SCENARIO("KeyFrameCache", "[rtp][keyframecache]")
+{
+	// clang-format off
+	static uint8_t buffer[] =
+	{
+		0x80, 0x7b, 0x52, 0x0e,
+		0x5b, 0x6b, 0xca, 0xb5,
+		0x00, 0x00, 0x00, 0x02
+	};
+	// clang-format on
+
+	// [pt:123, seq:21006, timestamp:1533790901, ssrc:2]
+	auto* packet = RtpPacket::Parse(buffer, sizeof(buffer));
+
+	REQUIRE(packet);
+
+	KeyFrameCache keyFrameCache;
+
+	auto insert = [&keyFrameCache, packet](uint16_t seq, uint32_t timestamp, bool isKeyFrame)
+	{
+		RtpPacket::SharedPtr sharedPacket;
+
+		packet->EmplacePayloadDescriptorHandler<TestKeyFramePayloadDescriptorHandler>(isKeyFrame);
+		packet->SetSequenceNumber(seq);
+		packet->SetTimestamp(timestamp);
+
+		keyFrameCache.Insert(packet, sharedPacket);
+
+		return sharedPacket;
+	};
+
+	auto getSeqs = [&keyFrameCache](uint32_t ssrc)
+	{
+		std::vector<uint16_t> seqs;
+		const auto* packets = keyFrameCache.Get(ssrc);
+
+		if (packets)
+		{
+			for (const auto& cachedPacket : *packets)
+			{
+				seqs.push_back(cachedPacket->GetSequenceNumber());
+			}
+		}
+
+		return seqs;
+	};
+
+	SECTION("nothing is cached before a key frame")
+	{
+		auto sharedPacket = insert(100, 1000, false);
+
+		REQUIRE(!sharedPacket.get());
+		REQUIRE(keyFrameCache.Get(2) == nullptr);
+	}
+
+	SECTION("packets since the key frame are cached and shared")
+	{
+		insert(99, 1000, false);
+
+		auto sharedPacket = insert(100, 2000, true);
+
+		insert(101, 2000, true);
+		insert(102, 3000, false);
+
+		REQUIRE(sharedPacket.get());
+		REQUIRE(sharedPacket.use_count() == 2);
+		REQUIRE(getSeqs(2) == std::vector<uint16_t>{ 100, 101, 102 });
+		REQUIRE(keyFrameCache.Get(1234) == nullptr);
+	}
+
+	SECTION("sequence number wrap")
+	{
+		insert(65534, 1000, true);
+		insert(65535, 1000, false);
+		insert(0, 1000, false);
+
+		REQUIRE(getSeqs(2) == std::vector<uint16_t>{ 65534, 65535, 0 });
+	}
+
+	SECTION("stream is not provided while it has gaps")
+	{
+		insert(100, 2000, true);
+		insert(102, 3000, false);
+
+		REQUIRE(keyFrameCache.Get(2) == nullptr);
+
+		// Recovered via RTX.
+		insert(101, 2000, false);
+
+		REQUIRE(getSeqs(2) == std::vector<uint16_t>{ 100, 101, 102 });
+
+		// Duplicated and late packets are ignored.
+		REQUIRE(!insert(101, 2000, false).get());
+		REQUIRE(!insert(99, 1000, true).get());
+		REQUIRE(getSeqs(2) == std::vector<uint16_t>{ 100, 101, 102 });
+	}
+
+	SECTION("new key frame replaces the previous one")
+	{
+		insert(100, 2000, true);
+		insert(101, 3000, false);
+		insert(102, 4000, true);
+		insert(103, 4000, false);
+
+		REQUIRE(getSeqs(2) == std::vector<uint16_t>{ 102, 103 });
+	}
+
+	SECTION("too many packets since the key frame")
+	{
+		insert(100, 2000, true);
+
+		for (uint16_t seq{ 101 }; seq < 100 + KeyFrameCache::MaxPackets; ++seq)
+		{
+			insert(seq, 3000, false);
+		}
+
+		REQUIRE(getSeqs(2).size() == size_t{ KeyFrameCache::MaxPackets });
+
+		insert(100 + KeyFrameCache::MaxPackets, 3000, false);
+
+		REQUIRE(keyFrameCache.Get(2) == nullptr);
+
+		// Until the next key frame.
+		insert(2000, 5000, true);
+
+		REQUIRE(getSeqs(2) == std::vector<uint16_t>{ 2000 });
+	}
+
+	SECTION("Clear()")
+	{
+		insert(100, 2000, true);
+		keyFrameCache.Clear();
+
+		REQUIRE(keyFrameCache.Get(2) == nullptr);
+	}
+
+	delete packet;
+}
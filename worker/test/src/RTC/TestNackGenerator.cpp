@@ -3,7 +3,12 @@
 #include "RTC/Codecs/PayloadDescriptorHandler.hpp"
 #include "RTC/NackGenerator.hpp"
 #include "RTC/RtpPacket.hpp"
+#include "RTC/SeqManager.hpp"
 #include <catch2/catch.hpp>
+#include <algorithm> // std::find()
+#include <map>
+#include <random>
+#include <set>
 #include <vector>
 
 using namespace RTC;
@@ -62,6 +67,10 @@ public:
 	{
 		return this->isKeyFrame;
 	};
+	Codecs::PayloadDescriptorHandler* CloneInto(uint8_t* storage) const override
+	{
+		return new (storage) TestPayloadDescriptorHandler(*this);
+	};
 
 private:
 	bool isKeyFrame{ false };
@@ -129,9 +138,7 @@ void validate(std::vector<TestNackGeneratorInput>& inputs)
 	{
 		listener.Reset(input);
 
-		auto* tpdh = new TestPayloadDescriptorHandler(input.isKeyFrame);
-
-		packet->SetPayloadDescriptorHandler(tpdh);
+		packet->EmplacePayloadDescriptorHandler<TestPayloadDescriptorHandler>(input.isKeyFrame);
 		packet->SetSequenceNumber(input.seq);
 		nackGenerator.ReceivePacket(packet, /*isRecovered*/ false);
 
@@ -139,6 +146,292 @@ void validate(std::vector<TestNackGeneratorInput>& inputs)
 	}
 };
 
+class TestNackGeneratorRecorder : public NackGenerator::Listener
+{
+public:
+	void OnNackGeneratorNackRequired(const std::vector<uint16_t>& seqNumbers) override
+	{
+		this->nackBatches.push_back(seqNumbers);
+	};
+
+	void OnNackGeneratorKeyFrameRequired() override
+	{
+		this->keyFrameRequests++;
+	}
+
+public:
+	std::vector<std::vector<uint16_t>> nackBatches;
+	size_t keyFrameRequests{ 0u };
+};
+
+// Previous map based NackGenerator algorithm, used as reference model.
+class TestNackGeneratorModel
+{
+private:
+	static constexpr size_t MaxPacketAge{ 10000u };
+	static constexpr size_t MaxNackPackets{ 1000u };
+	static constexpr uint8_t MaxNackRetries{ 10u };
+
+private:
+	struct NackInfo
+	{
+		uint64_t createdAtMs{ 0u };
+		uint64_t sentAtMs{ 0u };
+		uint8_t retries{ 0u };
+	};
+
+public:
+	TestNackGeneratorModel(TestNackGeneratorRecorder* listener, unsigned int sendNackDelayMs)
+	  : listener(listener), sendNackDelayMs(sendNackDelayMs)
+	{
+	}
+
+public:
+	bool ReceivePacket(uint16_t seq, bool isKeyFrame, bool isRecovered, uint64_t nowMs)
+	{
+		if (!this->started)
+		{
+			this->started = true;
+			this->lastSeq = seq;
+
+			if (isKeyFrame)
+				this->keyFrameList.insert(seq);
+
+			return false;
+		}
+
+		if (seq == this->lastSeq)
+			return false;
+
+		if (SeqManager<uint16_t>::IsSeqLowerThan(seq, this->lastSeq))
+		{
+			auto it = this->nackList.find(seq);
+
+			if (it == this->nackList.end())
+				return false;
+
+			auto retries = it->second.retries;
+
+			this->nackList.erase(it);
+
+			return retries != 0;
+		}
+
+		if (isKeyFrame)
+			this->keyFrameList.insert(seq);
+
+		this->keyFrameList.erase(
+		  this->keyFrameList.begin(), this->keyFrameList.lower_bound(seq - MaxPacketAge));
+
+		if (isRecovered)
+		{
+			this->recoveredList.insert(seq);
+			this->recoveredList.erase(
+			  this->recoveredList.begin(), this->recoveredList.lower_bound(seq - MaxPacketAge));
+
+			return false;
+		}
+
+		AddPacketsToNackList(this->lastSeq + 1, seq, nowMs);
+
+		this->lastSeq = seq;
+
+		NackRequired(GetNackBatch(/*timedOut*/ false, nowMs));
+
+		return false;
+	}
+
+	void NackTimedOutPackets(uint64_t nowMs)
+	{
+		NackRequired(GetNackBatch(/*timedOut*/ true, nowMs));
+	}
+
+	size_t GetNackListLength() const
+	{
+		return this->nackList.size();
+	}
+
+	uint16_t GetLastSeq() const
+	{
+		return this->lastSeq;
+	}
+
+private:
+	void AddPacketsToNackList(uint16_t seqStart, uint16_t seqEnd, uint64_t nowMs)
+	{
+		this->nackList.erase(this->nackList.begin(), this->nackList.lower_bound(seqEnd - MaxPacketAge));
+
+		const uint16_t numNewNacks = seqEnd - seqStart;
+
+		if (this->nackList.size() + numNewNacks > MaxNackPackets)
+		{
+			while (RemoveNackItemsUntilKeyFrame() &&
+			       this->nackList.size() + numNewNacks > MaxNackPackets)
+			{
+			}
+
+			if (this->nackList.size() + numNewNacks > MaxNackPackets)
+			{
+				this->nackList.clear();
+				this->listener->OnNackGeneratorKeyFrameRequired();
+
+				return;
+			}
+		}
+
+		for (uint16_t seq = seqStart; seq != seqEnd; ++seq)
+		{
+			if (this->recoveredList.find(seq) == this->recoveredList.end())
+				this->nackList[seq].createdAtMs = nowMs;
+		}
+	}
+
+	bool RemoveNackItemsUntilKeyFrame()
+	{
+		while (!this->keyFrameList.empty())
+		{
+			auto it = this->nackList.lower_bound(*this->keyFrameList.begin());
+
+			if (it != this->nackList.begin())
+			{
+				this->nackList.erase(this->nackList.begin(), it);
+
+				return true;
+			}
+
+			this->keyFrameList.erase(this->keyFrameList.begin());
+		}
+
+		return false;
+	}
+
+	std::vector<uint16_t> GetNackBatch(bool timedOut, uint64_t nowMs)
+	{
+		std::vector<uint16_t> nackBatch;
+
+		for (auto it = this->nackList.begin(); it != this->nackList.end();)
+		{
+			auto& nackInfo = it->second;
+
+			// clang-format off
+			if (
+				(this->sendNackDelayMs > 0 && nowMs - nackInfo.createdAtMs < this->sendNackDelayMs) ||
+				(nackInfo.sentAtMs != 0 && (!timedOut || nowMs - nackInfo.sentAtMs < this->rtt))
+			)
+			// clang-format on
+			{
+				++it;
+
+				continue;
+			}
+
+			nackBatch.push_back(it->first);
+			nackInfo.retries++;
+			nackInfo.sentAtMs = nowMs;
+
+			if (nackInfo.retries >= MaxNackRetries)
+				it = this->nackList.erase(it);
+			else
+				++it;
+		}
+
+		return nackBatch;
+	}
+
+	void NackRequired(const std::vector<uint16_t>& nackBatch)
+	{
+		if (!nackBatch.empty())
+			this->listener->OnNackGeneratorNackRequired(nackBatch);
+	}
+
+private:
+	TestNackGeneratorRecorder* listener{ nullptr };
+	unsigned int sendNackDelayMs{ 0u };
+	std::map<uint16_t, NackInfo, SeqManager<uint16_t>::SeqLowerThan> nackList;
+	std::set<uint16_t, SeqManager<uint16_t>::SeqLowerThan> keyFrameList;
+	std::set<uint16_t, SeqManager<uint16_t>::SeqLowerThan> recoveredList;
+	bool started{ false };
+	uint16_t lastSeq{ 0u };
+	uint32_t rtt{ 100u };
+};
+
+bool receivePacket(
+  NackGenerator& nackGenerator, uint16_t seq, bool isKeyFrame, bool isRecovered, uint64_t nowMs)
+{
+	packet->EmplacePayloadDescriptorHandler<TestPayloadDescriptorHandler>(isKeyFrame);
+	packet->SetSequenceNumber(seq);
+
+	return nackGenerator.ReceivePacket(packet, isRecovered, nowMs);
+}
+
+// Feeds both with a random stream of packets, including lost, reordered,
+// retransmitted and recovered ones, and checks they behave the same.
+void validateAgainstModel(unsigned int sendNackDelayMs)
+{
+	TestNackGeneratorRecorder listener;
+	TestNackGeneratorRecorder modelListener;
+	NackGenerator nackGenerator(&listener, sendNackDelayMs);
+	TestNackGeneratorModel model(&modelListener, sendNackDelayMs);
+	std::mt19937 random(sendNackDelayMs); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+	std::uniform_int_distribution<int> percent(0, 99);
+	uint64_t nowMs{ 1000000u };
+	uint64_t nextTimerMs{ nowMs + 40u };
+	uint16_t seq{ 65000u };
+
+	nackGenerator.UpdateRtt(100u);
+
+	for (size_t idx{ 0u }; idx < 20000u; ++idx)
+	{
+		nowMs += std::uniform_int_distribution<int>(1, 20)(random);
+
+		for (; nextTimerMs <= nowMs; nextTimerMs += 40u)
+		{
+			nackGenerator.NackTimedOutPackets(nextTimerMs);
+			model.NackTimedOutPackets(nextTimerMs);
+		}
+
+		const auto lastSeq = model.GetLastSeq();
+		const auto event   = percent(random);
+		bool isRecovered{ false };
+
+		if (event < 70)
+		{
+			seq = lastSeq + 1u;
+		}
+		else if (event < 80)
+		{
+			seq = lastSeq + std::uniform_int_distribution<uint16_t>(2u, 10u)(random);
+		}
+		else if (event < 81)
+		{
+			seq = lastSeq + std::uniform_int_distribution<uint16_t>(100u, 1200u)(random);
+		}
+		else if (event < 95)
+		{
+			seq         = lastSeq - std::uniform_int_distribution<uint16_t>(1u, 30u)(random);
+			isRecovered = percent(random) < 50;
+		}
+		else
+		{
+			seq         = lastSeq + std::uniform_int_distribution<uint16_t>(1u, 5u)(random);
+			isRecovered = true;
+		}
+
+		const bool isKeyFrame = percent(random) < 3;
+
+		REQUIRE(
+		  receivePacket(nackGenerator, seq, isKeyFrame, isRecovered, nowMs) ==
+		  model.ReceivePacket(seq, isKeyFrame, isRecovered, nowMs));
+		REQUIRE(nackGenerator.GetNackListLength() == model.GetNackListLength());
+	}
+
+	REQUIRE(listener.nackBatches == modelListener.nackBatches);
+	REQUIRE(listener.keyFrameRequests == modelListener.keyFrameRequests);
+	// Make sure the stream covered all the cases.
+	REQUIRE(listener.nackBatches.size() > 1000u);
+	REQUIRE(listener.keyFrameRequests > 0u);
+}
+
 SCENARIO("NACK generator", "[rtp][rtcp]")
 {
 	SECTION("no NACKs required")
@@ -282,6 +575,152 @@ SCENARIO("NACK generator", "[rtp][rtcp]")
 		validate(inputs);
 	}
 
+	SECTION("Key Frame removes older packets from a too large Nack list")
+	{
+		// clang-format off
+		std::vector<TestNackGeneratorInput> inputs =
+		{
+			{    1, false,   0,   0, false,   0 },
+			{  500, false,   2, 498, false, 498 },
+			{  501,  true,   0,   0, false, 498 },
+			{ 1200, false, 502, 698, false, 698 }
+		};
+		// clang-format on
+
+		validate(inputs);
+	}
+
+	SECTION("sequence wrap across the window")
+	{
+		TestNackGeneratorRecorder listener;
+		NackGenerator nackGenerator(&listener, SendNackDelay);
+		uint64_t nowMs{ 1000000u };
+
+		REQUIRE(!receivePacket(nackGenerator, 65530, false, false, nowMs));
+		REQUIRE(!receivePacket(nackGenerator, 5, false, false, nowMs));
+		REQUIRE(listener.nackBatches.size() == 1u);
+		REQUIRE(
+		  listener.nackBatches[0] ==
+		  std::vector<uint16_t>{ 65531, 65532, 65533, 65534, 65535, 0, 1, 2, 3, 4 });
+		REQUIRE(nackGenerator.GetNackListLength() == 10u);
+
+		// Retransmitted packet.
+		REQUIRE(receivePacket(nackGenerator, 65533, false, true, nowMs));
+		REQUIRE(nackGenerator.GetNackListLength() == 9u);
+
+		// Lost packets stay in the list until they get older than MaxPacketAge.
+		for (uint16_t seq{ 6u }; seq != 3067u; ++seq)
+		{
+			receivePacket(nackGenerator, seq, false, false, ++nowMs);
+		}
+
+		REQUIRE(nackGenerator.GetNackListLength() == 9u);
+
+		receivePacket(nackGenerator, 3067u, false, false, ++nowMs);
+
+		REQUIRE(nackGenerator.GetNackListLength() == 8u);
+		REQUIRE(!receivePacket(nackGenerator, 65531, false, false, nowMs));
+		REQUIRE(receivePacket(nackGenerator, 65532, false, false, nowMs));
+		REQUIRE(nackGenerator.GetNackListLength() == 7u);
+
+		for (uint16_t seq{ 3068u }; seq != 3076u; ++seq)
+		{
+			receivePacket(nackGenerator, seq, false, false, ++nowMs);
+		}
+
+		REQUIRE(nackGenerator.GetNackListLength() == 1u);
+
+		receivePacket(nackGenerator, 3076u, false, false, ++nowMs);
+
+		REQUIRE(nackGenerator.GetNackListLength() == 0u);
+		REQUIRE(listener.nackBatches.size() == 1u);
+		REQUIRE(listener.keyFrameRequests == 0u);
+	}
+
+	SECTION("recovered packets ahead of the last seq are not NACKed")
+	{
+		TestNackGeneratorRecorder listener;
+		NackGenerator nackGenerator(&listener, SendNackDelay);
+		uint64_t nowMs{ 1000000u };
+
+		receivePacket(nackGenerator, 10, false, false, nowMs);
+
+		REQUIRE(!receivePacket(nackGenerator, 13, false, true, nowMs));
+		REQUIRE(listener.nackBatches.empty());
+
+		receivePacket(nackGenerator, 15, false, false, nowMs);
+
+		REQUIRE(listener.nackBatches.size() == 1u);
+		REQUIRE(listener.nackBatches[0] == std::vector<uint16_t>{ 11, 12, 14 });
+		REQUIRE(nackGenerator.GetNackListLength() == 3u);
+		REQUIRE(!receivePacket(nackGenerator, 13, false, false, nowMs));
+		REQUIRE(nackGenerator.GetNackListLength() == 3u);
+
+		// A recovered key frame ahead lets drop the older lost packets when the
+		// NACK list gets too large.
+		REQUIRE(!receivePacket(nackGenerator, 500, true, true, nowMs));
+
+		receivePacket(nackGenerator, 1014, false, false, nowMs);
+
+		REQUIRE(listener.nackBatches.size() == 2u);
+		REQUIRE(listener.nackBatches[1].size() == 997u);
+		REQUIRE(listener.nackBatches[1].front() == 16u);
+		REQUIRE(listener.nackBatches[1].back() == 1013u);
+		REQUIRE(
+		  std::find(listener.nackBatches[1].begin(), listener.nackBatches[1].end(), 500u) ==
+		  listener.nackBatches[1].end());
+		REQUIRE(nackGenerator.GetNackListLength() == 997u);
+		REQUIRE(listener.keyFrameRequests == 0u);
+	}
+
+	SECTION("NACK delay and RTT are measured across the 16 bit time wrap")
+	{
+		// Truncated to 16 bits, times start 36 ms before wrapping.
+		const uint64_t startMs{ (uint64_t{ 1u } << 20) - 36u };
+
+		{
+			TestNackGeneratorRecorder listener;
+			NackGenerator nackGenerator(&listener, 50u);
+
+			receivePacket(nackGenerator, 100, false, false, startMs);
+			receivePacket(nackGenerator, 102, false, false, startMs);
+			nackGenerator.NackTimedOutPackets(startMs + 40u);
+
+			REQUIRE(listener.nackBatches.empty());
+
+			nackGenerator.NackTimedOutPackets(startMs + 55u);
+
+			REQUIRE(listener.nackBatches.size() == 1u);
+			REQUIRE(listener.nackBatches[0] == std::vector<uint16_t>{ 101 });
+		}
+
+		{
+			TestNackGeneratorRecorder listener;
+			NackGenerator nackGenerator(&listener, 0u);
+
+			nackGenerator.UpdateRtt(100u);
+			receivePacket(nackGenerator, 100, false, false, startMs);
+			receivePacket(nackGenerator, 102, false, false, startMs);
+
+			REQUIRE(listener.nackBatches.size() == 1u);
+
+			nackGenerator.NackTimedOutPackets(startMs + 99u);
+
+			REQUIRE(listener.nackBatches.size() == 1u);
+
+			nackGenerator.NackTimedOutPackets(startMs + 100u);
+
+			REQUIRE(listener.nackBatches.size() == 2u);
+			REQUIRE(listener.nackBatches[1] == std::vector<uint16_t>{ 101 });
+		}
+	}
+
+	SECTION("behaves as the previous algorithm")
+	{
+		validateAgainstModel(0u);
+		validateAgainstModel(10u);
+	}
+
 	// Must run the loop to wait for UV timers and close them.
 	DepLibUV::RunLoop();
 }
@@ -0,0 +1,189 @@
+#include "common.hpp"
+#include "Utils.hpp"
+#include "RTC/RtcLogger.hpp"
+#include <catch2/catch.hpp>
+#include <cstring> // std::memcpy()
+#include <vector>
+
+using namespace RTC;
+
+SCENARIO("RtcLogger::TraceRing", "[rtclogger]")
+{
+	auto getRecords = []()
+	{
+		json data = json::object();
+		std::vector<RtcLogger::TraceRing::Record> records;
+
+		RtcLogger::TraceRing::FillJson(data);
+
+		REQUIRE(data["recordSize"] == sizeof(RtcLogger::TraceRing::Record));
+
+		for (const auto& chunk : data["records"])
+		{
+			size_t len;
+			auto* bytes = Utils::String::Base64Decode(chunk.get<std::string>(), len);
+
+			REQUIRE(len % sizeof(RtcLogger::TraceRing::Record) == 0);
+
+			const auto offset = records.size();
+
+			records.resize(offset + len / sizeof(RtcLogger::TraceRing::Record));
+			std::memcpy(records.data() + offset, bytes, len);
+		}
+
+		return records;
+	};
+
+	SECTION("disabled by default")
+	{
+		REQUIRE(!RtcLogger::TraceRing::IsEnabled());
+
+		RtcLogger::TraceRing::SetCapacity(4u);
+
+		REQUIRE(RtcLogger::TraceRing::IsEnabled());
+
+		RtcLogger::TraceRing::SetCapacity(0u);
+
+		REQUIRE(!RtcLogger::TraceRing::IsEnabled());
+	}
+
+	SECTION("records sent and dropped packets, oldest first")
+	{
+		RtcLogger::TraceRing::SetCapacity(4u);
+
+		const RtcLogger::ObjectHandle router("router-1");
+		const RtcLogger::ObjectHandle consumer("consumer-1");
+		RtcLogger::RtpPacket packet;
+
+		packet.timestamp        = 1000u;
+		packet.routerHandle     = router.value;
+		packet.recvSsrc         = 1234u;
+		packet.recvRtpTimestamp = 0u;
+		packet.recvSeqNumber    = 0u;
+
+		for (uint16_t seq{ 1u }; seq <= 6u; ++seq)
+		{
+			packet.consumerHandle = consumer.value;
+			packet.recvSeqNumber  = seq;
+			packet.sendSeqNumber  = seq + 100u;
+
+			if (seq % 2 == 0)
+				packet.Dropped(RtcLogger::RtpPacket::DropReason::NOT_A_KEYFRAME);
+			else
+				packet.Sent();
+		}
+
+		auto records = getRecords();
+
+		REQUIRE(records.size() == 4u);
+
+		for (size_t idx{ 0u }; idx < records.size(); ++idx)
+		{
+			const auto& record = records[idx];
+			const uint16_t seq = idx + 3u;
+
+			REQUIRE(record.timestamp == 1000u);
+			REQUIRE(record.routerHandle == router.value);
+			REQUIRE(record.consumerHandle == consumer.value);
+			REQUIRE(record.recvSsrc == 1234u);
+			REQUIRE(record.recvSeqNumber == seq);
+			REQUIRE(record.sendSeqNumber == seq + 100u);
+
+			const auto dropReason = seq % 2 == 0 ? RtcLogger::RtpPacket::DropReason::NOT_A_KEYFRAME
+			                                     : RtcLogger::RtpPacket::DropReason::NONE;
+
+			REQUIRE(record.dropped == (seq % 2 == 0 ? 1u : 0u));
+			REQUIRE(record.dropReason == static_cast<uint8_t>(dropReason));
+		}
+
+		// Per Consumer fields are cleared once the packet is sent or dropped.
+		REQUIRE(packet.consumerHandle == 0u);
+		REQUIRE(packet.routerHandle == router.value);
+
+		json data = json::object();
+
+		RtcLogger::TraceRing::FillJson(data);
+
+		REQUIRE(data["numWritten"] == 6u);
+		REQUIRE(data["objects"][std::to_string(router.value)] == "router-1");
+		REQUIRE(data["objects"][std::to_string(consumer.value)] == "consumer-1");
+
+		RtcLogger::TraceRing::SetCapacity(0u);
+	}
+
+	SECTION("object handles")
+	{
+		uint32_t handle;
+
+		{
+			const RtcLogger::ObjectHandle producer("producer-1");
+
+			handle = producer.value;
+
+			REQUIRE(handle != 0u);
+			REQUIRE(*RtcLogger::TraceRing::GetObjectId(handle) == "producer-1");
+		}
+
+		REQUIRE(RtcLogger::TraceRing::GetObjectId(handle) == nullptr);
+	}
+
+	SECTION("ids of unregistered objects are kept while records refer to them")
+	{
+		RtcLogger::TraceRing::SetCapacity(2u);
+
+		uint32_t handle;
+		RtcLogger::RtpPacket packet;
+
+		{
+			const RtcLogger::ObjectHandle producer("producer-1");
+
+			handle                = producer.value;
+			packet.producerHandle = handle;
+
+			packet.Sent();
+		}
+
+		json data = json::object();
+
+		RtcLogger::TraceRing::FillJson(data);
+
+		REQUIRE(data["objects"][std::to_string(handle)] == "producer-1");
+
+		// Records referring to it get overwritten.
+		packet.producerHandle = 0u;
+
+		packet.Sent();
+
+		REQUIRE(*RtcLogger::TraceRing::GetObjectId(handle) == "producer-1");
+
+		packet.Sent();
+
+		data = json::object();
+
+		RtcLogger::TraceRing::FillJson(data);
+
+		REQUIRE(data["objects"].find(std::to_string(handle)) == data["objects"].end());
+		REQUIRE(RtcLogger::TraceRing::GetObjectId(handle) == nullptr);
+
+		// Objects unregistered without packets being written are not kept
+		// forever.
+		for (size_t i{ 0u }; i < 100u; ++i)
+		{
+			const RtcLogger::ObjectHandle consumer("consumer");
+
+			handle = consumer.value;
+		}
+
+		REQUIRE(RtcLogger::TraceRing::GetObjectId(handle) != nullptr);
+
+		data = json::object();
+
+		RtcLogger::TraceRing::FillJson(data);
+
+		REQUIRE(data["objects"].size() <= 20u);
+
+		RtcLogger::TraceRing::SetCapacity(0u);
+
+		REQUIRE(RtcLogger::TraceRing::GetObjectId(handle) == nullptr);
+	}
+}
@@ -2,7 +2,7 @@
 #include "helpers.hpp"
 #include "RTC/RtpPacket.hpp"
 #include <catch2/catch.hpp>
-#include <cstring> // std::memset()
+#include <cstring> // std::memcmp(), std::memcpy(), std::memset()
 #include <string>
 #include <vector>
 
@@ -842,4 +842,88 @@ SCENARIO("parse RTP packets", "[parser][rtp]")
 
 		delete packet;
 	}
+
+	SECTION("write RtpPacket applying a rewrite plan")
+	{
+		// clang-format off
+		uint8_t buffer[] =
+		{
+			0x90, 0x01, 0x00, 0x08,
+			0x00, 0x00, 0x00, 0x04,
+			0x00, 0x00, 0x00, 0x05,
+			0xbe, 0xde, 0x00, 0x02, // Header Extension
+			0x12, 0x61, 0x62, 0x63, // MID "abc"
+			0x21, 0x00, 0x00, 0x00, // Transport-CC and padding
+			0x01, 0x02, 0x03, 0x04
+		};
+		// clang-format on
+
+		uint8_t original[sizeof(buffer)];
+		uint8_t written[sizeof(buffer)];
+
+		std::memcpy(original, buffer, sizeof(buffer));
+
+		RtpPacket* packet = RtpPacket::Parse(buffer, sizeof(buffer));
+
+		if (!packet)
+			FAIL("not a RTP packet");
+
+		packet->SetMidExtensionId(1);
+		packet->SetTransportWideCc01ExtensionId(2);
+
+		RtpPacket::RewritePlan rewritePlan;
+
+		rewritePlan.ssrc           = 6;
+		rewritePlan.sequenceNumber = 9;
+		rewritePlan.timestamp      = 7;
+		rewritePlan.mid[0]         = 'x';
+		rewritePlan.midLen         = 1;
+
+		packet->SetRewritePlan(&rewritePlan);
+
+		REQUIRE(packet->GetRewritePlan() == &rewritePlan);
+		REQUIRE(packet->GetSequenceNumber() == 9);
+		REQUIRE(packet->GetTimestamp() == 7);
+		REQUIRE(packet->GetSsrc() == 6);
+		REQUIRE(packet->UpdateTransportWideCc01(0x1234) == true);
+		REQUIRE(rewritePlan.hasTransportWideCc01 == true);
+		REQUIRE(rewritePlan.wideSeqNumber == 0x1234);
+		REQUIRE(packet->UpdateAbsSendTime(1000) == false);
+		REQUIRE(rewritePlan.hasAbsSendTime == false);
+
+		packet->Write(written);
+
+		// The packet itself must be untouched.
+		REQUIRE(std::memcmp(buffer, original, sizeof(buffer)) == 0);
+
+		packet->SetRewritePlan(nullptr);
+
+		REQUIRE(packet->GetSequenceNumber() == 8);
+		REQUIRE(packet->GetTimestamp() == 4);
+		REQUIRE(packet->GetSsrc() == 5);
+
+		RtpPacket* writtenPacket = RtpPacket::Parse(written, sizeof(written));
+
+		if (!writtenPacket)
+			FAIL("not a RTP packet");
+
+		writtenPacket->SetMidExtensionId(1);
+		writtenPacket->SetTransportWideCc01ExtensionId(2);
+
+		std::string mid;
+		uint16_t wideSeqNumber;
+
+		REQUIRE(writtenPacket->GetSequenceNumber() == 9);
+		REQUIRE(writtenPacket->GetTimestamp() == 7);
+		REQUIRE(writtenPacket->GetSsrc() == 6);
+		REQUIRE(writtenPacket->ReadMid(mid) == true);
+		REQUIRE(mid == "x");
+		REQUIRE(writtenPacket->ReadTransportWideCc01(wideSeqNumber) == true);
+		REQUIRE(wideSeqNumber == 0x1234);
+		REQUIRE(writtenPacket->GetPayloadLength() == 4);
+		REQUIRE(writtenPacket->GetPayload()[0] == 0x01);
+
+		delete writtenPacket;
+		delete packet;
+	}
 }
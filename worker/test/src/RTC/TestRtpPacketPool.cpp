@@ -0,0 +1,125 @@
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/RtpPacketPool.hpp"
+#include <catch2/catch.hpp>
+
+using namespace RTC;
+
+SCENARIO("RtpPacketPool", "[rtp][pool]")
+{
+	// clang-format off
+	uint8_t buffer[] =
+	{
+		0b10000000, 0b01111011, 0b01010010, 0b00001110,
+		0b01011011, 0b01101011, 0b11001010, 0b10110101,
+		0, 0, 0, 2
+	};
+	// clang-format on
+
+	SECTION("deleted packet memory is reused")
+	{
+		const auto inUse = RtpPacketPool::GetPacketPool().GetInUse();
+		auto* packet1    = RtpPacket::Parse(buffer, sizeof(buffer));
+
+		REQUIRE(packet1);
+		REQUIRE(RtpPacketPool::GetPacketPool().GetInUse() == inUse + 1);
+		REQUIRE(RtpPacketPool::GetPacketPool().GetHighWater() >= inUse + 1);
+
+		delete packet1;
+
+		REQUIRE(RtpPacketPool::GetPacketPool().GetInUse() == inUse);
+
+		auto* packet2 = RtpPacket::Parse(buffer, sizeof(buffer));
+
+		REQUIRE(packet2 == packet1);
+
+		delete packet2;
+	}
+
+	SECTION("cloned packet buffer comes from the pool")
+	{
+		auto* packet       = RtpPacket::Parse(buffer, sizeof(buffer));
+		const auto inUse   = RtpPacketPool::GetBufferPool().GetInUse();
+		auto* clonedPacket = packet->Clone();
+
+		REQUIRE(RtpPacketPool::GetBufferPool().GetInUse() == inUse + 1);
+		REQUIRE(RtpPacketPool::GetBufferPool().GetBlockSize() >= MtuSize);
+		REQUIRE(clonedPacket->GetSize() == packet->GetSize());
+		REQUIRE(clonedPacket->GetSequenceNumber() == packet->GetSequenceNumber());
+
+		delete clonedPacket;
+
+		REQUIRE(RtpPacketPool::GetBufferPool().GetInUse() == inUse);
+
+		delete packet;
+	}
+
+	SECTION("SharedPtr deletes the packet when the last reference is gone")
+	{
+		const auto inUse = RtpPacketPool::GetPacketPool().GetInUse();
+
+		RtpPacket::SharedPtr sharedPacket1;
+
+		REQUIRE(!sharedPacket1);
+		REQUIRE(sharedPacket1.use_count() == 0u);
+
+		sharedPacket1.reset(RtpPacket::Parse(buffer, sizeof(buffer)));
+
+		REQUIRE(sharedPacket1);
+		REQUIRE(sharedPacket1.use_count() == 1u);
+
+		{
+			RtpPacket::SharedPtr sharedPacket2 = sharedPacket1;
+
+			REQUIRE(sharedPacket2.get() == sharedPacket1.get());
+			REQUIRE(sharedPacket1.use_count() == 2u);
+		}
+
+		REQUIRE(sharedPacket1.use_count() == 1u);
+		REQUIRE(RtpPacketPool::GetPacketPool().GetInUse() == inUse + 1);
+
+		sharedPacket1.reset();
+
+		REQUIRE(!sharedPacket1);
+		REQUIRE(RtpPacketPool::GetPacketPool().GetInUse() == inUse);
+	}
+
+	SECTION("SharedPtr reset() and assignment to the same packet keep it alive")
+	{
+		const auto inUse = RtpPacketPool::GetPacketPool().GetInUse();
+
+		RtpPacket::SharedPtr sharedPacket1(RtpPacket::Parse(buffer, sizeof(buffer)));
+		auto* packet = sharedPacket1.get();
+
+		sharedPacket1.reset(sharedPacket1.get());
+
+		REQUIRE(sharedPacket1.get() == packet);
+		REQUIRE(sharedPacket1.use_count() == 1u);
+		REQUIRE(sharedPacket1->GetSequenceNumber() == packet->GetSequenceNumber());
+
+		const auto& sharedPacketRef = sharedPacket1;
+
+		sharedPacket1 = sharedPacketRef;
+
+		REQUIRE(sharedPacket1.get() == packet);
+		REQUIRE(sharedPacket1.use_count() == 1u);
+		REQUIRE(RtpPacketPool::GetPacketPool().GetInUse() == inUse + 1);
+
+		sharedPacket1.reset();
+
+		REQUIRE(RtpPacketPool::GetPacketPool().GetInUse() == inUse);
+	}
+
+	SECTION("FillJson() reports pool occupancy")
+	{
+		json data = json::object();
+
+		RtpPacketPool::FillJson(data);
+
+		REQUIRE(data["packets"]["inUse"] == RtpPacketPool::GetPacketPool().GetInUse());
+		REQUIRE(data["packets"]["highWater"] == RtpPacketPool::GetPacketPool().GetHighWater());
+		REQUIRE(data["packets"]["capacity"] == RtpPacketPool::GetPacketPool().GetCapacity());
+		REQUIRE(data["buffers"]["inUse"] == RtpPacketPool::GetBufferPool().GetInUse());
+		REQUIRE(data["buffers"]["highWater"] == RtpPacketPool::GetBufferPool().GetHighWater());
+	}
+}
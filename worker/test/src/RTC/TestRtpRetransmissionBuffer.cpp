@@ -7,7 +7,7 @@
 using namespace RTC;
 
 // Class inheriting from RtpRetransmissionBuffer so we can access its protected
-// buffer member.
+// buffer accessors.
 class RtpMyRetransmissionBuffer : public RtpRetransmissionBuffer
 {
 public:
@@ -41,19 +41,19 @@ public:
 		packet->SetSequenceNumber(seq);
 		packet->SetTimestamp(timestamp);
 
-		std::shared_ptr<RtpPacket> sharedPacket;
+		RtpPacket::SharedPtr sharedPacket;
 
 		RtpRetransmissionBuffer::Insert(packet, sharedPacket);
 	}
 
 	void AssertBuffer(std::vector<VerificationItem> verificationBuffer)
 	{
-		REQUIRE(verificationBuffer.size() == this->buffer.size());
+		REQUIRE(verificationBuffer.size() == GetBufferSize());
 
 		for (size_t idx{ 0u }; idx < verificationBuffer.size(); ++idx)
 		{
 			auto& verificationItem = verificationBuffer.at(idx);
-			auto* item             = this->buffer.at(idx);
+			auto* item             = GetBufferItem(idx);
 
 			REQUIRE(verificationItem.isPresent == !!item);
 
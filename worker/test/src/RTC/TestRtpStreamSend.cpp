@@ -22,7 +22,7 @@ static RtpPacket* CreateRtpPacket(uint8_t* buffer, uint16_t seq, uint32_t timest
 
 static void SendRtpPacket(std::vector<std::pair<RtpStreamSend*, uint32_t>> streams, RtpPacket* packet)
 {
-	std::shared_ptr<RtpPacket> sharedPacket;
+	RtpPacket::SharedPtr sharedPacket;
 
 	for (auto& stream : streams)
 	{
@@ -497,7 +497,7 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp][nack]")
 			auto* packet = RtpPacket::Parse(rtpBuffer1, 1500);
 			packet->SetSsrc(1111);
 
-			std::shared_ptr<RtpPacket> sharedPacket(packet);
+			RtpPacket::SharedPtr sharedPacket(packet);
 
 			stream->ReceivePacket(packet, sharedPacket);
 		}
@@ -514,7 +514,7 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp][nack]")
 
 		for (size_t i = 0; i < iterations; i++)
 		{
-			std::shared_ptr<RtpPacket> sharedPacket;
+			RtpPacket::SharedPtr sharedPacket;
 
 			// Create packet.
 			auto* packet = RtpPacket::Parse(rtpBuffer1, 1500);
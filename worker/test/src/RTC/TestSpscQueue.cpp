@@ -0,0 +1,101 @@
+#include "common.hpp"
+#include "RTC/SpscQueue.hpp"
+#include <catch2/catch.hpp>
+#include <memory> // std::unique_ptr
+#include <thread>
+
+using namespace RTC;
+
+SCENARIO("SpscQueue", "[spscqueue]")
+{
+	SECTION("capacity is rounded up to a power of two")
+	{
+		SpscQueue<int> queue(100);
+
+		REQUIRE(queue.GetCapacity() == 128);
+		REQUIRE(queue.GetSize() == 0);
+	}
+
+	SECTION("items are popped in order and Push() fails when full")
+	{
+		SpscQueue<int> queue(4);
+		int item;
+
+		REQUIRE(queue.Pop(item) == false);
+
+		for (int i{ 0 }; i < 4; ++i)
+		{
+			REQUIRE(queue.Push(i));
+		}
+
+		REQUIRE(queue.Push(4) == false);
+		REQUIRE(queue.GetSize() == 4);
+
+		for (int i{ 0 }; i < 4; ++i)
+		{
+			REQUIRE(queue.Pop(item));
+			REQUIRE(item == i);
+		}
+
+		REQUIRE(queue.Pop(item) == false);
+
+		// Wrap around.
+		REQUIRE(queue.Push(5));
+		REQUIRE(queue.Pop(item));
+		REQUIRE(item == 5);
+	}
+
+	SECTION("move-only items")
+	{
+		SpscQueue<std::unique_ptr<int>> queue(2);
+		std::unique_ptr<int> item;
+
+		REQUIRE(queue.Push(std::unique_ptr<int>(new int(7))));
+		REQUIRE(queue.Pop(item));
+		REQUIRE(*item == 7);
+	}
+
+	SECTION("producer and consumer in different threads")
+	{
+		static constexpr size_t NumItems{ 100000u };
+
+		SpscQueue<size_t> queue(64);
+		size_t expected{ 0u };
+		bool ordered{ true };
+
+		std::thread consumer(
+		  [&queue, &expected, &ordered]()
+		  {
+			  size_t item;
+
+			  while (expected < NumItems)
+			  {
+				  if (!queue.Pop(item))
+				  {
+					  std::this_thread::yield();
+
+					  continue;
+				  }
+
+				  if (item != expected)
+					  ordered = false;
+
+				  ++expected;
+			  }
+		  });
+
+		for (size_t i{ 0u }; i < NumItems; ++i)
+		{
+			while (!queue.Push(i))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		consumer.join();
+
+		REQUIRE(expected == NumItems);
+		REQUIRE(ordered);
+		REQUIRE(queue.GetSize() == 0);
+	}
+}
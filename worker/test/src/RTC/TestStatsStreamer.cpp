@@ -0,0 +1,342 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "MediaSoupErrors.hpp"
+#include "PayloadChannel/PayloadChannelNotifier.hpp"
+#include "PayloadChannel/PayloadChannelSocket.hpp"
+#include "RTC/RtpStreamSend.hpp"
+#include "RTC/StatsStreamer.hpp"
+#include <catch2/catch.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace RTC;
+
+struct Notification
+{
+	std::string message;
+	std::vector<uint8_t> payload;
+
+	json GetData() const
+	{
+		return json::parse(this->message)["data"];
+	}
+};
+
+static PayloadChannelReadFreeFn payloadChannelRead(
+  uint8_t** /*message*/,
+  uint32_t* /*messageLen*/,
+  size_t* /*messageCtx*/,
+  uint8_t** /*payload*/,
+  uint32_t* /*payloadLen*/,
+  size_t* /*payloadCapacity*/,
+  const void* /*handle*/,
+  PayloadChannelReadCtx /*ctx*/)
+{
+	return nullptr;
+}
+
+static void payloadChannelWrite(
+  const uint8_t* message,
+  uint32_t messageLen,
+  const uint8_t* payload,
+  uint32_t payloadLen,
+  ChannelWriteCtx ctx)
+{
+	auto* notifications = static_cast<std::vector<Notification>*>(ctx);
+
+	notifications->push_back(Notification{
+	  std::string(reinterpret_cast<const char*>(message), messageLen),
+	  std::vector<uint8_t>(payload, payload + payloadLen) });
+}
+
+static uint64_t readVarint(const std::vector<uint8_t>& payload, size_t& pos)
+{
+	uint64_t value{ 0u };
+
+	for (uint8_t shift{ 0u };; shift += 7)
+	{
+		const uint8_t byte = payload.at(pos++);
+
+		value |= static_cast<uint64_t>(byte & 0x7Fu) << shift;
+
+		if ((byte & 0x80u) == 0u)
+			return value;
+	}
+}
+
+// Applies the deltas in the payload to the given values of each entry.
+static void applyPayload(
+  const std::vector<uint8_t>& payload, std::map<uint64_t, StatsStreamer::Values>& entries)
+{
+	REQUIRE(payload.at(0) == static_cast<uint8_t>(StatsStreamer::Version));
+
+	size_t pos{ 1u };
+
+	while (pos < payload.size())
+	{
+		const uint64_t entryId = readVarint(payload, pos);
+		const uint64_t mask    = readVarint(payload, pos);
+		auto& values           = entries[entryId];
+
+		for (size_t idx{ 0u }; idx < StatsStreamer::MaxValues; ++idx)
+		{
+			if ((mask & (uint64_t{ 1u } << idx)) == 0u)
+				continue;
+
+			const uint64_t zigZag = readVarint(payload, pos);
+
+			values[idx] += static_cast<int64_t>(zigZag >> 1) ^ -static_cast<int64_t>(zigZag & 1u);
+		}
+	}
+}
+
+class TestStatsSource : public StatsStreamer::Source
+{
+public:
+	void FillStatsStream(uint64_t /*nowMs*/, StatsStreamer* statsStreamer) override
+	{
+		for (const auto& kv : this->streams)
+		{
+			statsStreamer->AddStats(StatsStreamer::Type::OUTBOUND_RTP, kv.first, kv.second);
+		}
+	}
+
+public:
+	std::map<uint32_t, StatsStreamer::Values> streams;
+};
+
+// Sends the stats of a real RtpStreamSend, simulating traffic on it.
+class TestRtpStreamStatsSource : public StatsStreamer::Source
+{
+public:
+	explicit TestRtpStreamStatsSource(RtpStreamSend* rtpStream) : rtpStream(rtpStream)
+	{
+	}
+
+public:
+	void FillStatsStream(uint64_t nowMs, StatsStreamer* statsStreamer) override
+	{
+		StatsStreamer::Values values{};
+
+		this->rtpStream->FillStatsValues(nowMs, values);
+
+		++this->round;
+
+		values[StatsStreamer::PACKET_COUNT] += this->round * 100;
+		values[StatsStreamer::BYTE_COUNT] += this->round * 120000;
+		values[StatsStreamer::BITRATE] += this->round % 2 == 0 ? 1000000 : 1001000;
+
+		statsStreamer->AddStats(StatsStreamer::Type::OUTBOUND_RTP, this->rtpStream->GetSsrc(), values);
+	}
+
+private:
+	RtpStreamSend* rtpStream{ nullptr };
+	int64_t round{ 0 };
+};
+
+class TestRtpStreamListener : public RtpStreamSend::Listener
+{
+public:
+	void OnRtpStreamScore(RtpStream* /*rtpStream*/, uint8_t /*score*/, uint8_t /*previousScore*/) override
+	{
+	}
+
+	void OnRtpStreamRetransmitRtpPacket(RtpStreamSend* /*rtpStream*/, RtpPacket* /*packet*/) override
+	{
+	}
+};
+
+SCENARIO("StatsStreamer", "[stats]")
+{
+	std::vector<Notification> notifications;
+	PayloadChannel::PayloadChannelSocket payloadChannel(
+	  payloadChannelRead, nullptr, payloadChannelWrite, &notifications);
+	PayloadChannel::PayloadChannelNotifier payloadChannelNotifier(&payloadChannel);
+	StatsStreamer statsStreamer(&payloadChannelNotifier);
+
+	SECTION("sends deltas of changed values")
+	{
+		TestStatsSource source;
+		std::map<uint64_t, StatsStreamer::Values> entries;
+
+		source.streams[1111u][StatsStreamer::PACKET_COUNT] = 100;
+		source.streams[1111u][StatsStreamer::BYTE_COUNT]   = 120000;
+		source.streams[1111u][StatsStreamer::SCORE]        = 10;
+
+		statsStreamer.AddSource(&source, "consumer-1");
+		statsStreamer.SendStats();
+
+		REQUIRE(notifications.size() == 1u);
+		REQUIRE(json::parse(notifications[0].message)["event"] == "stats");
+
+		const auto data = notifications[0].GetData();
+
+		REQUIRE(data["added"].size() == 1u);
+		REQUIRE(data["added"][0]["id"] == "consumer-1");
+		REQUIRE(data["added"][0]["type"] == "outbound-rtp");
+		REQUIRE(data["added"][0]["ssrc"] == 1111u);
+		REQUIRE(data["removed"].empty());
+
+		const auto entryId = data["added"][0]["entryId"].get<uint64_t>();
+
+		applyPayload(notifications[0].payload, entries);
+
+		REQUIRE(entries[entryId] == source.streams[1111u]);
+
+		// Nothing changed, so nothing is sent.
+		statsStreamer.SendStats();
+
+		REQUIRE(notifications.size() == 1u);
+
+		// A counter goes up and the score goes down.
+		source.streams[1111u][StatsStreamer::PACKET_COUNT] = 150;
+		source.streams[1111u][StatsStreamer::SCORE]        = 7;
+
+		statsStreamer.SendStats();
+
+		REQUIRE(notifications.size() == 2u);
+		REQUIRE(notifications[1].GetData()["added"].empty());
+		// Version, entryId, mask (2 bytes) and 2 deltas.
+		REQUIRE(notifications[1].payload.size() == 6u);
+
+		applyPayload(notifications[1].payload, entries);
+
+		REQUIRE(entries[entryId] == source.streams[1111u]);
+
+		// The stream is gone.
+		source.streams.clear();
+
+		statsStreamer.SendStats();
+
+		REQUIRE(notifications.size() == 3u);
+		REQUIRE(notifications[2].GetData()["removed"] == json::array({ entryId }));
+		REQUIRE(notifications[2].payload.size() == 1u);
+
+		// And so is the source.
+		source.streams[2222u][StatsStreamer::PACKET_COUNT] = 1;
+
+		statsStreamer.SendStats();
+		statsStreamer.RemoveSource(&source);
+		statsStreamer.SendStats();
+
+		REQUIRE(notifications.size() == 5u);
+		REQUIRE(notifications[4].GetData()["removed"].size() == 1u);
+		REQUIRE(
+		  notifications[4].GetData()["removed"][0] == notifications[3].GetData()["added"][0]["entryId"]);
+	}
+
+	SECTION("subscribing sends all values again")
+	{
+		TestStatsSource source;
+
+		source.streams[1111u][StatsStreamer::PACKET_COUNT] = 100;
+
+		statsStreamer.AddSource(&source, "consumer-1");
+		statsStreamer.SendStats();
+
+		REQUIRE_THROWS_AS(statsStreamer.Subscribe(10u), MediaSoupTypeError);
+
+		statsStreamer.Subscribe(1000u);
+
+		REQUIRE(statsStreamer.IsSubscribed());
+
+		statsStreamer.SendStats();
+
+		REQUIRE(notifications.size() == 2u);
+		REQUIRE(notifications[1].GetData()["added"].size() == 1u);
+		REQUIRE(notifications[1].payload.size() > 1u);
+
+		statsStreamer.Unsubscribe();
+
+		REQUIRE(!statsStreamer.IsSubscribed());
+
+		statsStreamer.RemoveSource(&source);
+	}
+
+	payloadChannel.Close();
+
+	// Let the loop release the handles.
+	uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+}
+
+SCENARIO("StatsStreamer benchmark", "[stats][.benchmark]")
+{
+	constexpr size_t NumStreams{ 1000u };
+
+	std::vector<Notification> notifications;
+	PayloadChannel::PayloadChannelSocket payloadChannel(
+	  payloadChannelRead, nullptr, payloadChannelWrite, &notifications);
+	PayloadChannel::PayloadChannelNotifier payloadChannelNotifier(&payloadChannel);
+	StatsStreamer statsStreamer(&payloadChannelNotifier);
+	TestRtpStreamListener listener;
+	std::vector<RtpStreamSend*> rtpStreams;
+	std::vector<TestRtpStreamStatsSource*> sources;
+	std::string mid;
+
+	for (size_t idx{ 0u }; idx < NumStreams; ++idx)
+	{
+		RtpStream::Params params;
+
+		params.ssrc          = 1000u + idx;
+		params.clockRate     = 90000;
+		params.mimeType.type = RTC::RtpCodecMimeType::Type::VIDEO;
+
+		auto* rtpStream = new RtpStreamSend(&listener, params, mid);
+		auto* source    = new TestRtpStreamStatsSource(rtpStream);
+
+		rtpStreams.push_back(rtpStream);
+		sources.push_back(source);
+
+		statsStreamer.AddSource(source, "consumer-" + std::to_string(idx));
+	}
+
+	// The first notification announces every entry.
+	statsStreamer.SendStats();
+
+	REQUIRE(notifications.size() == 1u);
+	REQUIRE(notifications[0].GetData()["added"].size() == NumStreams);
+
+	BENCHMARK("getStats() of 1000 RTP streams")
+	{
+		size_t len{ 0u };
+
+		for (auto* rtpStream : rtpStreams)
+		{
+			json data = json::array();
+
+			data.emplace_back(json::value_t::object);
+			rtpStream->FillJsonStats(data[0]);
+
+			len += data.dump().length();
+		}
+
+		return len;
+	};
+
+	BENCHMARK("stats stream of 1000 RTP streams")
+	{
+		notifications.clear();
+
+		statsStreamer.SendStats();
+
+		return notifications.back().payload.size();
+	};
+
+	for (auto* source : sources)
+	{
+		statsStreamer.RemoveSource(source);
+
+		delete source;
+	}
+
+	for (auto* rtpStream : rtpStreams)
+	{
+		delete rtpStream;
+	}
+
+	payloadChannel.Close();
+
+	// Let the loop release the handles.
+	uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+}
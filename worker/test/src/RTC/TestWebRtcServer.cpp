@@ -0,0 +1,401 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "RTC/PortManager.hpp"
+#include "RTC/WebRtcServer.hpp"
+#include "handles/UdpSocketHandler.hpp"
+#include <absl/hash/hash.h>
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace RTC;
+
+using UsernameFragmentKey = WebRtcServer::UsernameFragmentKey;
+
+#ifdef __linux__
+static constexpr uint32_t ReusePortNoIndex{ 0xFFFFFFFF };
+
+// Runs the given classic BPF program on the given packet as the kernel does
+// (just with the instructions used by the reusePort filter). A load out of the
+// packet ends it with 0.
+static uint32_t runReusePortFilter(
+  const std::vector<struct sock_filter>& filter, const std::vector<uint8_t>& packet)
+{
+	uint32_t a{ 0u };
+	uint32_t x{ 0u };
+	uint32_t mem[BPF_MEMWORDS]{};
+
+	auto load = [&packet](uint64_t offset, size_t size, uint32_t& value) -> bool
+	{
+		if (offset + size > packet.size())
+			return false;
+
+		value = 0u;
+
+		for (size_t i{ 0u }; i < size; ++i)
+		{
+			value = (value << 8) | packet[offset + i];
+		}
+
+		return true;
+	};
+
+	for (size_t pc{ 0u }; pc < filter.size(); ++pc)
+	{
+		const auto& instruction = filter[pc];
+		const uint32_t k        = instruction.k;
+		bool loaded{ true };
+
+		switch (instruction.code)
+		{
+			case BPF_LD | BPF_W | BPF_LEN:
+				a = static_cast<uint32_t>(packet.size());
+				break;
+			case BPF_LD | BPF_W | BPF_ABS:
+				loaded = load(k, 4u, a);
+				break;
+			case BPF_LD | BPF_H | BPF_ABS:
+				loaded = load(k, 2u, a);
+				break;
+			case BPF_LD | BPF_H | BPF_IND:
+				loaded = load(uint64_t{ x } + k, 2u, a);
+				break;
+			case BPF_LD | BPF_B | BPF_IND:
+				loaded = load(uint64_t{ x } + k, 1u, a);
+				break;
+			case BPF_LDX | BPF_IMM:
+				x = k;
+				break;
+			case BPF_LDX | BPF_MEM:
+				x = mem[k];
+				break;
+			case BPF_ST:
+				mem[k] = a;
+				break;
+			case BPF_ALU | BPF_ADD | BPF_K:
+				a += k;
+				break;
+			case BPF_ALU | BPF_ADD | BPF_X:
+				a += x;
+				break;
+			case BPF_ALU | BPF_SUB | BPF_K:
+				a -= k;
+				break;
+			case BPF_ALU | BPF_SUB | BPF_X:
+				a -= x;
+				break;
+			case BPF_ALU | BPF_AND | BPF_K:
+				a &= k;
+				break;
+			case BPF_MISC | BPF_TAX:
+				x = a;
+				break;
+			case BPF_JMP | BPF_JEQ | BPF_K:
+				pc += a == k ? instruction.jt : instruction.jf;
+				break;
+			case BPF_JMP | BPF_JGT | BPF_K:
+				pc += a > k ? instruction.jt : instruction.jf;
+				break;
+			case BPF_JMP | BPF_JGE | BPF_K:
+				pc += a >= k ? instruction.jt : instruction.jf;
+				break;
+			case BPF_JMP | BPF_JGE | BPF_X:
+				pc += a >= x ? instruction.jt : instruction.jf;
+				break;
+			case BPF_RET | BPF_K:
+				return k;
+			case BPF_RET | BPF_A:
+				return a;
+			default:
+				FAIL("unexpected BPF instruction code " << instruction.code);
+		}
+
+		if (!loaded)
+			return 0u;
+	}
+
+	FAIL("BPF program did not return");
+
+	return 0u;
+}
+
+static void appendStunAttribute(
+  std::vector<uint8_t>& packet, uint16_t type, const std::string& value)
+{
+	packet.push_back(static_cast<uint8_t>(type >> 8));
+	packet.push_back(static_cast<uint8_t>(type));
+	packet.push_back(static_cast<uint8_t>(value.size() >> 8));
+	packet.push_back(static_cast<uint8_t>(value.size()));
+	packet.insert(packet.end(), value.begin(), value.end());
+	packet.resize((packet.size() + 3u) & ~size_t{ 3u }, 0u);
+}
+
+// STUN Binding request with the given USERNAME after the given number of
+// SOFTWARE attributes.
+static std::vector<uint8_t> stunBindingRequest(
+  const std::string& username, size_t numAttributes = 0u)
+{
+	// clang-format off
+	std::vector<uint8_t> packet
+	{
+		0x00, 0x01, 0x00, 0x00, // Binding request, length.
+		0x21, 0x12, 0xA4, 0x42, // Magic cookie.
+		0x01, 0x02, 0x03, 0x04, // Transaction ID.
+		0x05, 0x06, 0x07, 0x08,
+		0x09, 0x0A, 0x0B, 0x0C
+	};
+	// clang-format on
+
+	for (size_t i{ 0u }; i < numAttributes; ++i)
+	{
+		appendStunAttribute(packet, 0x8022, "mediasoup");
+	}
+
+	appendStunAttribute(packet, 0x0006, username);
+
+	packet[2] = static_cast<uint8_t>((packet.size() - 20u) >> 8);
+	packet[3] = static_cast<uint8_t>(packet.size() - 20u);
+
+	return packet;
+}
+
+// Class inheriting from UdpSocketHandler that keeps the received datagrams.
+class TestReusePortUdpSocket : public UdpSocketHandler
+{
+public:
+	static uv_udp_t* BindLoopback()
+	{
+		auto* uvHandle = new uv_udp_t;
+		struct sockaddr_in addr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+		uv_udp_init_ex(DepLibUV::GetLoop(), uvHandle, UV_UDP_RECVMMSG);
+		uv_ip4_addr("127.0.0.1", 0, std::addressof(addr));
+		uv_udp_bind(uvHandle, reinterpret_cast<const struct sockaddr*>(std::addressof(addr)), 0);
+
+		return uvHandle;
+	}
+
+public:
+	explicit TestReusePortUdpSocket(uv_udp_t* uvHandle) : UdpSocketHandler(uvHandle)
+	{
+	}
+
+public:
+	void UserOnUdpDatagramReceived(
+	  const uint8_t* data, size_t len, const struct sockaddr* /*addr*/) override
+	{
+		this->received.emplace_back(reinterpret_cast<const char*>(data), len);
+	}
+
+public:
+	std::vector<std::string> received;
+};
+#endif
+
+SCENARIO("WebRtcServer", "[rtc][webrtcserver]")
+{
+	SECTION("UsernameFragmentKey keeps up to MaxLength chars")
+	{
+		const std::string usernameFragment(UsernameFragmentKey::MaxLength, 'a');
+		const UsernameFragmentKey key(usernameFragment);
+
+		REQUIRE(!key.IsEmpty());
+		REQUIRE(key.ToString() == usernameFragment);
+
+		// Longer ones cannot be ours, so they get an empty key.
+		const UsernameFragmentKey tooLongKey(usernameFragment + "a");
+
+		REQUIRE(tooLongKey.IsEmpty());
+		REQUIRE(tooLongKey.ToString().empty());
+		REQUIRE(tooLongKey == UsernameFragmentKey(""));
+		REQUIRE(!(tooLongKey == key));
+	}
+
+	SECTION("UsernameFragmentKey equality and hash")
+	{
+		const std::string username = "abcd:efgh";
+		const UsernameFragmentKey key("abcd");
+		// Same chars taken from the USERNAME attribute of a STUN packet.
+		const UsernameFragmentKey keyFromUsername(username.c_str(), 4u);
+		const UsernameFragmentKey prefixKey("abc");
+		const UsernameFragmentKey otherKey("abce");
+		const absl::Hash<UsernameFragmentKey> hash;
+
+		REQUIRE(key == keyFromUsername);
+		REQUIRE(!(key == prefixKey));
+		REQUIRE(!(key == otherKey));
+		REQUIRE(hash(key) == hash(keyFromUsername));
+		REQUIRE(hash(key) != hash(prefixKey));
+		REQUIRE(hash(key) != hash(otherKey));
+
+		absl::flat_hash_map<UsernameFragmentKey, int> map;
+
+		map[key]      = 1;
+		map[otherKey] = 2;
+
+		REQUIRE(map.size() == 2u);
+		REQUIRE(map.at(keyFromUsername) == 1);
+		REQUIRE(map.find(prefixKey) == map.end());
+		REQUIRE(map.find(UsernameFragmentKey(std::string(40u, 'a'))) == map.end());
+	}
+
+#ifdef __linux__
+	SECTION("reusePort filter returns the index given by the USERNAME")
+	{
+		const auto& filter = WebRtcServer::GetReusePortFilter();
+
+		for (uint8_t index{ 0u }; index <= WebRtcServer::MaxReusePortIndex; ++index)
+		{
+			char indexChar;
+
+			if (index < 10u)
+				indexChar = static_cast<char>('0' + index);
+			else if (index < 36u)
+				indexChar = static_cast<char>('a' + index - 10u);
+			else
+				indexChar = static_cast<char>('A' + index - 36u);
+
+			const std::string username = std::string(1u, indexChar) + "abc:remote";
+
+			REQUIRE(runReusePortFilter(filter, stunBindingRequest(username)) == index);
+			REQUIRE(runReusePortFilter(filter, stunBindingRequest(username, 4u)) == index);
+		}
+
+		// Too many attributes before USERNAME.
+		REQUIRE(
+		  runReusePortFilter(filter, stunBindingRequest("1abc:remote", 5u)) == ReusePortNoIndex);
+
+		// Chars out of the index ones.
+		for (const char indexChar : { '/', ':', '@', '[', '`', '{', '\x00', '\x80' })
+		{
+			const std::string username = std::string(1u, indexChar) + "abc:remote";
+
+			REQUIRE(runReusePortFilter(filter, stunBindingRequest(username)) == ReusePortNoIndex);
+		}
+	}
+
+	SECTION("reusePort filter does not select the first socket for other packets")
+	{
+		const auto& filter = WebRtcServer::GetReusePortFilter();
+
+		// The index char is the first byte of the USERNAME value, so every
+		// truncated packet without it must not get an index (neither the one of
+		// the first socket, 0).
+		for (const size_t numAttributes : { 0u, 3u })
+		{
+			const auto packet       = stunBindingRequest("1abc:remote", numAttributes);
+			const size_t charOffset = 20u + (numAttributes * 16u) + 4u;
+
+			REQUIRE(runReusePortFilter(filter, packet) == 1u);
+
+			for (size_t len{ 0u }; len <= charOffset; ++len)
+			{
+				const std::vector<uint8_t> truncated(packet.begin(), packet.begin() + len);
+
+				REQUIRE(runReusePortFilter(filter, truncated) == ReusePortNoIndex);
+			}
+		}
+
+		// Attribute length beyond the end of the packet.
+		auto packet = stunBindingRequest("1abc:remote", 1u);
+
+		packet[22] = 0xFF;
+		packet[23] = 0xFF;
+
+		REQUIRE(runReusePortFilter(filter, packet) == ReusePortNoIndex);
+
+		// Binding success response.
+		packet    = stunBindingRequest("1abc:remote");
+		packet[0] = 0x01;
+		packet[1] = 0x01;
+
+		REQUIRE(runReusePortFilter(filter, packet) == ReusePortNoIndex);
+
+		// Wrong magic cookie.
+		packet    = stunBindingRequest("1abc:remote");
+		packet[4] = 0x00;
+
+		REQUIRE(runReusePortFilter(filter, packet) == ReusePortNoIndex);
+
+		// RTP packet.
+		packet    = std::vector<uint8_t>(40u, 0x00);
+		packet[0] = 0x80;
+
+		REQUIRE(runReusePortFilter(filter, packet) == ReusePortNoIndex);
+	}
+
+	SECTION("reusePort sockets get their STUN requests and connected ones stay out of the group")
+	{
+		std::string ip{ "127.0.0.1" };
+		auto* socket0       = new TestReusePortUdpSocket(PortManager::BindUdpReusePort(ip, 0u));
+		const uint16_t port = socket0->GetLocalPort();
+		auto* client1       = new TestReusePortUdpSocket(TestReusePortUdpSocket::BindLoopback());
+		auto* client2       = new TestReusePortUdpSocket(TestReusePortUdpSocket::BindLoopback());
+		const auto& filter  = WebRtcServer::GetReusePortFilter();
+
+		REQUIRE(socket0->SetReusePortFilter(filter.data(), filter.size()));
+
+		// A socket connected before the next one is bound must not take its
+		// index.
+		std::string connectedIp{ "127.0.0.1" };
+		auto* connected = new TestReusePortUdpSocket(
+		  PortManager::ConnectUdp(connectedIp, port, client1->GetLocalAddress()));
+		auto* socket1 = new TestReusePortUdpSocket(PortManager::BindUdpReusePort(ip, port));
+
+		auto send = [socket0](TestReusePortUdpSocket* client, const std::string& username)
+		{
+			const auto packet = stunBindingRequest(username);
+
+			client->Send(packet.data(), packet.size(), socket0->GetLocalAddress(), nullptr);
+		};
+
+		// Run the loop without blocking until the given sockets have received
+		// the given number of datagrams (or give up).
+		auto runLoopUntilReceived = [socket0, socket1, connected](size_t numDatagrams)
+		{
+			for (size_t i{ 0u }; i < 1000u; ++i)
+			{
+				const size_t numReceived =
+				  socket0->received.size() + socket1->received.size() + connected->received.size();
+
+				if (numReceived >= numDatagrams)
+					break;
+
+				uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+			}
+		};
+
+		// The connected socket gets everything from its remote address.
+		send(client1, "1abc:remote");
+		runLoopUntilReceived(1u);
+
+		REQUIRE(connected->received.size() == 1u);
+
+		send(client2, "1abc:remote");
+		runLoopUntilReceived(2u);
+
+		REQUIRE(socket1->received.size() == 1u);
+
+		send(client2, "0abc:remote");
+		runLoopUntilReceived(3u);
+
+		REQUIRE(socket0->received.size() == 1u);
+
+		// Nor is it selected by an index beyond those in the group.
+		send(client2, "2abc:remote");
+		runLoopUntilReceived(4u);
+
+		REQUIRE(connected->received.size() == 1u);
+		REQUIRE(socket0->received.size() + socket1->received.size() == 3u);
+
+		delete connected;
+		delete client2;
+		delete client1;
+		delete socket1;
+		delete socket0;
+
+		// Run the loop to close UV handles of deleted sockets.
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+	}
+#endif
+}
@@ -0,0 +1,55 @@
+#include "common.hpp"
+#include "DepUsrSCTP.hpp"
+#include <catch2/catch.hpp>
+
+SCENARIO("DepUsrSCTP", "[sctp][depusrsctp]")
+{
+	const uintptr_t slotBits{ DepUsrSCTP::SlotBits };
+	const uintptr_t slotMask{ DepUsrSCTP::SlotMask };
+	const uintptr_t maxGeneration{ DepUsrSCTP::MaxGeneration };
+
+	SECTION("slot generations wrap to 1")
+	{
+		REQUIRE(DepUsrSCTP::GetNextSlotGeneration(0u) == 1u);
+		REQUIRE(DepUsrSCTP::GetNextSlotGeneration(1u) == 2u);
+		REQUIRE(DepUsrSCTP::GetNextSlotGeneration(maxGeneration - 1u) == maxGeneration);
+		REQUIRE(DepUsrSCTP::GetNextSlotGeneration(maxGeneration) == 1u);
+
+		// The highest generation still fits into an id.
+		const uintptr_t id = (maxGeneration << slotBits) | slotMask;
+
+		REQUIRE(id >> slotBits == maxGeneration);
+		REQUIRE((id & slotMask) == slotMask);
+	}
+
+	SECTION("released slots are reused with a new generation")
+	{
+		const uintptr_t id1 = DepUsrSCTP::GetNextSctpAssociationId();
+
+		// Generation 0 is never used.
+		REQUIRE(id1 >> slotBits != 0u);
+
+		// No SctpAssociation registered with it.
+		REQUIRE(DepUsrSCTP::RetrieveSctpAssociation(id1) == nullptr);
+
+		// As if the SctpAssociation failed to be created.
+		DepUsrSCTP::ReleaseSctpAssociationId(id1);
+
+		const uintptr_t id2 = DepUsrSCTP::GetNextSctpAssociationId();
+
+		REQUIRE((id2 & slotMask) == (id1 & slotMask));
+		REQUIRE(id2 >> slotBits == DepUsrSCTP::GetNextSlotGeneration(id1 >> slotBits));
+
+		// A new slot is taken while the previous one is in use.
+		const uintptr_t id3 = DepUsrSCTP::GetNextSctpAssociationId();
+
+		REQUIRE((id3 & slotMask) != (id2 & slotMask));
+
+		DepUsrSCTP::ReleaseSctpAssociationId(id3);
+		DepUsrSCTP::ReleaseSctpAssociationId(id2);
+
+		// Stale ids do not resolve.
+		REQUIRE(DepUsrSCTP::RetrieveSctpAssociation(id1) == nullptr);
+		REQUIRE(DepUsrSCTP::RetrieveSctpAssociation(id2) == nullptr);
+	}
+}
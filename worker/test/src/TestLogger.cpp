@@ -0,0 +1,140 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "Channel/ChannelSocket.hpp"
+#include <catch2/catch.hpp>
+#include <cstring> // std::strlen()
+#include <string>
+#include <vector>
+
+static ChannelReadFreeFn channelRead(
+  uint8_t** /*message*/,
+  uint32_t* /*messageLen*/,
+  size_t* /*messageCtx*/,
+  const void* /*handle*/,
+  ChannelReadCtx /*ctx*/)
+{
+	return nullptr;
+}
+
+static void channelWrite(const uint8_t* message, uint32_t messageLen, ChannelWriteCtx ctx)
+{
+	auto* messages = static_cast<std::vector<std::string>*>(ctx);
+
+	messages->emplace_back(reinterpret_cast<const char*>(message), messageLen);
+}
+
+static void sendLog(Logger::CallSite& callSite, const char* message)
+{
+	if (!Logger::IsAllowed(callSite))
+		return;
+
+	std::snprintf(Logger::buffer, Logger::bufferSize, "%s", message);
+
+	Logger::SendLog(callSite, Logger::buffer, static_cast<int>(std::strlen(message)));
+}
+
+SCENARIO("Logger", "[logger]")
+{
+	std::vector<std::string> messages;
+	Channel::ChannelSocket channel(channelRead, nullptr, channelWrite, &messages);
+	auto* previousChannel = Logger::channel;
+
+	Logger::ClassInit(&channel);
+
+	SECTION("sync mode writes every message and does not rate limit")
+	{
+		Logger::CallSite callSite{};
+
+		for (uint32_t i{ 0u }; i < Logger::MaxMessagesPerWindow + 5u; ++i)
+		{
+			sendLog(callSite, "Wfoo");
+		}
+
+		REQUIRE(messages.size() == Logger::MaxMessagesPerWindow + 5u);
+		REQUIRE(messages[0] == "Wfoo");
+	}
+
+	SECTION("batching mode buffers messages until the loop runs")
+	{
+		Logger::CallSite callSite{};
+
+		Logger::SetBatching(true);
+
+		sendLog(callSite, "Wfoo");
+		sendLog(callSite, "Dbar");
+
+		REQUIRE(messages.empty());
+
+		// Run the prepare and check handles.
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		REQUIRE(messages == std::vector<std::string>{ "Wfoo", "Dbar" });
+
+		sendLog(callSite, "Wbaz");
+		Logger::SetBatching(false);
+
+		REQUIRE(messages.size() == 3u);
+		REQUIRE(messages[2] == "Wbaz");
+	}
+
+	SECTION("batching mode writes errors right away after buffered messages")
+	{
+		Logger::CallSite callSite{};
+
+		Logger::SetBatching(true);
+
+		sendLog(callSite, "Wfoo");
+		// Just text, not an error.
+		sendLog(callSite, "Equux");
+
+		REQUIRE(messages.empty());
+
+		std::snprintf(Logger::buffer, Logger::bufferSize, "%s", "Ebar");
+		Logger::SendErrorLog(Logger::buffer, 4);
+
+		REQUIRE(messages == std::vector<std::string>{ "Wfoo", "Equux", "Ebar" });
+
+		Logger::SetBatching(false);
+	}
+
+	SECTION("batching mode rate limits each call site")
+	{
+		Logger::CallSite callSite1{};
+		Logger::CallSite callSite2{};
+		const auto numSuppressed = Logger::GetNumSuppressed();
+
+		Logger::SetBatching(true);
+
+		for (uint32_t i{ 0u }; i < Logger::MaxMessagesPerWindow + 5u; ++i)
+		{
+			sendLog(callSite1, "Wfoo");
+		}
+
+		sendLog(callSite2, "Wbar");
+
+		REQUIRE(Logger::GetNumSuppressed() == numSuppressed + 5u);
+		REQUIRE(callSite1.numSuppressed == 5u);
+
+		// Start a new window.
+		callSite1.windowStartMs -= Logger::RateLimitWindowMs;
+
+		sendLog(callSite1, "Wfoo");
+
+		Logger::Flush();
+
+		REQUIRE(messages.size() == Logger::MaxMessagesPerWindow + 2u);
+		REQUIRE(messages[Logger::MaxMessagesPerWindow] == "Wbar");
+		REQUIRE(messages.back() == "Wfoo [5 similar messages suppressed]");
+		REQUIRE(callSite1.numSuppressed == 0u);
+
+		Logger::SetBatching(false);
+	}
+
+	channel.Close();
+
+	// Let the loop release the handles.
+	uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+	Logger::ClassInit(previousChannel);
+}
@@ -0,0 +1,84 @@
+#include "common.hpp"
+#include "Metrics.hpp"
+#include "RTC/RtcLogger.hpp"
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+
+// Returns the value of the sample with the given name and labels.
+static std::string getSample(const std::string& text, const std::string& sample)
+{
+	std::istringstream stream(text);
+	std::string line;
+
+	while (std::getline(stream, line))
+	{
+		if (line.compare(0, sample.length() + 1, sample + " ") == 0)
+			return line.substr(sample.length() + 1);
+	}
+
+	return "";
+}
+
+SCENARIO("Metrics", "[metrics]")
+{
+	SECTION("counters are rendered as OpenMetrics")
+	{
+		const auto routed = Metrics::GetCounter(Metrics::Counter::RTP_PACKETS_ROUTED);
+		const auto eagain = Metrics::GetCounter(Metrics::Counter::TCP_SEND_EAGAIN);
+
+		Metrics::Increment(Metrics::Counter::RTP_PACKETS_ROUTED);
+		Metrics::Increment(Metrics::Counter::RTP_PACKETS_ROUTED);
+		Metrics::Increment(Metrics::Counter::TCP_SEND_EAGAIN);
+
+		const auto text = Metrics::Render();
+
+		REQUIRE(
+		  getSample(text, "mediasoup_worker_rtp_packets_routed_total") == std::to_string(routed + 2));
+		REQUIRE(
+		  getSample(text, "mediasoup_worker_send_eagain_total{protocol=\"tcp\"}") ==
+		  std::to_string(eagain + 1));
+		// A single family for all the labels.
+		REQUIRE(text.find("# TYPE mediasoup_worker_send_eagain counter\n") != std::string::npos);
+		REQUIRE(
+		  text.find("# TYPE mediasoup_worker_send_eagain counter\n") ==
+		  text.rfind("# TYPE mediasoup_worker_send_eagain counter\n"));
+		REQUIRE(text.substr(text.length() - 6) == "# EOF\n");
+	}
+
+	SECTION("drops are rendered by reason")
+	{
+		const std::string sample =
+		  "mediasoup_worker_rtp_packets_dropped_total{reason=\"SendRtpStreamDiscarded\"}";
+		const auto dropped = std::stoull(getSample(Metrics::Render(), sample));
+
+		RTC::RtcLogger::RtpPacket packet;
+
+		packet.Dropped(RTC::RtcLogger::RtpPacket::DropReason::SEND_RTP_STREAM_DISCARDED);
+
+		REQUIRE(getSample(Metrics::Render(), sample) == std::to_string(dropped + 1));
+	}
+
+	SECTION("loop lag histogram buckets are cumulative")
+	{
+		const std::string name = "mediasoup_worker_event_loop_lag_seconds";
+		auto text              = Metrics::Render();
+		const auto le1ms       = std::stoull(getSample(text, name + "_bucket{le=\"0.001000\"}"));
+		const auto le10ms      = std::stoull(getSample(text, name + "_bucket{le=\"0.010000\"}"));
+		const auto leInf       = std::stoull(getSample(text, name + "_bucket{le=\"+Inf\"}"));
+		const auto count       = std::stoull(getSample(text, name + "_count"));
+
+		REQUIRE(leInf == count);
+
+		Metrics::ObserveLoopLag(0u);
+		Metrics::ObserveLoopLag(7000u);
+		Metrics::ObserveLoopLag(5000000u);
+
+		text = Metrics::Render();
+
+		REQUIRE(getSample(text, name + "_bucket{le=\"0.001000\"}") == std::to_string(le1ms + 1));
+		REQUIRE(getSample(text, name + "_bucket{le=\"0.010000\"}") == std::to_string(le10ms + 2));
+		REQUIRE(getSample(text, name + "_bucket{le=\"+Inf\"}") == std::to_string(leInf + 3));
+		REQUIRE(getSample(text, name + "_count") == std::to_string(count + 3));
+	}
+}
@@ -0,0 +1,118 @@
+#include "common.hpp"
+#include "Utils.hpp"
+#include <catch2/catch.hpp>
+#include <cstring> // std::memcmp()
+#include <string>
+#include <vector>
+
+using namespace Utils;
+
+SCENARIO("Utils::Crypto::GetCRC32()")
+{
+	SECTION("check value")
+	{
+		const std::string data{ "123456789" };
+
+		REQUIRE(
+		  Crypto::GetCRC32(reinterpret_cast<const uint8_t*>(data.c_str()), data.length()) ==
+		  0xCBF43926);
+	}
+
+	SECTION("matches the byte at a time computation for any length and alignment")
+	{
+		std::vector<uint8_t> data(300);
+
+		for (size_t i{ 0u }; i < data.size(); ++i)
+		{
+			data[i] = static_cast<uint8_t>(i * 31 + 7);
+		}
+
+		for (size_t offset{ 0u }; offset < 8u; ++offset)
+		{
+			for (size_t len{ 0u }; len <= data.size() - offset; ++len)
+			{
+				// Bitwise CRC-32 (IEEE 802.3, reflected).
+				uint32_t crc{ 0xFFFFFFFF };
+
+				for (size_t i{ 0u }; i < len; ++i)
+				{
+					crc ^= data[offset + i];
+
+					for (int bit{ 0 }; bit < 8; ++bit)
+					{
+						crc = (crc >> 1) ^ (0xEDB88320 & (0u - (crc & 1u)));
+					}
+				}
+
+				REQUIRE(Crypto::GetCRC32(data.data() + offset, len) == (crc ^ ~0U));
+			}
+		}
+	}
+}
+
+SCENARIO("Utils::Crypto::GetHmacSha1()")
+{
+	// RFC 2202, test case 2.
+	const std::string key{ "Jefe" };
+	const std::string data{ "what do ya want for nothing?" };
+	// clang-format off
+	const uint8_t expected[] =
+	{
+		0xef, 0xfc, 0xdf, 0x6a, 0xe5, 0xeb, 0x2f, 0xa2, 0xd2, 0x74,
+		0x16, 0xd5, 0xf1, 0x84, 0xdf, 0x9c, 0x25, 0x9a, 0x7c, 0x79
+	};
+	// clang-format on
+
+	SECTION("with a key string")
+	{
+		const uint8_t* hmac =
+		  Crypto::GetHmacSha1(key, reinterpret_cast<const uint8_t*>(data.c_str()), data.length());
+
+		REQUIRE(std::memcmp(hmac, expected, sizeof(expected)) == 0);
+	}
+
+	SECTION("with a HmacSha1Key can be used many times")
+	{
+		Crypto::HmacSha1Key hmacKey(key);
+
+		REQUIRE(hmacKey.GetKey() == key);
+
+		for (int i{ 0 }; i < 3; ++i)
+		{
+			const uint8_t* hmac = Crypto::GetHmacSha1(
+			  hmacKey, reinterpret_cast<const uint8_t*>(data.c_str()), data.length());
+
+			REQUIRE(std::memcmp(hmac, expected, sizeof(expected)) == 0);
+		}
+
+		// Other keys in between do not affect it.
+		Crypto::HmacSha1Key otherKey("foo");
+
+		Crypto::GetHmacSha1(otherKey, reinterpret_cast<const uint8_t*>(data.c_str()), 4);
+		Crypto::GetHmacSha1("bar", reinterpret_cast<const uint8_t*>(data.c_str()), 4);
+
+		const uint8_t* hmac =
+		  Crypto::GetHmacSha1(hmacKey, reinterpret_cast<const uint8_t*>(data.c_str()), data.length());
+
+		REQUIRE(std::memcmp(hmac, expected, sizeof(expected)) == 0);
+	}
+
+	SECTION("HmacSha1Key::SetKey()")
+	{
+		Crypto::HmacSha1Key hmacKey;
+
+		REQUIRE(hmacKey.IsEmpty());
+
+		hmacKey.SetKey("foo");
+		hmacKey.SetKey(key);
+
+		const uint8_t* hmac =
+		  Crypto::GetHmacSha1(hmacKey, reinterpret_cast<const uint8_t*>(data.c_str()), data.length());
+
+		REQUIRE(std::memcmp(hmac, expected, sizeof(expected)) == 0);
+
+		hmacKey.SetKey("");
+
+		REQUIRE(hmacKey.IsEmpty());
+	}
+}
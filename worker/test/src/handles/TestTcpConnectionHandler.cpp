@@ -0,0 +1,209 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "handles/TcpConnectionHandler.hpp"
+#include <catch2/catch.hpp>
+#include <arpa/inet.h>  // inet_pton()
+#include <sys/socket.h> // socket(), connect(), recv()
+#include <unistd.h>     // close()
+#include <vector>
+
+// Class inheriting from TcpConnectionHandler accepted by a loopback server.
+class TestTcpConnection : public TcpConnectionHandler, public TcpConnectionHandler::Listener
+{
+public:
+	TestTcpConnection() : TcpConnectionHandler(65536u)
+	{
+	}
+
+public:
+	void UserOnTcpConnectionRead() override
+	{
+		this->bufferDataLen = 0u;
+	}
+	void OnTcpConnectionClosed(TcpConnectionHandler* /*connection*/) override
+	{
+	}
+};
+
+// Loopback TCP server and a blocking client socket connected to it. The
+// accepted connection is a TestTcpConnection.
+class TestTcpPair
+{
+public:
+	TestTcpPair()
+	{
+		struct sockaddr_in addr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+		int addrLen = sizeof(this->localAddr);
+
+		uv_ip4_addr("127.0.0.1", 0, std::addressof(addr));
+
+		this->uvServer.data = static_cast<void*>(this);
+
+		uv_tcp_init(DepLibUV::GetLoop(), std::addressof(this->uvServer));
+		uv_tcp_bind(
+		  std::addressof(this->uvServer), reinterpret_cast<const struct sockaddr*>(&addr), 0);
+		uv_tcp_getsockname(
+		  std::addressof(this->uvServer),
+		  reinterpret_cast<struct sockaddr*>(&this->localAddr),
+		  &addrLen);
+		uv_listen(
+		  reinterpret_cast<uv_stream_t*>(std::addressof(this->uvServer)),
+		  1,
+		  [](uv_stream_t* handle, int /*status*/)
+		  {
+			  auto* pair = static_cast<TestTcpPair*>(handle->data);
+
+			  pair->connection = new TestTcpConnection();
+			  pair->connection->Setup(pair->connection, &pair->localAddr, "127.0.0.1", 0u);
+			  uv_accept(handle, reinterpret_cast<uv_stream_t*>(pair->connection->GetUvHandle()));
+			  pair->connection->Start();
+		  });
+
+		this->clientFd = socket(AF_INET, SOCK_STREAM, 0);
+
+		connect(this->clientFd, reinterpret_cast<const struct sockaddr*>(&this->localAddr), addrLen);
+
+		for (size_t i{ 0u }; i < 1000u && !this->connection; ++i)
+		{
+			uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+		}
+	}
+	~TestTcpPair()
+	{
+		delete this->connection;
+
+		close(this->clientFd);
+
+		uv_close(reinterpret_cast<uv_handle_t*>(std::addressof(this->uvServer)), nullptr);
+
+		// Let libuv release the handles.
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+	}
+
+public:
+	// Read everything available in the client socket.
+	size_t Receive()
+	{
+		uint8_t buffer[65536];
+		size_t received{ 0u };
+		ssize_t len;
+
+		while ((len = recv(this->clientFd, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0)
+		{
+			received += static_cast<size_t>(len);
+		}
+
+		return received;
+	}
+
+public:
+	uv_tcp_t uvServer;
+	struct sockaddr_storage localAddr;
+	TestTcpConnection* connection{ nullptr };
+	int clientFd{ -1 };
+};
+
+SCENARIO("TcpConnectionHandler write batching", "[handles][tcp]")
+{
+	static constexpr size_t NumWrites{ 10u };
+	static constexpr size_t DataSize{ 100u };
+
+	const uint8_t header[2] = { 0x00, 0x64 };
+	std::vector<uint8_t> data(DataSize, 0xAB);
+	TestTcpPair pair;
+	size_t numSent{ 0u };
+
+	REQUIRE(pair.connection);
+
+	auto write = [&pair, &header, &data, &numSent]()
+	{
+		pair.connection->Write(
+		  header,
+		  sizeof(header),
+		  data.data(),
+		  data.size(),
+		  new const std::function<void(bool sent)>(
+		    [&numSent](bool sent)
+		    {
+			    if (sent)
+				    numSent++;
+		    }));
+	};
+
+	SECTION("data is written immediately if write batching is disabled")
+	{
+		REQUIRE(!pair.connection->IsWriteBatchingEnabled());
+
+		for (size_t i{ 0u }; i < NumWrites; ++i)
+		{
+			write();
+		}
+
+		REQUIRE(numSent == NumWrites);
+		REQUIRE(pair.connection->GetSentBytes() == NumWrites * (sizeof(header) + DataSize));
+		REQUIRE(pair.Receive() == NumWrites * (sizeof(header) + DataSize));
+	}
+
+	SECTION("data is written at the end of the loop iteration if write batching is enabled")
+	{
+		pair.connection->SetWriteBatching(true);
+
+		REQUIRE(pair.connection->IsWriteBatchingEnabled());
+
+		for (size_t i{ 0u }; i < NumWrites; ++i)
+		{
+			write();
+		}
+
+		// Nothing written yet.
+		REQUIRE(numSent == 0u);
+		REQUIRE(pair.connection->GetSentBytes() == 0u);
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		REQUIRE(numSent == NumWrites);
+		REQUIRE(pair.connection->GetSentBytes() == NumWrites * (sizeof(header) + DataSize));
+		REQUIRE(pair.connection->GetWriteBatchFlushes() == 1u);
+		REQUIRE(pair.connection->GetWriteBatchItems() == NumWrites);
+		REQUIRE(pair.Receive() == NumWrites * (sizeof(header) + DataSize));
+	}
+
+	SECTION("full write batch is flushed")
+	{
+		std::vector<uint8_t> bigData(30000u, 0xCD);
+
+		pair.connection->SetWriteBatching(true);
+
+		for (size_t i{ 0u }; i < 3u; ++i)
+		{
+			pair.connection->Write(header, sizeof(header), bigData.data(), bigData.size(), nullptr);
+		}
+
+		// The third write does not fit so the first two ones are flushed.
+		REQUIRE(pair.connection->GetWriteBatchFlushes() == 1u);
+		REQUIRE(pair.connection->GetSentBytes() == 2u * (sizeof(header) + bigData.size()));
+
+		pair.connection->FlushWriteBatch();
+
+		REQUIRE(pair.connection->GetWriteBatchFlushes() == 2u);
+		REQUIRE(pair.connection->GetSentBytes() == 3u * (sizeof(header) + bigData.size()));
+	}
+
+	SECTION("pending data is written when closing")
+	{
+		pair.connection->SetWriteBatching(true);
+
+		for (size_t i{ 0u }; i < NumWrites; ++i)
+		{
+			write();
+		}
+
+		pair.connection->Close();
+
+		REQUIRE(numSent == NumWrites);
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		REQUIRE(pair.Receive() == NumWrites * (sizeof(header) + DataSize));
+	}
+}
@@ -0,0 +1,242 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "handles/Timer.hpp"
+#include <catch2/catch.hpp>
+#include <algorithm> // std::find()
+#include <iterator>  // std::distance()
+#include <vector>
+
+class TestTimerListener : public Timer::Listener
+{
+public:
+	void OnTimer(Timer* timer) override
+	{
+		this->fired.push_back({ timer, uv_now(DepLibUV::GetLoop()) });
+
+		for (auto* timerToDelete : this->timersToDelete)
+		{
+			if (timerToDelete != timer)
+				delete timerToDelete;
+		}
+
+		this->timersToDelete.clear();
+	}
+
+public:
+	struct Fired
+	{
+		Timer* timer;
+		uint64_t atMs;
+	};
+
+public:
+	std::vector<Fired> fired;
+	std::vector<Timer*> timersToDelete;
+};
+
+// Run the loop until the given listener has been called the given number of
+// times (or give up).
+static void runLoopUntilFired(TestTimerListener& listener, size_t numFired)
+{
+	for (size_t i{ 0u }; i < 10000u && listener.fired.size() < numFired; ++i)
+	{
+		uv_run(DepLibUV::GetLoop(), UV_RUN_ONCE);
+	}
+}
+
+SCENARIO("Timer", "[handles][timer]")
+{
+	TestTimerListener listener;
+
+	SECTION("non repeating timer fires once")
+	{
+		Timer timer(&listener);
+		const auto startMs = uv_now(DepLibUV::GetLoop());
+
+		timer.Start(20u);
+
+		REQUIRE(timer.IsActive());
+
+		runLoopUntilFired(listener, 1u);
+
+		REQUIRE(listener.fired.size() == 1);
+		REQUIRE(listener.fired[0].timer == &timer);
+		REQUIRE(listener.fired[0].atMs >= startMs + 20u);
+		REQUIRE(!timer.IsActive());
+	}
+
+	SECTION("repeating timer fires until stopped")
+	{
+		Timer timer(&listener);
+
+		timer.Start(5u, 5u);
+
+		runLoopUntilFired(listener, 3u);
+
+		REQUIRE(listener.fired.size() == 3);
+		REQUIRE(timer.IsActive());
+		REQUIRE(listener.fired[2].atMs >= listener.fired[1].atMs + 5u);
+
+		timer.Stop();
+
+		REQUIRE(!timer.IsActive());
+	}
+
+	SECTION("timers fire in expiration order")
+	{
+		// Cover the first two levels of the wheel.
+		const std::vector<uint64_t> timeouts = { 150u, 3u, 70u, 1u, 64u, 2u, 128u, 65u };
+		std::vector<Timer*> timers;
+		const auto startMs = uv_now(DepLibUV::GetLoop());
+
+		for (auto timeout : timeouts)
+		{
+			auto* timer = new Timer(&listener);
+
+			timer->Start(timeout);
+			timers.push_back(timer);
+		}
+
+		runLoopUntilFired(listener, timeouts.size());
+
+		REQUIRE(listener.fired.size() == timeouts.size());
+
+		for (size_t i{ 0u }; i < listener.fired.size(); ++i)
+		{
+			auto& fired = listener.fired[i];
+			auto it     = std::find(timers.begin(), timers.end(), fired.timer);
+			auto idx    = std::distance(timers.begin(), it);
+
+			REQUIRE(fired.atMs >= startMs + timeouts[idx]);
+
+			if (i > 0)
+				REQUIRE(timers[idx]->GetTimeout() >= listener.fired[i - 1].timer->GetTimeout());
+		}
+
+		for (auto* timer : timers)
+		{
+			delete timer;
+		}
+	}
+
+	SECTION("Restart() postpones the expiration")
+	{
+		Timer helper(&listener);
+		Timer timer(&listener);
+		Timer sentinel(&listener);
+
+		helper.Start(20u);
+		timer.Start(50u);
+		sentinel.Start(60u);
+
+		runLoopUntilFired(listener, 1u);
+
+		REQUIRE(listener.fired[0].timer == &helper);
+
+		timer.Restart();
+
+		runLoopUntilFired(listener, 3u);
+
+		REQUIRE(listener.fired.size() == 3);
+		REQUIRE(listener.fired[1].timer == &sentinel);
+		REQUIRE(listener.fired[2].timer == &timer);
+	}
+
+	SECTION("timer deleted by the listener of another timer does not fire")
+	{
+		auto* timer1 = new Timer(&listener);
+		auto* timer2 = new Timer(&listener);
+
+		timer1->Start(10u);
+		timer2->Start(10u);
+
+		// Whichever fires first deletes the other one.
+		listener.timersToDelete = { timer1, timer2 };
+
+		runLoopUntilFired(listener, 1u);
+
+		// Give the other one the chance to fire.
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		REQUIRE(listener.fired.size() == 1);
+
+		delete listener.fired[0].timer;
+	}
+
+	SECTION("closed timer cannot be started")
+	{
+		Timer timer(&listener);
+
+		timer.Start(10u);
+		timer.Close();
+
+		REQUIRE(!timer.IsActive());
+		REQUIRE_THROWS(timer.Start(10u));
+	}
+}
+
+// Run it with `make test MEDIASOUP_TEST_TAGS="[benchmark]"`. Each iteration
+// restarts all the timers, as NackGenerator, RtpStreamRecv and the like do on
+// every packet. The uv_timer_t case is how Timer was implemented before using
+// the TimerWheel.
+SCENARIO("Timer benchmark", "[handles][timer][.benchmark]")
+{
+	static constexpr size_t NumTimers{ 100000u };
+
+	TestTimerListener listener;
+
+	{
+		std::vector<Timer*> timers;
+
+		for (size_t i{ 0u }; i < NumTimers; ++i)
+		{
+			timers.push_back(new Timer(&listener));
+			timers.back()->Start(1000u + (i % 20000u));
+		}
+
+		BENCHMARK("restart 100k active Timers")
+		{
+			for (auto* timer : timers)
+			{
+				timer->Restart();
+			}
+
+			return timers.size();
+		};
+
+		for (auto* timer : timers)
+		{
+			delete timer;
+		}
+	}
+
+	{
+		std::vector<uv_timer_t> uvTimers(NumTimers);
+		auto onUvTimer = [](uv_timer_t* /*handle*/) {};
+
+		for (size_t i{ 0u }; i < NumTimers; ++i)
+		{
+			uv_timer_init(DepLibUV::GetLoop(), std::addressof(uvTimers[i]));
+			uv_timer_start(std::addressof(uvTimers[i]), onUvTimer, 1000u + (i % 20000u), 0u);
+		}
+
+		BENCHMARK("restart 100k active uv_timer_t")
+		{
+			for (auto& uvTimer : uvTimers)
+			{
+				uv_timer_stop(std::addressof(uvTimer));
+				uv_timer_start(std::addressof(uvTimer), onUvTimer, 1000u, 0u);
+			}
+
+			return uvTimers.size();
+		};
+
+		for (auto& uvTimer : uvTimers)
+		{
+			uv_close(reinterpret_cast<uv_handle_t*>(std::addressof(uvTimer)), nullptr);
+		}
+
+		// Let libuv release the handles before freeing their memory.
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+	}
+}
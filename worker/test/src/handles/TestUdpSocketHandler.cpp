@@ -0,0 +1,418 @@
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "MediaSoupErrors.hpp"
+#include "handles/UdpSocketHandler.hpp"
+#include <catch2/catch.hpp>
+#include <cstring> // std::memset()
+#include <vector>
+
+// Class inheriting from UdpSocketHandler bound to a random loopback port.
+class TestUdpSocket : public UdpSocketHandler
+{
+public:
+	static uv_udp_t* BindLoopback()
+	{
+		auto* uvHandle = new uv_udp_t;
+		struct sockaddr_in addr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+		uv_udp_init_ex(DepLibUV::GetLoop(), uvHandle, UV_UDP_RECVMMSG);
+		uv_ip4_addr("127.0.0.1", 0, std::addressof(addr));
+		uv_udp_bind(uvHandle, reinterpret_cast<const struct sockaddr*>(std::addressof(addr)), 0);
+
+		return uvHandle;
+	}
+
+	static uv_udp_t* ConnectLoopback(const struct sockaddr* remoteAddr)
+	{
+		auto* uvHandle = BindLoopback();
+
+		uv_udp_connect(uvHandle, remoteAddr);
+
+		return uvHandle;
+	}
+
+public:
+	TestUdpSocket() : UdpSocketHandler(BindLoopback())
+	{
+	}
+	explicit TestUdpSocket(const struct sockaddr* remoteAddr)
+	  : UdpSocketHandler(ConnectLoopback(remoteAddr))
+	{
+	}
+
+public:
+	void UserOnUdpDatagramReceived(
+	  const uint8_t* /*data*/, size_t /*len*/, const struct sockaddr* /*addr*/) override
+	{
+		this->numReceived++;
+	}
+
+public:
+	size_t numReceived{ 0u };
+};
+
+// Run the loop without blocking until the given socket has received the
+// given number of datagrams (or give up).
+static void runLoopUntilReceived(TestUdpSocket& socket, size_t numDatagrams)
+{
+	for (size_t i{ 0u }; i < 1000u && socket.numReceived < numDatagrams; ++i)
+	{
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+	}
+}
+
+// Run the loop to close UV handles of deleted sockets.
+static void runLoopToCloseHandles()
+{
+	uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+}
+
+SCENARIO("UdpSocketHandler send batching", "[handles][udp]")
+{
+	static constexpr size_t NumDatagrams{ 10u };
+	static constexpr size_t DatagramSize{ 100u };
+
+	std::vector<uint8_t> datagram(DatagramSize, 0xAB);
+
+	SECTION("datagrams are sent immediately if send batching is disabled")
+	{
+		auto* receiver = new TestUdpSocket();
+		auto* sender   = new TestUdpSocket();
+		size_t numSent{ 0u };
+
+		REQUIRE(!sender->IsSendBatchingEnabled());
+
+		for (size_t i{ 0u }; i < NumDatagrams; ++i)
+		{
+			sender->Send(
+			  datagram.data(),
+			  datagram.size(),
+			  receiver->GetLocalAddress(),
+			  new const std::function<void(bool sent)>(
+			    [&numSent](bool sent)
+			    {
+				    if (sent)
+					    numSent++;
+			    }));
+		}
+
+		REQUIRE(numSent == NumDatagrams);
+		REQUIRE(sender->GetSentBytes() == NumDatagrams * DatagramSize);
+
+		runLoopUntilReceived(*receiver, NumDatagrams);
+
+		REQUIRE(receiver->numReceived == NumDatagrams);
+
+		delete sender;
+		delete receiver;
+
+		runLoopToCloseHandles();
+	}
+
+	SECTION("datagrams are sent at the end of the loop iteration if send batching is enabled")
+	{
+		if (!UdpSocketHandler::IsSendBatchingSupported())
+			return;
+
+		auto* receiver = new TestUdpSocket();
+		auto* sender   = new TestUdpSocket();
+		size_t numSent{ 0u };
+
+		sender->SetSendBatching(true);
+
+		REQUIRE(sender->IsSendBatchingEnabled());
+
+		for (size_t i{ 0u }; i < NumDatagrams; ++i)
+		{
+			sender->Send(
+			  datagram.data(),
+			  datagram.size(),
+			  receiver->GetLocalAddress(),
+			  new const std::function<void(bool sent)>(
+			    [&numSent](bool sent)
+			    {
+				    if (sent)
+					    numSent++;
+			    }));
+		}
+
+		// Nothing sent yet.
+		REQUIRE(numSent == 0u);
+		REQUIRE(sender->GetSentBytes() == 0u);
+
+		runLoopUntilReceived(*receiver, NumDatagrams);
+
+		REQUIRE(numSent == NumDatagrams);
+		REQUIRE(sender->GetSentBytes() == NumDatagrams * DatagramSize);
+		REQUIRE(sender->GetSendBatchFlushes() == 1u);
+		REQUIRE(sender->GetSendBatchSyscalls() == 1u);
+		REQUIRE(receiver->numReceived == NumDatagrams);
+
+		delete sender;
+		delete receiver;
+
+		runLoopToCloseHandles();
+	}
+
+	SECTION("pending datagrams are sent when the socket is closed")
+	{
+		if (!UdpSocketHandler::IsSendBatchingSupported())
+			return;
+
+		auto* receiver = new TestUdpSocket();
+		auto* sender   = new TestUdpSocket();
+
+		sender->SetSendBatching(true);
+
+		for (size_t i{ 0u }; i < NumDatagrams; ++i)
+		{
+			sender->Send(datagram.data(), datagram.size(), receiver->GetLocalAddress(), nullptr);
+		}
+
+		REQUIRE(sender->GetSentBytes() == 0u);
+
+		sender->Close();
+
+		REQUIRE(sender->GetSentBytes() == NumDatagrams * DatagramSize);
+
+		runLoopUntilReceived(*receiver, NumDatagrams);
+
+		REQUIRE(receiver->numReceived == NumDatagrams);
+
+		delete sender;
+		delete receiver;
+
+		runLoopToCloseHandles();
+	}
+}
+
+SCENARIO("UdpSocketHandler send data pool", "[handles][udp]")
+{
+	static constexpr size_t NumDatagrams{ 10u };
+	static constexpr size_t DatagramSize{ 100u };
+
+	SECTION("released send data is reused")
+	{
+		auto* sendData1 = UdpSocketHandler::AllocateSendData(DatagramSize);
+
+		REQUIRE(sendData1->storeSize >= DatagramSize);
+		REQUIRE(sendData1->len == 0u);
+
+		UdpSocketHandler::ReleaseSendData(sendData1);
+
+		auto* sendData2 = UdpSocketHandler::AllocateSendData(DatagramSize);
+
+		REQUIRE(sendData2 == sendData1);
+
+		UdpSocketHandler::ReleaseSendData(sendData2);
+	}
+
+	SECTION("big send data is not pooled")
+	{
+		auto* sendData = UdpSocketHandler::AllocateSendData(100000u);
+
+		REQUIRE(sendData->storeSize == 100000u);
+
+		UdpSocketHandler::ReleaseSendData(sendData);
+	}
+
+	SECTION("send data is sent without copying it")
+	{
+		auto* receiver = new TestUdpSocket();
+		auto* sender   = new TestUdpSocket();
+		size_t numSent{ 0u };
+
+		for (bool sendBatching : { false, true })
+		{
+			if (sendBatching && !UdpSocketHandler::IsSendBatchingSupported())
+				break;
+
+			sender->SetSendBatching(sendBatching);
+
+			for (size_t i{ 0u }; i < NumDatagrams; ++i)
+			{
+				auto* sendData = UdpSocketHandler::AllocateSendData(DatagramSize);
+
+				std::memset(sendData->store, 0xAB, DatagramSize);
+				sendData->len = DatagramSize;
+
+				sender->Send(
+				  sendData,
+				  receiver->GetLocalAddress(),
+				  new const std::function<void(bool sent)>(
+				    [&numSent](bool sent)
+				    {
+					    if (sent)
+						    numSent++;
+				    }));
+			}
+
+			runLoopUntilReceived(*receiver, receiver->numReceived + NumDatagrams);
+		}
+
+		const size_t numRounds = UdpSocketHandler::IsSendBatchingSupported() ? 2u : 1u;
+
+		REQUIRE(numSent == numRounds * NumDatagrams);
+		REQUIRE(sender->GetSentBytes() == numRounds * NumDatagrams * DatagramSize);
+		REQUIRE(receiver->numReceived == numRounds * NumDatagrams);
+
+		delete sender;
+		delete receiver;
+
+		runLoopToCloseHandles();
+	}
+}
+
+SCENARIO("UdpSocketHandler recv batching", "[handles][udp]")
+{
+	static constexpr size_t NumDatagrams{ 10u };
+	static constexpr size_t DatagramSize{ 100u };
+
+	std::vector<uint8_t> datagram(DatagramSize, 0xAB);
+
+	SECTION("invalid recv batch size throws")
+	{
+		auto* receiver = new TestUdpSocket();
+
+		REQUIRE_THROWS_AS(receiver->SetRecvBatchSize(0), MediaSoupTypeError);
+		REQUIRE_THROWS_AS(
+		  receiver->SetRecvBatchSize(UdpSocketHandler::GetMaxRecvBatchSize() + 1), MediaSoupTypeError);
+
+		delete receiver;
+
+		runLoopToCloseHandles();
+	}
+
+	SECTION("several datagrams are read at once if recv batching is enabled")
+	{
+		auto* receiver = new TestUdpSocket();
+		auto* sender   = new TestUdpSocket();
+
+		receiver->SetRecvBatchSize(NumDatagrams);
+
+		REQUIRE(receiver->GetRecvBatchSize() == NumDatagrams);
+
+		for (size_t i{ 0u }; i < NumDatagrams; ++i)
+		{
+			sender->Send(datagram.data(), datagram.size(), receiver->GetLocalAddress(), nullptr);
+		}
+
+		runLoopUntilReceived(*receiver, NumDatagrams);
+
+		REQUIRE(receiver->numReceived == NumDatagrams);
+		REQUIRE(receiver->GetRecvDatagrams() == NumDatagrams);
+		REQUIRE(receiver->GetRecvBytes() == NumDatagrams * DatagramSize);
+#ifdef __linux__
+		// All datagrams were already in the socket so a few recvmmsg() calls are
+		// enough.
+		REQUIRE(receiver->GetRecvBatches() >= 1u);
+		REQUIRE(receiver->GetRecvBatches() < NumDatagrams);
+#endif
+
+		delete sender;
+		delete receiver;
+
+		runLoopToCloseHandles();
+	}
+}
+
+SCENARIO("UdpSocketHandler connected socket", "[handles][udp]")
+{
+	static constexpr size_t NumDatagrams{ 10u };
+
+	std::vector<uint8_t> datagram(100u, 0xAB);
+
+	auto* receiver = new TestUdpSocket();
+	auto* other    = new TestUdpSocket();
+	auto* sender   = new TestUdpSocket(receiver->GetLocalAddress());
+
+	REQUIRE(sender->IsConnected());
+	REQUIRE(!receiver->IsConnected());
+
+	SECTION("datagrams are sent to the peer whatever the given address")
+	{
+		for (size_t i{ 0u }; i < NumDatagrams; ++i)
+		{
+			sender->Send(datagram.data(), datagram.size(), other->GetLocalAddress(), nullptr);
+		}
+
+		runLoopUntilReceived(*receiver, NumDatagrams);
+
+		REQUIRE(receiver->numReceived == NumDatagrams);
+		REQUIRE(other->numReceived == 0u);
+	}
+
+	SECTION("batched datagrams are sent to the peer whatever the given address")
+	{
+		if (!UdpSocketHandler::IsSendBatchingSupported())
+			return;
+
+		sender->SetSendBatching(true);
+
+		for (size_t i{ 0u }; i < NumDatagrams; ++i)
+		{
+			sender->Send(datagram.data(), datagram.size(), other->GetLocalAddress(), nullptr);
+		}
+
+		runLoopUntilReceived(*receiver, NumDatagrams);
+
+		REQUIRE(receiver->numReceived == NumDatagrams);
+		REQUIRE(other->numReceived == 0u);
+	}
+
+	delete sender;
+	delete other;
+	delete receiver;
+
+	runLoopToCloseHandles();
+}
+
+// Run it with `make test MEDIASOUP_TEST_TAGS="[benchmark]"`. Each benchmark
+// iteration sends `NumDatagrams` SRTP sized datagrams so packets per second
+// (in a single core) is `NumDatagrams` divided by the reported mean time.
+SCENARIO("UdpSocketHandler send benchmark", "[handles][udp][.benchmark]")
+{
+	static constexpr size_t NumDatagrams{ 1000u };
+	static constexpr size_t DatagramSize{ 1200u };
+
+	std::vector<uint8_t> datagram(DatagramSize, 0xAB);
+
+	auto* receiver = new TestUdpSocket();
+	auto* sender   = new TestUdpSocket();
+
+	BENCHMARK("send 1000 datagrams with uv_udp_try_send()")
+	{
+		for (size_t i{ 0u }; i < NumDatagrams; ++i)
+		{
+			sender->Send(datagram.data(), datagram.size(), receiver->GetLocalAddress(), nullptr);
+		}
+
+		// Drain the receiver so the kernel doesn't drop datagrams.
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		return sender->GetSentBytes();
+	};
+
+	if (UdpSocketHandler::IsSendBatchingSupported())
+	{
+		sender->SetSendBatching(true);
+
+		BENCHMARK("send 1000 datagrams with send batching")
+		{
+			for (size_t i{ 0u }; i < NumDatagrams; ++i)
+			{
+				sender->Send(datagram.data(), datagram.size(), receiver->GetLocalAddress(), nullptr);
+			}
+
+			// Flush the batch and drain the receiver.
+			uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+			return sender->GetSentBytes();
+		};
+	}
+
+	delete sender;
+	delete receiver;
+
+	runLoopToCloseHandles();
+}